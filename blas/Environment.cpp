@@ -6,7 +6,9 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <string>
+#include <cstdio>
 #include "Environment.h"
+#include <helpers/logger.h>
 
 namespace nd4j {
 
@@ -15,6 +17,16 @@ namespace nd4j {
         _elementThreshold.store(1024);
         _verbose.store(false);
         _debug.store(false);
+        _fusion.store(false);
+        _planning.store(false);
+        _elementOverride.store(false);
+        _tadOverride.store(false);
+
+        for (int e = 0; e < OP_CLASS_COUNT; e++) {
+            _classElementThreshold[e].store(0);
+            _classTadThreshold[e].store(0);
+            _classMaxThreads[e].store(0);
+        }
 
 #ifndef ANDROID
         const char* omp_threads = std::getenv("OMP_NUM_THREADS");
@@ -29,6 +41,10 @@ namespace nd4j {
                 // still do nothing
             }
         }
+
+        const char* profile = std::getenv("ND4J_TUNING_PROFILE");
+        if (profile != nullptr && !loadTuning(profile))
+            nd4j_printf("Unable to load tuning profile [%s]\n", profile);
 #endif
     }
 
@@ -69,6 +85,7 @@ namespace nd4j {
 
     void Environment::setTadThreshold(int threshold) {
         _tadThreshold = threshold;
+        _tadOverride = true;
     }
 
     int Environment::elementwiseThreshold() {
@@ -77,6 +94,7 @@ namespace nd4j {
 
     void Environment::setElementwiseThreshold(int threshold) {
         _elementThreshold = threshold;
+        _elementOverride = true;
     }
 
     int Environment::maxThreads() {
@@ -87,6 +105,107 @@ namespace nd4j {
         _maxThreads.store(max);
     }
 
+    bool Environment::isElementwiseFusion() {
+        return _fusion.load();
+    }
+
+    void Environment::setElementwiseFusion(bool reallyFuse) {
+        _fusion = reallyFuse;
+    }
+
+    bool Environment::isStaticMemoryPlanning() {
+        return _planning.load();
+    }
+
+    void Environment::setStaticMemoryPlanning(bool reallyPlan) {
+        _planning = reallyPlan;
+    }
+
+    static inline bool validClass(int opClass) {
+        return opClass >= 0 && opClass < OP_CLASS_COUNT;
+    }
+
+    int Environment::elementwiseThreshold(int opClass) {
+        if (_elementOverride.load() || !validClass(opClass))
+            return _elementThreshold.load();
+
+        int tuned = _classElementThreshold[opClass].load();
+        return tuned > 0 ? tuned : _elementThreshold.load();
+    }
+
+    void Environment::setElementwiseThreshold(int opClass, int threshold) {
+        if (validClass(opClass)) {
+            _classElementThreshold[opClass] = threshold;
+            _elementOverride = false;
+        }
+    }
+
+    int Environment::tadThreshold(int opClass) {
+        if (_tadOverride.load() || !validClass(opClass))
+            return _tadThreshold.load();
+
+        int tuned = _classTadThreshold[opClass].load();
+        return tuned > 0 ? tuned : _tadThreshold.load();
+    }
+
+    void Environment::setTadThreshold(int opClass, int threshold) {
+        if (validClass(opClass)) {
+            _classTadThreshold[opClass] = threshold;
+            _tadOverride = false;
+        }
+    }
+
+    int Environment::maxThreads(int opClass, int available) {
+        if (!validClass(opClass))
+            return available;
+
+        int tuned = _classMaxThreads[opClass].load();
+        return tuned > 0 && tuned < available ? tuned : available;
+    }
+
+    void Environment::setMaxThreads(int opClass, int max) {
+        if (validClass(opClass))
+            _classMaxThreads[opClass] = max;
+    }
+
+    void Environment::resetTuning() {
+        for (int e = 0; e < OP_CLASS_COUNT; e++) {
+            _classElementThreshold[e] = 0;
+            _classTadThreshold[e] = 0;
+            _classMaxThreads[e] = 0;
+        }
+    }
+
+    bool Environment::loadTuning(const char *fileName) {
+        FILE *fp = fopen(fileName, "r");
+        if (fp == nullptr)
+            return false;
+
+        int opClass, element, tad, threads;
+        while (fscanf(fp, "%i %i %i %i", &opClass, &element, &tad, &threads) == 4) {
+            setElementwiseThreshold(opClass, element);
+            setTadThreshold(opClass, tad);
+            setMaxThreads(opClass, threads);
+        }
+
+        bool result = feof(fp) != 0;
+        fclose(fp);
+
+        return result;
+    }
+
+    bool Environment::saveTuning(const char *fileName) {
+        FILE *fp = fopen(fileName, "w");
+        if (fp == nullptr)
+            return false;
+
+        for (int e = 0; e < OP_CLASS_COUNT; e++)
+            fprintf(fp, "%i %i %i %i\n", e, _classElementThreshold[e].load(), _classTadThreshold[e].load(), _classMaxThreads[e].load());
+
+        fclose(fp);
+        return true;
+    }
+
     nd4j::Environment *nd4j::Environment::_instance = 0;
 
 }
@@ -8,6 +8,17 @@
 #include <atomic>
 #include <dll.h>
 
+// op classes with separately tuned parallelism thresholds & thread counts
+#define OP_CLASS_TRANSFORM 0
+#define OP_CLASS_PAIRWISE 1
+#define OP_CLASS_SCALAR 2
+#define OP_CLASS_BROADCAST 3
+#define OP_CLASS_REDUCE 4
+#define OP_CLASS_INDEX_REDUCE 5
+#define OP_CLASS_REDUCE3 6
+#define OP_CLASS_RANDOM 7
+#define OP_CLASS_COUNT 8
+
 namespace nd4j{
     class ND4J_EXPORT Environment {
     private:
@@ -16,6 +27,17 @@ namespace nd4j{
         std::atomic<bool> _verbose;
         std::atomic<bool> _debug;
         std::atomic<int> _maxThreads;
+        std::atomic<bool> _fusion;
+        std::atomic<bool> _planning;
+
+        // per op class values, 0 means "not tuned", so global values are used
+        std::atomic<int> _classElementThreshold[OP_CLASS_COUNT];
+        std::atomic<int> _classTadThreshold[OP_CLASS_COUNT];
+        std::atomic<int> _classMaxThreads[OP_CLASS_COUNT];
+
+        // global thresholds set after tuning take precedence over tuned ones
+        std::atomic<bool> _elementOverride;
+        std::atomic<bool> _tadOverride;
 
         static Environment* _instance;
 
@@ -38,6 +60,40 @@ namespace nd4j{
 
         int maxThreads();
         void setMaxThreads(int max);
+
+        bool isElementwiseFusion();
+        void setElementwiseFusion(bool reallyFuse);
+
+        bool isStaticMemoryPlanning();
+        void setStaticMemoryPlanning(bool reallyPlan);
+
+        /**
+         * Per op class thresholds. These return tuned value for given OP_CLASS_*, unless it wasn't tuned,
+         * or global threshold was set via setElementwiseThreshold/setTadThreshold after tuning: the last one set wins
+         */
+        int elementwiseThreshold(int opClass);
+        void setElementwiseThreshold(int opClass, int threshold);
+
+        int tadThreshold(int opClass);
+        void setTadThreshold(int opClass, int threshold);
+
+        /**
+         * Number of threads to be used for given op class, limited by number of available threads
+         */
+        int maxThreads(int opClass, int available);
+        void setMaxThreads(int opClass, int max);
+
+        /**
+         * Drops all tuned values, so global ones are used everywhere
+         */
+        void resetTuning();
+
+        /**
+         * Tuning profile is plain text, one line per op class: "class elementThreshold tadThreshold maxThreads".
+         * Profile is loaded on startup from file set via ND4J_TUNING_PROFILE environment variable, if any.
+         */
+        bool loadTuning(const char *fileName);
+        bool saveTuning(const char *fileName);
     };
 }
 
@@ -24,7 +24,8 @@ namespace nd4j {
     template <typename T>
     class GraphExecutioner {
     protected:
-
+        // actual node execution, executeFlatNode wraps it with profiling if that's enabled
+        static Nd4jStatus executeFlatNodeInternal(Graph<T> *graph, Node<T> *node, VariableSpace<T> *variableSpace);
 
     public:
         //static Nd4jStatus executeFlatNode(nd4j::graph::Graph *graph, nd4j::graph::Node *node, nd4j::graph::VariableSpace<float> *variableSpace);
@@ -53,6 +54,15 @@ namespace nd4j {
         static Graph<T> *importFromFlatBuffers(const char *filename);
 
         static Graph<T> *importFromFlatPointer(Nd4jPointer ptr);
+
+        /**
+         * This method memory-maps given FlatBuffers file, and binds graph variables directly to mapped memory where dtype and byte order allow it.
+         * Mapping is private copy-on-write, so processes loading the same file share weight pages, and it's released together with the graph.
+         *
+         * @param filename
+         * @return
+         */
+        static Graph<T> *mapFlatBuffers(const char *filename);
     };
 
     long getFileSize(const char * filename);
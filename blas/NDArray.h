@@ -483,6 +483,12 @@ namespace nd4j {
         // apply reduce3 (execAll) operations to this and other array, return result in new output array
         template<typename OpName>
         NDArray<T>* applyAllReduce3(const NDArray<T>* other, const std::vector<int>& dimensions, const T* extraParams = nullptr) const;
+
+        // apply reduce3 (execAll) operations to this and other array, keep only k best matches for each tad of this array, sorted from best to worst
+        // values and indices (of other array tads) must have numTadsX * k elements
+        // indices are stored as T, so for float16 other array can't have more than 2048 tads
+        template<typename OpName>
+        void applyAllReduce3TopK(const NDArray<T>* other, const std::vector<int>& dimensions, const int k, NDArray<T>* values, NDArray<T>* indices, const T* extraParams = nullptr) const;
         
         // apply reduce3 (exec) operations to this and other array, return result in new output array
         template<typename OpName>
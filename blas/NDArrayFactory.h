@@ -48,6 +48,13 @@ namespace nd4j {
 
         static NDArray<T>* simpleMMul(const nd4j::NDArray<T>* a, const nd4j::NDArray<T>* b, nd4j::NDArray<T>* c , const T alpha, const T beta);
 
+        /**
+         * This method binds numpy array to NDArray. If numpy data type, byte order and alignment match T, returned array is a view
+         * over npy data (i.e. memory-mapped file), so npy array must outlive it. Otherwise converted copy is returned.
+         * Arrays of rank 0 and 1 become row vectors.
+         */
+        static NDArray<T>* fromNpy(const cnpy::NpyArray& array);
+
     };
 }
 
@@ -262,6 +262,25 @@ public:
                             int *yTadShapeInfo,
                             Nd4jIndex *yOffsets);
 
+    /**
+     * Same as execReduce3All, but only k best matches for each x TAD are stored into values & indices, [xTads, k] each
+     */
+    static void execReduce3AllTopK(int opNum,
+                            T *x,
+                            int *xShapeInfo,
+                            T *extraParamsVals,
+                            T *y,
+                            int *yShapeInfo,
+                            int *dimension,
+                            int dimensionLength,
+                            int *xTadShapeInfo,
+                            Nd4jIndex *xOffsets,
+                            int *yTadShapeInfo,
+                            Nd4jIndex *yOffsets,
+                            int k,
+                            T *values,
+                            Nd4jIndex *indices);
+
     static void execReduce3TAD(int opNum,
                             T *x,
                             int *xShapeInfo,
@@ -493,6 +512,14 @@ public:
         nd4j::SpecialMethods<T>::sortTadGeneric(x, xShapeInfo, dimension, dimensionLength, tadShapeInfo, tadOffsets, descending);
     }
 
+    inline static void execArgsort(T *x, int *xShapeInfo, Nd4jIndex *indices, bool descending) {
+        nd4j::SpecialMethods<T>::argsortGeneric(x, xShapeInfo, indices, descending);
+    }
+
+    inline static void execSortByKey(T *x, int *xShapeInfo, T *y, int *yShapeInfo, bool descending) {
+        nd4j::SpecialMethods<T>::sortByKeyGeneric(x, xShapeInfo, y, yShapeInfo, descending);
+    }
+
     inline static void execSortCooIndices(int *indices, T *values, Nd4jIndex length, int rank) {
         nd4j::sparse::SparseUtils<T>::sortCooIndicesGeneric(indices, values, length, rank);
     }
@@ -506,6 +533,22 @@ public:
         nd4j::SpecialMethods<T>::decodeBitmapGeneric(dx, N, dz);
     }
 
+    inline static void encodeThresholdP1(T *dx, Nd4jIndex N, int *dz, float threshold) {
+        nd4j::SpecialMethods<T>::encodeThresholdP1Generic(dx, N, dz, threshold);
+    }
+
+    inline static void encodeThresholdP2(int *dx, Nd4jIndex N, int *dz) {
+        nd4j::SpecialMethods<T>::encodeThresholdP2Generic(dx, N, dz);
+    }
+
+    inline static void encodeThresholdP3(T *dx, int *offsets, Nd4jIndex N, int *dz) {
+        nd4j::SpecialMethods<T>::encodeThresholdP3Generic(dx, offsets, N, dz);
+    }
+
+    inline static void decodeThreshold(void *dx, Nd4jIndex N, T *dz) {
+        nd4j::SpecialMethods<T>::decodeThresholdGeneric(dx, N, dz);
+    }
+
 };
 
 
@@ -357,6 +357,102 @@ public:
                               int *yTadShapeInfo,
                             Nd4jIndex *yOffsets);
 
+    /**
+     * All-pairs Reduce3 that keeps only k best matches of y TADs for every x TAD, instead of full [xTads, yTads] matrix.
+     * Similarities (dot, cosine similarity) prefer larger values, distances prefer smaller ones.
+     * PLEASE NOTE: not supported on CUDA backend, throws std::runtime_error there
+     *
+     * @param k
+     * @param values [xTads, k] best values, sorted from best to worst
+     * @param indices [xTads, k] indices of matching y TADs
+     */
+    void execReduce3AllTopKDouble(Nd4jPointer *extraPointers,
+                             int opNum,
+                             double *x,
+                             int *xInfo,
+                             double *extraParamsVals,
+                             double *y,
+                             int *yInfo,
+                             int *dimension,
+                             int dimensionLength,
+                             int *xTadShapeInfo,
+                             Nd4jIndex *xOffsets,
+                             int *yTadShapeInfo,
+                             Nd4jIndex *yOffsets,
+                             int k,
+                             double *values,
+                             Nd4jIndex *indices);
+
+    void execReduce3AllTopKFloat(Nd4jPointer *extraPointers,
+                             int opNum,
+                             float *x,
+                             int *xInfo,
+                             float *extraParamsVals,
+                             float *y,
+                             int *yInfo,
+                             int *dimension,
+                             int dimensionLength,
+                             int *xTadShapeInfo,
+                             Nd4jIndex *xOffsets,
+                             int *yTadShapeInfo,
+                             Nd4jIndex *yOffsets,
+                             int k,
+                             float *values,
+                             Nd4jIndex *indices);
+
+    void execReduce3AllTopKHalf(Nd4jPointer *extraPointers,
+                             int opNum,
+                             float16 *x,
+                             int *xInfo,
+                             float16 *extraParamsVals,
+                             float16 *y,
+                             int *yInfo,
+                             int *dimension,
+                             int dimensionLength,
+                             int *xTadShapeInfo,
+                             Nd4jIndex *xOffsets,
+                             int *yTadShapeInfo,
+                             Nd4jIndex *yOffsets,
+                             int k,
+                             float16 *values,
+                             Nd4jIndex *indices);
+
+    /**
+     * Gather of x slices along axis, with integer indices. z shape must be evaluated already:
+     * its rank is rank of x plus rank of indices minus 1
+     * PLEASE NOTE: not supported on CUDA backend, throws std::runtime_error there
+     *
+     * @param axis
+     * @param indices
+     * @param numIndices
+     */
+    void gatherDouble(Nd4jPointer *extraPointers,
+                      double *x,
+                      int *xShapeInfo,
+                      double *z,
+                      int *zShapeInfo,
+                      int axis,
+                      int *indices,
+                      int numIndices);
+
+    void gatherFloat(Nd4jPointer *extraPointers,
+                     float *x,
+                     int *xShapeInfo,
+                     float *z,
+                     int *zShapeInfo,
+                     int axis,
+                     int *indices,
+                     int numIndices);
+
+    void gatherHalf(Nd4jPointer *extraPointers,
+                    float16 *x,
+                    int *xShapeInfo,
+                    float16 *z,
+                    int *zShapeInfo,
+                    int axis,
+                    int *indices,
+                    int numIndices);
+
 
 
 
@@ -2801,6 +2897,111 @@ public:
                                       bool scalarReturned);
 
 
+    /**
+     * This method executes chain of elementwise legacy ops as single pass over memory.
+     * Op types are the same as for execMetaPredicate*: 0 - Scalar, 1 - Transform, 2 - PairWise.
+     *
+     * @param extras
+     * @param numOps - number of ops in chain
+     * @param opTypes - op type per op
+     * @param opNums - op number per op
+     * @param dx - input of first op
+     * @param xShapeInfo
+     * @param operands - Y array per op, used for PairWise ops only
+     * @param operandShapes - Y shapeInfo per op, used for PairWise ops only
+     * @param dz - output of last op
+     * @param zShapeInfo
+     * @param scalars - scalar per op, used for Scalar ops only
+     * @param extraParams - extra params pointer per op
+     *
+     * PLEASE NOTE: not supported on CUDA backend, throws std::runtime_error there
+     */
+    void execMetaChainFloat(Nd4jPointer *extras,
+                            int numOps,
+                            int *opTypes,
+                            int *opNums,
+                            float *dx,
+                            int *xShapeInfo,
+                            Nd4jPointer *operands,
+                            Nd4jPointer *operandShapes,
+                            float *dz,
+                            int *zShapeInfo,
+                            float *scalars,
+                            Nd4jPointer *extraParams);
+
+    void execMetaChainDouble(Nd4jPointer *extras,
+                             int numOps,
+                             int *opTypes,
+                             int *opNums,
+                             double *dx,
+                             int *xShapeInfo,
+                             Nd4jPointer *operands,
+                             Nd4jPointer *operandShapes,
+                             double *dz,
+                             int *zShapeInfo,
+                             double *scalars,
+                             Nd4jPointer *extraParams);
+
+    void execMetaChainHalf(Nd4jPointer *extras,
+                           int numOps,
+                           int *opTypes,
+                           int *opNums,
+                           float16 *dx,
+                           int *xShapeInfo,
+                           Nd4jPointer *operands,
+                           Nd4jPointer *operandShapes,
+                           float16 *dz,
+                           int *zShapeInfo,
+                           float *scalars,
+                           Nd4jPointer *extraParams);
+
+    /**
+     * This method enables fusion of linear chains of elementwise legacy ops within GraphExecutioner.
+     * Intermediate results of fused chains aren't stored in VariableSpace.
+     *
+     * @param reallyEnable
+     */
+    void enableElementwiseFusion(bool reallyEnable);
+
+    /**
+     * This method enables static memory planning within GraphExecutioner: intermediates of graph executed over its own VariableSpace
+     * are placed into single pre-sized arena, and planned views are reused by subsequent executions of the same graph.
+     * Planned graphs are executed layer by layer, without DAG scheduler & elementwise fusion.
+     *
+     * @param reallyEnable
+     */
+    void enableStaticMemoryPlanning(bool reallyEnable);
+
+    /**
+     * This method enables per-op profiling of graph execution: every node and DeclarableOp execution is recorded
+     *
+     * @param reallyEnable
+     */
+    void enableOpProfiling(bool reallyEnable);
+
+    /**
+     * This method drops all events & statistics gathered by profiler so far
+     */
+    void resetOpProfiling();
+
+    /**
+     * This method writes profiler events as Chrome trace-event JSON, to be opened with chrome://tracing
+     *
+     * @param fileName
+     * @return true on success
+     */
+    bool exportOpProfilingTrace(const char *fileName);
+
+    /**
+     * This method tunes parallelism thresholds & thread counts per op class.
+     * Profile is loaded from given file if it exists, otherwise calibration is performed and saved into that file.
+     *
+     * @param profileFile might be nullptr, then calibration results aren't saved
+     * @return true on success
+     */
+    bool autotuneThresholds(const char *profileFile);
+
+
 
     /**
      * Get the shape buffer from a
@@ -2820,6 +3021,7 @@ public:
 
     /**
      * Create a pointer to an NDarray struct
+     * File is memory-mapped (copy-on-write) if possible, so pages are loaded on demand
      * @param path  the path to create the ndarray
      * struct from
      * @return  a pointer to the ndarray struct
@@ -2948,6 +3150,89 @@ public:
     void sortTadHalf(Nd4jPointer *extraPointers, float16 *x, int *xShapeInfo, int *dimension, int dimensionLength, int *tadShapeInfo, Nd4jIndex *tadOffsets, bool descending);
 
 
+    /**
+     * This method writes into indices positions of x elements in sorted order. x itself is left intact.
+     * Sort is stable.
+     * PLEASE NOTE: not supported on CUDA backend, throws std::runtime_error there
+     *
+     * @param extraPointers
+     * @param x
+     * @param xShapeInfo
+     * @param indices - output, length of x
+     * @param descending
+     */
+    void argsortFloat(Nd4jPointer *extraPointers, float *x, int *xShapeInfo, Nd4jIndex *indices, bool descending);
+
+    void argsortDouble(Nd4jPointer *extraPointers, double *x, int *xShapeInfo, Nd4jIndex *indices, bool descending);
+
+    void argsortHalf(Nd4jPointer *extraPointers, float16 *x, int *xShapeInfo, Nd4jIndex *indices, bool descending);
+
+
+    /**
+     * This method sorts keys x, and applies the same permutation to values y. Both arrays must have the same length.
+     * PLEASE NOTE: not supported on CUDA backend, throws std::runtime_error there
+     *
+     * @param extraPointers
+     * @param x - keys
+     * @param xShapeInfo
+     * @param y - values
+     * @param yShapeInfo
+     * @param descending
+     */
+    void sortByKeyFloat(Nd4jPointer *extraPointers, float *x, int *xShapeInfo, float *y, int *yShapeInfo, bool descending);
+
+    void sortByKeyDouble(Nd4jPointer *extraPointers, double *x, int *xShapeInfo, double *y, int *yShapeInfo, bool descending);
+
+    void sortByKeyHalf(Nd4jPointer *extraPointers, float16 *x, int *xShapeInfo, float16 *y, int *yShapeInfo, bool descending);
+
+
+    /**
+     * This method runs Hogwild-style skip-gram training over batch of (word, context) pairs.
+     * syn0/syn1/syn1Neg layouts are the same as SkipGram aggregate uses.
+     *
+     * @param extraPointers
+     * @param syn0
+     * @param syn1 - nullptr if hierarchic softmax isn't used
+     * @param syn1Neg - nullptr if negative sampling isn't used
+     * @param expTable
+     * @param negTable
+     * @param words - [numPairs]
+     * @param contexts - [numPairs]
+     * @param numPairs
+     * @param codes - Huffman codes, [vocabSize x maxCodeLength], nullptr if hierarchic softmax isn't used
+     * @param points - Huffman points, [vocabSize x maxCodeLength]
+     * @param codeLengths - [vocabSize]
+     * @param maxCodeLength
+     * @param vectorLength
+     * @param vocabSize
+     * @param expLength
+     * @param negTableLength
+     * @param negative - number of negative samples, 0 to disable negative sampling
+     * @param alpha - learning rate
+     * @param seed
+     * @return words per second, negative value if backend doesn't support this method (CUDA)
+     */
+    double execSkipGramFloat(Nd4jPointer *extraPointers, float *syn0, float *syn1, float *syn1Neg, float *expTable, float *negTable, int *words, int *contexts, Nd4jIndex numPairs, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed);
+
+    double execSkipGramDouble(Nd4jPointer *extraPointers, double *syn0, double *syn1, double *syn1Neg, double *expTable, double *negTable, int *words, int *contexts, Nd4jIndex numPairs, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed);
+
+    double execSkipGramHalf(Nd4jPointer *extraPointers, float16 *syn0, float16 *syn1, float16 *syn1Neg, float16 *expTable, float16 *negTable, int *words, int *contexts, Nd4jIndex numPairs, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed);
+
+
+    /**
+     * This method runs Hogwild-style CBOW training over batch of samples.
+     * contexts is [numSamples x contextWidth] matrix, rows shorter than contextWidth are padded with -1.
+     * All other arguments are the same as for execSkipGram.
+     *
+     * @return words per second, negative value if backend doesn't support this method (CUDA)
+     */
+    double execCbowFloat(Nd4jPointer *extraPointers, float *syn0, float *syn1, float *syn1Neg, float *expTable, float *negTable, int *words, int *contexts, int contextWidth, Nd4jIndex numSamples, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed);
+
+    double execCbowDouble(Nd4jPointer *extraPointers, double *syn0, double *syn1, double *syn1Neg, double *expTable, double *negTable, int *words, int *contexts, int contextWidth, Nd4jIndex numSamples, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed);
+
+    double execCbowHalf(Nd4jPointer *extraPointers, float16 *syn0, float16 *syn1, float16 *syn1Neg, float16 *expTable, float16 *negTable, int *words, int *contexts, int contextWidth, Nd4jIndex numSamples, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed);
+
+
     // special sort impl for sorting out COO indices and values
     void sortCooIndicesFloat(Nd4jPointer *extraPointers, int *indices, float *values, Nd4jIndex length, int rank);
 
@@ -2985,10 +3270,60 @@ public:
     int registerGraphDouble(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer flatBufferPointer);
     int registerGraphHalf(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer flatBufferPointer);
 
+    /**
+     * This method registers graph stored in given FlatBuffers file. File is memory-mapped, and constant variables are bound directly to mapped memory,
+     * so they're neither copied nor converted when dtype and byte order match.
+     *
+     * @param extraPointers
+     * @param graphId
+     * @param fileName
+     * @return
+     */
+    int registerMappedGraphFloat(Nd4jPointer *extraPointers, Nd4jIndex graphId, const char *fileName);
+    int registerMappedGraphDouble(Nd4jPointer *extraPointers, Nd4jIndex graphId, const char *fileName);
+    int registerMappedGraphHalf(Nd4jPointer *extraPointers, Nd4jIndex graphId, const char *fileName);
+
     nd4j::graph::VariablesSet<float>* executeStoredGraphFloat(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs);
     nd4j::graph::VariablesSet<double>* executeStoredGraphDouble(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs);
     nd4j::graph::VariablesSet<float16>* executeStoredGraphHalf(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs);
 
+    /**
+     * These methods submit stored graph for execution on internal worker thread, and return execution handle immediately.
+     * Inputs are copied before return, so input buffers can be reused right away.
+     *
+     * @param callback - optional nd4j::graph::GraphCallback, invoked on worker thread once results are available
+     * @param callbackData - passed to callback as is
+     * @return execution handle, or nullptr if backend doesn't support async execution (CUDA)
+     */
+    Nd4jPointer executeStoredGraphAsyncFloat(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer callback, Nd4jPointer callbackData);
+    Nd4jPointer executeStoredGraphAsyncDouble(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer callback, Nd4jPointer callbackData);
+    Nd4jPointer executeStoredGraphAsyncHalf(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer callback, Nd4jPointer callbackData);
+
+    /**
+     * This method returns true if execution is finished. Never blocks.
+     */
+    bool isGraphExecutionDone(Nd4jPointer handle);
+
+    /**
+     * This method blocks till execution is finished, and returns its status
+     */
+    int waitGraphExecution(Nd4jPointer handle);
+
+    /**
+     * These methods block till execution is finished, and return its results. Results should be released with deleteVariablesSet*
+     */
+    nd4j::graph::VariablesSet<float>* getGraphExecutionResultFloat(Nd4jPointer handle);
+    nd4j::graph::VariablesSet<double>* getGraphExecutionResultDouble(Nd4jPointer handle);
+    nd4j::graph::VariablesSet<float16>* getGraphExecutionResultHalf(Nd4jPointer handle);
+
+    /**
+     * This method releases execution handle, waiting for execution to finish if needed
+     */
+    void deleteGraphExecution(Nd4jPointer handle);
+
+    /**
+     * This method removes stored graph. If executions using this graph are in flight or queued, it blocks till they are finished
+     */
     int unregisterGraph(Nd4jPointer *extraPointers, Nd4jIndex graphId);
 
     void deleteIntArray(Nd4jPointer pointer);
@@ -23,10 +23,23 @@
 //#include <google/protobuf/io/zero_copy_stream_impl.h>
 
 #include <fcntl.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#include <helpers/mman.h>
+#include <io.h>
+#endif
 
 #include <chrono>
+#include <memory>
 #include <ctime>
 #include <graph/execution/LogicExecutor.h>
+#include <graph/execution/GraphScheduler.h>
+#include <graph/execution/GraphFuser.h>
+#include <graph/MemoryPlanner.h>
+#include <graph/OpProfiler.h>
+#include <omp.h>
 #include <array/DataTypeUtils.h>
 #include <helpers/BitwiseUtils.h>
 #include <generated/array_generated.h>
@@ -46,6 +59,31 @@ namespace graph {
  */
 template <typename T>
  Nd4jStatus GraphExecutioner<T>::executeFlatNode(Graph<T> *graph, Node<T> *node, VariableSpace<T> *variableSpace) {
+    auto profiler = OpProfiler::getInstance();
+    if (!profiler->isEnabled())
+        return executeFlatNodeInternal(graph, node, variableSpace);
+
+    ProfilerEvent event;
+    event.start = profiler->now();
+
+    auto status = executeFlatNodeInternal(graph, node, variableSpace);
+
+    event.end = profiler->now();
+    event.category = "node";
+    event.nodeId = node->id();
+    event.threadId = profiler->threadId();
+    if (node->getName() != nullptr && node->getName()->size() > 0)
+        event.name = *node->getName();
+    else
+        event.name = "node_" + std::to_string(node->id());
+
+    profiler->record(event);
+
+    return status;
+}
+
+template <typename T>
+Nd4jStatus GraphExecutioner<T>::executeFlatNodeInternal(Graph<T> *graph, Node<T> *node, VariableSpace<T> *variableSpace) {
     OpType opType = node->opType();
     int opNum = node->opNum();
 
@@ -194,6 +232,49 @@ Nd4jStatus GraphExecutioner<T>::execute(Graph<T> *graph, VariableSpace<T>* varia
 
     bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
 
+    // static memory plan is used only with graph's own VariableSpace: concurrent sessions over the same graph would share its arena
+    if (nd4j::Environment::getInstance()->isStaticMemoryPlanning() && __variableSpace == graph->getVariableSpace()) {
+        auto attached = __variableSpace->memoryPlanner();
+
+        // planner attached by caller is used as is. graph's own plan is rebuilt here if input shapes were changed
+        if (attached == nullptr || graph->ownsMemoryPlanner(attached))
+            __variableSpace->setMemoryPlanner(graph->getMemoryPlanner());
+    }
+
+    // linear chains of elementwise nodes are executed as single pass, if that's enabled
+    std::unique_ptr<GraphFuser<T>> fuser;
+    if (nd4j::Environment::getInstance()->isElementwiseFusion() && __variableSpace->memoryPlanner() == nullptr && GraphScheduler<T>::isApplicable(graph))
+        fuser.reset(new GraphFuser<T>(graph));
+
+    // independent nodes are executed concurrently, as soon as their inputs are ready
+    // statically planned memory relies on onion order, so planned graphs are always executed layer by layer
+    if (pe && omp_get_max_threads() > 1 && __variableSpace->memoryPlanner() == nullptr && GraphScheduler<T>::isApplicable(graph)) {
+        int numWorkers = nd4j::math::nd4j_min<int>(omp_get_max_threads(), GraphScheduler<T>::maxLayerWidth(graph));
+
+        if (numWorkers > 1) {
+            GraphScheduler<T> scheduler(graph, __variableSpace, numWorkers, fuser.get());
+
+            Nd4jStatus status;
+            try {
+                status = scheduler.execute();
+            } catch (...) {
+                if (tempFlow) {
+                    __variableSpace->setFlowPath(nullptr);
+                    delete flowPath;
+                }
+
+                throw;
+            }
+
+            if (tempFlow) {
+                __variableSpace->setFlowPath(nullptr);
+                delete flowPath;
+            }
+
+            return status;
+        }
+    }
+
     // TODO: add code divergence support here
     // basically if at some point code diverges, code branch might be _DISABLED_, and all nodes within that branch will be disabled as well
 
@@ -249,10 +330,14 @@ Nd4jStatus GraphExecutioner<T>::execute(Graph<T> *graph, VariableSpace<T>* varia
             if (shouldSkip)
                 continue;
 
+            // this node will be executed together with the rest of its chain
+            if (fuser != nullptr && fuser->isDeferred(node->id()))
+                continue;
+
             auto timeStart = std::chrono::system_clock::now();
 
             // actual node execution happens right here
-            Nd4jStatus status = executeFlatNode(graph, node, __variableSpace);
+            Nd4jStatus status = fuser != nullptr && fuser->isChainTail(node->id()) ? fuser->executeChain(graph, node->id(), __variableSpace) : executeFlatNode(graph, node, __variableSpace);
 
             auto timeEnd = std::chrono::system_clock::now();
 
@@ -285,8 +370,10 @@ Nd4jStatus GraphExecutioner<T>::execute(Graph<T> *graph, VariableSpace<T>* varia
         }
     }
 
-    if (tempFlow)
+    if (tempFlow) {
+        __variableSpace->setFlowPath(nullptr);
         delete flowPath;
+    }
 
     return ND4J_STATUS_OK;
 }
@@ -650,6 +737,48 @@ Graph<T>* GraphExecutioner<T>::importFromFlatBuffers(const char *filename) {
         return restoredGraph;
     }
 
+    template <typename T>
+    Graph<T> *GraphExecutioner<T>::mapFlatBuffers(const char *filename) {
+        long fileLen = getFileSize(filename);
+        if (fileLen <= 0) {
+            nd4j_printf("File [%s] wasn't found. Please check path and permissions\n", filename);
+            throw "File not found";
+        }
+
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0) {
+            nd4j_printf("File [%s] can't be opened\n", filename);
+            throw "File not found";
+        }
+
+        // private mapping: pages are shared until somebody writes into them
+        void *ptr = mmap(nullptr, (size_t) fileLen, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (ptr == MAP_FAILED)
+            throw "Unable to map FlatBuffers file";
+
+        flatbuffers::Verifier verifier(reinterpret_cast<uint8_t *>(ptr), (size_t) fileLen);
+        if (!VerifyFlatGraphBuffer(verifier)) {
+            munmap(ptr, (size_t) fileLen);
+            nd4j_printf("File [%s] isn't valid FlatGraph\n", filename);
+            throw "Bad FlatBuffers file";
+        }
+
+        auto fg = GetFlatGraph(reinterpret_cast<uint8_t *>(ptr));
+        Graph<T> *restoredGraph = nullptr;
+        try {
+            restoredGraph = new Graph<T>(fg, true);
+        } catch (...) {
+            // graph doesn't own the mapping yet
+            munmap(ptr, (size_t) fileLen);
+            throw;
+        }
+        restoredGraph->adoptMapping(ptr, fileLen);
+
+        return restoredGraph;
+    }
+
 
         template class ND4J_EXPORT GraphExecutioner<float>;
         template class ND4J_EXPORT GraphExecutioner<float16>;
@@ -19,6 +19,7 @@
 #include <indexing/NDIndex.h>
 #include <indexing/IndicesList.h>
 #include <helpers/ShapeUtils.h>
+#include <helpers/TadCache.h>
 
 namespace nd4j {
 
@@ -745,13 +746,11 @@ template <typename T>
         if(rankOf() == copy.size())
             result->_buffer[0] = functions::reduce::ReduceFunction<T>::template execScalar<OpName>(_buffer, _shapeInfo, nullptr);        
         else {
-            shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-            tad.createTadOnlyShapeInfo();
-            tad.createOffsets();        
+            auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, copy);        
             
             functions::reduce::ReduceFunction<T>::template exec<OpName>(_buffer, _shapeInfo, nullptr, result->_buffer,
                                                                         result->_shapeInfo, copy.data(), copy.size(),
-                                                                        tad.tadOnlyShapeInfo, tad.tadOffsets);       
+                                                                        tad->tadOnlyShapeInfo(), tad->tadOffsets());       
         }
         
         return result;
@@ -772,13 +771,11 @@ template <typename T>
         if(rankOf() == copy.size())
             result._buffer[0] = functions::reduce::ReduceFunction<T>::template execScalar<OpName>(_buffer, _shapeInfo, nullptr);        
         else {
-            shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-            tad.createTadOnlyShapeInfo();
-            tad.createOffsets();        
+            auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, copy);        
             
             functions::reduce::ReduceFunction<T>::template exec<OpName>(_buffer, _shapeInfo, nullptr, result._buffer,
                                                                         result._shapeInfo, copy.data(), copy.size(),
-                                                                        tad.tadOnlyShapeInfo, tad.tadOffsets);       
+                                                                        tad->tadOnlyShapeInfo(), tad->tadOffsets());       
         }
         
         return result;
@@ -802,13 +799,11 @@ template <typename T>
         if(rankOf() == copy.size())
             target->_buffer[0] = functions::reduce::ReduceFunction<T>::template execScalar<OpName>(_buffer, _shapeInfo, nullptr);
         else {
-            shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-            tad.createTadOnlyShapeInfo();
-            tad.createOffsets();
+            auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, copy);
 
             functions::reduce::ReduceFunction<T>::template exec<OpName>(_buffer, _shapeInfo, nullptr, target->_buffer,
                                                                         target->_shapeInfo, copy.data(), copy.size(),
-                                                                        tad.tadOnlyShapeInfo, tad.tadOffsets);
+                                                                        tad->tadOnlyShapeInfo(), tad->tadOffsets());
         }
     }
 
@@ -990,21 +985,19 @@ template <typename T>
         if (index >= numTads)
             throw "Can't get index higher than total number of TADs";
 
-        shape::TAD tad(this->_shapeInfo, copy.data(), copy.size());
-        tad.createTadOnlyShapeInfo();
-        tad.createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(this->_shapeInfo, copy);
 
-        shape::printShapeInfoLinear(tad.tadOnlyShapeInfo);
+        shape::printShapeInfoLinear(tad->tadOnlyShapeInfo());
 
-        T* buffer = this->_buffer + tad.tadOffsets[index];
+        T* buffer = this->_buffer + tad->tadOffsets()[index];
 
         int* shapeInfo;
         if (_workspace == nullptr) {
-            shapeInfo = new int[shape::shapeInfoLength(tad.tadOnlyShapeInfo[0])];
+            shapeInfo = new int[shape::shapeInfoLength(tad->tadOnlyShapeInfo()[0])];
         } else {
-            shapeInfo = (int *) _workspace->allocateBytes(shape::shapeInfoByteLength(tad.tadOnlyShapeInfo[0]));
+            shapeInfo = (int *) _workspace->allocateBytes(shape::shapeInfoByteLength(tad->tadOnlyShapeInfo()[0]));
         }
-        std::memcpy(shapeInfo, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
+        std::memcpy(shapeInfo, tad->tadOnlyShapeInfo(), shape::shapeInfoByteLength(tad->tadOnlyShapeInfo()));
 
         auto array = new NDArray<T>(buffer, shapeInfo, _workspace);
         array->_isBuffAlloc = false;
@@ -1166,13 +1159,11 @@ template<typename T>
 
         int dimension[1] = {1};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner<T>::execBroadcast(0, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(),
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad->tadOnlyShapeInfo(), tad->tadOffsets(),
+                                             tad->tadOnlyShapeInfo(), tad->tadOffsets());
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1183,13 +1174,11 @@ template<typename T>
 
         int dimension[1] = {1};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner<T>::execBroadcast(1, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(),
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad->tadOnlyShapeInfo(), tad->tadOffsets(),
+                                             tad->tadOnlyShapeInfo(), tad->tadOffsets());
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1200,13 +1189,11 @@ template<typename T>
 
         int dimension[1] = {1};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner<T>::execBroadcast(2, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(),
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad->tadOnlyShapeInfo(), tad->tadOffsets(),
+                                             tad->tadOnlyShapeInfo(), tad->tadOffsets());
 
     }
 
@@ -1218,13 +1205,11 @@ template<typename T>
 
         int dimension[1] = {1};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner<T>::execBroadcast(3, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(),
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad->tadOnlyShapeInfo(), tad->tadOffsets(),
+                                             tad->tadOnlyShapeInfo(), tad->tadOffsets());
 
     }
 
@@ -1237,13 +1222,11 @@ template<typename T>
 
         int dimension[1] = {1};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner<T>::execBroadcast(0, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, _buffer, _shapeInfo,
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad->tadOnlyShapeInfo(), tad->tadOffsets(),
+                                             tad->tadOnlyShapeInfo(), tad->tadOffsets());
     }
 
 
@@ -1255,13 +1238,11 @@ template<typename T>
 
         int dimension[1] = {0};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner<T>::execBroadcast(0, _buffer, _shapeInfo, column->_buffer, column->_shapeInfo, target->getBuffer(), target->getShapeInfo(),
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad->tadOnlyShapeInfo(), tad->tadOffsets(),
+                                             tad->tadOnlyShapeInfo(), tad->tadOffsets());
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1273,13 +1254,11 @@ template<typename T>
 
         int dimension[1] = {0};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner<T>::execBroadcast(0, _buffer, _shapeInfo, column->_buffer, column->_shapeInfo, _buffer, _shapeInfo,
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad->tadOnlyShapeInfo(), tad->tadOffsets(),
+                                             tad->tadOnlyShapeInfo(), tad->tadOffsets());
     }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1291,13 +1270,11 @@ template<typename T>
 
         int dimension[1] = {0};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner<T>::execBroadcast(2, _buffer, _shapeInfo, column->_buffer, column->_shapeInfo, _buffer, _shapeInfo,
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad->tadOnlyShapeInfo(), tad->tadOffsets(),
+                                             tad->tadOnlyShapeInfo(), tad->tadOffsets());
     }
 
 
@@ -1781,14 +1758,12 @@ void NDArray<T>::applyBroadcast(std::vector<int>& dimensions, const NDArray<T>*
     if (tadLength != tadArray->lengthOf())
        throw "Tad length mismatch";
 
-    shape::TAD tad(this->_shapeInfo, copy.data(), copy.size());
-    tad.createTadOnlyShapeInfo();
-    tad.createOffsets();
+    auto tad = nd4j::TadCache::getInstance()->tadForDimensions(this->_shapeInfo, copy);
 
     NDArray<T>* result = target == nullptr ? this : target;
 
     // TODO: eventually we want separate tads here
-    functions::broadcast::Broadcast<T>::template exec<OpName>(this->_buffer, this->_shapeInfo, tadArray->_buffer, tadArray->_shapeInfo, result->_buffer, result->_shapeInfo, copy.data(), (int)copy.size(), tad.tadOnlyShapeInfo, tad.tadOffsets, tad.tadOnlyShapeInfo, tad.tadOffsets);
+    functions::broadcast::Broadcast<T>::template exec<OpName>(this->_buffer, this->_shapeInfo, tadArray->_buffer, tadArray->_shapeInfo, result->_buffer, result->_shapeInfo, copy.data(), (int)copy.size(), tad->tadOnlyShapeInfo(), tad->tadOffsets(), tad->tadOnlyShapeInfo(), tad->tadOffsets());
 }
 
 
@@ -2382,13 +2357,11 @@ void NDArray<T>::svd(NDArray<T>& u, NDArray<T>& w, NDArray<T>& vt)
             if (dimensions.size() > 1)
                 std::sort(copy.begin(), copy.end());
 
-            shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-            tad.createTadOnlyShapeInfo();
-            tad.createOffsets();
+            auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, copy);
 
             functions::indexreduce::IndexReduce<T>::template exec<OpName>(_buffer, _shapeInfo, const_cast<T*>(extraParams), target->_buffer,
                                                                           target->_shapeInfo, copy.data(), copy.size(),
-                                                                          tad.tadOnlyShapeInfo, tad.tadOffsets);
+                                                                          tad->tadOnlyShapeInfo(), tad->tadOffsets());
         }
     }
     ////////////////////////////////////////////////////////////////////////
@@ -2408,13 +2381,11 @@ void NDArray<T>::svd(NDArray<T>& u, NDArray<T>& w, NDArray<T>& vt)
         if(rankOf() == copy.size())
             result->_buffer[0] = functions::indexreduce::IndexReduce<T>::template execScalar<OpName>(_buffer, _shapeInfo, const_cast<T*>(extraParams));
         else {
-            shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-            tad.createTadOnlyShapeInfo();
-            tad.createOffsets();
+            auto tad = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, copy);
         
             functions::indexreduce::IndexReduce<T>::template exec<OpName>(_buffer, _shapeInfo, const_cast<T*>(extraParams), result->_buffer,
                                                                     result->_shapeInfo, copy.data(), copy.size(),
-                                                                    tad.tadOnlyShapeInfo, tad.tadOffsets);
+                                                                    tad->tadOnlyShapeInfo(), tad->tadOffsets());
         }
         
         return result;
@@ -2462,15 +2433,11 @@ void NDArray<T>::svd(NDArray<T>& u, NDArray<T>& w, NDArray<T>& vt)
         shape::checkDimensions(rankOf(), copy);
         shape::checkDimensions(other->rankOf(), copy);               
         // create tads
-        shape::TAD tadX(_shapeInfo, copy.data(), copy.size());
-        tadX.createTadOnlyShapeInfo();
-        tadX.createOffsets();
+        auto tadX = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, copy);
 
-        shape::TAD tadY(other->_shapeInfo, copy.data(), copy.size());
-        tadY.createTadOnlyShapeInfo();
-        tadY.createOffsets();        
+        auto tadY = nd4j::TadCache::getInstance()->tadForDimensions(other->_shapeInfo, copy);        
         // check tads shapes
-        if(!shape::equalsSoft(tadX.tadOnlyShapeInfo, tadY.tadOnlyShapeInfo)) 
+        if(!shape::equalsSoft(tadX->tadOnlyShapeInfo(), tadY->tadOnlyShapeInfo())) 
             throw "NDArray::applyAllReduce3 method: the shapes of array tads are different !";
         // evaluate numbers of tads
         Nd4jIndex tadLengthX = shape::tadLength(_shapeInfo, copy.data(), copy.size());
@@ -2497,11 +2464,53 @@ void NDArray<T>::svd(NDArray<T>& u, NDArray<T>& w, NDArray<T>& vt)
         // perform calculations
         functions::reduce3::Reduce3<T>::template execAll<OpName>(_buffer, _shapeInfo, const_cast<T*>(extraParams),
                                                                  other->_buffer, other->_shapeInfo, result->_buffer,result->_shapeInfo,
-                                                                 copy.data(), copy.size(), tadX.tadOnlyShapeInfo, tadX.tadOffsets, tadY.tadOnlyShapeInfo, tadY.tadOffsets);
+                                                                 copy.data(), copy.size(), tadX->tadOnlyShapeInfo(), tadX->tadOffsets(), tadY->tadOnlyShapeInfo(), tadY->tadOffsets());
         delete []extraParamsVals;
         return result;
     }
  
+    ////////////////////////////////////////////////////////////////////////
+    // apply reduce3 (execAll) operations to this and other array, keep k best matches per tad
+    template<typename T>
+    template<typename OpName>
+    void NDArray<T>::applyAllReduce3TopK(const NDArray<T>* other, const std::vector<int>& dimensions, const int k, NDArray<T>* values, NDArray<T>* indices, const T* extraParams) const {
+        std::vector<int> copy(dimensions);
+        shape::checkDimensions(rankOf(), copy);
+        shape::checkDimensions(other->rankOf(), copy);
+        // create tads
+        auto tadX = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, copy);
+        auto tadY = nd4j::TadCache::getInstance()->tadForDimensions(other->_shapeInfo, copy);
+        // check tads shapes
+        if(!shape::equalsSoft(tadX->tadOnlyShapeInfo(), tadY->tadOnlyShapeInfo()))
+            throw "NDArray::applyAllReduce3TopK method: the shapes of array tads are different !";
+
+        Nd4jIndex tadLengthX = shape::tadLength(_shapeInfo, copy.data(), copy.size());
+        Nd4jIndex numTadsX = lengthOf() / tadLengthX;
+
+        if (k < 1 || values->lengthOf() != numTadsX * k || indices->lengthOf() != numTadsX * k)
+            throw "NDArray::applyAllReduce3TopK method: values and indices arrays must have numTads * k elements !";
+
+        // indices are stored as T, and float16 represents integers exactly only up to 2048
+        if (std::is_same<T, float16>::value && other->lengthOf() / tadLengthX > 2048)
+            throw "NDArray::applyAllReduce3TopK method: float16 indices can't address more than 2048 tads of other array !";
+
+        T extraParamsVals[3] = {(T) 0.0, (T) 0.0, (T) 0.0};
+        if(extraParams == nullptr)
+            extraParams = extraParamsVals;
+
+        std::vector<T> bestValues(numTadsX * k);
+        std::vector<Nd4jIndex> bestIndices(numTadsX * k);
+        functions::reduce3::Reduce3<T>::template execAllTopK<OpName>(_buffer, _shapeInfo, const_cast<T*>(extraParams),
+                                                                     other->_buffer, other->_shapeInfo, copy.data(), copy.size(),
+                                                                     tadX->tadOnlyShapeInfo(), tadX->tadOffsets(), tadY->tadOnlyShapeInfo(), tadY->tadOffsets(),
+                                                                     k, bestValues.data(), bestIndices.data());
+        // output arrays may have any order
+        for (Nd4jIndex e = 0; e < numTadsX * k; e++) {
+            values->putIndexedScalar(e, bestValues[e]);
+            indices->putIndexedScalar(e, (T) bestIndices[e]);
+        }
+    }
+
     ////////////////////////////////////////////////////////////////////////
     // apply reduce3 (exec) operations to this and other array, return result in new output array
     template<typename T>
@@ -2525,17 +2534,12 @@ void NDArray<T>::svd(NDArray<T>& u, NDArray<T>& w, NDArray<T>& vt)
         if(rankOf() == copy.size() && other->rankOf() == copy.size())
             result->_buffer[0] = functions::reduce3::Reduce3<T>::template execScalar<OpName>(_buffer, _shapeInfo, const_cast<T*>(extraParams), other->_buffer, other->_shapeInfo);
         else {
-            shape::TAD tadX(_shapeInfo, copy.data(), copy.size());
-            tadX.createTadOnlyShapeInfo();
-            tadX.createOffsets();
+            auto tadX = nd4j::TadCache::getInstance()->tadForDimensions(_shapeInfo, copy);
+            auto tadY = nd4j::TadCache::getInstance()->tadForDimensions(other->_shapeInfo, copy);
 
-            shape::TAD tadY(other->_shapeInfo, copy.data(), copy.size());
-            tadY.createTadOnlyShapeInfo();
-            tadY.createOffsets();        
-        
             functions::reduce3::Reduce3<T>::template exec<OpName>(_buffer, _shapeInfo, const_cast<T*>(extraParams),
                                                                  other->_buffer, other->_shapeInfo, result->_buffer,result->_shapeInfo,
-                                                                 copy.data(), copy.size(), tadX.tadOnlyShapeInfo, tadX.tadOffsets, tadY.tadOnlyShapeInfo, tadY.tadOffsets);
+                                                                 copy.data(), copy.size(), tadX->tadOnlyShapeInfo(), tadX->tadOffsets(), tadY->tadOnlyShapeInfo(), tadY->tadOffsets());
         }
         
         delete []extraParamsVals;
@@ -12,6 +12,8 @@
 #include <types/float16.h>
 #include <helpers/ShapeUtils.h>
 #include <helpers/BlasHelper.h>
+#include <helpers/TadCache.h>
+#include <helpers/BitwiseUtils.h>
 
 namespace nd4j {
 
@@ -40,12 +42,10 @@ namespace nd4j {
         Nd4jIndex tadLength = shape::tadLength(ndArray->getShapeInfo(), copy.data(), copy.size());
         Nd4jIndex numTads = ndArray->lengthOf() / tadLength;
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(ndArray->getShapeInfo(), copy.data(), copy.size()));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(ndArray->getShapeInfo(), copy);
 
-        int* shapeInfo = new int[shape::shapeInfoLength(tad->tadOnlyShapeInfo[0])];
-        std::memcpy(shapeInfo, tad->tadOnlyShapeInfo, shape::shapeInfoByteLength(tad->tadOnlyShapeInfo));
+        int* shapeInfo = new int[shape::shapeInfoLength(tad->tadOnlyShapeInfo()[0])];
+        std::memcpy(shapeInfo, tad->tadOnlyShapeInfo(), shape::shapeInfoByteLength(tad->tadOnlyShapeInfo()));
 
         for (auto idx: indices) {
             if (idx >= numTads) {
@@ -54,7 +54,7 @@ namespace nd4j {
             }
 
 
-            T* buffer = ndArray->getBuffer() + tad->tadOffsets[idx];
+            T* buffer = ndArray->getBuffer() + tad->tadOffsets()[idx];
             auto array = new NDArray<T>(buffer, shapeInfo);
             result->push_back(array);
         }
@@ -87,15 +87,13 @@ namespace nd4j {
         Nd4jIndex tadLength = shape::tadLength(ndArray->getShapeInfo(), copy.data(), copy.size());
         Nd4jIndex numTads = ndArray->lengthOf() / tadLength;
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(ndArray->getShapeInfo(), copy.data(), copy.size()));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = nd4j::TadCache::getInstance()->tadForDimensions(ndArray->getShapeInfo(), copy);
 
-        int* shapeInfo = new int[shape::shapeInfoLength(tad->tadOnlyShapeInfo[0])];
-        std::memcpy(shapeInfo, tad->tadOnlyShapeInfo, shape::shapeInfoByteLength(tad->tadOnlyShapeInfo));
+        int* shapeInfo = new int[shape::shapeInfoLength(tad->tadOnlyShapeInfo()[0])];
+        std::memcpy(shapeInfo, tad->tadOnlyShapeInfo(), shape::shapeInfoByteLength(tad->tadOnlyShapeInfo()));
 
         for (int idx = 0; idx < numTads; idx++ ) {
-            T* buffer = const_cast<NDArray<T>*>(ndArray)->getBuffer() + tad->tadOffsets[idx];
+            T* buffer = const_cast<NDArray<T>*>(ndArray)->getBuffer() + tad->tadOffsets()[idx];
             auto array = new NDArray<T>(buffer, shapeInfo);
             result->push_back(array);
         }
@@ -615,6 +613,78 @@ NDArray<T>* NDArrayFactory<T>::simpleMMul(const NDArray<T>* a, const NDArray<T>*
     return c;
 }
 
+    template <typename T, typename V>
+    static void convertNpy(const char *data, bool swap, T *z, Nd4jIndex length) {
+#pragma omp parallel for schedule(static) if (length > ELEMENT_THRESHOLD)
+        for (Nd4jIndex e = 0; e < length; e++) {
+            // npy data isn't guaranteed to be aligned, i.e. within npz
+            char bytes[sizeof(V)];
+            memcpy(bytes, data + e * sizeof(V), sizeof(V));
+            if (swap)
+                std::reverse(bytes, bytes + sizeof(V));
+
+            V v;
+            memcpy(&v, bytes, sizeof(V));
+            z[e] = (T) v;
+        }
+    }
+
+    template<typename T>
+    NDArray<T>* NDArrayFactory<T>::fromNpy(const cnpy::NpyArray& array) {
+        std::vector<int> shape;
+        for (auto v: array.shape)
+            shape.push_back((int) v);
+
+        if (shape.size() == 0)
+            shape = {1, 1};
+        else if (shape.size() == 1)
+            shape.insert(shape.begin(), 1);
+
+        char order = array.fortranOrder ? 'f' : 'c';
+        bool sameEndian = array.littleEndian != BitwiseUtils::isBE() || array.wordSize == 1;
+        bool floating = array.type == 'f';
+        if (floating && array.wordSize == sizeof(T) && sameEndian && reinterpret_cast<Nd4jIndex>(array.data) % sizeof(T) == 0) {
+            int *shapeInfo = order == 'f' ? shape::shapeBufferFortran((int) shape.size(), shape.data()) : shape::shapeBuffer((int) shape.size(), shape.data());
+            auto result = new NDArray<T>(reinterpret_cast<T *>(array.data), shapeInfo);
+            result->triggerAllocationFlag(false, true);
+            return result;
+        }
+
+        auto result = new NDArray<T>(order, shape);
+        Nd4jIndex length = result->lengthOf();
+
+        bool swap = !sameEndian;
+        T *z = result->getBuffer();
+        if (floating && array.wordSize == 2)
+            convertNpy<T, float16>(array.data, swap, z, length);
+        else if (floating && array.wordSize == 4)
+            convertNpy<T, float>(array.data, swap, z, length);
+        else if (floating && array.wordSize == 8)
+            convertNpy<T, double>(array.data, swap, z, length);
+        else if ((array.type == 'i' || array.type == 'b') && array.wordSize == 1)
+            convertNpy<T, int8_t>(array.data, swap, z, length);
+        else if (array.type == 'i' && array.wordSize == 2)
+            convertNpy<T, int16_t>(array.data, swap, z, length);
+        else if (array.type == 'i' && array.wordSize == 4)
+            convertNpy<T, int>(array.data, swap, z, length);
+        else if (array.type == 'i' && array.wordSize == 8)
+            convertNpy<T, Nd4jIndex>(array.data, swap, z, length);
+        else if (array.type == 'u' && array.wordSize == 1)
+            convertNpy<T, uint8_t>(array.data, swap, z, length);
+        else if (array.type == 'u' && array.wordSize == 2)
+            convertNpy<T, uint16_t>(array.data, swap, z, length);
+        else if (array.type == 'u' && array.wordSize == 4)
+            convertNpy<T, unsigned int>(array.data, swap, z, length);
+        else if (array.type == 'u' && array.wordSize == 8)
+            convertNpy<T, unsigned long long>(array.data, swap, z, length);
+        else {
+            delete result;
+            throw "Unsupported numpy data type";
+        }
+
+        return result;
+    }
+
 
     template class ND4J_EXPORT NDArrayFactory<float>;
     template class ND4J_EXPORT NDArrayFactory<float16>;
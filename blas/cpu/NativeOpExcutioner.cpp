@@ -188,6 +188,12 @@ void NativeOpExcutioner<T>::execReduce3All(int opNum, T *x, int *xShapeInfo, T *
     functions::reduce3::Reduce3<T>::execAll(opNum, x, xShapeInfo, extraParamsVals, y, yShapeInfo, result, resultShapeInfoBuffer, dimension, dimensionLength, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets);
 }
 
+////////////////////////////////////////////////////////////////////////
+template<typename T>
+void NativeOpExcutioner<T>::execReduce3AllTopK(int opNum, T *x, int *xShapeInfo, T *extraParamsVals, T *y, int *yShapeInfo, int *dimension, int dimensionLength, int *xTadShapeInfo, Nd4jIndex *xOffsets, int *yTadShapeInfo, Nd4jIndex *yOffsets, int k, T *values, Nd4jIndex *indices) {
+    functions::reduce3::Reduce3<T>::execAllTopK(opNum, x, xShapeInfo, extraParamsVals, y, yShapeInfo, dimension, dimensionLength, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets, k, values, indices);
+}
+
 ////////////////////////////////////////////////////////////////////////
 template<typename T>
 void NativeOpExcutioner<T>::execReduce3TAD(int opNum, T *x, int *xShapeInfo, T *extraParamsVals, T *y, int *yShapeInfo, T *result, int *resultShapeInfoBuffer, int *dimension, int dimensionLength, int *tadShapeInfo, Nd4jIndex *tadOffsets) {
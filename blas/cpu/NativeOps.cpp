@@ -9,6 +9,11 @@
 #include "../NDArray.h"
 #include "../GraphExecutioner.h"
 #include <graph/GraphHolder.h>
+#include <graph/VariableProxy.h>
+#include <graph/OpProfiler.h>
+#include <helpers/ThresholdTuner.h>
+#include <graph/execution/AsyncGraphExecutor.h>
+#include <loops/grid_fused.h>
 #include <templatemath.h>
 #include <types/float8.h>
 #include <loops/type_conversions.h>
@@ -28,6 +33,7 @@
 
 #include <layers/layers_factory.h>
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/gather.h>
 
 
 char *name;
@@ -41,6 +47,11 @@ bool experimentalSupport = false;
 #endif
 
 #include <ops/specials.h>
+#include <ops/word2vec.h>
+#include <chrono>
+#include <mutex>
+#include <map>
+#include <sys/stat.h>
 #include "../Environment.h"
 #include <TAD.h>
 #include <ops/declarable/OpRegistrator.h>
@@ -1177,6 +1188,99 @@ void NativeOps::execReduce3AllHalf(Nd4jPointer *extraPointers,
 #endif
 }
 
+void NativeOps::execReduce3AllTopKDouble(Nd4jPointer *extraPointers,
+                         int opNum,
+                         double *x,
+                         int *xInfo,
+                         double *extraParamsVals,
+                         double *y,
+                         int *yInfo,
+                         int *dimension,
+                         int dimensionLength,
+                         int *xTadShapeInfo,
+                         Nd4jIndex *xOffsets,
+                         int *yTadShapeInfo,
+                         Nd4jIndex *yOffsets,
+                         int k,
+                         double *values,
+                         Nd4jIndex *indices) {
+    NativeOpExcutioner<double>::execReduce3AllTopK(opNum, x, xInfo, extraParamsVals, y, yInfo, dimension, dimensionLength, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets, k, values, indices);
+}
+
+void NativeOps::execReduce3AllTopKFloat(Nd4jPointer *extraPointers,
+                         int opNum,
+                         float *x,
+                         int *xInfo,
+                         float *extraParamsVals,
+                         float *y,
+                         int *yInfo,
+                         int *dimension,
+                         int dimensionLength,
+                         int *xTadShapeInfo,
+                         Nd4jIndex *xOffsets,
+                         int *yTadShapeInfo,
+                         Nd4jIndex *yOffsets,
+                         int k,
+                         float *values,
+                         Nd4jIndex *indices) {
+    NativeOpExcutioner<float>::execReduce3AllTopK(opNum, x, xInfo, extraParamsVals, y, yInfo, dimension, dimensionLength, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets, k, values, indices);
+}
+
+void NativeOps::execReduce3AllTopKHalf(Nd4jPointer *extraPointers,
+                         int opNum,
+                         float16 *x,
+                         int *xInfo,
+                         float16 *extraParamsVals,
+                         float16 *y,
+                         int *yInfo,
+                         int *dimension,
+                         int dimensionLength,
+                         int *xTadShapeInfo,
+                         Nd4jIndex *xOffsets,
+                         int *yTadShapeInfo,
+                         Nd4jIndex *yOffsets,
+                         int k,
+                         float16 *values,
+                         Nd4jIndex *indices) {
+#ifndef __ANDROID__
+    // TODO: make this work with android-x86 as well
+    NativeOpExcutioner<float16>::execReduce3AllTopK(opNum, x, xInfo, extraParamsVals, y, yInfo, dimension, dimensionLength, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets, k, values, indices);
+#endif
+}
+
+void NativeOps::gatherDouble(Nd4jPointer *extraPointers,
+                         double *x,
+                         int *xShapeInfo,
+                         double *z,
+                         int *zShapeInfo,
+                         int axis,
+                         int *indices,
+                         int numIndices) {
+    nd4j::ops::helpers::_gather<double, int>(x, xShapeInfo, z, zShapeInfo, axis, indices, (Nd4jIndex) numIndices);
+}
+
+void NativeOps::gatherFloat(Nd4jPointer *extraPointers,
+                         float *x,
+                         int *xShapeInfo,
+                         float *z,
+                         int *zShapeInfo,
+                         int axis,
+                         int *indices,
+                         int numIndices) {
+    nd4j::ops::helpers::_gather<float, int>(x, xShapeInfo, z, zShapeInfo, axis, indices, (Nd4jIndex) numIndices);
+}
+
+void NativeOps::gatherHalf(Nd4jPointer *extraPointers,
+                         float16 *x,
+                         int *xShapeInfo,
+                         float16 *z,
+                         int *zShapeInfo,
+                         int axis,
+                         int *indices,
+                         int numIndices) {
+    nd4j::ops::helpers::_gather<float16, int>(x, xShapeInfo, z, zShapeInfo, axis, indices, (Nd4jIndex) numIndices);
+}
+
 
 /**
  *
@@ -1856,7 +1960,9 @@ void NativeOps::flattenDouble(
  * Since we'll use this from java, jni compiler would like to have method no matter what.
  */
 void NativeOps::initializeDevicesAndFunctions() {
-
+    // opt-in startup calibration, results are cached in ND4J_TUNING_PROFILE file if it's set
+    if (std::getenv("ND4J_AUTOTUNE") != nullptr)
+        nd4j::ThresholdTuner::tune(std::getenv("ND4J_TUNING_PROFILE"));
 }
 
 void NativeOps::initializeFunctions(Nd4jPointer *functions) {
@@ -2207,50 +2313,45 @@ void NativeOps::enableP2P(bool enable) {
 }
 
 void NativeOps::encodeThresholdP1Half(Nd4jPointer *extraPointers, float16 *dx, Nd4jIndex N, int *dz, float threshold) {
-    // TODO: to be implemented
+    NativeOpExcutioner<float16>::encodeThresholdP1(dx, N, dz, threshold);
 }
 
 void NativeOps::encodeThresholdP1Float(Nd4jPointer *extraPointers, float *dx, Nd4jIndex N, int *dz, float threshold) {
-    // TODO: to be implemented
+    NativeOpExcutioner<float>::encodeThresholdP1(dx, N, dz, threshold);
 }
 
 void NativeOps::encodeThresholdP1Double(Nd4jPointer *extraPointers, double *dx, Nd4jIndex N, int *dz, float threshold) {
-    // TODO: to be implemented
+    NativeOpExcutioner<double>::encodeThresholdP1(dx, N, dz, threshold);
 }
 
 
 void NativeOps::encodeThresholdP2Int(Nd4jPointer *extraPointers, int *dx, Nd4jIndex N, int *dz) {
-    // TODO: to be implemented
+    // the same layout as on cuda side: first element of P1 output is total count
+    NativeOpExcutioner<float>::encodeThresholdP2(dx + 1, N, dz);
 }
 
 void NativeOps::encodeThresholdP3Float(Nd4jPointer *extraPointers, float *dx, int *offsets, Nd4jIndex N, int *dz){
-    // offsets won't be used here
-
-    // TODO: to be implemented
+    NativeOpExcutioner<float>::encodeThresholdP3(dx, offsets, N, dz);
 }
 
 void NativeOps::encodeThresholdP3Double(Nd4jPointer *extraPointers, double *dx, int *offsets, Nd4jIndex N, int *dz){
-    // offsets won't be used here
-
-    // TODO: to be implemented
+    NativeOpExcutioner<double>::encodeThresholdP3(dx, offsets, N, dz);
 }
 
 void NativeOps::encodeThresholdP3Half(Nd4jPointer *extraPointers, float16 *dx, int *offsets, Nd4jIndex N, int *dz){
-    // offsets won't be used here
-
-    // TODO: to be implemented
+    NativeOpExcutioner<float16>::encodeThresholdP3(dx, offsets, N, dz);
 }
 
 void NativeOps::decodeThresholdFloat(Nd4jPointer *extraPointers, void *dx, Nd4jIndex N, float *dz){
-    // TODO: to be implemented
+    NativeOpExcutioner<float>::decodeThreshold(dx, N, dz);
 }
 
 void NativeOps::decodeThresholdHalf(Nd4jPointer *extraPointers, void *dx, Nd4jIndex N, float16 *dz){
-    // TODO: to be implemented
+    NativeOpExcutioner<float16>::decodeThreshold(dx, N, dz);
 }
 
 void NativeOps::decodeThresholdDouble(Nd4jPointer *extraPointers, void *dx, Nd4jIndex N, double *dz){
-    // TODO: to be implemented
+    NativeOpExcutioner<double>::decodeThreshold(dx, N, dz);
 }
 
 bool NativeOps::isP2PAvailable() {
@@ -2390,6 +2491,33 @@ void NativeOps::shuffleHalf(Nd4jPointer *extras,
     // no-op
 }
 
+/**
+ * CPU meta ops are just chains of two elementwise ops: opA is applied first, opB is applied to its result
+ */
+template <typename T>
+static void metaPredicateStridedGeneric(const int opTypeA, const int opNumA, const int opTypeB, const int opNumB, long N, T *dx, int xStride, T *dy, int yStride, T *dz, int zStride, T *extraA, T *extraB, T scalarA, T scalarB) {
+    int opTypes[] = {opTypeA, opTypeB};
+    int opNums[] = {opNumA, opNumB};
+    T *operands[] = {dy, dy};
+    Nd4jIndex yStrides[] = {yStride, yStride};
+    T scalars[] = {scalarA, scalarB};
+    T *extraParams[] = {extraA, extraB};
+
+    functions::grid::GRIDFused<T>::execStrided(2, opTypes, opNums, dx, xStride, operands, yStrides, dz, zStride, scalars, extraParams, N);
+}
+
+template <typename T>
+static void metaPredicateShapeGeneric(const int opTypeA, const int opNumA, const int opTypeB, const int opNumB, T *dx, int *xShapeInfo, T *dy, int *yShapeInfo, T *dz, int *zShapeInfo, T *extraA, T *extraB, T scalarA, T scalarB) {
+    int opTypes[] = {opTypeA, opTypeB};
+    int opNums[] = {opNumA, opNumB};
+    T *operands[] = {dy, dy};
+    int *operandShapes[] = {yShapeInfo, yShapeInfo};
+    T scalars[] = {scalarA, scalarB};
+    T *extraParams[] = {extraA, extraB};
+
+    functions::grid::GRIDFused<T>::execShaped(2, opTypes, opNums, dx, xShapeInfo, operands, operandShapes, dz, zShapeInfo, scalars, extraParams);
+}
+
 void NativeOps::execMetaPredicateReduceFloat(Nd4jPointer *extras,
                                              const int opTypeA,
                                              const int opNumA,
@@ -2418,7 +2546,7 @@ bool NativeOps::isExperimentalEnabled() {
 }
 
 void NativeOps::execMetaPredicateShapeFloat(Nd4jPointer *extras, const int opTypeA, const int opNumA, const int opTypeB, const int opNumB, long N, float *dx, int *xShapeInfo, float *dy, int *yShapeInfo, float *dz, int *zShapeInfo, float *extraA, float *extraB, float scalarA, float scalarB) {
-    // no-op;
+    metaPredicateShapeGeneric<float>(opTypeA, opNumA, opTypeB, opNumB, dx, xShapeInfo, dy, yShapeInfo, dz, zShapeInfo, extraA, extraB, (float) scalarA, (float) scalarB);
 }
 
 void NativeOps::setOmpMinThreads(int threads) {
@@ -2426,23 +2554,63 @@ void NativeOps::setOmpMinThreads(int threads) {
 }
 
 void NativeOps::execMetaPredicateStridedFloat(Nd4jPointer *extras, const int opTypeA, const int opNumA, const int opTypeB, const int opNumB, long N, float *dx, int xStride, float *dy, int yStride, float *dz, int zStride, float *extraA, float *extraB, float scalarA, float scalarB) {
-    // no-op
+    metaPredicateStridedGeneric<float>(opTypeA, opNumA, opTypeB, opNumB, N, dx, xStride, dy, yStride, dz, zStride, extraA, extraB, (float) scalarA, (float) scalarB);
 }
 
 void NativeOps::execMetaPredicateShapeDouble(Nd4jPointer *extras, const int opTypeA, const int opNumA, const int opTypeB, const int opNumB, long N, double *dx, int *xShapeInfo, double *dy, int *yShapeInfo, double *dz, int *zShapeInfo, double *extraA, double *extraB, double scalarA, double scalarB) {
-    // no-op;
+    metaPredicateShapeGeneric<double>(opTypeA, opNumA, opTypeB, opNumB, dx, xShapeInfo, dy, yShapeInfo, dz, zShapeInfo, extraA, extraB, (double) scalarA, (double) scalarB);
 }
 
 void NativeOps::execMetaPredicateStridedDouble(Nd4jPointer *extras, const int opTypeA, const int opNumA, const int opTypeB, const int opNumB, long N, double *dx, int xStride, double *dy, int yStride, double *dz, int zStride, double *extraA, double *extraB, double scalarA, double scalarB) {
-    // no-op
+    metaPredicateStridedGeneric<double>(opTypeA, opNumA, opTypeB, opNumB, N, dx, xStride, dy, yStride, dz, zStride, extraA, extraB, (double) scalarA, (double) scalarB);
 }
 
 void NativeOps::execMetaPredicateShapeHalf(Nd4jPointer *extras, const int opTypeA, const int opNumA, const int opTypeB, const int opNumB, long N, float16 *dx, int *xShapeInfo, float16 *dy, int *yShapeInfo, float16 *dz, int *zShapeInfo, float16 *extraA, float16 *extraB, float scalarA, float scalarB) {
-    // no-op;
+    metaPredicateShapeGeneric<float16>(opTypeA, opNumA, opTypeB, opNumB, dx, xShapeInfo, dy, yShapeInfo, dz, zShapeInfo, extraA, extraB, (float16) scalarA, (float16) scalarB);
 }
 
 void NativeOps::execMetaPredicateStridedHalf(Nd4jPointer *extras, const int opTypeA, const int opNumA, const int opTypeB, const int opNumB, long N, float16 *dx, int xStride, float16 *dy, int yStride, float16 *dz, int zStride, float16 *extraA, float16 *extraB, float scalarA, float scalarB) {
-    // no-op
+    metaPredicateStridedGeneric<float16>(opTypeA, opNumA, opTypeB, opNumB, N, dx, xStride, dy, yStride, dz, zStride, extraA, extraB, (float16) scalarA, (float16) scalarB);
+}
+
+void NativeOps::execMetaChainFloat(Nd4jPointer *extras, int numOps, int *opTypes, int *opNums, float *dx, int *xShapeInfo, Nd4jPointer *operands, Nd4jPointer *operandShapes, float *dz, int *zShapeInfo, float *scalars, Nd4jPointer *extraParams) {
+    functions::grid::GRIDFused<float>::execShaped(numOps, opTypes, opNums, dx, xShapeInfo, reinterpret_cast<float **>(operands), reinterpret_cast<int **>(operandShapes), dz, zShapeInfo, scalars, reinterpret_cast<float **>(extraParams));
+}
+
+void NativeOps::execMetaChainDouble(Nd4jPointer *extras, int numOps, int *opTypes, int *opNums, double *dx, int *xShapeInfo, Nd4jPointer *operands, Nd4jPointer *operandShapes, double *dz, int *zShapeInfo, double *scalars, Nd4jPointer *extraParams) {
+    functions::grid::GRIDFused<double>::execShaped(numOps, opTypes, opNums, dx, xShapeInfo, reinterpret_cast<double **>(operands), reinterpret_cast<int **>(operandShapes), dz, zShapeInfo, scalars, reinterpret_cast<double **>(extraParams));
+}
+
+void NativeOps::execMetaChainHalf(Nd4jPointer *extras, int numOps, int *opTypes, int *opNums, float16 *dx, int *xShapeInfo, Nd4jPointer *operands, Nd4jPointer *operandShapes, float16 *dz, int *zShapeInfo, float *scalars, Nd4jPointer *extraParams) {
+    std::vector<float16> scalarsH(numOps);
+    for (int e = 0; e < numOps; e++)
+        scalarsH[e] = scalars != nullptr ? (float16) scalars[e] : (float16) 0.0f;
+
+    functions::grid::GRIDFused<float16>::execShaped(numOps, opTypes, opNums, dx, xShapeInfo, reinterpret_cast<float16 **>(operands), reinterpret_cast<int **>(operandShapes), dz, zShapeInfo, scalarsH.data(), reinterpret_cast<float16 **>(extraParams));
+}
+
+void NativeOps::enableElementwiseFusion(bool reallyEnable) {
+    nd4j::Environment::getInstance()->setElementwiseFusion(reallyEnable);
+}
+
+void NativeOps::enableStaticMemoryPlanning(bool reallyEnable) {
+    nd4j::Environment::getInstance()->setStaticMemoryPlanning(reallyEnable);
+}
+
+void NativeOps::enableOpProfiling(bool reallyEnable) {
+    nd4j::graph::OpProfiler::getInstance()->setEnabled(reallyEnable);
+}
+
+void NativeOps::resetOpProfiling() {
+    nd4j::graph::OpProfiler::getInstance()->reset();
+}
+
+bool NativeOps::exportOpProfilingTrace(const char *fileName) {
+    return nd4j::graph::OpProfiler::getInstance()->exportChromeTrace(fileName);
+}
+
+bool NativeOps::autotuneThresholds(const char *profileFile) {
+    return nd4j::ThresholdTuner::tune(profileFile);
 }
 
 int NativeOps::getDevice() {
@@ -2952,7 +3120,28 @@ Nd4jPointer NativeOps::dataPointForNumpy(Nd4jPointer npyArray) {
  * @param path
  * @return
  */
+// numpy files are memory-mapped instead of being read at once, so we have to remember mapping length for releaseNumpy
+static std::map<Nd4jPointer, size_t> _numpyMappings;
+static std::mutex _numpyMutex;
+
 Nd4jPointer NativeOps::numpyFromFile(std::string path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void *ptr = mmap(nullptr, (size_t) st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            close(fd);
+
+            if (ptr != MAP_FAILED) {
+                std::lock_guard<std::mutex> lock(_numpyMutex);
+                _numpyMappings[reinterpret_cast<Nd4jPointer>(ptr)] = (size_t) st.st_size;
+                return reinterpret_cast<Nd4jPointer>(ptr);
+            }
+        } else
+            close(fd);
+    }
+
+    // fallback to plain read
     char *numpyBuffer = cnpy::loadFile(path.data());
     return reinterpret_cast<Nd4jPointer >(numpyBuffer);
 }
@@ -2983,6 +3172,16 @@ int NativeOps::elementSizeForNpyArray(Nd4jPointer npyArray) {
 }
 
 void NativeOps::releaseNumpy(Nd4jPointer npyArray) {
+    {
+        std::lock_guard<std::mutex> lock(_numpyMutex);
+        auto it = _numpyMappings.find(npyArray);
+        if (it != _numpyMappings.end()) {
+            munmap(npyArray, it->second);
+            _numpyMappings.erase(it);
+            return;
+        }
+    }
+
     free((void *) npyArray);
 }
 
@@ -3006,7 +3205,7 @@ void NativeOps::sortDouble(Nd4jPointer *extraPointers, double *x, int *xShapeInf
 }
 
 void NativeOps::sortHalf(Nd4jPointer *extraPointers, float16 *x, int *xShapeInfo, bool descending) {
-    //NativeOpExcutioner<float16>::execSort(x, xShapeInfo, descending);
+    NativeOpExcutioner<float16>::execSort(x, xShapeInfo, descending);
 }
 
 void NativeOps::sortTadFloat(Nd4jPointer *extraPointers, float *x, int *xShapeInfo, int *dimension, int dimensionLength, int *tadShapeInfo, Nd4jIndex *tadOffsets, bool descending) {
@@ -3018,7 +3217,89 @@ void NativeOps::sortTadDouble(Nd4jPointer *extraPointers, double *x, int *xShape
 }
 
 void NativeOps::sortTadHalf(Nd4jPointer *extraPointers, float16 *x, int *xShapeInfo, int *dimension, int dimensionLength, int *tadShapeInfo, Nd4jIndex *tadOffsets, bool descending) {
-    //NativeOpExcutioner<float16>::execSort(x, xShapeInfo, dimension, dimensionLength, tadShapeInfo, tadOffsets, descending);
+    NativeOpExcutioner<float16>::execSort(x, xShapeInfo, dimension, dimensionLength, tadShapeInfo, tadOffsets, descending);
+}
+
+void NativeOps::argsortFloat(Nd4jPointer *extraPointers, float *x, int *xShapeInfo, Nd4jIndex *indices, bool descending) {
+    NativeOpExcutioner<float>::execArgsort(x, xShapeInfo, indices, descending);
+}
+
+void NativeOps::argsortDouble(Nd4jPointer *extraPointers, double *x, int *xShapeInfo, Nd4jIndex *indices, bool descending) {
+    NativeOpExcutioner<double>::execArgsort(x, xShapeInfo, indices, descending);
+}
+
+void NativeOps::argsortHalf(Nd4jPointer *extraPointers, float16 *x, int *xShapeInfo, Nd4jIndex *indices, bool descending) {
+    NativeOpExcutioner<float16>::execArgsort(x, xShapeInfo, indices, descending);
+}
+
+void NativeOps::sortByKeyFloat(Nd4jPointer *extraPointers, float *x, int *xShapeInfo, float *y, int *yShapeInfo, bool descending) {
+    NativeOpExcutioner<float>::execSortByKey(x, xShapeInfo, y, yShapeInfo, descending);
+}
+
+void NativeOps::sortByKeyDouble(Nd4jPointer *extraPointers, double *x, int *xShapeInfo, double *y, int *yShapeInfo, bool descending) {
+    NativeOpExcutioner<double>::execSortByKey(x, xShapeInfo, y, yShapeInfo, descending);
+}
+
+void NativeOps::sortByKeyHalf(Nd4jPointer *extraPointers, float16 *x, int *xShapeInfo, float16 *y, int *yShapeInfo, bool descending) {
+    NativeOpExcutioner<float16>::execSortByKey(x, xShapeInfo, y, yShapeInfo, descending);
+}
+
+/**
+ * Throughput of word2vec batch, in words per second
+ */
+static double wordsPerSecond(Nd4jIndex processed, std::chrono::time_point<std::chrono::system_clock> timeStart) {
+    auto timeEnd = std::chrono::system_clock::now();
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count() / 1e6;
+
+    return seconds > 0.0 ? processed / seconds : (double) processed;
+}
+
+double NativeOps::execSkipGramFloat(Nd4jPointer *extraPointers, float *syn0, float *syn1, float *syn1Neg, float *expTable, float *negTable, int *words, int *contexts, Nd4jIndex numPairs, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    auto timeStart = std::chrono::system_clock::now();
+
+    Nd4jIndex processed = nd4j::Word2Vec<float>::skipGram(syn0, syn1, syn1Neg, expTable, negTable, words, contexts, numPairs, codes, points, codeLengths, maxCodeLength, vectorLength, vocabSize, expLength, negTableLength, negative, (float) alpha, (unsigned long long) seed);
+
+    return wordsPerSecond(processed, timeStart);
+}
+
+double NativeOps::execSkipGramDouble(Nd4jPointer *extraPointers, double *syn0, double *syn1, double *syn1Neg, double *expTable, double *negTable, int *words, int *contexts, Nd4jIndex numPairs, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    auto timeStart = std::chrono::system_clock::now();
+
+    Nd4jIndex processed = nd4j::Word2Vec<double>::skipGram(syn0, syn1, syn1Neg, expTable, negTable, words, contexts, numPairs, codes, points, codeLengths, maxCodeLength, vectorLength, vocabSize, expLength, negTableLength, negative, (double) alpha, (unsigned long long) seed);
+
+    return wordsPerSecond(processed, timeStart);
+}
+
+double NativeOps::execSkipGramHalf(Nd4jPointer *extraPointers, float16 *syn0, float16 *syn1, float16 *syn1Neg, float16 *expTable, float16 *negTable, int *words, int *contexts, Nd4jIndex numPairs, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    auto timeStart = std::chrono::system_clock::now();
+
+    Nd4jIndex processed = nd4j::Word2Vec<float16>::skipGram(syn0, syn1, syn1Neg, expTable, negTable, words, contexts, numPairs, codes, points, codeLengths, maxCodeLength, vectorLength, vocabSize, expLength, negTableLength, negative, (float16) alpha, (unsigned long long) seed);
+
+    return wordsPerSecond(processed, timeStart);
+}
+
+double NativeOps::execCbowFloat(Nd4jPointer *extraPointers, float *syn0, float *syn1, float *syn1Neg, float *expTable, float *negTable, int *words, int *contexts, int contextWidth, Nd4jIndex numSamples, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    auto timeStart = std::chrono::system_clock::now();
+
+    Nd4jIndex processed = nd4j::Word2Vec<float>::cbow(syn0, syn1, syn1Neg, expTable, negTable, words, contexts, contextWidth, numSamples, codes, points, codeLengths, maxCodeLength, vectorLength, vocabSize, expLength, negTableLength, negative, (float) alpha, (unsigned long long) seed);
+
+    return wordsPerSecond(processed, timeStart);
+}
+
+double NativeOps::execCbowDouble(Nd4jPointer *extraPointers, double *syn0, double *syn1, double *syn1Neg, double *expTable, double *negTable, int *words, int *contexts, int contextWidth, Nd4jIndex numSamples, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    auto timeStart = std::chrono::system_clock::now();
+
+    Nd4jIndex processed = nd4j::Word2Vec<double>::cbow(syn0, syn1, syn1Neg, expTable, negTable, words, contexts, contextWidth, numSamples, codes, points, codeLengths, maxCodeLength, vectorLength, vocabSize, expLength, negTableLength, negative, (double) alpha, (unsigned long long) seed);
+
+    return wordsPerSecond(processed, timeStart);
+}
+
+double NativeOps::execCbowHalf(Nd4jPointer *extraPointers, float16 *syn0, float16 *syn1, float16 *syn1Neg, float16 *expTable, float16 *negTable, int *words, int *contexts, int contextWidth, Nd4jIndex numSamples, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    auto timeStart = std::chrono::system_clock::now();
+
+    Nd4jIndex processed = nd4j::Word2Vec<float16>::cbow(syn0, syn1, syn1Neg, expTable, negTable, words, contexts, contextWidth, numSamples, codes, points, codeLengths, maxCodeLength, vectorLength, vocabSize, expLength, negTableLength, negative, (float16) alpha, (unsigned long long) seed);
+
+    return wordsPerSecond(processed, timeStart);
 }
 
 void NativeOps::sortCooIndicesFloat(Nd4jPointer *extraPointers, int *indices, float *values, Nd4jIndex length, int rank) {
@@ -3180,6 +3461,34 @@ Nd4jStatus realExec(nd4j::ops::DeclarableOp<T>* op, Nd4jPointer* extraPointers,
         ttArgs.push_back(tArgs[e]);
     }
 
+    // if provided outputs match cached output shapes exactly, op writes straight into them: no ResultSet, no temporary outputs, no assign
+    if (!isInplace && numOutputs > 0) {
+        ShapeList inShapes;
+        for (int e = 0; e < numInputs; e++)
+            inShapes.push_back((int *) inputShapes[e]);
+
+        auto cached = op->cachedOutputShape(&inShapes, ttArgs, iiArgs);
+        bool direct = cached != nullptr && cached->size() == numOutputs;
+        for (int e = 0; e < numOutputs && direct; e++)
+            direct = shape::equalsStrict(cached->at(e), (int *) outputShapes[e]);
+
+        if (direct) {
+            std::vector<nd4j::NDArray<T>*> outputs;
+            for (int e = 0; e < numOutputs; e++)
+                outputs.push_back(new nd4j::NDArray<T>((T *) outputBuffers[e], (int *) outputShapes[e]));
+
+            auto status = op->execute(inputs, outputs, ttArgs, iiArgs, isInplace);
+
+            for (auto v: outputs)
+                delete v;
+
+            for (auto v: inputs)
+                delete v;
+
+            return status;
+        }
+    }
+
     // hypothetically at this point we have everything filled
     auto result = op->execute(inputs, ttArgs, iiArgs, isInplace);
 
@@ -3268,51 +3577,60 @@ int NativeOps::registerGraphHalf(Nd4jPointer *extraPointers, Nd4jIndex graphId,
     return ND4J_STATUS_OK;
 }
 
-template <typename T>
-static VariablesSet<T>* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
-    auto graph = nd4j::graph::GraphHolder::getInstance()->pullGraph<T>(graphId);
-    auto varSpace = graph->getVariableSpace()->clone();
+int NativeOps::registerMappedGraphFloat(Nd4jPointer *extraPointers, Nd4jIndex graphId, const char *fileName) {
+    auto graph = nd4j::graph::GraphExecutioner<float>::mapFlatBuffers(fileName);
 
-    std::vector<nd4j::NDArray<T> *> handles;
+    nd4j::graph::GraphHolder::getInstance()->registerGraph(graphId, graph);
 
-    for (int e = 0; e < numInputs; e++) {
-        auto idx = inputIndices[e];
+    return ND4J_STATUS_OK;
+}
 
-        // we'll delete this array later, together with cloned VariableSpace
-        auto array = new nd4j::NDArray<T>((T *) inputBuffers[e], (int *) inputShapes[e]);
-        handles.emplace_back(array);
+int NativeOps::registerMappedGraphDouble(Nd4jPointer *extraPointers, Nd4jIndex graphId, const char *fileName) {
+    auto graph = nd4j::graph::GraphExecutioner<double>::mapFlatBuffers(fileName);
 
-        if (varSpace->hasVariable(idx)) {
-            auto var = varSpace->getVariable(idx);
-            if (var->hasNDArray())
-                delete var->getNDArray();
+    nd4j::graph::GraphHolder::getInstance()->registerGraph(graphId, graph);
 
-            var->setNDArray(array);
-        } else
-            varSpace->putVariable(idx, array);
-    }
+    return ND4J_STATUS_OK;
+}
+
+int NativeOps::registerMappedGraphHalf(Nd4jPointer *extraPointers, Nd4jIndex graphId, const char *fileName) {
+    auto graph = nd4j::graph::GraphExecutioner<float16>::mapFlatBuffers(fileName);
+
+    nd4j::graph::GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    return ND4J_STATUS_OK;
+}
+
+template <typename T>
+static VariablesSet<T>* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
+    // graph is held till this call is finished, so concurrent unregisterGraph() waits for us
+    auto holder = nd4j::graph::GraphHolder::getInstance();
+    auto graph = holder->acquireGraph<T>(graphId);
 
-    auto result = nd4j::graph::GraphExecutioner<T>::execute(graph, varSpace);
-    auto varSet = new nd4j::graph::VariablesSet<T>(result);
+    VariablesSet<T>* result;
+    try {
+        // this method might be called from many threads at once, so each call gets its own overlay:
+        // weights are shared with stored graph, while inputs & intermediates stay private to this call
+        nd4j::graph::VariableProxy<T> varSpace(graph->getVariableSpace());
 
-    if (result == ND4J_STATUS_OK) {
-        // pull back results, and provide them
-        auto outputs = graph->fetchOutputs();
-        for (int e = 0; e < outputs->size(); e++) {
-            // we're only getting variable ID/Index from original grap. values will be taken from cloned workspace
-            std::pair<int, int> varId(outputs->at(e)->id(), outputs->at(e)->index());
+        for (int e = 0; e < numInputs; e++) {
+            auto idx = inputIndices[e];
 
-            auto var = varSpace->getVariable(varId);
+            // we'll delete this array later, together with proxy
+            auto array = new nd4j::NDArray<T>((T *) inputBuffers[e], (int *) inputShapes[e]);
 
-            varSet->push_back(var->clone());
+            varSpace.putVariable(idx, array);
         }
 
-        delete outputs;
+        result = nd4j::graph::AsyncGraphExecutor<T>::execute(graph, &varSpace);
+    } catch (...) {
+        holder->releaseGraph<T>(graph);
+        throw;
     }
 
-    delete varSpace;
+    holder->releaseGraph<T>(graph);
 
-    return varSet;
+    return result;
 }
 
 VariablesSet<float>* NativeOps::executeStoredGraphFloat(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
@@ -3327,6 +3645,55 @@ VariablesSet<double>* NativeOps::executeStoredGraphDouble(Nd4jPointer *extraPoin
     return executeStoredGraphT<double>(extraPointers, graphId, inputBuffers, inputShapes, inputIndices, numInputs);
 }
 
+Nd4jPointer NativeOps::executeStoredGraphAsyncFloat(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer callback, Nd4jPointer callbackData) {
+    auto future = nd4j::graph::AsyncGraphExecutor<float>::getInstance()->submit(graphId, inputBuffers, inputShapes, inputIndices, numInputs, reinterpret_cast<nd4j::graph::GraphCallback>(callback), callbackData);
+    return reinterpret_cast<Nd4jPointer>(static_cast<nd4j::graph::ExecutionHandle*>(future));
+}
+
+Nd4jPointer NativeOps::executeStoredGraphAsyncHalf(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer callback, Nd4jPointer callbackData) {
+    auto future = nd4j::graph::AsyncGraphExecutor<float16>::getInstance()->submit(graphId, inputBuffers, inputShapes, inputIndices, numInputs, reinterpret_cast<nd4j::graph::GraphCallback>(callback), callbackData);
+    return reinterpret_cast<Nd4jPointer>(static_cast<nd4j::graph::ExecutionHandle*>(future));
+}
+
+Nd4jPointer NativeOps::executeStoredGraphAsyncDouble(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer callback, Nd4jPointer callbackData) {
+    auto future = nd4j::graph::AsyncGraphExecutor<double>::getInstance()->submit(graphId, inputBuffers, inputShapes, inputIndices, numInputs, reinterpret_cast<nd4j::graph::GraphCallback>(callback), callbackData);
+    return reinterpret_cast<Nd4jPointer>(static_cast<nd4j::graph::ExecutionHandle*>(future));
+}
+
+bool NativeOps::isGraphExecutionDone(Nd4jPointer handle) {
+    return reinterpret_cast<nd4j::graph::ExecutionHandle*>(handle)->isDone();
+}
+
+int NativeOps::waitGraphExecution(Nd4jPointer handle) {
+    return reinterpret_cast<nd4j::graph::ExecutionHandle*>(handle)->wait();
+}
+
+template <typename T>
+static VariablesSet<T>* getGraphExecutionResultT(Nd4jPointer handle) {
+    auto ptr = reinterpret_cast<nd4j::graph::ExecutionHandle*>(handle);
+    return static_cast<nd4j::graph::GraphFuture<T>*>(ptr)->detachResult();
+}
+
+VariablesSet<float>* NativeOps::getGraphExecutionResultFloat(Nd4jPointer handle) {
+    return getGraphExecutionResultT<float>(handle);
+}
+
+VariablesSet<float16>* NativeOps::getGraphExecutionResultHalf(Nd4jPointer handle) {
+    return getGraphExecutionResultT<float16>(handle);
+}
+
+VariablesSet<double>* NativeOps::getGraphExecutionResultDouble(Nd4jPointer handle) {
+    return getGraphExecutionResultT<double>(handle);
+}
+
+void NativeOps::deleteGraphExecution(Nd4jPointer handle) {
+    auto ptr = reinterpret_cast<nd4j::graph::ExecutionHandle*>(handle);
+
+    // execution might be still in progress
+    ptr->wait();
+    delete ptr;
+}
+
 int NativeOps::unregisterGraph(Nd4jPointer *extraPointers, Nd4jIndex graphId) {
 
     nd4j::graph::GraphHolder::getInstance()->dropGraphAny(graphId);
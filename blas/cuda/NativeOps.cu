@@ -45,6 +45,8 @@
 #include <GraphExecutioner.h>
 #include <graph/GraphHolder.h>
 #include <graph/VariablesSet.h>
+#include <stdexcept>
+#include <graph/OpProfiler.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <ops/declarable/CustomOperations.h>
 
@@ -5587,6 +5589,49 @@ float *dx, int *xShapeInfo, float *dy, int *yShapeInfo, float *dz, int *zShapeIn
         checkCudaErrors(cudaStreamSynchronize(*stream));
 }
 
+void NativeOps::execMetaChainFloat(Nd4jPointer *extras, int numOps, int *opTypes, int *opNums, float *dx, int *xShapeInfo, Nd4jPointer *operands, Nd4jPointer *operandShapes, float *dz, int *zShapeInfo, float *scalars, Nd4jPointer *extraParams) {
+    // CUDA backend has execMetaPredicate* only, so GraphFuser can't be used here
+    nd4j_printf("execMetaChain isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("execMetaChain isn't supported on CUDA backend");
+}
+
+void NativeOps::execMetaChainDouble(Nd4jPointer *extras, int numOps, int *opTypes, int *opNums, double *dx, int *xShapeInfo, Nd4jPointer *operands, Nd4jPointer *operandShapes, double *dz, int *zShapeInfo, double *scalars, Nd4jPointer *extraParams) {
+    // CUDA backend has execMetaPredicate* only, so GraphFuser can't be used here
+    nd4j_printf("execMetaChain isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("execMetaChain isn't supported on CUDA backend");
+}
+
+void NativeOps::execMetaChainHalf(Nd4jPointer *extras, int numOps, int *opTypes, int *opNums, float16 *dx, int *xShapeInfo, Nd4jPointer *operands, Nd4jPointer *operandShapes, float16 *dz, int *zShapeInfo, float *scalars, Nd4jPointer *extraParams) {
+    // CUDA backend has execMetaPredicate* only, so GraphFuser can't be used here
+    nd4j_printf("execMetaChain isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("execMetaChain isn't supported on CUDA backend");
+}
+
+void NativeOps::enableElementwiseFusion(bool reallyEnable) {
+    nd4j::Environment::getInstance()->setElementwiseFusion(reallyEnable);
+}
+
+void NativeOps::enableStaticMemoryPlanning(bool reallyEnable) {
+    nd4j::Environment::getInstance()->setStaticMemoryPlanning(reallyEnable);
+}
+
+void NativeOps::enableOpProfiling(bool reallyEnable) {
+    nd4j::graph::OpProfiler::getInstance()->setEnabled(reallyEnable);
+}
+
+void NativeOps::resetOpProfiling() {
+    nd4j::graph::OpProfiler::getInstance()->reset();
+}
+
+bool NativeOps::exportOpProfilingTrace(const char *fileName) {
+    return nd4j::graph::OpProfiler::getInstance()->exportChromeTrace(fileName);
+}
+
+bool NativeOps::autotuneThresholds(const char *profileFile) {
+    // CPU loop thresholds aren't used by CUDA backend
+    return true;
+}
+
 
 
 void NativeOps::execMetaPredicateShapeDouble(Nd4jPointer *extras, const int opTypeA, const int opNumA, const int opTypeB, const int opNumB, long N, double *dx, int *xShapeInfo, double *dy, int *yShapeInfo, double *dz, int *zShapeInfo, double *extraA, double *extraB, double scalarA, double scalarB) {
@@ -6457,6 +6502,108 @@ void NativeOps::execReduce3AllHalf(Nd4jPointer *extraPointers,
         checkCudaErrors(cudaStreamSynchronize(*stream));
 }
 
+void NativeOps::execReduce3AllTopKDouble(Nd4jPointer *extraPointers,
+                         int opNum,
+                         double *x,
+                         int *xInfo,
+                         double *extraParamsVals,
+                         double *y,
+                         int *yInfo,
+                         int *dimension,
+                         int dimensionLength,
+                         int *xTadShapeInfo,
+                         Nd4jIndex *xOffsets,
+                         int *yTadShapeInfo,
+                         Nd4jIndex *yOffsets,
+                         int k,
+                         double *values,
+                         Nd4jIndex *indices) {
+    // top-k all-pairs isn't implemented for CUDA backend yet
+    nd4j_printf("execReduce3AllTopK isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("execReduce3AllTopK isn't supported on CUDA backend");
+}
+
+void NativeOps::execReduce3AllTopKFloat(Nd4jPointer *extraPointers,
+                         int opNum,
+                         float *x,
+                         int *xInfo,
+                         float *extraParamsVals,
+                         float *y,
+                         int *yInfo,
+                         int *dimension,
+                         int dimensionLength,
+                         int *xTadShapeInfo,
+                         Nd4jIndex *xOffsets,
+                         int *yTadShapeInfo,
+                         Nd4jIndex *yOffsets,
+                         int k,
+                         float *values,
+                         Nd4jIndex *indices) {
+    // top-k all-pairs isn't implemented for CUDA backend yet
+    nd4j_printf("execReduce3AllTopK isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("execReduce3AllTopK isn't supported on CUDA backend");
+}
+
+void NativeOps::execReduce3AllTopKHalf(Nd4jPointer *extraPointers,
+                         int opNum,
+                         float16 *x,
+                         int *xInfo,
+                         float16 *extraParamsVals,
+                         float16 *y,
+                         int *yInfo,
+                         int *dimension,
+                         int dimensionLength,
+                         int *xTadShapeInfo,
+                         Nd4jIndex *xOffsets,
+                         int *yTadShapeInfo,
+                         Nd4jIndex *yOffsets,
+                         int k,
+                         float16 *values,
+                         Nd4jIndex *indices) {
+    // top-k all-pairs isn't implemented for CUDA backend yet
+    nd4j_printf("execReduce3AllTopK isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("execReduce3AllTopK isn't supported on CUDA backend");
+}
+
+void NativeOps::gatherDouble(Nd4jPointer *extraPointers,
+                         double *x,
+                         int *xShapeInfo,
+                         double *z,
+                         int *zShapeInfo,
+                         int axis,
+                         int *indices,
+                         int numIndices) {
+    // integer gather isn't implemented for CUDA backend yet
+    nd4j_printf("gather isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("gather isn't supported on CUDA backend");
+}
+
+void NativeOps::gatherFloat(Nd4jPointer *extraPointers,
+                         float *x,
+                         int *xShapeInfo,
+                         float *z,
+                         int *zShapeInfo,
+                         int axis,
+                         int *indices,
+                         int numIndices) {
+    // integer gather isn't implemented for CUDA backend yet
+    nd4j_printf("gather isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("gather isn't supported on CUDA backend");
+}
+
+void NativeOps::gatherHalf(Nd4jPointer *extraPointers,
+                         float16 *x,
+                         int *xShapeInfo,
+                         float16 *z,
+                         int *zShapeInfo,
+                         int axis,
+                         int *indices,
+                         int numIndices) {
+    // integer gather isn't implemented for CUDA backend yet
+    nd4j_printf("gather isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("gather isn't supported on CUDA backend");
+}
+
 void NativeOps::sortFloat(Nd4jPointer *extraPointers, float *x, int *xShapeInfo, bool descending) {
     cudaStream_t *stream = reinterpret_cast<cudaStream_t *>(&extraPointers[     1]);
     int *hostXShapeInfo = reinterpret_cast<int *>(extraPointers[0]);
@@ -6677,6 +6824,66 @@ void NativeOps::sortTadDouble(Nd4jPointer *extraPointers, double *x, int *xShape
     checkCudaErrors(cudaStreamSynchronize(*stream));
 }
 
+void NativeOps::argsortFloat(Nd4jPointer *extraPointers, float *x, int *xShapeInfo, Nd4jIndex *indices, bool descending) {
+    nd4j_printf("argsort isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("argsort isn't supported on CUDA backend");
+}
+
+void NativeOps::argsortDouble(Nd4jPointer *extraPointers, double *x, int *xShapeInfo, Nd4jIndex *indices, bool descending) {
+    nd4j_printf("argsort isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("argsort isn't supported on CUDA backend");
+}
+
+void NativeOps::argsortHalf(Nd4jPointer *extraPointers, float16 *x, int *xShapeInfo, Nd4jIndex *indices, bool descending) {
+    nd4j_printf("argsort isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("argsort isn't supported on CUDA backend");
+}
+
+void NativeOps::sortByKeyFloat(Nd4jPointer *extraPointers, float *x, int *xShapeInfo, float *y, int *yShapeInfo, bool descending) {
+    nd4j_printf("sortByKey isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("sortByKey isn't supported on CUDA backend");
+}
+
+void NativeOps::sortByKeyDouble(Nd4jPointer *extraPointers, double *x, int *xShapeInfo, double *y, int *yShapeInfo, bool descending) {
+    nd4j_printf("sortByKey isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("sortByKey isn't supported on CUDA backend");
+}
+
+void NativeOps::sortByKeyHalf(Nd4jPointer *extraPointers, float16 *x, int *xShapeInfo, float16 *y, int *yShapeInfo, bool descending) {
+    nd4j_printf("sortByKey isn't supported on CUDA backend\n", "");
+    throw std::runtime_error("sortByKey isn't supported on CUDA backend");
+}
+
+double NativeOps::execSkipGramFloat(Nd4jPointer *extraPointers, float *syn0, float *syn1, float *syn1Neg, float *expTable, float *negTable, int *words, int *contexts, Nd4jIndex numPairs, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    nd4j_printf("execSkipGram isn't supported on CUDA backend\n", "");
+    return -1.0;
+}
+
+double NativeOps::execSkipGramDouble(Nd4jPointer *extraPointers, double *syn0, double *syn1, double *syn1Neg, double *expTable, double *negTable, int *words, int *contexts, Nd4jIndex numPairs, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    nd4j_printf("execSkipGram isn't supported on CUDA backend\n", "");
+    return -1.0;
+}
+
+double NativeOps::execSkipGramHalf(Nd4jPointer *extraPointers, float16 *syn0, float16 *syn1, float16 *syn1Neg, float16 *expTable, float16 *negTable, int *words, int *contexts, Nd4jIndex numPairs, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    nd4j_printf("execSkipGram isn't supported on CUDA backend\n", "");
+    return -1.0;
+}
+
+double NativeOps::execCbowFloat(Nd4jPointer *extraPointers, float *syn0, float *syn1, float *syn1Neg, float *expTable, float *negTable, int *words, int *contexts, int contextWidth, Nd4jIndex numSamples, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    nd4j_printf("execCbow isn't supported on CUDA backend\n", "");
+    return -1.0;
+}
+
+double NativeOps::execCbowDouble(Nd4jPointer *extraPointers, double *syn0, double *syn1, double *syn1Neg, double *expTable, double *negTable, int *words, int *contexts, int contextWidth, Nd4jIndex numSamples, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    nd4j_printf("execCbow isn't supported on CUDA backend\n", "");
+    return -1.0;
+}
+
+double NativeOps::execCbowHalf(Nd4jPointer *extraPointers, float16 *syn0, float16 *syn1, float16 *syn1Neg, float16 *expTable, float16 *negTable, int *words, int *contexts, int contextWidth, Nd4jIndex numSamples, int *codes, int *points, int *codeLengths, int maxCodeLength, int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, double alpha, Nd4jIndex seed) {
+    nd4j_printf("execCbow isn't supported on CUDA backend\n", "");
+    return -1.0;
+}
+
 void NativeOps::sortCooIndicesFloat(Nd4jPointer *extraPointers, int *indices, float *values, Nd4jIndex length, int rank) {
 
 }
@@ -6954,6 +7161,30 @@ int NativeOps::registerGraphHalf(Nd4jPointer *extraPointers, Nd4jIndex graphId,
 	return ND4J_STATUS_OK;
 }
 
+int NativeOps::registerMappedGraphFloat(Nd4jPointer *extraPointers, Nd4jIndex graphId, const char *fileName) {
+	auto graph = nd4j::graph::GraphExecutioner<float>::mapFlatBuffers(fileName);
+
+	nd4j::graph::GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+	return ND4J_STATUS_OK;
+}
+
+int NativeOps::registerMappedGraphDouble(Nd4jPointer *extraPointers, Nd4jIndex graphId, const char *fileName) {
+	auto graph = nd4j::graph::GraphExecutioner<double>::mapFlatBuffers(fileName);
+
+	nd4j::graph::GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+	return ND4J_STATUS_OK;
+}
+
+int NativeOps::registerMappedGraphHalf(Nd4jPointer *extraPointers, Nd4jIndex graphId, const char *fileName) {
+	auto graph = nd4j::graph::GraphExecutioner<float16>::mapFlatBuffers(fileName);
+
+	nd4j::graph::GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+	return ND4J_STATUS_OK;
+}
+
 template <typename T>
 static VariablesSet<T>* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
 	auto graph = nd4j::graph::GraphHolder::getInstance()->pullGraph<T>(graphId);
@@ -7013,6 +7244,48 @@ VariablesSet<double>* NativeOps::executeStoredGraphDouble(Nd4jPointer *extraPoin
 	return executeStoredGraphT<double>(extraPointers, graphId, inputBuffers, inputShapes, inputIndices, numInputs);
 }
 
+Nd4jPointer NativeOps::executeStoredGraphAsyncFloat(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer callback, Nd4jPointer callbackData) {
+	// AsyncGraphExecutor isn't available on CUDA backend, executeStoredGraphFloat should be used instead
+	nd4j_printf("executeStoredGraphAsync isn't supported on CUDA backend\n", "");
+	return nullptr;
+}
+
+Nd4jPointer NativeOps::executeStoredGraphAsyncHalf(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer callback, Nd4jPointer callbackData) {
+	// AsyncGraphExecutor isn't available on CUDA backend, executeStoredGraphHalf should be used instead
+	nd4j_printf("executeStoredGraphAsync isn't supported on CUDA backend\n", "");
+	return nullptr;
+}
+
+Nd4jPointer NativeOps::executeStoredGraphAsyncDouble(Nd4jPointer *extraPointers, Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer callback, Nd4jPointer callbackData) {
+	// AsyncGraphExecutor isn't available on CUDA backend, executeStoredGraphDouble should be used instead
+	nd4j_printf("executeStoredGraphAsync isn't supported on CUDA backend\n", "");
+	return nullptr;
+}
+
+bool NativeOps::isGraphExecutionDone(Nd4jPointer handle) {
+	return true;
+}
+
+int NativeOps::waitGraphExecution(Nd4jPointer handle) {
+	return ND4J_STATUS_BAD_GRAPH;
+}
+
+VariablesSet<float>* NativeOps::getGraphExecutionResultFloat(Nd4jPointer handle) {
+	return nullptr;
+}
+
+VariablesSet<float16>* NativeOps::getGraphExecutionResultHalf(Nd4jPointer handle) {
+	return nullptr;
+}
+
+VariablesSet<double>* NativeOps::getGraphExecutionResultDouble(Nd4jPointer handle) {
+	return nullptr;
+}
+
+void NativeOps::deleteGraphExecution(Nd4jPointer handle) {
+	// no-op
+}
+
 int NativeOps::unregisterGraph(Nd4jPointer *extraPointers, Nd4jIndex graphId) {
 
 	nd4j::graph::GraphHolder::getInstance()->dropGraphAny(graphId);
@@ -3,6 +3,18 @@
 //license available in LICENSE file, or at http://www.opensource.org/licenses/mit-license.php
 
 #include"cnpy.h"
+#include <stdexcept>
+#include <limits>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#include <helpers/mman.h>
+#include <io.h>
+#endif
 
 
 
@@ -86,19 +98,22 @@ char* cnpy::loadFile(char const *path) {
     long length;
     FILE * f = fopen (path, "rb"); //was "rb"
 
-    if (f) {
-        fseek (f, 0, SEEK_END);
-        length = ftell (f);
-        fseek (f, 0, SEEK_SET);
-        buffer = (char*) malloc ((length+ 1) * sizeof(char));
-        if (buffer) {
-            fread (buffer, sizeof(char), length, f);
-        }
-
-        fclose (f);
+    if (!f)
+        return nullptr;
+
+    fseek (f, 0, SEEK_END);
+    length = ftell (f);
+    fseek (f, 0, SEEK_SET);
+    buffer = (char*) malloc ((length+ 1) * sizeof(char));
+    if (buffer) {
+        if (fread (buffer, sizeof(char), length, f) != (size_t) length) {
+            free(buffer);
+            buffer = nullptr;
+        } else
+            buffer[length] = '\0';
     }
 
-    buffer[length] = '\0';
+    fclose (f);
     return buffer;
 }
 
@@ -124,7 +139,7 @@ void cnpy::parseNpyHeaderStr(std::string header,
     int loc1, loc2;
 
     //fortran order
-    loc1 = header.find("fortranOrder") + 16;
+    loc1 = header.find("fortran_order") + 16;
     fortranOrder = (header.substr(loc1,5) == "True" ? true : false);
 
     //shape
@@ -249,36 +264,18 @@ cnpy::NpyArray cnpy::loadNpyFromFile(FILE *fp) {
     * @return
     */
 cnpy::NpyArray cnpy::loadNpyFromPointer(char *data)  {
-    //move the pointer forward by 11 immitating
-    //the seek in loading directly from a file
-    data += 11;
-    unsigned int *shape;
-    unsigned int ndims, wordSize;
-    bool fortranOrder;
-    cnpy::parseNpyHeaderStr(std::string(data),
-                            wordSize,
-                            shape,
-                            ndims,
-                            fortranOrder);
-    //the "real" data starts after the \n
-    char currChar = data[0];
-    while(currChar != '\n') {
-        data++;
-        currChar = data[0];
-    }
+    // length of buffer isn't known here, so header is trusted
+    NpyHeader header;
+    if (!cnpy::parseNpyHeaderBuffer(data, std::numeric_limits<size_t>::max(), header))
+        throw std::runtime_error("load_npy_from_pointer: bad npy header");
 
-    //move pass the \n
-    data++;
-
-    unsigned long long size = 1; //long long so no overflow when multiplying by word_size
-    for(unsigned int i = 0; i < ndims; i++) size *= shape[i];
-    char *cursor = data;
     cnpy::NpyArray arr;
-    arr.wordSize = wordSize;
-    arr.shape = std::vector<unsigned int>(shape,shape + ndims);
-    delete[] shape;
-    arr.data = cursor;
-    arr.fortranOrder = fortranOrder;
+    arr.wordSize = header.wordSize;
+    arr.shape = header.shape;
+    arr.data = data + header.dataOffset;
+    arr.fortranOrder = header.fortranOrder;
+    arr.type = header.type;
+    arr.littleEndian = header.littleEndian;
     return arr;
 }
 
@@ -340,10 +337,8 @@ cnpy::npz_t cnpy::npzLoad(std::string fname) {
 cnpy::NpyArray cnpy::npzLoad(std::string fname, std::string varname) {
     FILE *fp = fopen(fname.c_str(),"rb");
 
-    if(!fp) {
-        printf("npz_load: Error! Unable to open file %s!\n",fname.c_str());
-        abort();
-    }
+    if(!fp)
+        throw std::runtime_error("npz_load: unable to open file " + fname);
 
     while(1) {
         std::vector<char> local_header(30);
@@ -379,8 +374,7 @@ cnpy::NpyArray cnpy::npzLoad(std::string fname, std::string varname) {
     }
 
     fclose(fp);
-    printf("npz_load: Error! Variable name %s not found in %s!\n",varname.c_str(),fname.c_str());
-    abort();
+    throw std::runtime_error("npz_load: variable " + varname + " not found in " + fname);
 }
 
 
@@ -394,10 +388,8 @@ cnpy::NpyArray cnpy::npzLoad(std::string fname, std::string varname) {
 cnpy::NpyArray cnpy::npyLoad(std::string fname) {
     FILE* fp = fopen(fname.c_str(), "rb");
 
-    if(!fp) {
-        printf("npy_load: Error! Unable to open file %s!\n",fname.c_str());
-        abort();
-    }
+    if(!fp)
+        throw std::runtime_error("npy_load: unable to open file " + fname);
 
     NpyArray arr = cnpy::loadNpyFromFile(fp);
 
@@ -406,4 +398,354 @@ cnpy::NpyArray cnpy::npyLoad(std::string fname) {
 }
 
 
+/**
+ * Releases array data: either unmaps it, or frees heap buffer
+ */
+void cnpy::NpyArray::destruct() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingLength);
+        mapping = nullptr;
+        mappingLength = 0;
+    } else
+        delete[] data;
+
+    data = nullptr;
+}
+
+/**
+ * Number of elements described by header
+ */
+unsigned long long cnpy::NpyHeader::length() const {
+    unsigned long long size = 1;
+    for (auto v: shape)
+        size *= v;
+    return size;
+}
+
+/**
+ * Parses .npy header in place, without copying anything but the dict.
+ * Format versions 1.0 (2 bytes header length) and 2.0/3.0 (4 bytes header length) are supported.
+ */
+bool cnpy::parseNpyHeaderBuffer(const char *buffer, size_t length, NpyHeader &header) {
+    if (buffer == nullptr || length < 10)
+        return false;
+
+    if ((unsigned char) buffer[0] != 0x93 || memcmp(buffer + 1, "NUMPY", 5) != 0)
+        return false;
+
+    auto ub = reinterpret_cast<const unsigned char *>(buffer);
+    unsigned char major = ub[6];
+    size_t prefix, headerLength;
+    if (major == 1) {
+        prefix = 10;
+        headerLength = ub[8] | (ub[9] << 8);
+    } else if (major == 2 || major == 3) {
+        if (length < 12)
+            return false;
+
+        prefix = 12;
+        headerLength = (size_t) ub[8] | ((size_t) ub[9] << 8) | ((size_t) ub[10] << 16) | ((size_t) ub[11] << 24);
+    } else
+        return false;
+
+    if (headerLength > length - prefix)
+        return false;
+
+    std::string dict(buffer + prefix, headerLength);
+
+    // descr: '<f4', '|u1' etc
+    auto loc = dict.find("'descr'");
+    if (loc == std::string::npos)
+        return false;
+
+    loc = dict.find('\'', loc + 7);
+    if (loc == std::string::npos || loc + 3 >= dict.size())
+        return false;
+
+    char order = dict[loc + 1];
+    header.littleEndian = order == '>' ? false : order == '=' ? BigEndianTest() == '<' : true;
+    header.type = dict[loc + 2];
+    header.wordSize = (unsigned int) atoi(dict.c_str() + loc + 3);
+    if (header.wordSize == 0)
+        return false;
+
+    // fortran_order: True/False
+    loc = dict.find("'fortran_order'");
+    if (loc == std::string::npos)
+        return false;
+
+    loc = dict.find_first_not_of(" :", loc + 15);
+    header.fortranOrder = loc != std::string::npos && dict.compare(loc, 4, "True") == 0;
+
+    // shape: (), (5,), (3, 4)
+    loc = dict.find("'shape'");
+    if (loc == std::string::npos)
+        return false;
+
+    auto open = dict.find('(', loc);
+    auto close = dict.find(')', open);
+    if (open == std::string::npos || close == std::string::npos)
+        return false;
+
+    header.shape.clear();
+    std::stringstream ss(dict.substr(open + 1, close - open - 1));
+    std::string token;
+    while (std::getline(ss, token, ',')) {
+        if (token.find_first_not_of(' ') == std::string::npos)
+            continue;
+
+        header.shape.push_back((unsigned int) strtoul(token.c_str(), nullptr, 10));
+    }
+
+    header.dataOffset = prefix + headerLength;
+    return true;
+}
+
+/**
+ * Maps whole file into memory, private copy-on-write
+ */
+static char* mapFile(const std::string &fname, size_t &length) {
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("npy_map: unable to open file " + fname);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        throw std::runtime_error("npy_map: unable to stat file " + fname);
+    }
+
+    length = (size_t) st.st_size;
+    void *ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (ptr == MAP_FAILED)
+        throw std::runtime_error("npy_map: mmap failed for " + fname);
+
+    return reinterpret_cast<char *>(ptr);
+}
+
+/**
+ * Builds array pointing into mapping at given offset, and checks that mapping actually contains all the data
+ */
+static cnpy::NpyArray mappedArray(char *mapping, size_t mappingLength, size_t offset, size_t available, const std::string &fname) {
+    cnpy::NpyHeader header;
+    if (!cnpy::parseNpyHeaderBuffer(mapping + offset, available, header) || header.length() * header.wordSize > available - header.dataOffset) {
+        munmap(mapping, mappingLength);
+        throw std::runtime_error("npy_map: bad npy data in " + fname);
+    }
+
+    cnpy::NpyArray arr;
+    arr.data = mapping + offset + header.dataOffset;
+    arr.shape = header.shape;
+    arr.wordSize = header.wordSize;
+    arr.fortranOrder = header.fortranOrder;
+    arr.type = header.type;
+    arr.littleEndian = header.littleEndian;
+    arr.mapping = mapping;
+    arr.mappingLength = mappingLength;
+    return arr;
+}
+
+cnpy::NpyArray cnpy::npyMap(std::string fname) {
+    size_t length;
+    char *mapping = mapFile(fname, length);
+    return mappedArray(mapping, length, 0, length, fname);
+}
+
+static inline unsigned short zipShort(const char *ptr) {
+    auto u = reinterpret_cast<const unsigned char *>(ptr);
+    return (unsigned short) (u[0] | (u[1] << 8));
+}
+
+static inline unsigned int zipInt(const char *ptr) {
+    auto u = reinterpret_cast<const unsigned char *>(ptr);
+    return (unsigned int) u[0] | ((unsigned int) u[1] << 8) | ((unsigned int) u[2] << 16) | ((unsigned int) u[3] << 24);
+}
+
+struct ZipMember {
+    std::string name;
+    unsigned short method;
+    unsigned int compressedSize;
+    unsigned int localOffset;
+};
 
+/**
+ * Walks zip central directory. Zip64 archives aren't supported.
+ */
+static std::vector<ZipMember> zipDirectory(const char *zip, size_t length, const std::string &fname) {
+    // end of central directory record is the last 22 bytes + optional comment up to 64kb
+    if (length < 22)
+        throw std::runtime_error("npz: not a zip archive " + fname);
+
+    size_t limit = length > 22 + 65535 ? length - 22 - 65535 : 0;
+    size_t eocd = std::string::npos;
+    for (size_t e = length - 22; ; e--) {
+        if (zipInt(zip + e) == 0x06054b50) {
+            eocd = e;
+            break;
+        }
+
+        if (e == limit)
+            break;
+    }
+
+    if (eocd == std::string::npos)
+        throw std::runtime_error("npz: not a zip archive " + fname);
+
+    unsigned short records = zipShort(zip + eocd + 10);
+    size_t offset = zipInt(zip + eocd + 16);
+    if (offset == 0xFFFFFFFFu)
+        throw std::runtime_error("npz: zip64 archives aren't supported " + fname);
+
+    std::vector<ZipMember> members;
+    for (unsigned short r = 0; r < records; r++) {
+        if (offset + 46 > length || zipInt(zip + offset) != 0x02014b50)
+            throw std::runtime_error("npz: corrupted central directory in " + fname);
+
+        ZipMember member;
+        member.method = zipShort(zip + offset + 10);
+        member.compressedSize = zipInt(zip + offset + 20);
+        unsigned short nameLength = zipShort(zip + offset + 28);
+        unsigned short extraLength = zipShort(zip + offset + 30);
+        unsigned short commentLength = zipShort(zip + offset + 32);
+        member.localOffset = zipInt(zip + offset + 42);
+
+        if (offset + 46 + nameLength > length)
+            throw std::runtime_error("npz: corrupted central directory in " + fname);
+
+        member.name = std::string(zip + offset + 46, nameLength);
+        if (member.name.size() > 4 && member.name.compare(member.name.size() - 4, 4, ".npy") == 0)
+            member.name.erase(member.name.size() - 4);
+
+        members.push_back(member);
+        offset += 46 + nameLength + extraLength + commentLength;
+    }
+
+    return members;
+}
+
+std::vector<std::string> cnpy::npzMembers(std::string fname) {
+    size_t length;
+    char *mapping = mapFile(fname, length);
+
+    std::vector<std::string> result;
+    try {
+        for (auto &m: zipDirectory(mapping, length, fname))
+            result.push_back(m.name);
+    } catch (std::runtime_error &e) {
+        munmap(mapping, length);
+        throw;
+    }
+
+    munmap(mapping, length);
+    return result;
+}
+
+cnpy::NpyArray cnpy::npzMap(std::string fname, std::string varname) {
+    size_t length;
+    char *mapping = mapFile(fname, length);
+
+    std::vector<ZipMember> members;
+    try {
+        members = zipDirectory(mapping, length, fname);
+    } catch (std::runtime_error &e) {
+        munmap(mapping, length);
+        throw;
+    }
+
+    for (auto &m: members) {
+        if (m.name != varname)
+            continue;
+
+        // only stored members can be mapped, there's no inflate here
+        if (m.method != 0) {
+            munmap(mapping, length);
+            throw std::runtime_error("npz_map: member " + varname + " is compressed, use numpy.savez instead of savez_compressed");
+        }
+
+        size_t local = m.localOffset;
+        if (local + 30 > length || zipInt(mapping + local) != 0x04034b50) {
+            munmap(mapping, length);
+            throw std::runtime_error("npz_map: corrupted local header in " + fname);
+        }
+
+        size_t offset = local + 30 + zipShort(mapping + local + 26) + zipShort(mapping + local + 28);
+        if (offset + m.compressedSize > length) {
+            munmap(mapping, length);
+            throw std::runtime_error("npz_map: truncated member " + varname + " in " + fname);
+        }
+
+        return mappedArray(mapping, length, offset, m.compressedSize, fname);
+    }
+
+    munmap(mapping, length);
+    throw std::runtime_error("npz_map: variable " + varname + " not found in " + fname);
+}
+
+#ifdef _WIN32
+#define npy_fseek _fseeki64
+#else
+#define npy_fseek fseeko
+#endif
+
+cnpy::NpyReader::NpyReader(std::string fname) {
+    _fp = fopen(fname.c_str(), "rb");
+    if (_fp == nullptr)
+        throw std::runtime_error("npy_reader: unable to open file " + fname);
+
+    // v1 header length fits into 2 bytes, v2/v3 into 4 bytes: read prefix first
+    char prefix[12];
+    std::vector<char> buffer;
+    if (fread(prefix, 1, 12, _fp) == 12) {
+        size_t headerLength = prefix[6] == 1 ? zipShort(prefix + 8) + 10 : zipInt(prefix + 8) + 12;
+        buffer.resize(headerLength);
+        memcpy(buffer.data(), prefix, 12);
+        if (headerLength < 12 || fread(buffer.data() + 12, 1, headerLength - 12, _fp) != headerLength - 12)
+            buffer.clear();
+    }
+
+    if (buffer.empty() || !parseNpyHeaderBuffer(buffer.data(), buffer.size(), _header)) {
+        fclose(_fp);
+        _fp = nullptr;
+        throw std::runtime_error("npy_reader: bad npy header in " + fname);
+    }
+
+    if (_header.fortranOrder) {
+        fclose(_fp);
+        _fp = nullptr;
+        throw std::runtime_error("npy_reader: only C order is supported for row streaming");
+    }
+
+    _rowLength = _header.wordSize;
+    for (size_t e = 1; e < _header.shape.size(); e++)
+        _rowLength *= _header.shape[e];
+}
+
+cnpy::NpyReader::~NpyReader() {
+    if (_fp != nullptr)
+        fclose(_fp);
+}
+
+const cnpy::NpyHeader& cnpy::NpyReader::header() const {
+    return _header;
+}
+
+unsigned long long cnpy::NpyReader::rows() const {
+    return _header.shape.empty() ? 1 : _header.shape[0];
+}
+
+unsigned long long cnpy::NpyReader::rowLength() const {
+    return _rowLength;
+}
+
+unsigned long long cnpy::NpyReader::readRows(unsigned long long start, unsigned long long count, char *buffer) {
+    if (start >= rows())
+        return 0;
+
+    count = std::min(count, rows() - start);
+    if (npy_fseek(_fp, _header.dataOffset + start * _rowLength, SEEK_SET) != 0)
+        throw std::runtime_error("npy_reader: seek failed");
+
+    return fread(buffer, (size_t) _rowLength, (size_t) count, _fp);
+}
@@ -38,9 +38,93 @@ namespace cnpy {
         std::vector<unsigned int> shape;
         unsigned int wordSize;
         bool fortranOrder;
-        void destruct() {
-            delete[] data;
-        }
+
+        // numpy type kind: 'f', 'i', 'u', 'b' etc, and byte order of data
+        char type = 'f';
+        bool littleEndian = true;
+
+        // if array was memory-mapped, data points into this mapping instead of heap
+        void* mapping = nullptr;
+        size_t mappingLength = 0;
+
+        void destruct();
+    };
+
+    /**
+     * Parsed .npy header
+     */
+    struct NpyHeader {
+        std::vector<unsigned int> shape;
+        unsigned int wordSize = 0;
+        bool fortranOrder = false;
+        char type = 'f';
+        bool littleEndian = true;
+
+        // offset of array data from the start of .npy, i.e. magic + version + header length + header
+        size_t dataOffset = 0;
+
+        unsigned long long length() const;
+    };
+
+    /**
+     * Parses .npy header (format versions 1.0, 2.0 and 3.0) in place.
+     * @param buffer pointer to the start of .npy, i.e. magic string
+     * @param length number of bytes available at buffer
+     * @param header parsed header
+     * @return false if buffer doesn't contain valid .npy header
+     */
+    bool parseNpyHeaderBuffer(const char *buffer, size_t length, NpyHeader &header);
+
+    /**
+     * Memory-maps given .npy file, header is parsed in place and returned array data points directly into mapping.
+     * Mapping is private copy-on-write, and it's released by NpyArray::destruct()
+     * @param fname
+     * @return
+     */
+    NpyArray npyMap(std::string fname);
+
+    /**
+     * Returns names of all members of given .npz archive, without .npy extension
+     * @param fname
+     * @return
+     */
+    std::vector<std::string> npzMembers(std::string fname);
+
+    /**
+     * Memory-maps given .npz archive and returns single member array pointing directly into mapping, nothing else is read.
+     * Only stored (not compressed) members are supported, i.e. the ones written by numpy.savez
+     * @param fname
+     * @param varname
+     * @return
+     */
+    NpyArray npzMap(std::string fname, std::string varname);
+
+    /**
+     * Streaming reader for .npy files which are too large to be loaded at once: only header is read on open,
+     * and then ranges of rows (along first dimension) are read on demand. C order only.
+     */
+    class NpyReader {
+    protected:
+        FILE *_fp = nullptr;
+        NpyHeader _header;
+        unsigned long long _rowLength = 0;
+    public:
+        explicit NpyReader(std::string fname);
+        ~NpyReader();
+
+        const NpyHeader& header() const;
+
+        // number of rows, i.e. shape[0]
+        unsigned long long rows() const;
+
+        // number of bytes in single row
+        unsigned long long rowLength() const;
+
+        /**
+         * Reads rows [start, start + count) into buffer, which must have count * rowLength() bytes available
+         * @return number of rows actually read
+         */
+        unsigned long long readRows(unsigned long long start, unsigned long long count, char *buffer);
     };
 
     struct npz_t : public std::map<std::string, NpyArray> {
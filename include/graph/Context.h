@@ -37,6 +37,9 @@ namespace nd4j {
 
             // branch for divergent_op
             int _branch = 0;
+
+            // number of variable lookups done via this context, used to detect data-dependent shape functions
+            Nd4jIndex _variableReads = 0;
         public:
             // TODO: maybe override new here as well?
 
@@ -67,6 +70,7 @@ namespace nd4j {
             nd4j::memory::Workspace* workspace();
 
             void setVariableSpace(VariableSpace<T> *variableSpace);
+            VariableSpace<T> *getVariableSpace();
 
             nd4j::random::RandomBuffer* getRNG();
             void setRNG(nd4j::random::RandomBuffer* rng);
@@ -109,6 +113,11 @@ namespace nd4j {
             Variable<T>* variable(std::initializer_list<int> p);
 
 
+            /**
+             * This method returns number of variable lookups done via this context so far
+             */
+            Nd4jIndex variableReads();
+
             void pushNDArrayToVariableSpace(int nodeId, int index, NDArray<T>* array, bool removable = true);
             void pushNDArrayToVariableSpace(std::pair<int, int>& pair, NDArray<T>* array, bool removable = true);
 
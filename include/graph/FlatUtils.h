@@ -21,6 +21,22 @@ namespace nd4j {
 
             template <typename T>
             static NDArray<T>* fromFlatArray(const nd4j::graph::FlatArray* flatArray);
+
+            /**
+             * This method returns NDArray which uses FlatArray buffer directly, without any copies.
+             * That's only possible when dtype and byte order match T and host, and buffer is properly aligned,
+             * otherwise it falls back to fromFlatArray() conversion.
+             *
+             * PLEASE NOTE: returned array doesn't own its buffer, so FlatArray memory must outlive it
+             */
+            template <typename T>
+            static NDArray<T>* viewFlatArray(const nd4j::graph::FlatArray* flatArray);
+
+            /**
+             * This method returns true if viewFlatArray() can use given FlatArray buffer directly
+             */
+            template <typename T>
+            static bool isViewable(const nd4j::graph::FlatArray* flatArray);
         };
     }
 }
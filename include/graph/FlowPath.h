@@ -6,6 +6,7 @@
 #define LIBND4J_FLOWPATH_H
 
 #include <map>
+#include <mutex>
 #include <pointercast.h>
 #include <graph/NodeState.h>
 #include <dll.h>
@@ -16,6 +17,9 @@ namespace nd4j {
         private:
             std::map<int, NodeState> _states;
 
+            // nodes might be executed concurrently, so every state access is guarded
+            std::mutex _mutex;
+
             void ensureNode(int nodeId);
         public:
             FlowPath() = default;
@@ -21,6 +21,8 @@
 
 namespace nd4j {
     namespace graph {
+        template <typename T>
+        class MemoryPlanner;
 
         template <typename T>
         class Graph {
@@ -49,6 +51,15 @@ namespace nd4j {
             std::map<int, Scope<T> *> _mappedScopes;
             std::vector<Scope<T> *> _scopes;
 
+            // memory-mapped FlatBuffers file, variables might hold views into it, so it's unmapped in destructor
+            void *_mappedBuffer = nullptr;
+            Nd4jIndex _mappedLength = 0;
+
+            // static memory plan for this graph's own VariableSpace, built on first request
+            std::mutex _mutexPlanning;
+            MemoryPlanner<T>* _planner = nullptr;
+            bool _planned = false;
+
 ////////////////////////////////////////
             Nd4jStatus validateNode(nd4j::graph::Node<T> *node);
 
@@ -60,10 +71,26 @@ namespace nd4j {
 
             void printOutNode(Node<T>* node);
         public:
-            Graph(const FlatGraph *flatGraph = nullptr);
+            /**
+             * @param flatGraph
+             * @param zeroCopy - if true, variables with matching dtype and byte order are bound directly to FlatGraph memory instead of being copied
+             */
+            Graph(const FlatGraph *flatGraph = nullptr, bool zeroCopy = false);
 
             ~Graph();
 
+            /**
+             * This method passes ownership of memory-mapped file to this graph, it'll be unmapped after all variables are released
+             *
+             * @param buffer
+             * @param length
+             */
+            void adoptMapping(void *buffer, Nd4jIndex length);
+
+            // memory-mapped file adopted by this graph, nullptr if graph was copied from FlatBuffers
+            void *mappedBuffer();
+            Nd4jIndex mappedLength();
+
             // method that'll print out graph
             Nd4jStatus validate();
 
@@ -73,6 +100,19 @@ namespace nd4j {
             // this method will return estimated memory size (in bytes) required for 1 full graph execution round
             Nd4jIndex estimateRequiredMemory();
 
+            /**
+             * This method returns static memory plan for this graph, built for current shapes of its inputs.
+             * Plan is built on first call, and rebuilt only if input shapes were changed since then.
+             *
+             * @return nullptr if graph can't be planned, i.e. it has LOGIC ops
+             */
+            MemoryPlanner<T>* getMemoryPlanner();
+
+            /**
+             * This method returns true if given planner is the one returned by getMemoryPlanner()
+             */
+            bool ownsMemoryPlanner(MemoryPlanner<T>* planner);
+
             // this method returns number of root nodes in this graph
             int rootNodes();
 
@@ -115,6 +155,12 @@ namespace nd4j {
              */
             std::vector<nd4j::graph::Variable<T> *> *fetchOutputs();
 
+            /**
+             * This method returns IDs of output nodes of this graph
+             * @return
+             */
+            std::vector<int> *getOutputIds();
+
             /**
              * This method returns pointer to ExecutorConfiguration
              *
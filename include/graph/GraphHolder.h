@@ -5,6 +5,8 @@
 #include <helpers/logger.h>
 #include <pointercast.h>
 #include <map>
+#include <mutex>
+#include <condition_variable>
 #include <graph/Graph.h>
 
 namespace nd4j {
@@ -16,23 +18,53 @@ namespace nd4j {
             std::map<Nd4jIndex, Graph<double>*> _graphD;
             std::map<Nd4jIndex, Graph<float16>*> _graphH;
 
+            // guards maps above only. stored graphs are executed outside of this lock
+            std::mutex _mutex;
+
+            // number of executions holding each stored graph. dropped graph is released once it's not held anymore
+            std::map<void*, int> _references;
+            std::condition_variable _released;
+
             GraphHolder() = default;
             ~GraphHolder() = default;
+
+            // lookup without locking, nullptr if there's no such graph
+            template <typename T>
+            Graph<T>* findGraph(Nd4jIndex graphId);
         public:
             static GraphHolder* getInstance();
 
+            /**
+             * This method stores given graph under given id. Graph is built here, so its VariableSpace isn't modified
+             * by executions anymore, and can be shared by concurrent sessions.
+             */
             template <typename T>
             void registerGraph(Nd4jIndex graphId, Graph<T>* graph);
             
             template <typename T>
             Graph<T>* cloneGraph(Nd4jIndex graphId);
 
+            /**
+             * This method returns stored graph. PLEASE NOTE: it doesn't keep graph from being dropped, use acquireGraph() for execution
+             */
             template <typename T>
             Graph<T>* pullGraph(Nd4jIndex graphId);
 
+            /**
+             * This method returns stored graph, and holds it: dropGraph() waits till every acquired graph is released with releaseGraph()
+             */
+            template <typename T>
+            Graph<T>* acquireGraph(Nd4jIndex graphId);
+
+            template <typename T>
+            void releaseGraph(Graph<T>* graph);
+
             template <typename T>
             void forgetGraph(Nd4jIndex graphId);
 
+            /**
+             * This method removes graph from holder, and deletes it once all executions holding it are finished
+             */
             template <typename T>
             void dropGraph(Nd4jIndex graphId);
 
@@ -0,0 +1,112 @@
+#ifndef LIBND4J_MEMORYPLANNER_H
+#define LIBND4J_MEMORYPLANNER_H
+
+#include <map>
+#include <vector>
+#include <pointercast.h>
+#include <memory/Workspace.h>
+#include <NDArray.h>
+#include <dll.h>
+
+// planned buffers are aligned to cache line
+#define PLANNER_ALIGNMENT 64
+
+namespace nd4j {
+    namespace graph {
+        template <typename T>
+        class Graph;
+
+        /**
+         * This class does static memory planning for Graph intermediates:
+         * 1) output shapes are inferred for every node, in onion order, via calculateOutputShape
+         * 2) lifetime of each output is computed as [producer layer, last consumer layer]. Outputs of in-place nodes are the same memory
+         *    as their inputs, so consumers of in-place outputs keep original buffer alive as well
+         * 3) outputs with non-overlapping lifetimes are packed into shared offsets of one Workspace
+         *
+         * Views of the arena are built once per plan. Once attached to VariableSpace, DeclarableOp::prepareOutputs binds planned outputs
+         * to these views, without shape inference or allocation.
+         * PLEASE NOTE: plan is valid only for input shapes it was built with, use isActual() to check that.
+         * @tparam T
+         */
+        template <typename T>
+        class MemoryPlanner {
+        protected:
+            struct PlannedBuffer {
+                std::pair<int, int> _id;
+                Nd4jIndex _bytes = 0L;
+                Nd4jIndex _offset = 0L;
+                int _first = 0;
+                int _last = 0;
+                int *_shapeInfo = nullptr;
+                NDArray<T>* _array = nullptr;
+            };
+
+            Graph<T>* _graph;
+            nd4j::memory::Workspace* _workspace = nullptr;
+            T* _arena = nullptr;
+
+            std::map<std::pair<int, int>, PlannedBuffer> _buffers;
+
+            // shapes of external inputs plan was built with
+            std::map<std::pair<int, int>, std::vector<int>> _inputShapes;
+
+            Nd4jIndex _arenaSize = 0L;
+            Nd4jIndex _totalSize = 0L;
+
+            void assignOffsets();
+
+            void release();
+        public:
+            MemoryPlanner(Graph<T>* graph);
+            ~MemoryPlanner();
+
+            /**
+             * This method builds plan & allocates arena for given graph. Previous plan, if any, is dropped.
+             * @return
+             */
+            Nd4jStatus plan();
+
+            /**
+             * This method returns true if external inputs of the graph still have shapes this plan was built with
+             */
+            bool isActual();
+
+            /**
+             * This method returns true if given node output has planned location
+             */
+            bool hasBuffer(std::pair<int, int>& pair);
+
+            /**
+             * These methods return planned location of given node output
+             */
+            T* buffer(std::pair<int, int>& pair);
+            int* shapeInfo(std::pair<int, int>& pair);
+            Nd4jIndex offset(std::pair<int, int>& pair);
+            Nd4jIndex bytes(std::pair<int, int>& pair);
+
+            /**
+             * This method returns view of the arena for given node output. View is owned by planner, and stays the same till next plan() call
+             */
+            NDArray<T>* array(std::pair<int, int>& pair);
+
+            /**
+             * This method returns number of planned buffers
+             */
+            int numberOfBuffers();
+
+            /**
+             * This method returns arena size, i.e. peak memory of live intermediates
+             */
+            Nd4jIndex arenaSize();
+
+            /**
+             * This method returns sum of all planned buffers, i.e. memory required without reuse
+             */
+            Nd4jIndex totalSize();
+
+            nd4j::memory::Workspace* workspace();
+        };
+    }
+}
+
+#endif //LIBND4J_MEMORYPLANNER_H
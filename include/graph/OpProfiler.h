@@ -0,0 +1,149 @@
+#ifndef LIBND4J_OPPROFILER_H
+#define LIBND4J_OPPROFILER_H
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <pointercast.h>
+#include <dll.h>
+
+// number of linear sub-buckets within each power of 2 of op time histograms
+#define PROFILER_SUB_BUCKETS 8
+
+// number of power of 2 ranges covered by histograms: up to ~2^40 microseconds
+#define PROFILER_RANGES 40
+
+// events beyond this limit aren't stored for trace, but still go into statistics
+#define PROFILER_MAX_EVENTS 1048576
+
+namespace nd4j {
+    namespace graph {
+
+        /**
+         * Single timed event: either graph node execution, or DeclarableOp execution within it
+         */
+        struct ND4J_EXPORT ProfilerEvent {
+            std::string name;
+            std::string category;
+            int nodeId = 0;
+
+            // microseconds since profiler epoch
+            Nd4jIndex start = 0;
+            Nd4jIndex end = 0;
+
+            int threadId = 0;
+
+            std::vector<std::vector<int>> inputShapes;
+            std::vector<std::vector<int>> outputShapes;
+
+            // bytes taken from Workspace during execution
+            Nd4jIndex workspaceBytes = 0;
+
+            // estimated number of floating point operations
+            Nd4jIndex flops = 0;
+        };
+
+        /**
+         * Aggregated statistics for single op name
+         */
+        class ND4J_EXPORT ProfilerStats {
+        protected:
+            std::vector<Nd4jIndex> _histogram;
+        public:
+            std::string name;
+            Nd4jIndex calls = 0;
+            Nd4jIndex totalTime = 0;
+            Nd4jIndex minTime = 0;
+            Nd4jIndex maxTime = 0;
+            Nd4jIndex workspaceBytes = 0;
+            Nd4jIndex flops = 0;
+
+            ProfilerStats();
+
+            void update(Nd4jIndex time, Nd4jIndex bytes, Nd4jIndex flops);
+
+            Nd4jIndex meanTime() const;
+
+            /**
+             * Approximate percentile of op time, in microseconds. Error is bounded by histogram bucket width, i.e. 1/PROFILER_SUB_BUCKETS
+             * @param p - percentile, 0...100
+             */
+            Nd4jIndex percentile(double p) const;
+
+            static int bucket(Nd4jIndex time);
+            static Nd4jIndex bucketValue(int bucket);
+        };
+
+        /**
+         * Opt-in profiler for graph execution. When enabled, GraphExecutioner records every node and DeclarableOp records every op
+         * execution. Recorded events can be exported as Chrome trace (chrome://tracing or Perfetto), and per-op statistics are aggregated on the fly.
+         */
+        class ND4J_EXPORT OpProfiler {
+        private:
+            static OpProfiler* _instance;
+
+            std::atomic<bool> _enabled;
+            std::atomic<int> _threads;
+
+            std::mutex _mutex;
+            std::vector<ProfilerEvent> _events;
+            std::map<std::string, ProfilerStats> _stats;
+            Nd4jIndex _dropped = 0;
+
+            Nd4jIndex _epoch;
+
+            OpProfiler();
+            ~OpProfiler() = default;
+        public:
+            static OpProfiler* getInstance();
+
+            bool isEnabled();
+            void setEnabled(bool reallyEnabled);
+
+            /**
+             * Removes all recorded events and statistics
+             */
+            void reset();
+
+            /**
+             * Microseconds since profiler epoch, monotonic
+             */
+            Nd4jIndex now();
+
+            /**
+             * Small sequential id of calling thread
+             */
+            int threadId();
+
+            void record(ProfilerEvent &event);
+
+            std::vector<ProfilerEvent> events();
+            Nd4jIndex droppedEvents();
+
+            /**
+             * Per-op statistics of "op" events, sorted by total time, descending
+             */
+            std::vector<ProfilerStats> statistics();
+
+            /**
+             * Chrome trace-event JSON
+             */
+            std::string chromeTrace();
+            bool exportChromeTrace(const char *fileName);
+
+            /**
+             * Prints per-op statistics table to stdout
+             */
+            void printStatistics();
+
+            /**
+             * Rough FLOPs estimate for op with given name: GEMM-like ops are estimated via their shapes, everything else as 1 op per output element
+             */
+            static Nd4jIndex estimateFlops(const std::string &name, const std::vector<std::vector<int>> &inputShapes, const std::vector<std::vector<int>> &outputShapes);
+        };
+    }
+}
+
+#endif //LIBND4J_OPPROFILER_H
@@ -7,6 +7,7 @@
 
 #include <thread>
 #include "VariableSpace.h"
+#include "VariableProxy.h"
 #include "Context.h"
 #include "Stash.h"
 #include <memory/Workspace.h>
@@ -23,12 +24,15 @@ namespace nd4j{
             VariableSpace<T>* _variableSpace;
             Stash<T>* _stash;
 
+            // if true, sessions get VariableProxy over original VariableSpace instead of full clone
+            bool _shareVariables;
+
             std::mutex _mutex;
 
             Nd4jIndex getSessionId();
             Nd4jIndex getThreadId();
         public:
-            SessionLocalStorage(VariableSpace<T>* variableSpace = nullptr, Stash<T>* stash = nullptr);
+            SessionLocalStorage(VariableSpace<T>* variableSpace = nullptr, Stash<T>* stash = nullptr, bool shareVariables = false);
 
             ~SessionLocalStorage();
 
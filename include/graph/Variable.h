@@ -41,7 +41,11 @@ namespace nd4j {
             Variable(bool placeHolder);
             Variable(nd4j::NDArray<T> *arrayw, const char *name, int id, int idx = 0);
             Variable(nd4j::NDArray<T> *array = nullptr, const char *name = nullptr);
-            Variable(const nd4j::graph::FlatVariable *flatVariable);
+            /**
+             * @param flatVariable
+             * @param zeroCopy - if true, array is bound directly to FlatVariable buffer whenever possible, and variable is marked read-only then
+             */
+            Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy = false);
             ~Variable();
 
             Variable<T>* clone();
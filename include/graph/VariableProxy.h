@@ -0,0 +1,63 @@
+#ifndef LIBND4J_VARIABLEPROXY_H
+#define LIBND4J_VARIABLEPROXY_H
+
+#include <graph/VariableSpace.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class is lightweight per-session overlay over shared VariableSpace.
+         *
+         * Backing VariableSpace is never modified by proxy:
+         * 1) external variables (i.e. weights & constants) are returned from backing space as is, without copies
+         * 2) placeholders and node outputs get private shadow variables on first access
+         * 3) all new variables are stored in proxy only
+         *
+         * PLEASE NOTE: backing VariableSpace must stay unchanged while proxies are alive, since it's read without locks.
+         * For stored graphs that's guaranteed by GraphHolder::registerGraph, which builds graph before it's available to sessions.
+         * @tparam T
+         */
+        template <typename T>
+        class VariableProxy : public VariableSpace<T> {
+        protected:
+            VariableSpace<T>* _backed;
+
+            // returns variable stored in given space, or nullptr
+            static Variable<T>* lookup(VariableSpace<T>* space, std::pair<int, int>& pair);
+
+            // returns local shadow of backed variable, or backed variable itself if it's shared
+            Variable<T>* resolve(std::pair<int, int>& pair, Variable<T>* origin);
+
+            // creates array-less copy of variable, with the same id, name & flags
+            static Variable<T>* shadow(std::pair<int, int>& pair, Variable<T>* origin);
+        public:
+            explicit VariableProxy(VariableSpace<T>* backed);
+            ~VariableProxy();
+
+            using VariableSpace<T>::putVariable;
+
+            VariableSpace<T>* backed();
+
+            virtual bool hasExternalVariable(int it);
+            virtual bool hasExternalVariable(std::pair<int,int>& pair);
+            virtual bool hasExternalVariable(std::string *symbol);
+
+            virtual bool hasVariable(int id);
+            virtual bool hasVariable(int id, int idx);
+            virtual bool hasVariable(std::pair<int,int>& pair);
+            virtual bool hasVariable(std::string *symbol);
+
+            virtual nd4j::graph::Variable<T> *getVariable(int id);
+            virtual nd4j::graph::Variable<T> *getVariable(int id, int idx);
+            virtual nd4j::graph::Variable<T> *getVariable(std::pair<int,int>& pair);
+            virtual nd4j::graph::Variable<T> *getVariable(std::string *symbol);
+
+            /**
+             * This method sets array for given variable within this proxy only. Backed variable stays intact.
+             */
+            virtual void putVariable(int id, NDArray<T> *array);
+        };
+    }
+}
+
+#endif //LIBND4J_VARIABLEPROXY_H
@@ -23,8 +23,16 @@
 namespace nd4j {
     namespace graph {
 
+        template <typename T>
+        class MemoryPlanner;
+
+        template <typename T>
+        class VariableProxy;
+
         template <typename T>
         class VariableSpace {
+            // proxy reads maps of backing VariableSpace directly
+            friend class VariableProxy<T>;
         protected:
 
             nd4j::memory::Workspace _workspace;
@@ -47,7 +55,8 @@ namespace nd4j {
 
             int _auto_counter = -1;
 
-            std::mutex _varmap;
+            // guards all maps above: nodes might be executed concurrently by GraphScheduler
+            std::recursive_mutex _varmap;
 
             std::map<int, nd4j::graph::Variable<T> *> _temporary;
 
@@ -55,33 +64,36 @@ namespace nd4j {
 
             FlowPath* _flow = nullptr;
 
+            // if set, node outputs are placed into planned arena offsets. NOT owned by VariableSpace
+            MemoryPlanner<T>* _planner = nullptr;
+
         public:
             VariableSpace();
-            ~VariableSpace();
+            virtual ~VariableSpace();
 
             int numberOfPlaceholders();
             std::vector<Variable<T>*>* getPlaceholders();
             nd4j::random::RandomBuffer* getRNG();
             void setRNG(nd4j::random::RandomBuffer* rng);
 
-            bool hasExternalVariable(int it);
-            bool hasExternalVariable(std::pair<int,int>& pair);
-            bool hasExternalVariable(std::string *symbol);
+            virtual bool hasExternalVariable(int it);
+            virtual bool hasExternalVariable(std::pair<int,int>& pair);
+            virtual bool hasExternalVariable(std::string *symbol);
 
-            bool hasVariable(int id);
-            bool hasVariable(int id, int idx);
-            bool hasVariable(std::pair<int,int>& pair);
-            bool hasVariable(std::string *symbol);
+            virtual bool hasVariable(int id);
+            virtual bool hasVariable(int id, int idx);
+            virtual bool hasVariable(std::pair<int,int>& pair);
+            virtual bool hasVariable(std::string *symbol);
 
-            nd4j::graph::Variable<T> *getVariable(int id);
-            nd4j::graph::Variable<T> *getVariable(int id, int idx);
-            nd4j::graph::Variable<T> *getVariable(std::pair<int,int>& pair);
-            nd4j::graph::Variable<T> *getVariable(std::string *symbol);
+            virtual nd4j::graph::Variable<T> *getVariable(int id);
+            virtual nd4j::graph::Variable<T> *getVariable(int id, int idx);
+            virtual nd4j::graph::Variable<T> *getVariable(std::pair<int,int>& pair);
+            virtual nd4j::graph::Variable<T> *getVariable(std::string *symbol);
 
             void putVariable(std::pair<int,int>& pair, NDArray<T> *array);
             void putVariable(std::pair<int,int>& pair, Variable<T> *variable);
             void putVariable(int id, Variable<T> *variable);
-            void putVariable(int id, NDArray<T> *array);
+            virtual void putVariable(int id, NDArray<T> *array);
             void putVariable(int id, int idx, NDArray<T> *array);
             void putVariable(int id, int idx, Variable<T> *array);
 
@@ -106,6 +118,9 @@ namespace nd4j {
 
             void setFlowPath(FlowPath* timers);
             FlowPath* flowPath();
+
+            void setMemoryPlanner(MemoryPlanner<T>* planner);
+            MemoryPlanner<T>* memoryPlanner();
         };
     }
 }
@@ -0,0 +1,155 @@
+#ifndef LIBND4J_ASYNCGRAPHEXECUTOR_H
+#define LIBND4J_ASYNCGRAPHEXECUTOR_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <NDArray.h>
+#include <graph/Graph.h>
+#include <graph/VariableProxy.h>
+#include <graph/VariablesSet.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Completion callback: handle of finished execution, its status, and user data passed on submission
+         */
+        typedef void (*GraphCallback)(Nd4jPointer handle, int status, Nd4jPointer userData);
+
+        /**
+         * This class is type-agnostic part of async execution handle: completion state & status
+         */
+        class ND4J_EXPORT ExecutionHandle {
+        protected:
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            bool _done = false;
+            Nd4jStatus _status = ND4J_STATUS_OK;
+        public:
+            virtual ~ExecutionHandle() = default;
+
+            /**
+             * This method returns true if execution is finished. Never blocks.
+             */
+            bool isDone();
+
+            /**
+             * This method blocks till execution is finished, and returns its status
+             */
+            Nd4jStatus wait();
+
+            /**
+             * This method blocks till execution is finished, but not longer than given number of microseconds
+             * @return true if execution is finished
+             */
+            bool waitFor(Nd4jIndex microseconds);
+
+            void markDone(Nd4jStatus status);
+        };
+
+        /**
+         * This class is handle of one asynchronous stored graph execution
+         * @tparam T
+         */
+        template <typename T>
+        class GraphFuture : public ExecutionHandle {
+        protected:
+            VariablesSet<T>* _result = nullptr;
+        public:
+            GraphFuture() = default;
+            ~GraphFuture();
+
+            void setResult(VariablesSet<T>* result);
+
+            /**
+             * This method blocks till execution is finished, and returns results. Results are still owned by this future.
+             */
+            VariablesSet<T>* result();
+
+            /**
+             * This method blocks till execution is finished, and returns results. Caller becomes owner of results.
+             */
+            VariablesSet<T>* detachResult();
+        };
+
+        /**
+         * This class executes stored graphs on internal worker threads.
+         *
+         * Inputs are staged on caller thread: they are copied into VariableProxy of the request before submit() returns,
+         * so caller can prepare next request while current one is executed, and can reuse its input buffers right away.
+         *
+         * Callback, if any, is invoked on worker thread when results are already available, but before handle is marked as done,
+         * so handle can't be released by waiting thread while callback is running. Don't wait on handle within callback.
+         *
+         * Each submitted execution holds its graph, so unregistering graph blocks till executions already submitted for it are finished.
+         * PLEASE NOTE: that's why graph must not be unregistered from callback.
+         * @tparam T
+         */
+        template <typename T>
+        class AsyncGraphExecutor {
+        protected:
+            struct Job {
+                Graph<T>* _graph = nullptr;
+                VariableProxy<T>* _variableSpace = nullptr;
+                GraphFuture<T>* _future = nullptr;
+                GraphCallback _callback = nullptr;
+                Nd4jPointer _userData = nullptr;
+            };
+
+            std::deque<Job> _queue;
+            std::vector<std::thread> _workers;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            int _numWorkers = 1;
+            bool _stop = false;
+
+            std::atomic<Nd4jIndex> _submitted;
+            std::atomic<Nd4jIndex> _completed;
+
+            AsyncGraphExecutor();
+            ~AsyncGraphExecutor();
+
+            void worker();
+
+            GraphFuture<T>* enqueue(Graph<T>* graph, VariableProxy<T>* variableSpace, GraphCallback callback, Nd4jPointer userData);
+        public:
+            static AsyncGraphExecutor<T>* getInstance();
+
+            /**
+             * This method executes given graph over given proxy on calling thread, and collects graph outputs
+             */
+            static VariablesSet<T>* execute(Graph<T>* graph, VariableProxy<T>* variableSpace);
+
+            /**
+             * These methods submit stored graph for execution, and return handle immediately. Inputs are copied.
+             *
+             * @param graphId - id of graph registered in GraphHolder
+             * @param indices - ids of graph variables to be replaced
+             * @param inputs - arrays for these variables
+             * @param callback - optional completion callback
+             * @param userData - passed to callback as is
+             */
+            GraphFuture<T>* submit(Nd4jIndex graphId, std::vector<int>& indices, std::vector<NDArray<T>*>& inputs, GraphCallback callback = nullptr, Nd4jPointer userData = nullptr);
+            GraphFuture<T>* submit(Nd4jIndex graphId, Nd4jPointer* inputBuffers, Nd4jPointer* inputShapes, int* inputIndices, int numInputs, GraphCallback callback = nullptr, Nd4jPointer userData = nullptr);
+
+            /**
+             * Number of worker threads, 1 by default. Each worker runs its graph with full OpenMP parallelism.
+             */
+            void setNumberOfWorkers(int numWorkers);
+            int numberOfWorkers();
+
+            // number of submitted executions that weren't picked by worker yet
+            int queueSize();
+
+            Nd4jIndex numberOfSubmitted();
+            Nd4jIndex numberOfCompleted();
+        };
+    }
+}
+
+#endif //LIBND4J_ASYNCGRAPHEXECUTOR_H
@@ -0,0 +1,199 @@
+#ifndef LIBND4J_GRAPHBATCHER_H
+#define LIBND4J_GRAPHBATCHER_H
+
+#include <pointercast.h>
+#include <NDArray.h>
+#include <graph/VariableProxy.h>
+#include <graph/Graph.h>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Statistics of one executed batch
+         */
+        struct BatchStats {
+            // number of callers coalesced into this batch
+            int _requests = 0;
+
+            // number of rows along dimension 0
+            int _rows = 0;
+
+            // rows / max batch size
+            double _occupancy = 0.0;
+
+            // time spent by first caller waiting for others, and time spent in graph execution, microseconds
+            Nd4jIndex _queueTime = 0L;
+            Nd4jIndex _executionTime = 0L;
+        };
+
+        template <typename T>
+        class GraphBatcher;
+
+        /**
+         * This class holds outputs of one caller within executed batch.
+         * Outputs are views into batched arrays, so batch is kept alive till all its results are released.
+         * @tparam T
+         */
+        template <typename T>
+        class BatchedResult {
+        protected:
+            std::shared_ptr<void> _batch;
+            std::vector<NDArray<T>*> _outputs;
+            Nd4jStatus _status;
+
+            friend class GraphBatcher<T>;
+
+            BatchedResult(std::shared_ptr<void> batch, Nd4jStatus status);
+        public:
+            ~BatchedResult();
+
+            Nd4jStatus status();
+
+            int size();
+
+            /**
+             * This method returns view of index-th graph output, limited to rows of this caller
+             */
+            NDArray<T>* at(int index);
+        };
+
+        /**
+         * This class coalesces concurrent requests to the same stored graph into batches along dimension 0.
+         *
+         * There's no dedicated thread here: first caller of each batch waits till batch is full or max delay is passed,
+         * then executes the whole batch, while other callers just wait for results.
+         * Requests with different input ids or different shapes beyond dimension 0 never share the same batch.
+         *
+         * Outputs that have batch dimension are split back into per-caller views, other outputs are shared by all callers as is.
+         * Which outputs have batch dimension isn't guessed from shapes: first merged batch executes its first caller alone as well,
+         * and outputs that followed number of rows in both runs are recorded as batched. Graphs with outputs that neither follow
+         * number of rows nor keep their shape aren't batched at all: every request is executed on its own.
+         * @tparam T
+         */
+        template <typename T>
+        class GraphBatcher {
+        protected:
+            enum BatchLayout {
+                // batch dimension of outputs isn't known yet
+                LAYOUT_UNKNOWN = 0,
+                // outputs marked in _batchedOutputs are split along dimension 0
+                LAYOUT_SPLIT = 1,
+                // outputs can't be split, so requests aren't merged
+                LAYOUT_SEPARATE = 2,
+            };
+
+            struct Batch {
+                std::vector<int> _indices;
+                std::vector<std::vector<NDArray<T>*>> _inputs;
+                std::vector<int> _rows;
+                int _totalRows = 0;
+
+                bool _closed = false;
+                bool _done = false;
+                Nd4jStatus _status = ND4J_STATUS_OK;
+
+                // holds batched inputs & outputs
+                VariableProxy<T>* _variableSpace = nullptr;
+                std::vector<NDArray<T>*> _outputs;
+
+                // layout of outputs, as it was known when batch was opened
+                BatchLayout _layout = LAYOUT_UNKNOWN;
+                std::vector<bool> _batchedOutputs;
+
+                // callers executed one by one, if outputs of this batch can't be split
+                std::vector<std::shared_ptr<Batch>> _separate;
+
+                std::chrono::time_point<std::chrono::system_clock> _opened;
+
+                ~Batch();
+            };
+
+            Nd4jIndex _graphId;
+            int _maxBatchSize;
+            Nd4jIndex _maxDelay;
+
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            std::shared_ptr<Batch> _open;
+
+            BatchLayout _layout = LAYOUT_UNKNOWN;
+            std::vector<bool> _batchedOutputs;
+
+            // statistics
+            Nd4jIndex _numberOfBatches = 0L;
+            Nd4jIndex _numberOfRequests = 0L;
+            double _totalOccupancy = 0.0;
+            Nd4jIndex _totalExecutionTime = 0L;
+            int _historyLimit = 1024;
+            std::deque<BatchStats> _history;
+
+            bool isCompatible(Batch* batch, std::vector<int>& indices, std::vector<NDArray<T>*>& inputs);
+
+            void executeBatch(Batch* batch);
+            void executeBatch(Graph<T>* graph, Batch* batch);
+
+            // merges inputs of all callers, and executes graph once over them
+            void runBatch(Graph<T>* graph, Batch* batch);
+
+            std::shared_ptr<Batch> separateBatch(Batch* batch, int position);
+
+            /**
+             * This method compares outputs of the same graph executed for different number of rows, and marks outputs that follow it
+             * @return false if some output neither follows number of rows nor keeps its shape
+             */
+            static bool learnLayout(Batch* first, Batch* second, std::vector<bool>& batched);
+
+            // checks that every batched output really has batch dimension in this batch
+            static bool isSplittable(Batch* batch);
+
+            BatchedResult<T>* extractResult(std::shared_ptr<Batch> batch, int position);
+        public:
+            /**
+             * @param graphId - id of graph registered in GraphHolder
+             * @param maxBatchSize - max number of rows along dimension 0 per batch
+             * @param maxDelay - max time first request waits for others, microseconds
+             */
+            GraphBatcher(Nd4jIndex graphId, int maxBatchSize = 32, Nd4jIndex maxDelay = 1000L);
+            ~GraphBatcher() = default;
+
+            /**
+             * This method executes stored graph for given inputs, possibly batched together with concurrent calls.
+             * All inputs must have the same size along dimension 0. Blocks till results are available.
+             *
+             * @param indices - ids of graph variables to be replaced
+             * @param inputs - arrays for these variables
+             * @return
+             */
+            BatchedResult<T>* execute(std::vector<int>& indices, std::vector<NDArray<T>*>& inputs);
+
+            int maxBatchSize();
+            Nd4jIndex maxDelay();
+
+            void setMaxBatchSize(int maxBatchSize);
+            void setMaxDelay(Nd4jIndex maxDelay);
+
+            /**
+             * Aggregated statistics
+             */
+            Nd4jIndex numberOfBatches();
+            Nd4jIndex numberOfRequests();
+            double averageOccupancy();
+            double averageBatchSize();
+            Nd4jIndex averageExecutionTime();
+
+            /**
+             * This method returns statistics for last executed batches, oldest first
+             */
+            std::vector<BatchStats> history();
+
+            void printStats();
+        };
+    }
+}
+
+#endif //LIBND4J_GRAPHBATCHER_H
@@ -0,0 +1,65 @@
+#ifndef LIBND4J_GRAPHFUSER_H
+#define LIBND4J_GRAPHFUSER_H
+
+#include <pointercast.h>
+#include <graph/Node.h>
+#include <graph/Graph.h>
+#include <graph/VariableSpace.h>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class finds linear chains of elementwise legacy nodes (Transform, Scalar, PairWise) within Graph,
+         * and executes each chain as single fused pass via GRIDFused.
+         *
+         * Node can be appended to chain only if previous node of the chain is used nowhere else, and isn't graph output.
+         * Whole chain is executed at the position of its last node, so all PairWise operands are available by then.
+         * Intermediate results of the chain never reach VariableSpace.
+         *
+         * PLEASE NOTE: graphs with LOGIC ops aren't supported here, as well as graphs with statically planned memory.
+         * @tparam T
+         */
+        template <typename T>
+        class GraphFuser {
+        protected:
+            // chains, keyed by id of their last node
+            std::map<int, std::vector<Node<T>*>> _chains;
+
+            // all nodes of chains, except last ones
+            std::set<int> _deferred;
+
+            // executes chain nodes one by one, the same way as they would be executed without fusion
+            Nd4jStatus executeSequential(Graph<T>* graph, std::vector<Node<T>*>& chain, VariableSpace<T>* variableSpace);
+        public:
+            explicit GraphFuser(Graph<T>* graph);
+            ~GraphFuser() = default;
+
+            /**
+             * This method returns true if given node is part of fused chain, but not the last one, so it shouldn't be executed on its own
+             */
+            bool isDeferred(int nodeId);
+
+            /**
+             * This method returns true if given node is the last node of fused chain
+             */
+            bool isChainTail(int nodeId);
+
+            int numberOfChains();
+
+            /**
+             * This method executes whole chain ending at given node, and stores result as output of that node
+             */
+            Nd4jStatus executeChain(Graph<T>* graph, int nodeId, VariableSpace<T>* variableSpace);
+
+            /**
+             * This method checks if given node can be part of fused chain
+             */
+            static bool isFusable(Node<T>* node);
+        };
+    }
+}
+
+#endif //LIBND4J_GRAPHFUSER_H
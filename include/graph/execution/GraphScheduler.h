@@ -0,0 +1,98 @@
+#ifndef LIBND4J_GRAPHSCHEDULER_H
+#define LIBND4J_GRAPHSCHEDULER_H
+
+#include <pointercast.h>
+#include <graph/Node.h>
+#include <graph/Graph.h>
+#include <graph/VariableSpace.h>
+#include <graph/execution/GraphFuser.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class executes Graph as DAG: each node is launched as soon as all of its inputs are available,
+         * without waiting for the whole onion layer to finish.
+         *
+         * Ready nodes are spread over per-worker deques: worker pushes & pops its own deque from the back,
+         * and idle workers steal from the front of other deques. Worker 0 is calling thread, others are taken from persistent GraphWorkers pool.
+         *
+         * Exception thrown by op on any worker stops execution, and is rethrown on calling thread.
+         * If GraphFuser is provided, deferred nodes are only released to their consumers, and chains are executed at their tails.
+         *
+         * PLEASE NOTE: graphs with LOGIC ops aren't supported here, since those ops execute nodes out of onion order.
+         * @tparam T
+         */
+        template <typename T>
+        class GraphScheduler {
+        protected:
+            struct WorkerQueue {
+                std::mutex _mutex;
+                std::deque<Node<T>*> _nodes;
+            };
+
+            Graph<T>* _graph;
+            VariableSpace<T>* _variableSpace;
+            FlowPath* _flowPath;
+            GraphFuser<T>* _fuser;
+            int _numWorkers;
+
+            // number of unfinished inputs per node id, and reverse edges
+            std::map<int, std::atomic<int>*> _pending;
+            std::map<int, std::vector<Node<T>*>> _successors;
+
+            std::vector<WorkerQueue*> _queues;
+
+            std::atomic<int> _remaining;
+            std::atomic<int> _queued;
+            std::atomic<int> _status;
+
+            std::mutex _mutexIdle;
+            std::condition_variable _idle;
+
+            // first exception thrown by any worker
+            std::mutex _mutexError;
+            std::exception_ptr _error;
+
+            void buildDependencies();
+
+            void enqueue(int worker, Node<T>* node);
+            Node<T>* dequeue(int worker);
+
+            void processNode(int worker, Node<T>* node);
+            void workerLoop(int worker, int ompThreads);
+
+            // returns true if node belongs to inactive branch, and should be skipped
+            bool shouldSkip(Node<T>* node);
+        public:
+            GraphScheduler(Graph<T>* graph, VariableSpace<T>* variableSpace, int numWorkers, GraphFuser<T>* fuser = nullptr);
+            ~GraphScheduler();
+
+            /**
+             * This method executes all nodes of the graph, and returns first error code, if any
+             * @return
+             */
+            Nd4jStatus execute();
+
+            /**
+             * This method checks if given graph can be executed by this scheduler
+             * @param graph
+             * @return
+             */
+            static bool isApplicable(Graph<T>* graph);
+
+            /**
+             * This method returns number of nodes in widest onion layer
+             * @param graph
+             * @return
+             */
+            static int maxLayerWidth(Graph<T>* graph);
+        };
+    }
+}
+
+#endif //LIBND4J_GRAPHSCHEDULER_H
@@ -0,0 +1,48 @@
+#ifndef LIBND4J_GRAPHWORKERS_H
+#define LIBND4J_GRAPHWORKERS_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class is process-wide pool of persistent threads, used by GraphScheduler.
+         * Threads are started lazily, and live till process exit, so graph executions don't pay for thread creation.
+         *
+         * Tasks are executed in submission order. Task must not block waiting for another task: pool can be smaller than number of queued tasks.
+         */
+        class ND4J_EXPORT GraphWorkers {
+        protected:
+            std::deque<std::function<void()>> _tasks;
+            std::vector<std::thread> _threads;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            bool _stop = false;
+
+            GraphWorkers() = default;
+            ~GraphWorkers();
+
+            void loop();
+        public:
+            static GraphWorkers* getInstance();
+
+            /**
+             * This method makes sure at least given number of threads is running
+             */
+            void ensureThreads(int numThreads);
+
+            void submit(std::function<void()> task);
+
+            int numberOfThreads();
+        };
+    }
+}
+
+#endif //LIBND4J_GRAPHWORKERS_H
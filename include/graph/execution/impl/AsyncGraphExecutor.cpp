@@ -0,0 +1,248 @@
+#include <graph/execution/AsyncGraphExecutor.h>
+#include <graph/GraphHolder.h>
+#include <GraphExecutioner.h>
+#include <chrono>
+
+namespace nd4j {
+    namespace graph {
+        bool ExecutionHandle::isDone() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _done;
+        }
+
+        Nd4jStatus ExecutionHandle::wait() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [&] { return _done; });
+            return _status;
+        }
+
+        bool ExecutionHandle::waitFor(Nd4jIndex microseconds) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            return _condition.wait_for(lock, std::chrono::microseconds(microseconds), [&] { return _done; });
+        }
+
+        void ExecutionHandle::markDone(Nd4jStatus status) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _status = status;
+                _done = true;
+            }
+
+            _condition.notify_all();
+        }
+
+        template <typename T>
+        GraphFuture<T>::~GraphFuture() {
+            if (_result != nullptr)
+                delete _result;
+        }
+
+        template <typename T>
+        void GraphFuture<T>::setResult(VariablesSet<T> *result) {
+            _result = result;
+        }
+
+        template <typename T>
+        VariablesSet<T>* GraphFuture<T>::result() {
+            wait();
+            return _result;
+        }
+
+        template <typename T>
+        VariablesSet<T>* GraphFuture<T>::detachResult() {
+            wait();
+
+            auto result = _result;
+            _result = nullptr;
+            return result;
+        }
+
+        template <typename T>
+        AsyncGraphExecutor<T>::AsyncGraphExecutor() {
+            _submitted.store(0);
+            _completed.store(0);
+
+            // jobs left in queue release their graphs on destruction, so holder must outlive executor
+            GraphHolder::getInstance();
+        }
+
+        template <typename T>
+        AsyncGraphExecutor<T>::~AsyncGraphExecutor() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _condition.notify_all();
+
+            for (auto &t: _workers)
+                t.join();
+
+            // whatever is left in queue will never be executed
+            for (auto &job: _queue) {
+                delete job._variableSpace;
+                GraphHolder::getInstance()->releaseGraph<T>(job._graph);
+                job._future->markDone(ND4J_STATUS_BAD_GRAPH);
+            }
+        }
+
+        template <typename T>
+        AsyncGraphExecutor<T>* AsyncGraphExecutor<T>::getInstance() {
+            static AsyncGraphExecutor<T> instance;
+            return &instance;
+        }
+
+        template <typename T>
+        VariablesSet<T>* AsyncGraphExecutor<T>::execute(Graph<T> *graph, VariableProxy<T> *variableSpace) {
+            auto status = GraphExecutioner<T>::execute(graph, variableSpace);
+            auto varSet = new VariablesSet<T>(status);
+
+            if (status == ND4J_STATUS_OK) {
+                // pull back results, and provide them
+                auto outputs = graph->fetchOutputs();
+                for (int e = 0; e < outputs->size(); e++) {
+                    // we're only getting variable ID/Index from original grap. values will be taken from proxy
+                    std::pair<int, int> varId(outputs->at(e)->id(), outputs->at(e)->index());
+
+                    auto var = variableSpace->getVariable(varId);
+
+                    varSet->push_back(var->clone());
+                }
+
+                delete outputs;
+            }
+
+            return varSet;
+        }
+
+        template <typename T>
+        void AsyncGraphExecutor<T>::worker() {
+            while (true) {
+                Job job;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _condition.wait(lock, [&] { return _stop || !_queue.empty(); });
+
+                    if (_stop)
+                        return;
+
+                    job = _queue.front();
+                    _queue.pop_front();
+                }
+
+                VariablesSet<T>* result;
+                try {
+                    result = execute(job._graph, job._variableSpace);
+                } catch (...) {
+                    result = new VariablesSet<T>(ND4J_STATUS_KERNEL_FAILURE);
+                }
+
+                delete job._variableSpace;
+
+                // from now on graph isn't used by this job, so it can be dropped
+                GraphHolder::getInstance()->releaseGraph<T>(job._graph);
+
+                auto status = result->status();
+                job._future->setResult(result);
+                _completed++;
+
+                if (job._callback != nullptr)
+                    job._callback(reinterpret_cast<Nd4jPointer>(static_cast<ExecutionHandle*>(job._future)), status, job._userData);
+
+                job._future->markDone(status);
+            }
+        }
+
+        template <typename T>
+        GraphFuture<T>* AsyncGraphExecutor<T>::enqueue(Graph<T> *graph, VariableProxy<T> *variableSpace, GraphCallback callback, Nd4jPointer userData) {
+            auto future = new GraphFuture<T>();
+
+            Job job;
+            job._graph = graph;
+            job._variableSpace = variableSpace;
+            job._future = future;
+            job._callback = callback;
+            job._userData = userData;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                // workers are started lazily
+                while ((int) _workers.size() < _numWorkers)
+                    _workers.emplace_back(&AsyncGraphExecutor<T>::worker, this);
+
+                _queue.emplace_back(job);
+                _submitted++;
+            }
+
+            _condition.notify_one();
+
+            return future;
+        }
+
+        template <typename T>
+        GraphFuture<T>* AsyncGraphExecutor<T>::submit(Nd4jIndex graphId, std::vector<int> &indices, std::vector<NDArray<T>*> &inputs, GraphCallback callback, Nd4jPointer userData) {
+            // graph is held till worker is done with it, so unregisterGraph() will wait for queued executions
+            auto graph = GraphHolder::getInstance()->acquireGraph<T>(graphId);
+
+            // staging happens here, on caller thread, while workers might be busy with previous requests
+            auto varSpace = new VariableProxy<T>(graph->getVariableSpace());
+            for (int e = 0; e < (int) inputs.size(); e++)
+                varSpace->putVariable(indices.at(e), inputs.at(e)->dup());
+
+            return enqueue(graph, varSpace, callback, userData);
+        }
+
+        template <typename T>
+        GraphFuture<T>* AsyncGraphExecutor<T>::submit(Nd4jIndex graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int *inputIndices, int numInputs, GraphCallback callback, Nd4jPointer userData) {
+            std::vector<int> indices(inputIndices, inputIndices + numInputs);
+            std::vector<NDArray<T>*> inputs;
+
+            for (int e = 0; e < numInputs; e++)
+                inputs.emplace_back(new NDArray<T>((T *) inputBuffers[e], (int *) inputShapes[e]));
+
+            auto future = submit(graphId, indices, inputs, callback, userData);
+
+            for (auto v: inputs)
+                delete v;
+
+            return future;
+        }
+
+        template <typename T>
+        void AsyncGraphExecutor<T>::setNumberOfWorkers(int numWorkers) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // running workers are never stopped, so this only matters for workers that aren't started yet
+            _numWorkers = numWorkers < 1 ? 1 : numWorkers;
+        }
+
+        template <typename T>
+        int AsyncGraphExecutor<T>::numberOfWorkers() {
+            return _numWorkers;
+        }
+
+        template <typename T>
+        int AsyncGraphExecutor<T>::queueSize() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return (int) _queue.size();
+        }
+
+        template <typename T>
+        Nd4jIndex AsyncGraphExecutor<T>::numberOfSubmitted() {
+            return _submitted.load();
+        }
+
+        template <typename T>
+        Nd4jIndex AsyncGraphExecutor<T>::numberOfCompleted() {
+            return _completed.load();
+        }
+
+        template class ND4J_EXPORT GraphFuture<float>;
+        template class ND4J_EXPORT GraphFuture<float16>;
+        template class ND4J_EXPORT GraphFuture<double>;
+
+        template class ND4J_EXPORT AsyncGraphExecutor<float>;
+        template class ND4J_EXPORT AsyncGraphExecutor<float16>;
+        template class ND4J_EXPORT AsyncGraphExecutor<double>;
+    }
+}
@@ -0,0 +1,471 @@
+#include <graph/execution/GraphBatcher.h>
+#include <graph/GraphHolder.h>
+#include <GraphExecutioner.h>
+#include <helpers/shape.h>
+#include <stdexcept>
+#include <cstring>
+
+namespace nd4j {
+    namespace graph {
+        template <typename T>
+        BatchedResult<T>::BatchedResult(std::shared_ptr<void> batch, Nd4jStatus status) {
+            _batch = batch;
+            _status = status;
+        }
+
+        template <typename T>
+        BatchedResult<T>::~BatchedResult() {
+            // views only, batched arrays are released together with last result of the batch
+            for (auto v: _outputs)
+                delete v;
+        }
+
+        template <typename T>
+        Nd4jStatus BatchedResult<T>::status() {
+            return _status;
+        }
+
+        template <typename T>
+        int BatchedResult<T>::size() {
+            return (int) _outputs.size();
+        }
+
+        template <typename T>
+        NDArray<T>* BatchedResult<T>::at(int index) {
+            return _outputs.at(index);
+        }
+
+        template <typename T>
+        GraphBatcher<T>::Batch::~Batch() {
+            if (_variableSpace != nullptr)
+                delete _variableSpace;
+        }
+
+        template <typename T>
+        GraphBatcher<T>::GraphBatcher(Nd4jIndex graphId, int maxBatchSize, Nd4jIndex maxDelay) {
+            _graphId = graphId;
+            _maxBatchSize = maxBatchSize < 1 ? 1 : maxBatchSize;
+            _maxDelay = maxDelay < 0 ? 0 : maxDelay;
+        }
+
+        template <typename T>
+        bool GraphBatcher<T>::isCompatible(Batch *batch, std::vector<int> &indices, std::vector<NDArray<T> *> &inputs) {
+            if (batch->_indices != indices)
+                return false;
+
+            auto &first = batch->_inputs.at(0);
+            for (int e = 0; e < (int) inputs.size(); e++) {
+                auto x = first.at(e);
+                auto y = inputs.at(e);
+
+                if (x->rankOf() != y->rankOf())
+                    return false;
+
+                // everything but batch dimension must match
+                for (int d = 1; d < x->rankOf(); d++)
+                    if (x->sizeAt(d) != y->sizeAt(d))
+                        return false;
+            }
+
+            return true;
+        }
+
+        template <typename T>
+        void GraphBatcher<T>::executeBatch(Batch *batch) {
+            // graph is held till batch is executed, so concurrent unregisterGraph() waits for us
+            auto holder = GraphHolder::getInstance();
+            auto graph = holder->acquireGraph<T>(_graphId);
+
+            try {
+                executeBatch(graph, batch);
+            } catch (...) {
+                holder->releaseGraph<T>(graph);
+                throw;
+            }
+
+            holder->releaseGraph<T>(graph);
+        }
+
+        template <typename T>
+        void GraphBatcher<T>::executeBatch(Graph<T> *graph, Batch *batch) {
+            int numRequests = (int) batch->_rows.size();
+
+            std::shared_ptr<Batch> first;
+            if (numRequests > 1 && batch->_layout == LAYOUT_UNKNOWN) {
+                // first caller is executed alone as well, so batch dimension of outputs is found by comparing both runs
+                first = separateBatch(batch, 0);
+                runBatch(graph, first.get());
+
+                if (first->_status != ND4J_STATUS_OK) {
+                    batch->_status = first->_status;
+                    return;
+                }
+            }
+
+            runBatch(graph, batch);
+            if (numRequests < 2 || batch->_status != ND4J_STATUS_OK)
+                return;
+
+            if (batch->_layout == LAYOUT_UNKNOWN) {
+                std::vector<bool> batched;
+                bool splittable = learnLayout(first.get(), batch, batched);
+
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_layout == LAYOUT_UNKNOWN) {
+                        _layout = splittable ? LAYOUT_SPLIT : LAYOUT_SEPARATE;
+                        _batchedOutputs = batched;
+                    }
+                }
+
+                if (splittable) {
+                    batch->_batchedOutputs = batched;
+                    return;
+                }
+            } else if (isSplittable(batch)) {
+                return;
+            } else {
+                // outputs don't follow recorded layout anymore
+                std::lock_guard<std::mutex> lock(_mutex);
+                _layout = LAYOUT_SEPARATE;
+            }
+
+            // outputs of this batch can't be split, so every caller is executed on its own
+            for (int e = 0; e < numRequests; e++) {
+                if (e == 0 && first != nullptr) {
+                    batch->_separate.emplace_back(first);
+                    continue;
+                }
+
+                auto separate = separateBatch(batch, e);
+                runBatch(graph, separate.get());
+                batch->_separate.emplace_back(separate);
+            }
+        }
+
+        template <typename T>
+        std::shared_ptr<typename GraphBatcher<T>::Batch> GraphBatcher<T>::separateBatch(Batch *batch, int position) {
+            auto separate = std::make_shared<Batch>();
+            separate->_indices = batch->_indices;
+            separate->_inputs.emplace_back(batch->_inputs.at(position));
+            separate->_rows.emplace_back(batch->_rows.at(position));
+            separate->_totalRows = batch->_rows.at(position);
+            separate->_closed = true;
+            separate->_opened = batch->_opened;
+
+            return separate;
+        }
+
+        template <typename T>
+        bool GraphBatcher<T>::learnLayout(Batch *first, Batch *second, std::vector<bool> &batched) {
+            batched.clear();
+            if (first->_outputs.size() != second->_outputs.size() || first->_totalRows == second->_totalRows)
+                return false;
+
+            for (int e = 0; e < (int) first->_outputs.size(); e++) {
+                auto x = first->_outputs.at(e);
+                auto y = second->_outputs.at(e);
+
+                if (x == nullptr || y == nullptr) {
+                    if (x != y)
+                        return false;
+
+                    batched.emplace_back(false);
+                } else if (x->rankOf() > 0 && y->rankOf() == x->rankOf() && x->sizeAt(0) == first->_totalRows && y->sizeAt(0) == second->_totalRows) {
+                    batched.emplace_back(true);
+                } else if (x->isSameShape(y)) {
+                    batched.emplace_back(false);
+                } else
+                    return false;
+            }
+
+            return true;
+        }
+
+        template <typename T>
+        bool GraphBatcher<T>::isSplittable(Batch *batch) {
+            if (batch->_batchedOutputs.size() != batch->_outputs.size())
+                return false;
+
+            for (int e = 0; e < (int) batch->_outputs.size(); e++) {
+                if (!batch->_batchedOutputs.at(e))
+                    continue;
+
+                auto output = batch->_outputs.at(e);
+                if (output == nullptr || output->rankOf() < 1 || output->sizeAt(0) != batch->_totalRows)
+                    return false;
+            }
+
+            return true;
+        }
+
+        template <typename T>
+        void GraphBatcher<T>::runBatch(Graph<T> *graph, Batch *batch) {
+            batch->_variableSpace = new VariableProxy<T>(graph->getVariableSpace());
+
+            for (int e = 0; e < (int) batch->_indices.size(); e++) {
+                auto first = batch->_inputs.at(0).at(e);
+
+                std::vector<int> shape(first->shapeOf(), first->shapeOf() + first->rankOf());
+                shape[0] = batch->_totalRows;
+
+                // proxy takes ownership of batched input
+                auto batched = new NDArray<T>('c', shape);
+
+                Nd4jIndex offset = 0L;
+                for (auto &request: batch->_inputs) {
+                    auto input = request.at(e);
+
+                    if (input->ordering() == 'c' && input->ews() == 1) {
+                        memcpy(batched->getBuffer() + offset, input->getBuffer(), input->lengthOf() * sizeof(T));
+                    } else {
+                        std::vector<int> rowShape(input->shapeOf(), input->shapeOf() + input->rankOf());
+                        NDArray<T> view(batched->getBuffer() + offset, shape::shapeBuffer(input->rankOf(), rowShape.data()));
+                        view.triggerAllocationFlag(false, true);
+                        view.assign(input);
+                    }
+
+                    offset += input->lengthOf();
+                }
+
+                batch->_variableSpace->putVariable(batch->_indices.at(e), batched);
+            }
+
+            batch->_status = GraphExecutioner<T>::execute(graph, batch->_variableSpace);
+            if (batch->_status != ND4J_STATUS_OK)
+                return;
+
+            auto outputs = graph->fetchOutputs();
+            for (auto v: *outputs) {
+                std::pair<int, int> pair(v->id(), v->index());
+                auto var = batch->_variableSpace->getVariable(pair);
+
+                batch->_outputs.emplace_back(var == nullptr ? nullptr : var->getNDArray());
+            }
+
+            delete outputs;
+        }
+
+        template <typename T>
+        BatchedResult<T>* GraphBatcher<T>::extractResult(std::shared_ptr<Batch> batch, int position) {
+            if (!batch->_separate.empty())
+                return extractResult(batch->_separate.at(position), 0);
+
+            auto result = new BatchedResult<T>(batch, batch->_status);
+            if (batch->_status != ND4J_STATUS_OK)
+                return result;
+
+            int rowStart = 0;
+            for (int e = 0; e < position; e++)
+                rowStart += batch->_rows.at(e);
+
+            int rows = batch->_rows.at(position);
+
+            for (int o = 0; o < (int) batch->_outputs.size(); o++) {
+                auto output = batch->_outputs.at(o);
+                if (output == nullptr) {
+                    result->_outputs.emplace_back(nullptr);
+                    continue;
+                }
+
+                // single caller gets whole outputs
+                bool batched = batch->_rows.size() > 1 && o < (int) batch->_batchedOutputs.size() && batch->_batchedOutputs.at(o);
+
+                NDArray<T>* view;
+                if (batched && output->ordering() == 'c' && output->ews() == 1) {
+                    std::vector<int> shape(output->shapeOf(), output->shapeOf() + output->rankOf());
+                    shape[0] = rows;
+
+                    Nd4jIndex rowLength = output->lengthOf() / batch->_totalRows;
+
+                    view = new NDArray<T>(output->getBuffer() + rowStart * rowLength, shape::shapeBuffer(output->rankOf(), shape.data()));
+                    view->triggerAllocationFlag(false, true);
+                } else if (batched) {
+                    // any other layout: strided view of this caller's rows, the same way subarray() builds it
+                    int rank = output->rankOf();
+                    int *shapeInfo = new int[shape::shapeInfoLength(rank)];
+                    memcpy(shapeInfo, output->getShapeInfo(), shape::shapeInfoByteLength(rank));
+                    shape::shapeOf(shapeInfo)[0] = rows;
+                    shapeInfo[shape::shapeInfoLength(rank) - 2] = -1;
+
+                    view = new NDArray<T>(output->getBuffer() + rowStart * output->stridesOf()[0], shapeInfo);
+                    view->triggerAllocationFlag(false, true);
+                } else {
+                    // there's no batch dimension in this output, so all callers get the same array
+                    view = new NDArray<T>(output->getBuffer(), output->getShapeInfo());
+                }
+
+                result->_outputs.emplace_back(view);
+            }
+
+            return result;
+        }
+
+        template <typename T>
+        BatchedResult<T>* GraphBatcher<T>::execute(std::vector<int> &indices, std::vector<NDArray<T> *> &inputs) {
+            if (inputs.empty() || inputs.size() != indices.size())
+                throw std::runtime_error("Number of inputs should match number of indices");
+
+            int rows = inputs.at(0)->rankOf() > 0 ? inputs.at(0)->sizeAt(0) : 0;
+            for (auto input: inputs)
+                if (input->rankOf() < 1 || input->sizeAt(0) != rows)
+                    throw std::runtime_error("All inputs should have the same size along dimension 0");
+
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            // current batch can't take this request, so it's launched right away
+            if (_open != nullptr && (_open->_totalRows + rows > _maxBatchSize || !isCompatible(_open.get(), indices, inputs))) {
+                _open->_closed = true;
+                _open.reset();
+                _condition.notify_all();
+            }
+
+            bool leader = false;
+            if (_open == nullptr) {
+                _open = std::make_shared<Batch>();
+                _open->_indices = indices;
+                _open->_opened = std::chrono::system_clock::now();
+                _open->_layout = _layout;
+                _open->_batchedOutputs = _batchedOutputs;
+                leader = true;
+            }
+
+            auto batch = _open;
+            int position = (int) batch->_inputs.size();
+            batch->_inputs.emplace_back(inputs);
+            batch->_rows.emplace_back(rows);
+            batch->_totalRows += rows;
+
+            if (batch->_totalRows >= _maxBatchSize || batch->_layout == LAYOUT_SEPARATE) {
+                batch->_closed = true;
+                _open.reset();
+                _condition.notify_all();
+            }
+
+            if (leader) {
+                auto deadline = batch->_opened + std::chrono::microseconds(_maxDelay);
+                _condition.wait_until(lock, deadline, [&] { return batch->_closed; });
+
+                // nobody can join this batch from now on
+                batch->_closed = true;
+                if (_open == batch)
+                    _open.reset();
+
+                lock.unlock();
+
+                auto timeStart = std::chrono::system_clock::now();
+
+                try {
+                    executeBatch(batch.get());
+                } catch (...) {
+                    nd4j_printf("Batch execution failed for graph [%lld]\n", _graphId);
+                    batch->_status = ND4J_STATUS_BAD_GRAPH;
+                }
+
+                auto timeEnd = std::chrono::system_clock::now();
+
+                lock.lock();
+
+                BatchStats stats;
+                stats._requests = (int) batch->_rows.size();
+                stats._rows = batch->_totalRows;
+                stats._occupancy = (double) batch->_totalRows / (double) _maxBatchSize;
+                stats._queueTime = std::chrono::duration_cast<std::chrono::microseconds>(timeStart - batch->_opened).count();
+                stats._executionTime = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count();
+
+                _numberOfBatches++;
+                _numberOfRequests += stats._requests;
+                _totalOccupancy += stats._occupancy;
+                _totalExecutionTime += stats._executionTime;
+
+                _history.emplace_back(stats);
+                if ((int) _history.size() > _historyLimit)
+                    _history.pop_front();
+
+                batch->_done = true;
+                _condition.notify_all();
+            } else {
+                _condition.wait(lock, [&] { return batch->_done; });
+            }
+
+            lock.unlock();
+
+            return extractResult(batch, position);
+        }
+
+        template <typename T>
+        int GraphBatcher<T>::maxBatchSize() {
+            return _maxBatchSize;
+        }
+
+        template <typename T>
+        Nd4jIndex GraphBatcher<T>::maxDelay() {
+            return _maxDelay;
+        }
+
+        template <typename T>
+        void GraphBatcher<T>::setMaxBatchSize(int maxBatchSize) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _maxBatchSize = maxBatchSize < 1 ? 1 : maxBatchSize;
+        }
+
+        template <typename T>
+        void GraphBatcher<T>::setMaxDelay(Nd4jIndex maxDelay) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _maxDelay = maxDelay < 0 ? 0 : maxDelay;
+        }
+
+        template <typename T>
+        Nd4jIndex GraphBatcher<T>::numberOfBatches() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _numberOfBatches;
+        }
+
+        template <typename T>
+        Nd4jIndex GraphBatcher<T>::numberOfRequests() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _numberOfRequests;
+        }
+
+        template <typename T>
+        double GraphBatcher<T>::averageOccupancy() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _numberOfBatches == 0 ? 0.0 : _totalOccupancy / (double) _numberOfBatches;
+        }
+
+        template <typename T>
+        double GraphBatcher<T>::averageBatchSize() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _numberOfBatches == 0 ? 0.0 : (double) _numberOfRequests / (double) _numberOfBatches;
+        }
+
+        template <typename T>
+        Nd4jIndex GraphBatcher<T>::averageExecutionTime() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _numberOfBatches == 0 ? 0L : _totalExecutionTime / _numberOfBatches;
+        }
+
+        template <typename T>
+        std::vector<BatchStats> GraphBatcher<T>::history() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return std::vector<BatchStats>(_history.begin(), _history.end());
+        }
+
+        template <typename T>
+        void GraphBatcher<T>::printStats() {
+            auto batches = numberOfBatches();
+            auto requests = numberOfRequests();
+
+            nd4j_printf("Graph [%lld]: batches: %lld; requests: %lld; avg requests per batch: %f; avg occupancy: %f; avg execution time: %lld us\n",
+                        _graphId, batches, requests, averageBatchSize(), averageOccupancy(), averageExecutionTime());
+        }
+
+        template class ND4J_EXPORT BatchedResult<float>;
+        template class ND4J_EXPORT BatchedResult<float16>;
+        template class ND4J_EXPORT BatchedResult<double>;
+
+        template class ND4J_EXPORT GraphBatcher<float>;
+        template class ND4J_EXPORT GraphBatcher<float16>;
+        template class ND4J_EXPORT GraphBatcher<double>;
+    }
+}
@@ -0,0 +1,178 @@
+#include <graph/execution/GraphFuser.h>
+#include <graph/Context.h>
+#include <GraphExecutioner.h>
+#include <loops/grid_fused.h>
+
+namespace nd4j {
+    namespace graph {
+        template <typename T>
+        GraphFuser<T>::GraphFuser(Graph<T> *graph) {
+            // number of times each node output is used as input anywhere in the graph
+            std::map<int, int> uses;
+            for (auto layer: *graph->getOnion())
+                for (auto node: *layer.second)
+                    for (auto &in: *node->input())
+                        uses[in.first]++;
+
+            auto outputIds = graph->getOutputIds();
+            std::set<int> outputs(outputIds->begin(), outputIds->end());
+
+            // chains under construction, keyed by their current last node
+            std::map<int, std::vector<Node<T>*>> open;
+
+            // onion is ordered by layer, so producer is always visited before its consumer
+            for (auto layer: *graph->getOnion()) {
+                for (auto node: *layer.second) {
+                    if (!isFusable(node))
+                        continue;
+
+                    auto in = node->input()->at(0);
+                    int producer = in.first;
+
+                    // only chain tail is materialized, so intermediate nodes can't be visible outside of graph
+                    if (in.second == 0 && open.count(producer) > 0 && uses[producer] == 1 && outputs.count(producer) == 0 && !open[producer].back()->hasExternalOutputs()) {
+                        auto chain = open[producer];
+                        chain.emplace_back(node);
+
+                        open.erase(producer);
+                        open[node->id()] = chain;
+                    } else {
+                        open[node->id()] = std::vector<Node<T>*>({node});
+                    }
+                }
+            }
+
+            for (auto &v: open) {
+                if (v.second.size() < 2)
+                    continue;
+
+                for (int e = 0; e < (int) v.second.size() - 1; e++)
+                    _deferred.insert(v.second.at(e)->id());
+
+                _chains[v.first] = v.second;
+            }
+        }
+
+        template <typename T>
+        bool GraphFuser<T>::isFusable(Node<T> *node) {
+            if (!node->hasCustomOp() || node->hasGraphEmbedded() || node->isDivergencePoint())
+                return false;
+
+            if (node->getContextPrototype()->isInplace())
+                return false;
+
+            switch (node->opType()) {
+                case OpType_TRANSFORM:
+                    return node->input()->size() == 1 && functions::grid::GRIDFused<T>::isFusable(FUSED_OP_TRANSFORM, node->opNum());
+                case OpType_SCALAR:
+                    // scalar passed as second input can't be fused
+                    return node->input()->size() == 1;
+                case OpType_PAIRWISE:
+                    return node->input()->size() == 2;
+                default:
+                    return false;
+            }
+        }
+
+        template <typename T>
+        bool GraphFuser<T>::isDeferred(int nodeId) {
+            return _deferred.count(nodeId) > 0;
+        }
+
+        template <typename T>
+        bool GraphFuser<T>::isChainTail(int nodeId) {
+            return _chains.count(nodeId) > 0;
+        }
+
+        template <typename T>
+        int GraphFuser<T>::numberOfChains() {
+            return (int) _chains.size();
+        }
+
+        template <typename T>
+        Nd4jStatus GraphFuser<T>::executeSequential(Graph<T> *graph, std::vector<Node<T>*> &chain, VariableSpace<T> *variableSpace) {
+            for (auto node: chain) {
+                auto status = GraphExecutioner<T>::executeFlatNode(graph, node, variableSpace);
+                if (status != ND4J_STATUS_OK)
+                    return status;
+            }
+
+            return ND4J_STATUS_OK;
+        }
+
+        template <typename T>
+        Nd4jStatus GraphFuser<T>::executeChain(Graph<T> *graph, int nodeId, VariableSpace<T> *variableSpace) {
+            auto &chain = _chains.at(nodeId);
+            int numOps = (int) chain.size();
+
+            Context<T> headContext(chain.front()->getContextPrototype(), variableSpace);
+            auto x = headContext.variable(0)->getNDArray();
+            if (x == nullptr)
+                return ND4J_STATUS_BAD_INPUT;
+
+            std::vector<int> opTypes(numOps);
+            std::vector<int> opNums(numOps);
+            std::vector<T*> operands(numOps, nullptr);
+            std::vector<int*> operandShapes(numOps, nullptr);
+            std::vector<T> scalars(numOps, (T) 0.0f);
+            std::vector<T*> extraParams(numOps, nullptr);
+
+            for (int e = 0; e < numOps; e++) {
+                auto node = chain.at(e);
+                auto tArgs = node->getContextPrototype()->getTArguments();
+
+                opNums[e] = node->opNum();
+                extraParams[e] = tArgs->data();
+
+                if (node->opType() == OpType_TRANSFORM) {
+                    opTypes[e] = FUSED_OP_TRANSFORM;
+                } else if (node->opType() == OpType_SCALAR) {
+                    opTypes[e] = FUSED_OP_SCALAR;
+
+                    // the same scalar source as LegacyScalarOp uses
+                    if (tArgs->size() > 0) {
+                        scalars[e] = tArgs->at(0);
+                        extraParams[e] = tArgs->data() + 1;
+                    } else
+                        scalars[e] = node->scalar();
+                } else {
+                    opTypes[e] = FUSED_OP_PAIRWISE;
+
+                    Context<T> context(node->getContextPrototype(), variableSpace);
+                    auto y = context.variable(1)->getNDArray();
+
+                    // broadcastable operands are left for legacy op
+                    if (y == nullptr || y->lengthOf() != x->lengthOf())
+                        return executeSequential(graph, chain, variableSpace);
+
+                    operands[e] = y->getBuffer();
+                    operandShapes[e] = y->getShapeInfo();
+                }
+            }
+
+            Context<T> tailContext(chain.back()->getContextPrototype(), variableSpace);
+
+            NDArray<T>* z;
+            if (!tailContext.isValueAvailable(0)) {
+                z = new NDArray<T>(x->getShapeInfo(), true, tailContext.getWorkspace());
+
+                std::pair<int, int> pair(nodeId, 0);
+                tailContext.pushNDArrayToVariableSpace(pair, z);
+            } else {
+                z = tailContext.variable(nodeId, 0)->getNDArray();
+                if (z->lengthOf() != x->lengthOf())
+                    return executeSequential(graph, chain, variableSpace);
+            }
+
+            nd4j_debug("Executing fused chain of %i nodes, ending at node_%i\n", numOps, nodeId);
+
+            functions::grid::GRIDFused<T>::execShaped(numOps, opTypes.data(), opNums.data(), x->getBuffer(), x->getShapeInfo(), operands.data(), operandShapes.data(), z->getBuffer(), z->getShapeInfo(), scalars.data(), extraParams.data());
+
+            return ND4J_STATUS_OK;
+        }
+
+        template class ND4J_EXPORT GraphFuser<float>;
+        template class ND4J_EXPORT GraphFuser<float16>;
+        template class ND4J_EXPORT GraphFuser<double>;
+    }
+}
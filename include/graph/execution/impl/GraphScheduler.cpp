@@ -0,0 +1,291 @@
+#include <graph/execution/GraphScheduler.h>
+#include <graph/execution/GraphWorkers.h>
+#include <GraphExecutioner.h>
+#include <chrono>
+#include <set>
+#include <memory>
+#include <omp.h>
+
+namespace nd4j {
+    namespace graph {
+        template <typename T>
+        GraphScheduler<T>::GraphScheduler(Graph<T> *graph, VariableSpace<T> *variableSpace, int numWorkers, GraphFuser<T>* fuser) {
+            _graph = graph;
+            _variableSpace = variableSpace;
+            _flowPath = variableSpace->flowPath();
+            _fuser = fuser;
+            _numWorkers = numWorkers < 1 ? 1 : numWorkers;
+
+            _remaining.store(0);
+            _queued.store(0);
+            _status.store(ND4J_STATUS_OK);
+
+            for (int e = 0; e < _numWorkers; e++)
+                _queues.emplace_back(new WorkerQueue());
+        }
+
+        template <typename T>
+        GraphScheduler<T>::~GraphScheduler() {
+            for (auto q: _queues)
+                delete q;
+
+            for (auto p: _pending)
+                delete p.second;
+        }
+
+        template <typename T>
+        bool GraphScheduler<T>::isApplicable(Graph<T> *graph) {
+            for (auto layer: *graph->getOnion())
+                for (auto node: *layer.second)
+                    if (node->opType() == OpType_LOGIC)
+                        return false;
+
+            return true;
+        }
+
+        template <typename T>
+        int GraphScheduler<T>::maxLayerWidth(Graph<T> *graph) {
+            int width = 0;
+            for (auto layer: *graph->getOnion())
+                width = nd4j::math::nd4j_max<int>(width, (int) layer.second->size());
+
+            return width;
+        }
+
+        template <typename T>
+        void GraphScheduler<T>::buildDependencies() {
+            for (auto layer: *_graph->getOnion())
+                for (auto node: *layer.second)
+                    _pending[node->id()] = new std::atomic<int>(0);
+
+            for (auto layer: *_graph->getOnion()) {
+                for (auto node: *layer.second) {
+                    // the same node might be used as input more then once
+                    std::set<int> dependencies;
+                    for (auto &inputId: *node->input()) {
+                        // external variables are available from the very beginning
+                        if (inputId.first < 0 || _pending.count(inputId.first) == 0 || _variableSpace->hasExternalVariable(inputId.first))
+                            continue;
+
+                        dependencies.insert(inputId.first);
+                    }
+
+                    for (auto d: dependencies)
+                        _successors[d].emplace_back(node);
+
+                    _pending[node->id()]->store((int) dependencies.size());
+                    _remaining++;
+                }
+            }
+        }
+
+        template <typename T>
+        void GraphScheduler<T>::enqueue(int worker, Node<T> *node) {
+            {
+                std::lock_guard<std::mutex> lock(_queues[worker]->_mutex);
+                _queues[worker]->_nodes.push_back(node);
+            }
+
+            _queued++;
+
+            // taking idle lock here prevents lost wakeup between predicate check & wait
+            {
+                std::lock_guard<std::mutex> lock(_mutexIdle);
+            }
+            _idle.notify_one();
+        }
+
+        template <typename T>
+        Node<T>* GraphScheduler<T>::dequeue(int worker) {
+            // own queue first, LIFO for better cache locality
+            {
+                auto queue = _queues[worker];
+                std::lock_guard<std::mutex> lock(queue->_mutex);
+                if (!queue->_nodes.empty()) {
+                    auto node = queue->_nodes.back();
+                    queue->_nodes.pop_back();
+                    _queued--;
+                    return node;
+                }
+            }
+
+            // stealing from others, FIFO
+            for (int e = 1; e < _numWorkers; e++) {
+                auto queue = _queues[(worker + e) % _numWorkers];
+                std::lock_guard<std::mutex> lock(queue->_mutex);
+                if (!queue->_nodes.empty()) {
+                    auto node = queue->_nodes.front();
+                    queue->_nodes.pop_front();
+                    _queued--;
+                    return node;
+                }
+            }
+
+            return nullptr;
+        }
+
+        template <typename T>
+        bool GraphScheduler<T>::shouldSkip(Node<T> *node) {
+            bool skip = false;
+            for (auto &inputId: *node->input()) {
+                // we're skipping external variables here
+                if (inputId.first < 0 || _variableSpace->hasExternalVariable(inputId.first))
+                    continue;
+
+                /**
+                 * We can skip current node, in two cases:
+                 * 1) If previous node was disabled
+                 * 2) If previous node was divergent node (i.e. IF op) and code went other way
+                 */
+                Node<T>* prevNode = _graph->getMapped()->at(inputId.first);
+                if (!_flowPath->isActive(inputId.first)) {
+                    skip = true;
+                    _flowPath->markActive(node->id(), false);
+                } else if (prevNode->isDivergencePoint()) {
+                    if (_flowPath->branch(inputId.first) != inputId.second) {
+                        skip = true;
+                        _flowPath->markActive(node->id(), false);
+                    }
+                }
+            }
+
+            return skip;
+        }
+
+        template <typename T>
+        void GraphScheduler<T>::processNode(int worker, Node<T> *node) {
+            // deferred node is executed later, as part of its chain, so it's only released here
+            bool deferred = _fuser != nullptr && _fuser->isDeferred(node->id());
+
+            if (!deferred && !shouldSkip(node)) {
+                auto timeStart = std::chrono::system_clock::now();
+
+                Nd4jStatus status;
+                try {
+                    status = _fuser != nullptr && _fuser->isChainTail(node->id()) ? _fuser->executeChain(_graph, node->id(), _variableSpace) : GraphExecutioner<T>::executeFlatNode(_graph, node, _variableSpace);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_mutexError);
+                    if (!_error)
+                        _error = std::current_exception();
+
+                    status = ND4J_STATUS_KERNEL_FAILURE;
+                }
+
+                auto timeEnd = std::chrono::system_clock::now();
+                auto outerTime = std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count();
+                _flowPath->setOuterTime(node->id(), outerTime);
+
+                if (status != ND4J_STATUS_OK) {
+                    _status.store(status);
+
+                    {
+                        std::lock_guard<std::mutex> lock(_mutexIdle);
+                    }
+                    _idle.notify_all();
+                    return;
+                }
+            }
+
+            // skipped nodes are released as well, so their consumers will be disabled too
+            if (_successors.count(node->id()) > 0) {
+                for (auto successor: _successors.at(node->id()))
+                    if (--(*_pending.at(successor->id())) == 0)
+                        enqueue(worker, successor);
+            }
+
+            if (--_remaining == 0) {
+                {
+                    std::lock_guard<std::mutex> lock(_mutexIdle);
+                }
+                _idle.notify_all();
+            }
+        }
+
+        template <typename T>
+        void GraphScheduler<T>::workerLoop(int worker, int ompThreads) {
+            // each worker gets its share of cores for ops' own OpenMP loops
+            omp_set_num_threads(ompThreads);
+
+            while (_status.load() == ND4J_STATUS_OK && _remaining.load() > 0) {
+                auto node = dequeue(worker);
+                if (node == nullptr) {
+                    std::unique_lock<std::mutex> lock(_mutexIdle);
+                    _idle.wait(lock, [&] { return _queued.load() > 0 || _remaining.load() == 0 || _status.load() != ND4J_STATUS_OK; });
+                    continue;
+                }
+
+                processNode(worker, node);
+            }
+        }
+
+        template <typename T>
+        Nd4jStatus GraphScheduler<T>::execute() {
+            buildDependencies();
+
+            if (_remaining.load() == 0)
+                return ND4J_STATUS_OK;
+
+            // root nodes are spread over workers round-robin
+            int cnt = 0;
+            for (auto layer: *_graph->getOnion())
+                for (auto node: *layer.second)
+                    if (_pending.at(node->id())->load() == 0)
+                        enqueue(cnt++ % _numWorkers, node);
+
+            int callerThreads = omp_get_max_threads();
+            int ompThreads = nd4j::math::nd4j_max<int>(1, callerThreads / _numWorkers);
+
+            // pool tasks that weren't started before calling thread finished are revoked, so they never touch this scheduler
+            struct Session {
+                std::mutex mutex;
+                std::condition_variable condition;
+                bool closed = false;
+                int active = 0;
+            };
+            auto session = std::make_shared<Session>();
+
+            auto pool = GraphWorkers::getInstance();
+            pool->ensureThreads(_numWorkers - 1);
+
+            for (int e = 1; e < _numWorkers; e++) {
+                pool->submit([this, session, e, ompThreads] {
+                    {
+                        std::lock_guard<std::mutex> lock(session->mutex);
+                        if (session->closed)
+                            return;
+
+                        session->active++;
+                    }
+
+                    workerLoop(e, ompThreads);
+
+                    {
+                        std::lock_guard<std::mutex> lock(session->mutex);
+                        session->active--;
+                    }
+                    session->condition.notify_all();
+                });
+            }
+
+            // calling thread is worker 0
+            workerLoop(0, ompThreads);
+
+            {
+                std::unique_lock<std::mutex> lock(session->mutex);
+                session->closed = true;
+                session->condition.wait(lock, [&] { return session->active == 0; });
+            }
+
+            omp_set_num_threads(callerThreads);
+
+            if (_error)
+                std::rethrow_exception(_error);
+
+            return _status.load();
+        }
+
+        template class ND4J_EXPORT GraphScheduler<float>;
+        template class ND4J_EXPORT GraphScheduler<float16>;
+        template class ND4J_EXPORT GraphScheduler<double>;
+    }
+}
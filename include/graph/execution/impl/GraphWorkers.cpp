@@ -0,0 +1,59 @@
+#include <graph/execution/GraphWorkers.h>
+
+namespace nd4j {
+    namespace graph {
+        GraphWorkers* GraphWorkers::getInstance() {
+            static GraphWorkers instance;
+            return &instance;
+        }
+
+        GraphWorkers::~GraphWorkers() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _condition.notify_all();
+
+            for (auto &t: _threads)
+                t.join();
+        }
+
+        void GraphWorkers::loop() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _condition.wait(lock, [&] { return _stop || !_tasks.empty(); });
+
+                    if (_stop)
+                        return;
+
+                    task = std::move(_tasks.front());
+                    _tasks.pop_front();
+                }
+
+                task();
+            }
+        }
+
+        void GraphWorkers::ensureThreads(int numThreads) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            while ((int) _threads.size() < numThreads)
+                _threads.emplace_back(&GraphWorkers::loop, this);
+        }
+
+        void GraphWorkers::submit(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _tasks.emplace_back(std::move(task));
+            }
+
+            _condition.notify_one();
+        }
+
+        int GraphWorkers::numberOfThreads() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return (int) _threads.size();
+        }
+    }
+}
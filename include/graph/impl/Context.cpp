@@ -76,6 +76,11 @@ namespace nd4j {
                 this->_rng = variableSpace->getRNG();
         }
 
+        template <typename T>
+        VariableSpace<T> *Context<T>::getVariableSpace() {
+            return _variableSpace;
+        }
+
         template <typename T>
         void Context<T>::forgetWorkspace() {
             _workspace = nullptr;
@@ -207,6 +212,8 @@ namespace nd4j {
 
         template <typename T>
         Variable<T>* Context<T>::variable(std::pair<int,int>& p) {
+            _variableReads++;
+
             if (!_variableSpace->hasVariable(p)) {
                 nd4j_printf("Node %i; Non-existent variable requested: [%i:%i]\n", this->_nodeId, p.first, p.second);
                 throw "Bad variable";
@@ -216,6 +223,11 @@ namespace nd4j {
         }
 
 
+        template <typename T>
+        Nd4jIndex Context<T>::variableReads() {
+            return _variableReads;
+        }
+
         template <typename T>
         void Context<T>::pushNDArrayToVariableSpace(int nodeId, int index, NDArray<T> *array, bool removable) {
             std::pair<int,int> pair(nodeId, index);
@@ -6,6 +6,7 @@
 #include <array/DataTypeConversions.h>
 #include <array/DataTypeUtils.h>
 #include <array/ByteOrderUtils.h>
+#include <helpers/BitwiseUtils.h>
 
 
 namespace nd4j {
@@ -32,8 +33,51 @@ namespace nd4j {
         }
 
 
+        template<typename T>
+        bool FlatUtils::isViewable(const nd4j::graph::FlatArray *flatArray) {
+            if (flatArray->shape() == nullptr || flatArray->buffer() == nullptr)
+                return false;
+
+            if (DataTypeUtils::fromFlatDataType(flatArray->dtype()) != DataTypeUtils::fromT<T>())
+                return false;
+
+            bool isBe = BitwiseUtils::isBE();
+            auto order = ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder());
+            if ((isBe && order != nd4j::ByteOrder::BE) || (!isBe && order != nd4j::ByteOrder::LE))
+                return false;
+
+            // byte vectors aren't guaranteed to be aligned for T
+            if (reinterpret_cast<Nd4jIndex>(flatArray->buffer()->data()) % sizeof(T) != 0)
+                return false;
+
+            return flatArray->buffer()->size() >= shape::length((int *) flatArray->shape()->data()) * sizeof(T);
+        }
+
+        template<typename T>
+        NDArray<T> *FlatUtils::viewFlatArray(const nd4j::graph::FlatArray *flatArray) {
+            if (!isViewable<T>(flatArray))
+                return fromFlatArray<T>(flatArray);
+
+            int * newShape = new int[shape::shapeInfoLength((int *)flatArray->shape()->data())];
+            memcpy(newShape, flatArray->shape()->data(), shape::shapeInfoByteLength((int *)flatArray->shape()->data()));
+
+            auto array = new NDArray<T>(reinterpret_cast<T *>(const_cast<int8_t *>(flatArray->buffer()->data())), newShape);
+            array->triggerAllocationFlag(false, true);
+
+            return array;
+        }
+
+
         template NDArray<float> *FlatUtils::fromFlatArray<float>(const nd4j::graph::FlatArray *flatArray);
         template NDArray<float16> *FlatUtils::fromFlatArray<float16>(const nd4j::graph::FlatArray *flatArray);
         template NDArray<double> *FlatUtils::fromFlatArray<double>(const nd4j::graph::FlatArray *flatArray);
+
+        template NDArray<float> *FlatUtils::viewFlatArray<float>(const nd4j::graph::FlatArray *flatArray);
+        template NDArray<float16> *FlatUtils::viewFlatArray<float16>(const nd4j::graph::FlatArray *flatArray);
+        template NDArray<double> *FlatUtils::viewFlatArray<double>(const nd4j::graph::FlatArray *flatArray);
+
+        template bool FlatUtils::isViewable<float>(const nd4j::graph::FlatArray *flatArray);
+        template bool FlatUtils::isViewable<float16>(const nd4j::graph::FlatArray *flatArray);
+        template bool FlatUtils::isViewable<double>(const nd4j::graph::FlatArray *flatArray);
     }
-}
\ No newline at end of file
+}
@@ -15,48 +15,56 @@ namespace nd4j {
         }
 
         void FlowPath::setInnerTime(int nodeId, Nd4jIndex time) {
+            std::lock_guard<std::mutex> lock(_mutex);
             ensureNode(nodeId);
 
             _states[nodeId].setInnerTime(time);
         }
 
         void FlowPath::setOuterTime(int nodeId, Nd4jIndex time) {
+            std::lock_guard<std::mutex> lock(_mutex);
             ensureNode(nodeId);
 
             _states[nodeId].setOuterTime(time);
         }
 
         Nd4jIndex FlowPath::innerTime(int nodeId) {
+            std::lock_guard<std::mutex> lock(_mutex);
             ensureNode(nodeId);
 
             return _states[nodeId].innerTime();
         }
 
         Nd4jIndex FlowPath::outerTime(int nodeId) {
+            std::lock_guard<std::mutex> lock(_mutex);
             ensureNode(nodeId);
 
             return _states[nodeId].outerTime();
         }
 
         bool FlowPath::isActive(int nodeId) {
+            std::lock_guard<std::mutex> lock(_mutex);
             ensureNode(nodeId);
 
             return _states[nodeId].isActive();
         }
             
         void FlowPath::markActive(int nodeId, bool isActive) {
+            std::lock_guard<std::mutex> lock(_mutex);
             ensureNode(nodeId);
 
             _states[nodeId].markActive(isActive);
         }
 
         int FlowPath::branch(int nodeId){
+            std::lock_guard<std::mutex> lock(_mutex);
             ensureNode(nodeId);
 
             return _states[nodeId].branch();
         }
 
         void FlowPath::markBranch(int nodeId, int index) {
+            std::lock_guard<std::mutex> lock(_mutex);
             ensureNode(nodeId);
 
             _states[nodeId].markBranch(index);
@@ -3,9 +3,15 @@
 //
 
 #include <graph/Graph.h>
+#include <graph/MemoryPlanner.h>
 #include <helpers/EnumUtils.h>
 #include <graph/FlatUtils.h>
 #include <NativeOps.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#else
+#include <helpers/mman.h>
+#endif
 
 namespace nd4j {
     namespace graph {
@@ -222,6 +228,11 @@ namespace nd4j {
             return res;
         }
 
+        template <typename T>
+        std::vector<int> * Graph<T>::getOutputIds() {
+            return &_output;
+        }
+
         template <typename T>
         std::map<int, Node<T> *> * Graph<T>::getMapped() {
             return _mapped;
@@ -277,10 +288,53 @@ namespace nd4j {
             delete _onion;
             delete _configuration;
 
+            // views of the arena were referenced by variables only
+            if (_planner != nullptr)
+                delete _planner;
+
+            // variables are gone at this point, so views into mapped file are gone too
+            if (_mappedBuffer != nullptr)
+                munmap(_mappedBuffer, (size_t) _mappedLength);
 
             // delete _onion content here
         }
 
+        template <typename T>
+        MemoryPlanner<T>* Graph<T>::getMemoryPlanner() {
+            std::lock_guard<std::mutex> lock(_mutexPlanning);
+
+            if (_planner == nullptr) {
+                _planner = new MemoryPlanner<T>(this);
+                _planned = _planner->plan() == ND4J_STATUS_OK;
+            } else if (_planned && !_planner->isActual()) {
+                _planned = _planner->plan() == ND4J_STATUS_OK;
+            }
+
+            return _planned ? _planner : nullptr;
+        }
+
+        template <typename T>
+        bool Graph<T>::ownsMemoryPlanner(MemoryPlanner<T>* planner) {
+            std::lock_guard<std::mutex> lock(_mutexPlanning);
+            return planner != nullptr && planner == _planner;
+        }
+
+        template <typename T>
+        void Graph<T>::adoptMapping(void *buffer, Nd4jIndex length) {
+            _mappedBuffer = buffer;
+            _mappedLength = length;
+        }
+
+        template <typename T>
+        void *Graph<T>::mappedBuffer() {
+            return _mappedBuffer;
+        }
+
+        template <typename T>
+        Nd4jIndex Graph<T>::mappedLength() {
+            return _mappedLength;
+        }
+
         template <typename T>
         void Graph<T>::addNode(Node<T> *node) {
             _built.store(false);
@@ -498,6 +552,11 @@ namespace nd4j {
             if (_built.load())
                 return ND4J_STATUS_OK;
 
+            // the same graph might be executed from multiple threads at once, so only one of them builds it
+            std::lock_guard<std::mutex> lock(_mutexPreprocessing);
+            if (_built.load())
+                return ND4J_STATUS_OK;
+
             int buildCnt = 0;
             int buildLimit = _unmapped.size() * 2;
             while (_unmapped.size() > 0) {
@@ -650,9 +709,6 @@ namespace nd4j {
                 }
             }
 
-            if (_unmapped.size() == 0)
-                _built.store(true);
-
             // if we're dumping everything out there - we'll add external variables as well
             if (_configuration->_outputMode == OutputMode_VARIABLE_SPACE) {
                 auto ext = _variableSpace->getExternalVariables();
@@ -733,11 +789,16 @@ namespace nd4j {
                     }
                 }
             }
+
+            // flag goes last: concurrent callers skip the lock as soon as they see it
+            if (_unmapped.size() == 0)
+                _built.store(true);
+
             return ND4J_STATUS_OK;
         }
 
         template <typename T>
-        Graph<T>::Graph(const FlatGraph *flatGraph) {
+        Graph<T>::Graph(const FlatGraph *flatGraph, bool zeroCopy) {
             this->_onion = new std::map<int, std::vector<Node<T> *> *>();
             this->_mapped = new std::map<int, Node<T> *> ();
             this->_nodes = new std::vector<int>();
@@ -766,7 +827,7 @@ namespace nd4j {
                 for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
                     auto flatVar = flatGraph->variables()->Get(e);
 
-                    auto var = new Variable<T>(flatVar);
+                    auto var = new Variable<T>(flatVar, zeroCopy);
                     std::pair<int, int> pair(flatVar->id()->first(), flatVar->id()->second());
                     _variableSpace->putVariable(pair, var);
 
@@ -836,13 +897,8 @@ namespace nd4j {
 
         template <typename T>
         Nd4jStatus Graph<T>::validate() {
-            if (!_built) {
-                _mutexPreprocessing.lock();
-                if (!_built) {
-                    this->buildGraph();
-                }
-                _mutexPreprocessing.unlock();
-            }
+            if (!_built)
+                this->buildGraph();
 
             if (_built != true)
                 return ND4J_STATUS_BAD_GRAPH;
@@ -16,122 +16,189 @@ namespace nd4j {
 
         template <>
         void GraphHolder::registerGraph(Nd4jIndex graphId, Graph<float>* graph) {
+            // stored graph is built before anyone can pull it: sessions read its VariableSpace without locks
+            graph->buildGraph();
+
+            std::lock_guard<std::mutex> lock(_mutex);
             _graphF[graphId] = graph;
         }
 
         template <>
         void GraphHolder::registerGraph(Nd4jIndex graphId, Graph<float16>* graph) {
+            // stored graph is built before anyone can pull it: sessions read its VariableSpace without locks
+            graph->buildGraph();
+
+            std::lock_guard<std::mutex> lock(_mutex);
             _graphH[graphId] = graph;
         }
 
         template <>
         void GraphHolder::registerGraph(Nd4jIndex graphId, Graph<double>* graph) {
+            // stored graph is built before anyone can pull it: sessions read its VariableSpace without locks
+            graph->buildGraph();
+
+            std::lock_guard<std::mutex> lock(_mutex);
             _graphD[graphId] = graph;
         }
-            
+
         template <>
-        Graph<float>* GraphHolder::cloneGraph(Nd4jIndex graphId) {
-            if (!this->hasGraph<float>(graphId)) {
+        Graph<float>* GraphHolder::pullGraph(Nd4jIndex graphId) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if (_graphF.count(graphId) == 0) {
                 nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", graphId);
                 throw "Bad argument";
             }
 
-            auto graph = _graphF[graphId]->clone();
-
-            return graph;
+            return _graphF.at(graphId);
         }
 
         template <>
-        Graph<float>* GraphHolder::pullGraph(Nd4jIndex graphId) {
-            if (!this->hasGraph<float>(graphId)) {
+        Graph<float16>* GraphHolder::pullGraph(Nd4jIndex graphId) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if (_graphH.count(graphId) == 0) {
                 nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", graphId);
                 throw "Bad argument";
             }
 
-            auto graph = _graphF[graphId];
-
-            return graph;
+            return _graphH.at(graphId);
         }
 
         template <>
-        Graph<float16>* GraphHolder::pullGraph(Nd4jIndex graphId) {
-            if (!this->hasGraph<float16>(graphId)) {
+        Graph<double>* GraphHolder::pullGraph(Nd4jIndex graphId) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if (_graphD.count(graphId) == 0) {
                 nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", graphId);
                 throw "Bad argument";
             }
 
-            auto graph = _graphH[graphId];
+            return _graphD.at(graphId);
+        }
 
-            return graph;
+        template <>
+        Graph<float>* GraphHolder::findGraph(Nd4jIndex graphId) {
+            return _graphF.count(graphId) == 0 ? nullptr : _graphF.at(graphId);
         }
 
         template <>
-        Graph<double>* GraphHolder::pullGraph(Nd4jIndex graphId) {
-            if (!this->hasGraph<double>(graphId)) {
+        Graph<float16>* GraphHolder::findGraph(Nd4jIndex graphId) {
+            return _graphH.count(graphId) == 0 ? nullptr : _graphH.at(graphId);
+        }
+
+        template <>
+        Graph<double>* GraphHolder::findGraph(Nd4jIndex graphId) {
+            return _graphD.count(graphId) == 0 ? nullptr : _graphD.at(graphId);
+        }
+
+        template <typename T>
+        Graph<T>* GraphHolder::acquireGraph(Nd4jIndex graphId) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto graph = findGraph<T>(graphId);
+            if (graph == nullptr) {
                 nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", graphId);
                 throw "Bad argument";
             }
 
-            auto graph = _graphD[graphId];
+            _references[graph]++;
 
             return graph;
         }
 
         template <typename T>
-        void GraphHolder::forgetGraph(Nd4jIndex graphId) {
-            if (sizeof(T) == 4) {
-                if (this->hasGraph<float>(graphId))
-                    _graphF.erase(graphId);
-            } else if (sizeof(T) == 2) {
-                if (this->hasGraph<double>(graphId))
-                    _graphD.erase(graphId);
-            } else if (sizeof(T) == 8) {
-                if (this->hasGraph<float16>(graphId))
-                    _graphH.erase(graphId);
+        void GraphHolder::releaseGraph(Graph<T>* graph) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (--_references[graph] <= 0)
+                    _references.erase(graph);
             }
+
+            _released.notify_all();
+        }
+
+        template <>
+        Graph<float>* GraphHolder::cloneGraph(Nd4jIndex graphId) {
+            auto graph = pullGraph<float>(graphId);
+
+            return graph->clone();
         }
 
         template <typename T>
-        void GraphHolder::dropGraph(Nd4jIndex graphId) {
+        void GraphHolder::forgetGraph(Nd4jIndex graphId) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
             // FIXME: we don't want this sizeof(T) here really. especially once we add multi-dtype support
             if (sizeof(T) == 4) {
-                if (this->hasGraph<float>(graphId)) {
-                    auto g = _graphF[graphId];
-                    forgetGraph<float>(graphId);
-                    delete g;
-                }
+                _graphF.erase(graphId);
             } else if (sizeof(T) == 8) {
-                if (this->hasGraph<double>(graphId)) {
-                    auto g = _graphD[graphId];
-                    forgetGraph<double>(graphId);
-                    delete g;
-                }
+                _graphD.erase(graphId);
             } else if (sizeof(T) == 2) {
-                if (this->hasGraph<float16>(graphId)) {
-                    auto g = _graphH[graphId];
-                    forgetGraph<float16>(graphId);
-                    delete g;
-                }
+                _graphH.erase(graphId);
             }
         }
 
+        template <typename T>
+        void GraphHolder::dropGraph(Nd4jIndex graphId) {
+            if (!this->hasGraph<T>(graphId))
+                return;
+
+            // graph is removed from holder first, so nobody will pull it while it's being released
+            auto g = this->pullGraph<T>(graphId);
+            this->forgetGraph<T>(graphId);
+
+            // executions that acquired graph before that are still running
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _released.wait(lock, [&] { return _references.count(g) == 0; });
+            }
+
+            delete g;
+        }
+
         void GraphHolder::dropGraphAny(Nd4jIndex graphId) {
             this->dropGraph<float>(graphId);
             this->dropGraph<float16>(graphId);
             this->dropGraph<double>(graphId);
         }
 
-        template<typename T>
-        bool GraphHolder::hasGraph(Nd4jIndex graphId) {
+        template <>
+        bool GraphHolder::hasGraph<float>(Nd4jIndex graphId) {
+            std::lock_guard<std::mutex> lock(_mutex);
             return _graphF.count(graphId) > 0;
         }
 
+        template <>
+        bool GraphHolder::hasGraph<float16>(Nd4jIndex graphId) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _graphH.count(graphId) > 0;
+        }
+
+        template <>
+        bool GraphHolder::hasGraph<double>(Nd4jIndex graphId) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _graphD.count(graphId) > 0;
+        }
+
 
-        template bool GraphHolder::hasGraph<float>(Nd4jIndex graphId);
         template void GraphHolder::forgetGraph<float>(Nd4jIndex graphId);
+        template void GraphHolder::forgetGraph<float16>(Nd4jIndex graphId);
+        template void GraphHolder::forgetGraph<double>(Nd4jIndex graphId);
+
+        template Graph<float>* GraphHolder::acquireGraph<float>(Nd4jIndex graphId);
+        template Graph<float16>* GraphHolder::acquireGraph<float16>(Nd4jIndex graphId);
+        template Graph<double>* GraphHolder::acquireGraph<double>(Nd4jIndex graphId);
+
+        template void GraphHolder::releaseGraph<float>(Graph<float>* graph);
+        template void GraphHolder::releaseGraph<float16>(Graph<float16>* graph);
+        template void GraphHolder::releaseGraph<double>(Graph<double>* graph);
+
         template void GraphHolder::dropGraph<float>(Nd4jIndex graphId);
+        template void GraphHolder::dropGraph<float16>(Nd4jIndex graphId);
+        template void GraphHolder::dropGraph<double>(Nd4jIndex graphId);
 
 
         GraphHolder* GraphHolder::_INSTANCE = 0;
     }
-}
\ No newline at end of file
+}
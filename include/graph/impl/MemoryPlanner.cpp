@@ -0,0 +1,298 @@
+#include <graph/MemoryPlanner.h>
+#include <graph/Graph.h>
+#include <graph/Context.h>
+#include <array/ShapeList.h>
+#include <algorithm>
+#include <set>
+
+namespace nd4j {
+    namespace graph {
+        template <typename T>
+        MemoryPlanner<T>::MemoryPlanner(Graph<T> *graph) {
+            _graph = graph;
+        }
+
+        template <typename T>
+        MemoryPlanner<T>::~MemoryPlanner() {
+            release();
+        }
+
+        template <typename T>
+        void MemoryPlanner<T>::release() {
+            for (auto &v: _buffers) {
+                delete v.second._array;
+                delete[] v.second._shapeInfo;
+            }
+
+            _buffers.clear();
+            _inputShapes.clear();
+
+            if (_workspace != nullptr)
+                delete _workspace;
+
+            _workspace = nullptr;
+            _arena = nullptr;
+            _arenaSize = 0L;
+            _totalSize = 0L;
+        }
+
+        template <typename T>
+        bool MemoryPlanner<T>::isActual() {
+            auto variableSpace = _graph->getVariableSpace();
+            for (auto &v: _inputShapes) {
+                std::pair<int, int> pair(v.first);
+                if (!variableSpace->hasVariable(pair))
+                    return false;
+
+                auto array = variableSpace->getVariable(pair)->getNDArray();
+                if (array == nullptr || !shape::equalsSoft(array->getShapeInfo(), const_cast<int *>(v.second.data())))
+                    return false;
+            }
+
+            return true;
+        }
+
+        template <typename T>
+        Nd4jStatus MemoryPlanner<T>::plan() {
+            auto variableSpace = _graph->getVariableSpace();
+
+            // variables still referencing views of previous plan are reset, since these views are gone with it
+            for (auto &v: _buffers) {
+                std::pair<int, int> pair(v.first);
+                if (variableSpace->hasVariable(pair) && variableSpace->getVariable(pair)->getNDArray() == v.second._array)
+                    variableSpace->getVariable(pair)->setNDArray(nullptr);
+            }
+
+            release();
+
+            _graph->buildGraph();
+            auto onion = _graph->getOnion();
+
+            // nodes with LOGIC ops are executed out of onion order, so lifetimes can't be derived from layers
+            for (auto &layer: *onion)
+                for (auto node: *layer.second)
+                    if (node->opType() == OpType_LOGIC) {
+                        nd4j_debug("Graph has LOGIC ops, memory planning is impossible\n", "");
+                        return ND4J_STATUS_BAD_INPUT;
+                    }
+
+            // in-place node writes into its inputs, so its outputs are aliases of input buffers
+            std::map<std::pair<int, int>, std::pair<int, int>> aliases;
+            auto resolve = [&] (std::pair<int, int> pair) -> std::pair<int, int> {
+                while (aliases.count(pair) > 0)
+                    pair = aliases.at(pair);
+
+                return pair;
+            };
+
+            // step 1: shapes inference, in the same order as execution
+            for (auto &layer: *onion) {
+                for (auto node: *layer.second) {
+                    auto block = node->getContextPrototype();
+                    if (block != nullptr && block->isInplace()) {
+                        for (int e = 0; e < (int) node->input()->size(); e++) {
+                            auto &v = node->input()->at(e);
+                            aliases[std::pair<int, int>(node->id(), e)] = resolve(std::pair<int, int>(v.first, v.second));
+                        }
+
+                        continue;
+                    }
+
+                    if (!node->hasCustomOp() || node->hasGraphEmbedded() || block == nullptr)
+                        continue;
+
+                    bool known = true;
+                    std::vector<int*> inputShapes;
+                    for (auto &input: *node->input()) {
+                        auto v = resolve(std::pair<int, int>(input.first, input.second));
+                        if (v.first < 0 || variableSpace->hasExternalVariable(v.first)) {
+                            auto var = variableSpace->getVariable(v);
+                            if (var == nullptr || var->getNDArray() == nullptr) {
+                                known = false;
+                                break;
+                            }
+
+                            inputShapes.push_back(var->getNDArray()->getShapeInfo());
+
+                            auto shapeInfo = var->getNDArray()->getShapeInfo();
+                            _inputShapes[std::pair<int, int>(v.first, v.second)] = std::vector<int>(shapeInfo, shapeInfo + shape::shapeInfoLength(shape::rank(shapeInfo)));
+                        } else {
+                            std::pair<int, int> pair(v.first, v.second);
+                            if (_buffers.count(pair) == 0) {
+                                known = false;
+                                break;
+                            }
+
+                            inputShapes.push_back(_buffers.at(pair)._shapeInfo);
+                        }
+                    }
+
+                    // output shape depends on something we can't infer statically
+                    if (!known)
+                        continue;
+
+                    Context<T> ctx(block, variableSpace);
+                    ShapeList inSha(inputShapes);
+                    auto outSha = node->getCustomOp()->calculateOutputShape(&inSha, ctx);
+
+                    int cnt = 0;
+                    for (auto shape: *outSha->asVector()) {
+                        PlannedBuffer buffer;
+                        buffer._id = std::pair<int, int>(node->id(), cnt++);
+                        buffer._shapeInfo = shape;
+                        buffer._bytes = ((shape::length(shape) * sizeof(T) + PLANNER_ALIGNMENT - 1) / PLANNER_ALIGNMENT) * PLANNER_ALIGNMENT;
+                        buffer._first = layer.first;
+                        buffer._last = layer.first;
+
+                        _buffers[buffer._id] = buffer;
+                    }
+
+                    // shapes are owned by planner from now on
+                    delete outSha;
+                }
+            }
+
+            // step 2: lifetimes. buffer stays alive till the last layer consuming it, or consuming any of its in-place aliases
+            for (auto &layer: *onion) {
+                for (auto node: *layer.second) {
+                    for (auto &v: *node->input()) {
+                        auto pair = resolve(std::pair<int, int>(v.first, v.second));
+                        if (_buffers.count(pair) > 0)
+                            _buffers.at(pair)._last = nd4j::math::nd4j_max<int>(_buffers.at(pair)._last, layer.first);
+                    }
+                }
+            }
+
+            // graph outputs & dangling outputs must survive till the end of execution
+            int lastLayer = onion->empty() ? 0 : onion->rbegin()->first;
+            std::map<int, bool> consumed;
+            for (auto &layer: *onion)
+                for (auto node: *layer.second)
+                    for (auto &v: *node->input())
+                        consumed[v.first] = true;
+
+            auto outputIds = _graph->getOutputIds();
+            std::set<int> outputs(outputIds->begin(), outputIds->end());
+
+            for (auto &v: _buffers) {
+                if (consumed.count(v.first.first) == 0 || outputs.count(v.first.first) > 0)
+                    v.second._last = lastLayer + 1;
+            }
+
+            for (auto &v: aliases) {
+                auto pair = resolve(v.first);
+                if (_buffers.count(pair) > 0 && (consumed.count(v.first.first) == 0 || outputs.count(v.first.first) > 0))
+                    _buffers.at(pair)._last = lastLayer + 1;
+            }
+
+            // step 3: offsets
+            assignOffsets();
+
+            _workspace = new nd4j::memory::Workspace(_arenaSize);
+            _arena = _arenaSize > 0 ? reinterpret_cast<T *>(_workspace->allocateBytes(_arenaSize)) : nullptr;
+
+            for (auto &v: _buffers)
+                v.second._array = new NDArray<T>(buffer(v.second._id), v.second._shapeInfo);
+
+            nd4j_debug("Memory plan: %i buffers; arena size: [%lld] bytes; unplanned size: [%lld] bytes\n", (int) _buffers.size(), _arenaSize, _totalSize);
+
+            return ND4J_STATUS_OK;
+        }
+
+        template <typename T>
+        void MemoryPlanner<T>::assignOffsets() {
+            _arenaSize = 0L;
+            _totalSize = 0L;
+
+            std::vector<PlannedBuffer*> order;
+            for (auto &v: _buffers) {
+                order.emplace_back(&v.second);
+                _totalSize += v.second._bytes;
+            }
+
+            // greedy by size: biggest buffers get placed first, each one into lowest gap free during its lifetime
+            std::stable_sort(order.begin(), order.end(), [] (PlannedBuffer* a, PlannedBuffer* b) -> bool {
+                return a->_bytes > b->_bytes;
+            });
+
+            std::vector<PlannedBuffer*> placed;
+            for (auto buffer: order) {
+                std::vector<PlannedBuffer*> overlapping;
+                for (auto p: placed)
+                    if (p->_first <= buffer->_last && buffer->_first <= p->_last)
+                        overlapping.emplace_back(p);
+
+                std::sort(overlapping.begin(), overlapping.end(), [] (PlannedBuffer* a, PlannedBuffer* b) -> bool {
+                    return a->_offset < b->_offset;
+                });
+
+                Nd4jIndex offset = 0L;
+                for (auto p: overlapping) {
+                    if (p->_offset >= offset + buffer->_bytes)
+                        break;
+
+                    offset = nd4j::math::nd4j_max<Nd4jIndex>(offset, p->_offset + p->_bytes);
+                }
+
+                buffer->_offset = offset;
+                _arenaSize = nd4j::math::nd4j_max<Nd4jIndex>(_arenaSize, offset + buffer->_bytes);
+
+                placed.emplace_back(buffer);
+            }
+        }
+
+        template <typename T>
+        bool MemoryPlanner<T>::hasBuffer(std::pair<int, int> &pair) {
+            return _arena != nullptr && _buffers.count(pair) > 0;
+        }
+
+        template <typename T>
+        T* MemoryPlanner<T>::buffer(std::pair<int, int> &pair) {
+            return reinterpret_cast<T *>(reinterpret_cast<char *>(_arena) + _buffers.at(pair)._offset);
+        }
+
+        template <typename T>
+        int* MemoryPlanner<T>::shapeInfo(std::pair<int, int> &pair) {
+            return _buffers.at(pair)._shapeInfo;
+        }
+
+        template <typename T>
+        Nd4jIndex MemoryPlanner<T>::offset(std::pair<int, int> &pair) {
+            return _buffers.at(pair)._offset;
+        }
+
+        template <typename T>
+        Nd4jIndex MemoryPlanner<T>::bytes(std::pair<int, int> &pair) {
+            return _buffers.at(pair)._bytes;
+        }
+
+        template <typename T>
+        NDArray<T>* MemoryPlanner<T>::array(std::pair<int, int> &pair) {
+            return _buffers.at(pair)._array;
+        }
+
+        template <typename T>
+        int MemoryPlanner<T>::numberOfBuffers() {
+            return (int) _buffers.size();
+        }
+
+        template <typename T>
+        Nd4jIndex MemoryPlanner<T>::arenaSize() {
+            return _arenaSize;
+        }
+
+        template <typename T>
+        Nd4jIndex MemoryPlanner<T>::totalSize() {
+            return _totalSize;
+        }
+
+        template <typename T>
+        nd4j::memory::Workspace* MemoryPlanner<T>::workspace() {
+            return _workspace;
+        }
+
+        template class ND4J_EXPORT MemoryPlanner<float>;
+        template class ND4J_EXPORT MemoryPlanner<float16>;
+        template class ND4J_EXPORT MemoryPlanner<double>;
+    }
+}
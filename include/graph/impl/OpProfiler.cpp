@@ -0,0 +1,276 @@
+#include <graph/OpProfiler.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+namespace nd4j {
+    namespace graph {
+
+        ProfilerStats::ProfilerStats() {
+            _histogram.resize((PROFILER_RANGES + 1) * PROFILER_SUB_BUCKETS, 0);
+        }
+
+        int ProfilerStats::bucket(Nd4jIndex time) {
+            if (time < PROFILER_SUB_BUCKETS)
+                return time < 0 ? 0 : (int) time;
+
+            // log-linear buckets: power of 2 range, and linear position within it
+            int exp = 0;
+            while ((time >> (exp + 1)) > 0)
+                exp++;
+
+            int mantissa = (int) ((time >> (exp - 3)) & (PROFILER_SUB_BUCKETS - 1));
+            int result = (exp - 2) * PROFILER_SUB_BUCKETS + mantissa;
+
+            return std::min<int>(result, (PROFILER_RANGES + 1) * PROFILER_SUB_BUCKETS - 1);
+        }
+
+        Nd4jIndex ProfilerStats::bucketValue(int bucket) {
+            if (bucket < PROFILER_SUB_BUCKETS)
+                return bucket;
+
+            int exp = bucket / PROFILER_SUB_BUCKETS + 2;
+            int mantissa = bucket % PROFILER_SUB_BUCKETS;
+            Nd4jIndex width = ((Nd4jIndex) 1) << (exp - 3);
+
+            // middle of the bucket
+            return (PROFILER_SUB_BUCKETS + mantissa) * width + width / 2;
+        }
+
+        void ProfilerStats::update(Nd4jIndex time, Nd4jIndex bytes, Nd4jIndex flops) {
+            if (calls == 0 || time < minTime)
+                minTime = time;
+
+            if (calls == 0 || time > maxTime)
+                maxTime = time;
+
+            calls++;
+            totalTime += time;
+            workspaceBytes += bytes;
+            this->flops += flops;
+            _histogram[bucket(time)]++;
+        }
+
+        Nd4jIndex ProfilerStats::meanTime() const {
+            return calls > 0 ? totalTime / calls : 0;
+        }
+
+        Nd4jIndex ProfilerStats::percentile(double p) const {
+            if (calls == 0)
+                return 0;
+
+            auto target = (Nd4jIndex) std::ceil(p / 100.0 * calls);
+            target = std::max<Nd4jIndex>(1, std::min<Nd4jIndex>(target, calls));
+            if (target == calls)
+                return maxTime;
+
+            Nd4jIndex cnt = 0;
+            for (int e = 0; e < (int) _histogram.size(); e++) {
+                cnt += _histogram[e];
+                if (cnt >= target)
+                    return std::max<Nd4jIndex>(minTime, std::min<Nd4jIndex>(maxTime, bucketValue(e)));
+            }
+
+            return maxTime;
+        }
+
+
+        OpProfiler::OpProfiler() {
+            _enabled.store(false);
+            _threads.store(0);
+            _epoch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        OpProfiler* OpProfiler::getInstance() {
+            if (_instance == 0)
+                _instance = new OpProfiler();
+
+            return _instance;
+        }
+
+        bool OpProfiler::isEnabled() {
+            return _enabled.load();
+        }
+
+        void OpProfiler::setEnabled(bool reallyEnabled) {
+            _enabled = reallyEnabled;
+        }
+
+        void OpProfiler::reset() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _events.clear();
+            _stats.clear();
+            _dropped = 0;
+        }
+
+        Nd4jIndex OpProfiler::now() {
+            auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            return time - _epoch;
+        }
+
+        int OpProfiler::threadId() {
+            static thread_local int id = -1;
+            if (id < 0)
+                id = _threads++;
+
+            return id;
+        }
+
+        void OpProfiler::record(ProfilerEvent &event) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // statistics are gathered for ops only, nodes are just wrappers around them
+            if (event.category == "op") {
+                auto &stats = _stats[event.name];
+                stats.name = event.name;
+                stats.update(event.end - event.start, event.workspaceBytes, event.flops);
+            }
+
+            if (_events.size() < PROFILER_MAX_EVENTS)
+                _events.push_back(event);
+            else
+                _dropped++;
+        }
+
+        std::vector<ProfilerEvent> OpProfiler::events() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _events;
+        }
+
+        Nd4jIndex OpProfiler::droppedEvents() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _dropped;
+        }
+
+        std::vector<ProfilerStats> OpProfiler::statistics() {
+            std::vector<ProfilerStats> result;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto &v: _stats)
+                    result.push_back(v.second);
+            }
+
+            std::sort(result.begin(), result.end(), [](const ProfilerStats &a, const ProfilerStats &b) -> bool {
+                return a.totalTime > b.totalTime;
+            });
+
+            return result;
+        }
+
+        static void escapeJson(std::stringstream &stream, const std::string &value) {
+            for (auto c: value) {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if ((unsigned char) c < 0x20)
+                    stream << ' ';
+                else
+                    stream << c;
+            }
+        }
+
+        static void shapesJson(std::stringstream &stream, const std::vector<std::vector<int>> &shapes) {
+            stream << "[";
+            for (int e = 0; e < (int) shapes.size(); e++) {
+                stream << (e > 0 ? ",[" : "[");
+                for (int i = 0; i < (int) shapes[e].size(); i++)
+                    stream << (i > 0 ? "," : "") << shapes[e][i];
+                stream << "]";
+            }
+            stream << "]";
+        }
+
+        std::string OpProfiler::chromeTrace() {
+            auto list = events();
+
+            std::stringstream stream;
+            stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            for (int e = 0; e < (int) list.size(); e++) {
+                auto &event = list[e];
+                if (e > 0)
+                    stream << ",";
+
+                // complete events: nested node/op events on the same thread are shown as stack
+                stream << "\n{\"name\":\"";
+                escapeJson(stream, event.name);
+                stream << "\",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"ts\":" << event.start << ",\"dur\":" << (event.end - event.start);
+                stream << ",\"pid\":0,\"tid\":" << event.threadId << ",\"args\":{\"node\":" << event.nodeId;
+
+                if (event.category == "op") {
+                    stream << ",\"inputs\":";
+                    shapesJson(stream, event.inputShapes);
+                    stream << ",\"outputs\":";
+                    shapesJson(stream, event.outputShapes);
+                    stream << ",\"workspaceBytes\":" << event.workspaceBytes << ",\"flops\":" << event.flops;
+                }
+
+                stream << "}}";
+            }
+            stream << "\n]}\n";
+
+            return stream.str();
+        }
+
+        bool OpProfiler::exportChromeTrace(const char *fileName) {
+            FILE *fp = fopen(fileName, "wb");
+            if (fp == nullptr)
+                return false;
+
+            auto trace = chromeTrace();
+            bool result = fwrite(trace.c_str(), 1, trace.size(), fp) == trace.size();
+            fclose(fp);
+
+            return result;
+        }
+
+        void OpProfiler::printStatistics() {
+            auto stats = statistics();
+
+            printf("%-24s %10s %12s %10s %10s %10s %10s %14s %14s\n", "op", "calls", "total, us", "mean", "p50", "p90", "p99", "ws bytes", "GFLOP/s");
+            for (auto &s: stats) {
+                double gflops = s.totalTime > 0 ? (double) s.flops / (double) s.totalTime / 1000.0 : 0.0;
+                printf("%-24s %10lld %12lld %10lld %10lld %10lld %10lld %14lld %14.3f\n", s.name.c_str(), s.calls, s.totalTime, s.meanTime(), s.percentile(50), s.percentile(90), s.percentile(99), s.workspaceBytes, gflops);
+            }
+            fflush(stdout);
+        }
+
+        static Nd4jIndex shapeLength(const std::vector<int> &shape) {
+            Nd4jIndex length = 1;
+            for (auto v: shape)
+                length *= v;
+
+            return length;
+        }
+
+        Nd4jIndex OpProfiler::estimateFlops(const std::string &name, const std::vector<std::vector<int>> &inputShapes, const std::vector<std::vector<int>> &outputShapes) {
+            Nd4jIndex outLength = 0;
+            for (auto &s: outputShapes)
+                outLength += shapeLength(s);
+
+            if (outputShapes.empty() || inputShapes.empty())
+                return outLength;
+
+            Nd4jIndex z = shapeLength(outputShapes[0]);
+            if ((name == "matmul" || name == "mmul" || name == "tensormmul") && inputShapes.size() >= 2 && z > 0) {
+                // for 2D GEMM lenA * lenB / lenC = K^2, otherwise we assume last dimension of A is reduced
+                Nd4jIndex k;
+                if (inputShapes[0].size() == 2 && inputShapes[1].size() == 2 && outputShapes[0].size() == 2)
+                    k = (Nd4jIndex) std::llround(std::sqrt((double) shapeLength(inputShapes[0]) * (double) shapeLength(inputShapes[1]) / (double) z));
+                else
+                    k = inputShapes[0].empty() ? 1 : inputShapes[0].back();
+
+                return 2 * z * k;
+            }
+
+            if (name == "conv2d" && inputShapes.size() >= 2 && !inputShapes[1].empty() && inputShapes[1][0] > 0) {
+                // weights are [oC, iC, kH, kW]: every output element reduces over everything but oC
+                return 2 * z * (shapeLength(inputShapes[1]) / inputShapes[1][0]);
+            }
+
+            return outLength;
+        }
+
+        OpProfiler* OpProfiler::_instance = 0;
+    }
+}
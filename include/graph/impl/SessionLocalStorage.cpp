@@ -10,11 +10,12 @@ namespace nd4j {
     namespace graph {
 
         template <typename T>
-        SessionLocalStorage<T>::SessionLocalStorage(VariableSpace<T>* variableSpace, Stash<T>* stash) {
+        SessionLocalStorage<T>::SessionLocalStorage(VariableSpace<T>* variableSpace, Stash<T>* stash, bool shareVariables) {
             // we start from 1, since key 0 holds original VariableSpace
             _sessionCounter.store(1);
             _variableSpace = variableSpace;
             _stash = stash;
+            _shareVariables = shareVariables;
         }
 
         template <typename T>
@@ -104,10 +105,14 @@ namespace nd4j {
 
             nd4j_debug("Adding ThreadId: %i;\n", (int) tid);
             Nd4jIndex ntid = _sessionCounter++;
+
+            // proxy is cheap, but shares external variables with original VariableSpace
+            auto varSpace = _shareVariables ? new VariableProxy<T>(_variableSpace) : _variableSpace->clone();
+
             _mutex.lock();
 
             _threadSession[tid] = ntid;
-            _threadVariableSpace[ntid] = _variableSpace->clone();
+            _threadVariableSpace[ntid] = varSpace;
 
             _mutex.unlock();
 
@@ -150,7 +150,7 @@ namespace nd4j {
         }
 
         template <typename T>
-        nd4j::graph::Variable<T>::Variable(const nd4j::graph::FlatVariable *flatVariable) {
+        nd4j::graph::Variable<T>::Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy) {
             auto vid = flatVariable->id();
             this->_id = vid->first();
             this->_index = vid->second();
@@ -159,14 +159,18 @@ namespace nd4j {
                 this->_name = flatVariable->name()->str();
 
             _external = true;
-            _readOnly = false;
 
             T *buffer = nullptr;
 
             if (flatVariable->ndarray() != nullptr) {
                  auto ar = flatVariable->ndarray();
-                _ndarray = nd4j::graph::FlatUtils::fromFlatArray<T>(ar);
-                _ndarray->triggerAllocationFlag(true, true);
+                if (zeroCopy && nd4j::graph::FlatUtils::isViewable<T>(ar)) {
+                    _ndarray = nd4j::graph::FlatUtils::viewFlatArray<T>(ar);
+                    _readOnly = true;
+                } else {
+                    _ndarray = nd4j::graph::FlatUtils::fromFlatArray<T>(ar);
+                    _ndarray->triggerAllocationFlag(true, true);
+                }
             } else if (flatVariable->shape() != nullptr) {
                 int shapeLen = flatVariable->shape()->Length();
                 //int *shape = new int[shapeLen];
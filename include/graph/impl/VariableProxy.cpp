@@ -0,0 +1,204 @@
+#include <graph/VariableProxy.h>
+
+namespace nd4j {
+    namespace graph {
+        template <typename T>
+        VariableProxy<T>::VariableProxy(VariableSpace<T>* backed) {
+            _backed = backed;
+        }
+
+        template <typename T>
+        VariableProxy<T>::~VariableProxy() {
+            // only local variables are released here, via VariableSpace destructor
+        }
+
+        template <typename T>
+        VariableSpace<T>* VariableProxy<T>::backed() {
+            return _backed;
+        }
+
+        template <typename T>
+        Variable<T>* VariableProxy<T>::lookup(VariableSpace<T>* space, std::pair<int, int>& pair) {
+            // same resolution rules as VariableSpace::getVariable(pair), but without exceptions
+            if (pair.first < 0) {
+                auto it = space->_variables.find(pair.first);
+                return it == space->_variables.end() ? nullptr : it->second;
+            }
+
+            auto it = space->_paired.find(pair);
+            if (it != space->_paired.end())
+                return it->second;
+
+            if (pair.second == 0) {
+                auto jt = space->_temporary.find(pair.first);
+                if (jt != space->_temporary.end())
+                    return jt->second;
+            }
+
+            return nullptr;
+        }
+
+        template <typename T>
+        Variable<T>* VariableProxy<T>::shadow(std::pair<int, int>& pair, Variable<T>* origin) {
+            auto result = new Variable<T>(origin->isPlaceholder());
+            result->markExternal(origin->isExternal());
+            result->markReadOnly(origin->isReadOnly());
+            result->setId(pair.first, pair.second);
+
+            if (origin->getName() != nullptr && origin->getName()->length() > 0)
+                result->setName(origin->getName());
+
+            return result;
+        }
+
+        template <typename T>
+        Variable<T>* VariableProxy<T>::resolve(std::pair<int, int>& pair, Variable<T>* origin) {
+            if (origin == nullptr)
+                return nullptr;
+
+            // weights & constants are shared between all sessions
+            if (!origin->isPlaceholder() && (pair.first < 0 || origin->isExternal()))
+                return origin;
+
+            auto result = shadow(pair, origin);
+            VariableSpace<T>::putVariable(pair, result);
+
+            return result;
+        }
+
+        template <typename T>
+        bool VariableProxy<T>::hasExternalVariable(int id) {
+            std::pair<int, int> pair(id, 0);
+            return hasExternalVariable(pair);
+        }
+
+        template <typename T>
+        bool VariableProxy<T>::hasExternalVariable(std::pair<int,int>& pair) {
+            std::lock_guard<std::recursive_mutex> lock(this->_varmap);
+
+            auto var = lookup(this, pair);
+            if (var == nullptr)
+                var = lookup(_backed, pair);
+
+            return var != nullptr && var->isExternal();
+        }
+
+        template <typename T>
+        bool VariableProxy<T>::hasExternalVariable(std::string *symbol) {
+            if (!hasVariable(symbol))
+                return false;
+
+            return getVariable(symbol)->isExternal();
+        }
+
+        template <typename T>
+        bool VariableProxy<T>::hasVariable(int id) {
+            if (VariableSpace<T>::hasVariable(id))
+                return true;
+
+            return _backed->_variables.count(id) == 1 || _backed->_temporary.count(id) == 1;
+        }
+
+        template <typename T>
+        bool VariableProxy<T>::hasVariable(int id, int idx) {
+            std::pair<int, int> pair(id, idx);
+            return hasVariable(pair);
+        }
+
+        template <typename T>
+        bool VariableProxy<T>::hasVariable(std::pair<int,int>& pair) {
+            if (VariableSpace<T>::hasVariable(pair))
+                return true;
+
+            return _backed->_paired.count(pair) > 0;
+        }
+
+        template <typename T>
+        bool VariableProxy<T>::hasVariable(std::string *symbol) {
+            if (VariableSpace<T>::hasVariable(symbol))
+                return true;
+
+            return _backed->_symbolic.count(*symbol) == 1;
+        }
+
+        template <typename T>
+        Variable<T>* VariableProxy<T>::getVariable(int id) {
+            std::lock_guard<std::recursive_mutex> lock(this->_varmap);
+
+            std::pair<int, int> pair(id, 0);
+            auto var = lookup(this, pair);
+            if (var != nullptr)
+                return var;
+
+            var = resolve(pair, lookup(_backed, pair));
+            if (var != nullptr)
+                return var;
+
+            // nothing here, so we'll get the same exception VariableSpace throws
+            return VariableSpace<T>::getVariable(id);
+        }
+
+        template <typename T>
+        Variable<T>* VariableProxy<T>::getVariable(int id, int idx) {
+            std::pair<int, int> pair(id, idx);
+            return getVariable(pair);
+        }
+
+        template <typename T>
+        Variable<T>* VariableProxy<T>::getVariable(std::pair<int,int>& pair) {
+            std::lock_guard<std::recursive_mutex> lock(this->_varmap);
+
+            if (pair.first == 0)
+                throw "0 requested";
+
+            auto var = lookup(this, pair);
+            if (var != nullptr)
+                return var;
+
+            return resolve(pair, lookup(_backed, pair));
+        }
+
+        template <typename T>
+        Variable<T>* VariableProxy<T>::getVariable(std::string *symbol) {
+            std::lock_guard<std::recursive_mutex> lock(this->_varmap);
+
+            if (VariableSpace<T>::hasVariable(symbol))
+                return VariableSpace<T>::getVariable(symbol);
+
+            auto origin = _backed->_symbolic.at(*symbol);
+            std::pair<int, int> pair(origin->id(), origin->index());
+
+            return resolve(pair, origin);
+        }
+
+        template <typename T>
+        void VariableProxy<T>::putVariable(int id, NDArray<T> *array) {
+            std::lock_guard<std::recursive_mutex> lock(this->_varmap);
+
+            std::pair<int, int> pair(id, 0);
+            auto var = lookup(this, pair);
+            if (var == nullptr) {
+                auto origin = lookup(_backed, pair);
+
+                // unknown variable, nothing to shadow
+                if (origin == nullptr) {
+                    VariableSpace<T>::putVariable(id, array);
+                    return;
+                }
+
+                // even shared variables are shadowed here, since we don't want to touch backed space
+                var = shadow(pair, origin);
+                VariableSpace<T>::putVariable(pair, var);
+            }
+
+            if (var->hasNDArray() && var->getNDArray() != array && var->isRemovable())
+                delete var->getNDArray();
+
+            var->setNDArray(array);
+        }
+
+        template class ND4J_EXPORT VariableProxy<float>;
+        template class ND4J_EXPORT VariableProxy<float16>;
+        template class ND4J_EXPORT VariableProxy<double>;
+    }
+}
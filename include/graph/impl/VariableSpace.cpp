@@ -19,6 +19,8 @@ namespace nd4j {
 
         template <typename T>
         nd4j::graph::VariableSpace<T>* nd4j::graph::VariableSpace<T>::clone() {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             auto result = new VariableSpace<T>();
 
             for (auto const& x : _paired) {
@@ -56,11 +58,15 @@ namespace nd4j {
 
         template <typename T>
         bool nd4j::graph::VariableSpace<T>::hasVariable(std::string *symbol) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             return _symbolic.count(*symbol) == 1;
         }
 
         template <typename T>
         nd4j::graph::Variable<T> * nd4j::graph::VariableSpace<T>::getVariable(std::string *symbol) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             return _symbolic.at(*symbol);
         }
 
@@ -72,6 +78,8 @@ namespace nd4j {
 
         template <typename T>
         bool VariableSpace<T>::hasExternalVariable(int id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             if (!hasVariable(id))
                 return false;
 
@@ -81,6 +89,8 @@ namespace nd4j {
 
         template <typename T>
         bool VariableSpace<T>::hasExternalVariable(std::pair<int,int>& pair) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             if (!hasVariable(pair))
                 return false;
 
@@ -90,6 +100,8 @@ namespace nd4j {
 
         template <typename T>
         bool VariableSpace<T>::hasExternalVariable(std::string *symbol) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             if (!hasVariable(symbol))
                 return false;
 
@@ -105,6 +117,8 @@ namespace nd4j {
 
         template <typename T>
         nd4j::graph::Variable<T> * nd4j::graph::VariableSpace<T>::getVariable(std::pair<int, int>& pair) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             if (pair.first == 0)
                 throw "0 requested";
 
@@ -124,11 +138,15 @@ namespace nd4j {
 
         template <typename T>
         bool nd4j::graph::VariableSpace<T>::hasVariable(int id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             return _variables.count(id) == 1 || _temporary.count(id) == 1;
         }
 
         template <typename T>
         bool nd4j::graph::VariableSpace<T>::hasVariable(std::pair<int,int>& id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             return _paired.count(id) > 0;
         }
 
@@ -198,44 +216,44 @@ namespace nd4j {
 
         template <typename T>
         void nd4j::graph::VariableSpace<T>::silentPutVariable(std::pair<int,int>& pair, Variable<T> *variable) {
-            _varmap.lock();
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
 
             //std::pair<std::pair<int, int>, nd4j::graph::Variable<T> *> p(pair, variable);
             _paired[pair] = variable;
-
-            _varmap.unlock();
         }
 
         template <typename T>
         void nd4j::graph::VariableSpace<T>::putVariable(std::pair<int,int>& pair, Variable<T> *variable) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             silentPutVariable(pair, variable);
 
             if (variable->isPlaceholder())
                 _placeholders.push_back(variable);
 
-            // copying duplicate for compatibility
-            if (pair.second == 0 && !this->hasVariable(pair.first)) {
+            // copying duplicate for compatibility. non-virtual call: only this space matters here
+            if (pair.second == 0 && !VariableSpace<T>::hasVariable(pair.first)) {
                 this->putVariable(pair.first, variable);
             } else {
                 if (variable->getName() != nullptr && variable->getName()->length() != 0) {
                     _symbolic[*(variable->getName())] = variable;
                 }
 
-                _varmap.lock();
-
                 _handles->push_back(variable);
-
-                _varmap.unlock();
             }
         }
 
         template <typename T>
         void VariableSpace<T>::trackList(nd4j::NDArrayList<T>* list) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             _lists.emplace_back(list);
         }
 
         template <typename T>
         void nd4j::graph::VariableSpace<T>::putVariable(int id, Variable<T> *variable) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             // we don't want to add variables more then once
             if (_variables.count(id) > 0 || _temporary.count(id) > 0) {
                 nd4j_verbose("Trying to update variable for node_%i\n", id);
@@ -251,8 +269,6 @@ namespace nd4j {
 
             //nd4j_debug("Adding Variable to Space: id: %i; Array is null: %i;\n", id, variable->getNDArray() == nullptr);
 
-            _varmap.lock();
-
             _handles->emplace_back(variable);
 
             if (_auto_counter >= id)
@@ -278,10 +294,8 @@ namespace nd4j {
                 _temporary[id] = variable;
             }
 
-            _varmap.unlock();
-
             std::pair<int,int> pair(id, 0);
-            if (!hasVariable(pair)) {
+            if (!VariableSpace<T>::hasVariable(pair)) {
                 this->silentPutVariable(pair, variable);
 
                 if (variable->isPlaceholder())
@@ -297,18 +311,12 @@ namespace nd4j {
 
         template <typename T>
         nd4j::graph::Variable<T> * nd4j::graph::VariableSpace<T>::getVariable(int id) {
-//            _varmap.lock();
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
 
             if (id < 0) {
-                auto  v = _variables.at(id);
-   //             _varmap.unlock();
-
-                return v;
+                return _variables.at(id);
             } else {
-                auto v = _temporary.at(id);
-    //            _varmap.unlock();
-
-                return v;
+                return _temporary.at(id);
             }
         }
 
@@ -361,6 +369,16 @@ namespace nd4j {
             return _flow;
         }
 
+        template <typename T>
+        void VariableSpace<T>::setMemoryPlanner(MemoryPlanner<T>* planner) {
+            _planner = planner;
+        }
+
+        template <typename T>
+        MemoryPlanner<T>* VariableSpace<T>::memoryPlanner() {
+            return _planner;
+        }
+
         template <typename T>
         VariableSpace<T>::VariableSpace() {
             _handles = new std::vector<Variable<T> *>;
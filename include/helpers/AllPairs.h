@@ -0,0 +1,281 @@
+#ifndef LIBND4J_ALLPAIRS_H
+#define LIBND4J_ALLPAIRS_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <ops/ops.h>
+#include <op_boilerplate.h>
+#include <Environment.h>
+#include <helpers/shape.h>
+#include <type_traits>
+#include <algorithm>
+#include <vector>
+#include <omp.h>
+
+// ways to compute pairwise values: generic tiled kernel, or GEMM followed by elementwise post-processing
+#define ALLPAIRS_TILED 0
+#define ALLPAIRS_DOT 1
+#define ALLPAIRS_EUCLIDEAN 2
+#define ALLPAIRS_COSINE_SIMILARITY 3
+#define ALLPAIRS_COSINE_DISTANCE 4
+
+// shorter TADs aren't worth GEMM call & extra rounding of norm expansion
+#define ALLPAIRS_GEMM_MIN_LENGTH 8
+
+// tiles are sized so both row blocks fit into L1
+#define ALLPAIRS_TILE_BYTES 16384
+#define ALLPAIRS_TILE_MAX 64
+
+// top-k processes X in row blocks against column blocks of Y, so only rows x cols buffer is materialized per thread
+#define ALLPAIRS_TOPK_ROWS 64
+#define ALLPAIRS_TOPK_COLS 1024
+
+namespace nd4j {
+
+    /**
+     * Cache-blocked all-pairs engine for Reduce3 execAll.
+     *
+     * TADs of both inputs are packed into contiguous rows first (or used in place, if they are rows already). Dot, euclidean
+     * and cosine ops are lowered to squared norms plus GEMM, other ops are computed by tiled kernel, partitioned across threads by both axes.
+     * Top-k mode keeps only k best matches per row of X, without materializing full result matrix.
+     */
+    template <typename T>
+    class ND4J_EXPORT AllPairs {
+    protected:
+        /**
+         * Returns contiguous [numTads, tadLength] view of TADs: either original buffer, or packed copy stored in holder
+         */
+        static T* rows(T *x, int *tadShapeInfo, Nd4jIndex *offsets, int numTads, int tadLength, std::vector<T> &holder);
+
+        static void squaredNorms(T *rows, int numRows, int length, T *norms);
+
+        /**
+         * C[xRows, yRows] = X * Y^T, C is row-major with leading dimension ldc
+         */
+        static void dotProducts(T *x, int xRows, T *y, int yRows, int length, T *result, int ldc);
+
+        /**
+         * Converts dot products into op result in place, for one row of result
+         */
+        static void postProcess(int kind, T *result, int numCols, T xNorm, T *yNorms);
+
+        static int tileRows(int length);
+
+        template<typename OpType>
+        static int kind(int length) {
+            // half precision loses too much in norm expansion
+            if (std::is_same<T, float16>::value || length < ALLPAIRS_GEMM_MIN_LENGTH)
+                return ALLPAIRS_TILED;
+
+            if (std::is_same<OpType, simdOps::Dot<T>>::value)
+                return ALLPAIRS_DOT;
+
+            if (std::is_same<OpType, simdOps::EuclideanDistance<T>>::value)
+                return ALLPAIRS_EUCLIDEAN;
+
+            if (std::is_same<OpType, simdOps::CosineSimilarity<T>>::value)
+                return ALLPAIRS_COSINE_SIMILARITY;
+
+            if (std::is_same<OpType, simdOps::CosineDistance<T>>::value)
+                return ALLPAIRS_COSINE_DISTANCE;
+
+            return ALLPAIRS_TILED;
+        }
+
+        /**
+         * Similarities are better when larger, distances when smaller
+         */
+        template<typename OpType>
+        static bool isSimilarity() {
+            return std::is_same<OpType, simdOps::Dot<T>>::value || std::is_same<OpType, simdOps::CosineSimilarity<T>>::value;
+        }
+
+        template<typename OpType>
+        static inline T pair(T *x, T *y, int length, T eps) {
+            // same layout as execScalar uses: 2 accumulators & eps for EqualsWithEps
+            T extraParams[3] = {(T) 0.0f, (T) 0.0f, eps};
+
+            T reduction = OpType::startingValue(x);
+            for (int f = 0; f < length; f++)
+                reduction = OpType::update(reduction, OpType::op(x[f], y[f], extraParams), extraParams);
+
+            return OpType::postProcess(reduction, length, extraParams);
+        }
+
+        /**
+         * Computes [xEnd - xStart, yEnd - yStart] block of result with either GEMM lowering or tiled kernel
+         */
+        template<typename OpType>
+        static void block(int kind, T *x, T *xNorms, int xStart, int xEnd, T *y, T *yNorms, int yStart, int yEnd, int length, T eps, T *result, int ldc) {
+            if (kind != ALLPAIRS_TILED) {
+                dotProducts(x + (Nd4jIndex) xStart * length, xEnd - xStart, y + (Nd4jIndex) yStart * length, yEnd - yStart, length, result, ldc);
+                for (int r = xStart; r < xEnd; r++)
+                    postProcess(kind, result + (Nd4jIndex) (r - xStart) * ldc, yEnd - yStart, xNorms == nullptr ? (T) 0.0f : xNorms[r], yNorms == nullptr ? nullptr : yNorms + yStart);
+
+                return;
+            }
+
+            int tile = tileRows(length);
+            for (int tx = xStart; tx < xEnd; tx += tile) {
+                for (int ty = yStart; ty < yEnd; ty += tile) {
+                    int txEnd = nd4j::math::nd4j_min<int>(tx + tile, xEnd);
+                    int tyEnd = nd4j::math::nd4j_min<int>(ty + tile, yEnd);
+
+                    for (int r = tx; r < txEnd; r++) {
+                        T *lX = x + (Nd4jIndex) r * length;
+                        T *lZ = result + (Nd4jIndex) (r - xStart) * ldc - yStart;
+                        for (int c = ty; c < tyEnd; c++)
+                            lZ[c] = pair<OpType>(lX, y + (Nd4jIndex) c * length, length, eps);
+                    }
+                }
+            }
+        }
+
+    public:
+        /**
+         * Full [xTads, yTads] result matrix, row-major
+         */
+        template<typename OpType>
+        static void exec(T *x, int *xTadShapeInfo, Nd4jIndex *xOffsets, int xTads, T *y, int *yTadShapeInfo, Nd4jIndex *yOffsets, int yTads, int tadLength, T *extraParams, T *result) {
+            if (xTads < 1 || yTads < 1)
+                return;
+
+            T eps = extraParams == nullptr ? (T) 0.0f : extraParams[0];
+
+            std::vector<T> xHolder, yHolder, xNorms, yNorms;
+            T *xRows = rows(x, xTadShapeInfo, xOffsets, xTads, tadLength, xHolder);
+            T *yRows = rows(y, yTadShapeInfo, yOffsets, yTads, tadLength, yHolder);
+
+            int k = kind<OpType>(tadLength);
+            if (k != ALLPAIRS_TILED) {
+                if (k != ALLPAIRS_DOT) {
+                    xNorms.resize(xTads);
+                    yNorms.resize(yTads);
+                    squaredNorms(xRows, xTads, tadLength, xNorms.data());
+                    squaredNorms(yRows, yTads, tadLength, yNorms.data());
+                }
+
+                // single GEMM over everything: it's blocked & parallel on its own
+                dotProducts(xRows, xTads, yRows, yTads, tadLength, result, yTads);
+
+                int num_threads = nd4j::math::nd4j_max<int>(1, xTads / TAD_THRESHOLD_FOR(OP_CLASS_REDUCE3));
+                num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_REDUCE3));
+
+#pragma omp parallel for num_threads(num_threads) if (num_threads > 1) schedule(static) proc_bind(AFFINITY) default(shared)
+                for (int r = 0; r < xTads; r++)
+                    postProcess(k, result + (Nd4jIndex) r * yTads, yTads, k == ALLPAIRS_DOT ? (T) 0.0f : xNorms[r], k == ALLPAIRS_DOT ? nullptr : yNorms.data());
+
+                return;
+            }
+
+            // both axes are split into tiles, so threads get work even if one side has just few TADs
+            int tile = tileRows(tadLength);
+            int xBlocks = (xTads + tile - 1) / tile;
+            int yBlocks = (yTads + tile - 1) / tile;
+            int blocks = xBlocks * yBlocks;
+
+            int num_threads = nd4j::math::nd4j_max<int>(1, (int) (((Nd4jIndex) xTads * yTads) / TAD_THRESHOLD_FOR(OP_CLASS_REDUCE3)));
+            num_threads = nd4j::math::nd4j_min<int>(num_threads, nd4j::math::nd4j_min<int>(blocks, MAX_THREADS_FOR(OP_CLASS_REDUCE3)));
+
+#pragma omp parallel for num_threads(num_threads) if (num_threads > 1) schedule(dynamic, 1) proc_bind(AFFINITY) default(shared)
+            for (int b = 0; b < blocks; b++) {
+                int xStart = (b / yBlocks) * tile;
+                int yStart = (b % yBlocks) * tile;
+                int xEnd = nd4j::math::nd4j_min<int>(xStart + tile, xTads);
+                int yEnd = nd4j::math::nd4j_min<int>(yStart + tile, yTads);
+
+                block<OpType>(ALLPAIRS_TILED, xRows, nullptr, xStart, xEnd, yRows, nullptr, yStart, yEnd, tadLength, eps, result + (Nd4jIndex) xStart * yTads + yStart, yTads);
+            }
+        }
+
+        /**
+         * k best matches from Y for every TAD of X, sorted from best to worst: largest values for similarities (dot, cosine similarity),
+         * smallest ones for distances. Values & indices are [xTads, k] row-major. If k > yTads, tail is filled with zeros & -1 indices.
+         */
+        template<typename OpType>
+        static void topK(T *x, int *xTadShapeInfo, Nd4jIndex *xOffsets, int xTads, T *y, int *yTadShapeInfo, Nd4jIndex *yOffsets, int yTads, int tadLength, T *extraParams, int k, T *values, Nd4jIndex *indices) {
+            if (xTads < 1 || k < 1)
+                return;
+
+            T eps = extraParams == nullptr ? (T) 0.0f : extraParams[0];
+            bool similarity = isSimilarity<OpType>();
+
+            std::vector<T> xHolder, yHolder, xNorms, yNorms;
+            T *xRows = rows(x, xTadShapeInfo, xOffsets, xTads, tadLength, xHolder);
+            T *yRows = rows(y, yTadShapeInfo, yOffsets, yTads, tadLength, yHolder);
+
+            int kd = kind<OpType>(tadLength);
+            if (kd != ALLPAIRS_TILED && kd != ALLPAIRS_DOT) {
+                xNorms.resize(xTads);
+                yNorms.resize(yTads);
+                squaredNorms(xRows, xTads, tadLength, xNorms.data());
+                squaredNorms(yRows, yTads, tadLength, yNorms.data());
+            }
+
+            int kept = nd4j::math::nd4j_min<int>(k, yTads);
+            int rowBlocks = (xTads + ALLPAIRS_TOPK_ROWS - 1) / ALLPAIRS_TOPK_ROWS;
+
+            int num_threads = nd4j::math::nd4j_max<int>(1, (int) (((Nd4jIndex) xTads * yTads) / TAD_THRESHOLD_FOR(OP_CLASS_REDUCE3)));
+            num_threads = nd4j::math::nd4j_min<int>(num_threads, nd4j::math::nd4j_min<int>(rowBlocks, MAX_THREADS_FOR(OP_CLASS_REDUCE3)));
+
+#pragma omp parallel num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared)
+            {
+                // heap top is the worst of kept candidates, ties are broken by lower index
+                auto better = [similarity](const std::pair<T, Nd4jIndex> &a, const std::pair<T, Nd4jIndex> &b) -> bool {
+                    if (a.first == b.first)
+                        return a.second < b.second;
+
+                    return similarity ? a.first > b.first : a.first < b.first;
+                };
+
+                std::vector<T> buffer((size_t) ALLPAIRS_TOPK_ROWS * ALLPAIRS_TOPK_COLS);
+                std::vector<std::vector<std::pair<T, Nd4jIndex>>> heaps(ALLPAIRS_TOPK_ROWS);
+
+#pragma omp for schedule(dynamic, 1)
+                for (int b = 0; b < rowBlocks; b++) {
+                    int xStart = b * ALLPAIRS_TOPK_ROWS;
+                    int xEnd = nd4j::math::nd4j_min<int>(xStart + ALLPAIRS_TOPK_ROWS, xTads);
+
+                    for (auto &heap: heaps)
+                        heap.clear();
+
+                    for (int yStart = 0; yStart < yTads; yStart += ALLPAIRS_TOPK_COLS) {
+                        int yEnd = nd4j::math::nd4j_min<int>(yStart + ALLPAIRS_TOPK_COLS, yTads);
+                        block<OpType>(kd, xRows, xNorms.empty() ? nullptr : xNorms.data(), xStart, xEnd, yRows, yNorms.empty() ? nullptr : yNorms.data(), yStart, yEnd, tadLength, eps, buffer.data(), ALLPAIRS_TOPK_COLS);
+
+                        for (int r = xStart; r < xEnd; r++) {
+                            auto &heap = heaps[r - xStart];
+                            T *lZ = buffer.data() + (Nd4jIndex) (r - xStart) * ALLPAIRS_TOPK_COLS;
+
+                            for (int c = yStart; c < yEnd; c++) {
+                                std::pair<T, Nd4jIndex> candidate(lZ[c - yStart], c);
+                                if ((int) heap.size() < kept) {
+                                    heap.push_back(candidate);
+                                    std::push_heap(heap.begin(), heap.end(), better);
+                                } else if (better(candidate, heap.front())) {
+                                    std::pop_heap(heap.begin(), heap.end(), better);
+                                    heap.back() = candidate;
+                                    std::push_heap(heap.begin(), heap.end(), better);
+                                }
+                            }
+                        }
+                    }
+
+                    for (int r = xStart; r < xEnd; r++) {
+                        auto &heap = heaps[r - xStart];
+                        std::sort_heap(heap.begin(), heap.end(), better);
+
+                        T *lV = values + (Nd4jIndex) r * k;
+                        Nd4jIndex *lI = indices + (Nd4jIndex) r * k;
+                        for (int e = 0; e < k; e++) {
+                            lV[e] = e < (int) heap.size() ? heap[e].first : (T) 0.0f;
+                            lI[e] = e < (int) heap.size() ? heap[e].second : -1;
+                        }
+                    }
+                }
+            }
+        }
+    };
+}
+
+#endif //LIBND4J_ALLPAIRS_H
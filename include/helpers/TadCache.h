@@ -0,0 +1,86 @@
+#ifndef LIBND4J_TADCACHE_H
+#define LIBND4J_TADCACHE_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+namespace nd4j {
+    /**
+     * This class holds TAD shapeInfo & offsets for one (shapeInfo, dimensions) combination.
+     * Instances are immutable, and shared between all users of the same combination.
+     */
+    class ND4J_EXPORT TadPack {
+    protected:
+        int* _tadOnlyShapeInfo = nullptr;
+        Nd4jIndex* _tadOffsets = nullptr;
+        int _numTads = 0;
+    public:
+        TadPack(int* tadOnlyShapeInfo, Nd4jIndex* tadOffsets, int numTads);
+        ~TadPack();
+
+        // pointers are non-const only because legacy ops signatures want it that way. don't modify contents.
+        int* tadOnlyShapeInfo();
+        Nd4jIndex* tadOffsets();
+        int numberOfTads();
+    };
+
+    /**
+     * This class is process-wide LRU cache for TADs, keyed by full shapeInfo and dimensions.
+     *
+     * Lookups are guarded by mutex. TAD itself is built outside of the lock on cache miss.
+     * Evicted packs stay alive till last user releases them.
+     */
+    class ND4J_EXPORT TadCache {
+    private:
+        struct KeyHash {
+            size_t operator()(const std::vector<int>& key) const;
+        };
+
+        typedef std::pair<std::vector<int>, std::shared_ptr<TadPack>> Entry;
+
+        // most recently used entries are kept at front
+        std::list<Entry> _lru;
+        std::unordered_map<std::vector<int>, std::list<Entry>::iterator, KeyHash> _map;
+        std::mutex _mutex;
+
+        int _capacity = 4096;
+
+        std::atomic<Nd4jIndex> _hits;
+        std::atomic<Nd4jIndex> _misses;
+        std::atomic<Nd4jIndex> _evictions;
+
+        TadCache();
+        ~TadCache() = default;
+
+        // key is [shapeInfo, dimensionLength, dimensions]
+        static std::vector<int> buildKey(int* shapeInfo, int* dimensions, int dimensionLength);
+    public:
+        static TadCache* getInstance();
+
+        /**
+         * This method returns TAD for given shapeInfo & dimensions, building it if it's not cached yet
+         */
+        std::shared_ptr<TadPack> tadForDimensions(int* shapeInfo, int* dimensions, int dimensionLength);
+        std::shared_ptr<TadPack> tadForDimensions(int* shapeInfo, std::vector<int>& dimensions);
+        std::shared_ptr<TadPack> tadForDimensions(int* shapeInfo, int dimension);
+
+        void setCapacity(int capacity);
+        int capacity();
+
+        int size();
+        void clear();
+
+        Nd4jIndex hits();
+        Nd4jIndex misses();
+        Nd4jIndex evictions();
+        void resetCounters();
+    };
+}
+
+#endif //LIBND4J_TADCACHE_H
@@ -0,0 +1,45 @@
+#ifndef LIBND4J_THRESHOLDTUNER_H
+#define LIBND4J_THRESHOLDTUNER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <Environment.h>
+
+// largest problem size used for calibration: elements for elementwise classes, TADs for TAD-based classes
+#define TUNER_MAX_LENGTH 4194304
+#define TUNER_MAX_TADS 16384
+
+// TAD length used for calibration of TAD-based classes
+#define TUNER_TAD_LENGTH 64
+
+// parallel execution has to be at least this much faster than serial one to be considered as crossover
+#define TUNER_MARGIN 0.9
+
+namespace nd4j {
+
+    /**
+     * This class micro-benchmarks representative op of every OP_CLASS_* and stores crossover sizes & thread counts in Environment,
+     * so loops consult tuned values instead of global ELEMENT_THRESHOLD/TAD_THRESHOLD.
+     *
+     * For each class serial and fully parallel execution are timed over growing problem sizes, threshold is picked as size
+     * where parallel execution starts to win. Then thread counts are timed on the largest size, and the best one is kept.
+     * Random ops reuse transform calibration.
+     */
+    class ND4J_EXPORT ThresholdTuner {
+    public:
+        /**
+         * Calibrates all op classes. Takes few seconds at most.
+         */
+        static void calibrate(int repeats = 5);
+
+        static void calibrateClass(int opClass, int repeats = 5);
+
+        /**
+         * Loads tuning profile from given file if it exists, otherwise calibrates and saves profile there.
+         * File name can be nullptr, then calibration results are kept in memory only.
+         */
+        static bool tune(const char *profile);
+    };
+}
+
+#endif //LIBND4J_THRESHOLDTUNER_H
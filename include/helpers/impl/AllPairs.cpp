@@ -0,0 +1,125 @@
+#include <helpers/AllPairs.h>
+#include <helpers/BlasHelper.h>
+#include <ops/gemm.h>
+#include <cstring>
+
+namespace nd4j {
+
+    template <typename T>
+    T* AllPairs<T>::rows(T *x, int *tadShapeInfo, Nd4jIndex *offsets, int numTads, int tadLength, std::vector<T> &holder) {
+        int ews = shape::elementWiseStride(tadShapeInfo);
+
+        // TADs are rows of contiguous matrix already: nothing to pack
+        bool contiguous = ews == 1;
+        for (int r = 0; r < numTads && contiguous; r++)
+            contiguous = offsets[r] == offsets[0] + (Nd4jIndex) r * tadLength;
+
+        if (contiguous)
+            return x + offsets[0];
+
+        holder.resize((size_t) numTads * tadLength);
+        T *packed = holder.data();
+
+        int *shape = shape::shapeOf(tadShapeInfo);
+        int *stride = shape::stride(tadShapeInfo);
+        int rank = shape::rank(tadShapeInfo);
+        char order = shape::order(tadShapeInfo);
+
+        int num_threads = nd4j::math::nd4j_max<int>(1, numTads / TAD_THRESHOLD_FOR(OP_CLASS_REDUCE3));
+        num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_REDUCE3));
+
+#pragma omp parallel for num_threads(num_threads) if (num_threads > 1) schedule(static) proc_bind(AFFINITY) default(shared)
+        for (int r = 0; r < numTads; r++) {
+            T *source = x + offsets[r];
+            T *target = packed + (Nd4jIndex) r * tadLength;
+
+            if (ews == 1) {
+                memcpy(target, source, tadLength * sizeof(T));
+            } else if (ews > 1) {
+                for (int f = 0; f < tadLength; f++)
+                    target[f] = source[(Nd4jIndex) f * ews];
+            } else {
+                // same element order as legacy execAll used: TAD's own order
+                int coords[MAX_RANK];
+                for (int f = 0; f < tadLength; f++) {
+                    if (order == 'c')
+                        shape::ind2subC(rank, shape, f, coords);
+                    else
+                        shape::ind2sub(rank, shape, f, coords);
+
+                    target[f] = source[shape::getOffset(0, shape, stride, coords, rank)];
+                }
+            }
+        }
+
+        return packed;
+    }
+
+    template <typename T>
+    void AllPairs<T>::squaredNorms(T *rows, int numRows, int length, T *norms) {
+        int num_threads = nd4j::math::nd4j_max<int>(1, numRows / TAD_THRESHOLD_FOR(OP_CLASS_REDUCE3));
+        num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_REDUCE3));
+
+#pragma omp parallel for num_threads(num_threads) if (num_threads > 1) schedule(static) proc_bind(AFFINITY) default(shared)
+        for (int r = 0; r < numRows; r++) {
+            T *row = rows + (Nd4jIndex) r * length;
+            T sum = (T) 0.0f;
+            for (int f = 0; f < length; f++)
+                sum += row[f] * row[f];
+
+            norms[r] = sum;
+        }
+    }
+
+    template <typename T>
+    void AllPairs<T>::dotProducts(T *x, int xRows, T *y, int yRows, int length, T *result, int ldc) {
+        // row-major C = X * Y^T, both X & Y are row-major [rows, length]
+        auto blas = BlasHelper::getInstance();
+        if (sizeof(T) == 4 && blas->template hasGEMM<float>())
+            blas->sgemm()(CblasRowMajor, CblasNoTrans, CblasTrans, xRows, yRows, length, 1.0f, (float *) x, length, (float *) y, length, 0.0f, (float *) result, ldc);
+        else if (sizeof(T) == 8 && blas->template hasGEMM<double>())
+            blas->dgemm()(CblasRowMajor, CblasNoTrans, CblasTrans, xRows, yRows, length, 1.0, (double *) x, length, (double *) y, length, 0.0, (double *) result, ldc);
+        else
+            nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasTrans, xRows, yRows, length, (T) 1.0f, x, length, y, length, (T) 0.0f, result, ldc);
+    }
+
+    template <typename T>
+    void AllPairs<T>::postProcess(int kind, T *result, int numCols, T xNorm, T *yNorms) {
+        switch (kind) {
+            case ALLPAIRS_EUCLIDEAN: {
+                    // |x - y|^2 = |x|^2 + |y|^2 - 2 x.y, rounding can make it slightly negative for near-equal vectors
+                    for (int c = 0; c < numCols; c++) {
+                        T sq = xNorm + yNorms[c] - (T) 2.0f * result[c];
+                        result[c] = nd4j::math::nd4j_sqrt<T>(nd4j::math::nd4j_max<T>(sq, (T) 0.0f));
+                    }
+                }
+                break;
+            case ALLPAIRS_COSINE_SIMILARITY: {
+                    T xLen = nd4j::math::nd4j_sqrt<T>(xNorm);
+                    for (int c = 0; c < numCols; c++)
+                        result[c] = result[c] / (xLen * nd4j::math::nd4j_sqrt<T>(yNorms[c]));
+                }
+                break;
+            case ALLPAIRS_COSINE_DISTANCE: {
+                    T xLen = nd4j::math::nd4j_sqrt<T>(xNorm);
+                    for (int c = 0; c < numCols; c++)
+                        result[c] = (T) 1.0f - result[c] / (xLen * nd4j::math::nd4j_sqrt<T>(yNorms[c]));
+                }
+                break;
+            default:
+                // dot products are final already
+                break;
+        }
+    }
+
+    template <typename T>
+    int AllPairs<T>::tileRows(int length) {
+        int tile = ALLPAIRS_TILE_BYTES / (nd4j::math::nd4j_max<int>(1, length) * (int) sizeof(T));
+        return nd4j::math::nd4j_max<int>(1, nd4j::math::nd4j_min<int>(tile, ALLPAIRS_TILE_MAX));
+    }
+
+
+    template class ND4J_EXPORT AllPairs<float>;
+    template class ND4J_EXPORT AllPairs<float16>;
+    template class ND4J_EXPORT AllPairs<double>;
+}
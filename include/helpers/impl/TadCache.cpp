@@ -0,0 +1,166 @@
+#include <helpers/TadCache.h>
+#include <helpers/TAD.h>
+#include <helpers/shape.h>
+#include <cstring>
+
+namespace nd4j {
+    TadPack::TadPack(int *tadOnlyShapeInfo, Nd4jIndex *tadOffsets, int numTads) {
+        _tadOnlyShapeInfo = tadOnlyShapeInfo;
+        _tadOffsets = tadOffsets;
+        _numTads = numTads;
+    }
+
+    TadPack::~TadPack() {
+        delete[] _tadOnlyShapeInfo;
+        delete[] _tadOffsets;
+    }
+
+    int* TadPack::tadOnlyShapeInfo() {
+        return _tadOnlyShapeInfo;
+    }
+
+    Nd4jIndex* TadPack::tadOffsets() {
+        return _tadOffsets;
+    }
+
+    int TadPack::numberOfTads() {
+        return _numTads;
+    }
+
+    size_t TadCache::KeyHash::operator()(const std::vector<int> &key) const {
+        // FNV-1a over key elements
+        uint64_t hash = 14695981039346656037ULL;
+        for (auto v: key) {
+            hash ^= (uint64_t) (unsigned int) v;
+            hash *= 1099511628211ULL;
+        }
+
+        return (size_t) hash;
+    }
+
+    TadCache::TadCache() {
+        _hits.store(0);
+        _misses.store(0);
+        _evictions.store(0);
+    }
+
+    TadCache* TadCache::getInstance() {
+        // function-local static is initialized exactly once, even if first calls are concurrent
+        static TadCache instance;
+        return &instance;
+    }
+
+    std::vector<int> TadCache::buildKey(int *shapeInfo, int *dimensions, int dimensionLength) {
+        int shapeLength = shape::shapeInfoLength(shape::rank(shapeInfo));
+
+        std::vector<int> key(shapeInfo, shapeInfo + shapeLength);
+        key.emplace_back(dimensionLength);
+        key.insert(key.end(), dimensions, dimensions + dimensionLength);
+
+        return key;
+    }
+
+    std::shared_ptr<TadPack> TadCache::tadForDimensions(int *shapeInfo, int *dimensions, int dimensionLength) {
+        auto key = buildKey(shapeInfo, dimensions, dimensionLength);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _map.find(key);
+            if (it != _map.end()) {
+                // moving entry to front
+                _lru.splice(_lru.begin(), _lru, it->second);
+                _hits++;
+                return it->second->second;
+            }
+        }
+
+        _misses++;
+
+        // TAD is built outside of the lock. TAD might modify dimensions, so it gets its own copy
+        std::vector<int> dims(dimensions, dimensions + dimensionLength);
+        shape::TAD tad(shapeInfo, dims.data(), dimensionLength);
+        tad.createTadOnlyShapeInfo();
+        tad.createOffsets();
+
+        int tadShapeLength = shape::shapeInfoLength(shape::rank(tad.tadOnlyShapeInfo));
+        auto tadShapeInfo = new int[tadShapeLength];
+        memcpy(tadShapeInfo, tad.tadOnlyShapeInfo, tadShapeLength * sizeof(int));
+
+        auto tadOffsets = new Nd4jIndex[tad.numTads];
+        memcpy(tadOffsets, tad.tadOffsets, tad.numTads * sizeof(Nd4jIndex));
+
+        std::shared_ptr<TadPack> pack(new TadPack(tadShapeInfo, tadOffsets, tad.numTads));
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // someone else might have built the same TAD meanwhile
+        auto it = _map.find(key);
+        if (it != _map.end()) {
+            _lru.splice(_lru.begin(), _lru, it->second);
+            return it->second->second;
+        }
+
+        _lru.emplace_front(key, pack);
+        _map[key] = _lru.begin();
+
+        while ((int) _lru.size() > _capacity) {
+            _map.erase(_lru.back().first);
+            _lru.pop_back();
+            _evictions++;
+        }
+
+        return pack;
+    }
+
+    std::shared_ptr<TadPack> TadCache::tadForDimensions(int *shapeInfo, std::vector<int> &dimensions) {
+        return tadForDimensions(shapeInfo, dimensions.data(), (int) dimensions.size());
+    }
+
+    std::shared_ptr<TadPack> TadCache::tadForDimensions(int *shapeInfo, int dimension) {
+        return tadForDimensions(shapeInfo, &dimension, 1);
+    }
+
+    void TadCache::setCapacity(int capacity) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _capacity = capacity < 1 ? 1 : capacity;
+        while ((int) _lru.size() > _capacity) {
+            _map.erase(_lru.back().first);
+            _lru.pop_back();
+            _evictions++;
+        }
+    }
+
+    int TadCache::capacity() {
+        return _capacity;
+    }
+
+    int TadCache::size() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return (int) _lru.size();
+    }
+
+    void TadCache::clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _map.clear();
+        _lru.clear();
+    }
+
+    Nd4jIndex TadCache::hits() {
+        return _hits.load();
+    }
+
+    Nd4jIndex TadCache::misses() {
+        return _misses.load();
+    }
+
+    Nd4jIndex TadCache::evictions() {
+        return _evictions.load();
+    }
+
+    void TadCache::resetCounters() {
+        _hits.store(0);
+        _misses.store(0);
+        _evictions.store(0);
+    }
+}
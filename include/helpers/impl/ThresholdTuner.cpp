@@ -0,0 +1,174 @@
+#include <helpers/ThresholdTuner.h>
+#include <NDArray.h>
+#include <ops/ops.h>
+#include <helpers/logger.h>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <memory>
+#include <omp.h>
+
+namespace nd4j {
+
+    static bool isTadClass(int opClass) {
+        return opClass == OP_CLASS_BROADCAST || opClass == OP_CLASS_REDUCE || opClass == OP_CLASS_INDEX_REDUCE || opClass == OP_CLASS_REDUCE3;
+    }
+
+    /**
+     * Runs representative op of given class once. Size is number of elements for elementwise classes, and number of TADs otherwise
+     */
+    static void runClass(int opClass, NDArray<float> &x, NDArray<float> &y, NDArray<float> &z, NDArray<float> &row) {
+        switch (opClass) {
+            case OP_CLASS_TRANSFORM:
+                x.template applyTransform<simdOps::Tanh<float>>(&z, nullptr);
+                break;
+            case OP_CLASS_PAIRWISE:
+                x.template applyPairwiseTransform<simdOps::Add<float>>(&y, &z, nullptr);
+                break;
+            case OP_CLASS_SCALAR:
+                x.template applyScalar<simdOps::Multiply<float>>(2.0f, &z, nullptr);
+                break;
+            case OP_CLASS_BROADCAST:
+                x.template applyBroadcast<simdOps::Add<float>>({1}, &row, &z, nullptr);
+                break;
+            case OP_CLASS_REDUCE: {
+                    std::unique_ptr<NDArray<float>> r(x.template reduceAlongDimension<simdOps::Sum<float>>({1}));
+                }
+                break;
+            case OP_CLASS_INDEX_REDUCE: {
+                    std::unique_ptr<NDArray<float>> r(x.template applyIndexReduce<simdOps::IndexMax<float>>({1}));
+                }
+                break;
+            case OP_CLASS_REDUCE3: {
+                    std::unique_ptr<NDArray<float>> r(x.template applyReduce3<simdOps::EuclideanDistance<float>>(&y, {1}));
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    static Nd4jIndex timeClass(int opClass, NDArray<float> &x, NDArray<float> &y, NDArray<float> &z, NDArray<float> &row, int repeats) {
+        // warmup
+        runClass(opClass, x, y, z, row);
+
+        Nd4jIndex best = LLONG_MAX;
+        for (int r = 0; r < repeats; r++) {
+            auto timeStart = std::chrono::steady_clock::now();
+            runClass(opClass, x, y, z, row);
+            auto timeEnd = std::chrono::steady_clock::now();
+
+            best = nd4j::math::nd4j_min<Nd4jIndex>(best, std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+        }
+
+        return best;
+    }
+
+    static void setThreshold(int opClass, int threshold) {
+        if (isTadClass(opClass))
+            Environment::getInstance()->setTadThreshold(opClass, threshold);
+        else
+            Environment::getInstance()->setElementwiseThreshold(opClass, threshold);
+    }
+
+    void ThresholdTuner::calibrateClass(int opClass, int repeats) {
+        if (opClass == OP_CLASS_RANDOM)
+            return;
+
+        auto env = Environment::getInstance();
+        int available = omp_get_max_threads();
+        bool tads = isTadClass(opClass);
+
+        int first = tads ? 2 : 256;
+        int last = tads ? TUNER_MAX_TADS : TUNER_MAX_LENGTH;
+
+        // everything is allowed during calibration, thresholds alone decide
+        env->setMaxThreads(opClass, 0);
+
+        int threshold = last;
+        bool found = false;
+        for (int n = first; n <= last; n *= 4) {
+            std::vector<int> shape = tads ? std::vector<int>({n, TUNER_TAD_LENGTH}) : std::vector<int>({1, n});
+            NDArray<float> x('c', shape);
+            NDArray<float> y('c', shape);
+            NDArray<float> z('c', shape);
+            NDArray<float> row('c', {1, TUNER_TAD_LENGTH});
+            x.assign(0.5f);
+            y.assign(0.25f);
+            row.assign(1.0f);
+
+            // serial: 0 threads per element/TAD is impossible, so single thread is used
+            setThreshold(opClass, INT_MAX);
+            auto serial = timeClass(opClass, x, y, z, row, repeats);
+
+            setThreshold(opClass, 1);
+            auto parallel = timeClass(opClass, x, y, z, row, repeats);
+
+            if (parallel < serial * TUNER_MARGIN) {
+                // so at crossover size at least 2 threads are used
+                threshold = nd4j::math::nd4j_max<int>(1, n / 2);
+                found = true;
+                break;
+            }
+        }
+
+        setThreshold(opClass, threshold);
+
+        // thread count is picked on the largest problem size. if parallel execution never wins, threshold alone keeps it serial
+        int bestThreads = available;
+        if (found && available > 1) {
+            std::vector<int> shape = tads ? std::vector<int>({last, TUNER_TAD_LENGTH}) : std::vector<int>({1, last});
+            NDArray<float> x('c', shape);
+            NDArray<float> y('c', shape);
+            NDArray<float> z('c', shape);
+            NDArray<float> row('c', {1, TUNER_TAD_LENGTH});
+            x.assign(0.5f);
+            y.assign(0.25f);
+            row.assign(1.0f);
+
+            Nd4jIndex bestTime = LLONG_MAX;
+            bestThreads = 1;
+            for (int t = 1; ; t = nd4j::math::nd4j_min<int>(t * 2, available)) {
+                env->setMaxThreads(opClass, t);
+                auto time = timeClass(opClass, x, y, z, row, repeats);
+
+                if (time < bestTime * TUNER_MARGIN) {
+                    bestTime = time;
+                    bestThreads = t;
+                }
+
+                if (t == available)
+                    break;
+            }
+        }
+
+        // 0 stands for "all available threads"
+        env->setMaxThreads(opClass, bestThreads == available ? 0 : bestThreads);
+
+        nd4j_debug("Op class [%i]: threshold [%i], threads [%i]\n", opClass, threshold, bestThreads);
+    }
+
+    void ThresholdTuner::calibrate(int repeats) {
+        for (int c = 0; c < OP_CLASS_COUNT; c++)
+            calibrateClass(c, repeats);
+
+        // random ops are elementwise, and their cost is comparable to transforms
+        auto env = Environment::getInstance();
+        env->setElementwiseThreshold(OP_CLASS_RANDOM, env->elementwiseThreshold(OP_CLASS_TRANSFORM));
+        int threads = env->maxThreads(OP_CLASS_TRANSFORM, INT_MAX);
+        env->setMaxThreads(OP_CLASS_RANDOM, threads == INT_MAX ? 0 : threads);
+    }
+
+    bool ThresholdTuner::tune(const char *profile) {
+        auto env = Environment::getInstance();
+        if (profile != nullptr && env->loadTuning(profile))
+            return true;
+
+        calibrate();
+
+        if (profile != nullptr)
+            return env->saveTuning(profile);
+
+        return true;
+    }
+}
@@ -242,9 +242,9 @@ namespace functions {
 
                 int zEWS = shape::elementWiseStride(tadShapeInfoZ);
 
-                int tadsPerThread = tads / TAD_THRESHOLD;
+                int tadsPerThread = tads / TAD_THRESHOLD_FOR(OP_CLASS_BROADCAST);
                 int _threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
-                _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
+                _threads = nd4j::math::nd4j_min<int>(_threads, MAX_THREADS_FOR(OP_CLASS_BROADCAST));
 
 #pragma omp parallel for schedule(guided) num_threads(_threads) if (_threads > 1) proc_bind(AFFINITY) default(shared)
                 for (int i = 0; i < tads; i++) {
@@ -0,0 +1,183 @@
+#include "../grid_fused.h"
+#include <op_boilerplate.h>
+#include <helpers/shape.h>
+#include <helpers/TAD.h>
+#include "../transform.h"
+#include "../scalar.h"
+#include "../pairwise_transform.h"
+
+#include "../legacy_ops.h"
+
+namespace functions {
+    namespace grid {
+
+        template <typename T>
+        template <typename OpType>
+        void GRIDFused<T>::transformBlock(T *x, Nd4jIndex xStride, T *z, Nd4jIndex zStride, T *extraParams, int length) {
+            if (xStride == 1 && zStride == 1) {
+#pragma omp simd
+                for (int e = 0; e < length; e++)
+                    z[e] = OpType::op(x[e], extraParams);
+            } else {
+#pragma omp simd
+                for (int e = 0; e < length; e++)
+                    z[e * zStride] = OpType::op(x[e * xStride], extraParams);
+            }
+        }
+
+        template <typename T>
+        template <typename OpType>
+        void GRIDFused<T>::scalarBlock(T *x, Nd4jIndex xStride, T *z, Nd4jIndex zStride, T scalar, T *extraParams, int length) {
+            if (xStride == 1 && zStride == 1) {
+#pragma omp simd
+                for (int e = 0; e < length; e++)
+                    z[e] = OpType::op(x[e], scalar, extraParams);
+            } else {
+#pragma omp simd
+                for (int e = 0; e < length; e++)
+                    z[e * zStride] = OpType::op(x[e * xStride], scalar, extraParams);
+            }
+        }
+
+        template <typename T>
+        template <typename OpType>
+        void GRIDFused<T>::pairwiseBlock(T *x, Nd4jIndex xStride, T *y, Nd4jIndex yStride, T *z, Nd4jIndex zStride, T *extraParams, int length) {
+            if (xStride == 1 && yStride == 1 && zStride == 1) {
+#pragma omp simd
+                for (int e = 0; e < length; e++)
+                    z[e] = OpType::op(x[e], y[e], extraParams);
+            } else {
+#pragma omp simd
+                for (int e = 0; e < length; e++)
+                    z[e * zStride] = OpType::op(x[e * xStride], y[e * yStride], extraParams);
+            }
+        }
+
+        template <typename T>
+        template <typename OpType>
+        void GRIDFused<T>::checkSpecial(bool *special) {
+            *special = OpType::requiresSpecial;
+        }
+
+        template <typename T>
+        void GRIDFused<T>::execBlock(int opType, int opNum, T *x, Nd4jIndex xStride, T *y, Nd4jIndex yStride, T *z, Nd4jIndex zStride, T scalar, T *extraParams, int length) {
+            if (opType == FUSED_OP_SCALAR) {
+                DISPATCH_BY_OPNUM(scalarBlock, PARAMS(x, xStride, z, zStride, scalar, extraParams, length), SCALAR_OPS);
+            } else if (opType == FUSED_OP_TRANSFORM) {
+                DISPATCH_BY_OPNUM(transformBlock, PARAMS(x, xStride, z, zStride, extraParams, length), TRANSFORM_OPS);
+            } else if (opType == FUSED_OP_PAIRWISE) {
+                DISPATCH_BY_OPNUM(pairwiseBlock, PARAMS(x, xStride, y, yStride, z, zStride, extraParams, length), PAIRWISE_TRANSFORM_OPS);
+            }
+        }
+
+        template <typename T>
+        bool GRIDFused<T>::isFusable(int opType, int opNum) {
+            if (opType == FUSED_OP_SCALAR || opType == FUSED_OP_PAIRWISE)
+                return true;
+
+            if (opType == FUSED_OP_TRANSFORM) {
+                bool special = true;
+                DISPATCH_BY_OPNUM(checkSpecial, PARAMS(&special), TRANSFORM_OPS);
+                return !special;
+            }
+
+            return false;
+        }
+
+        template <typename T>
+        void GRIDFused<T>::execStrided(int numOps, int *opTypes, int *opNums, T *dx, Nd4jIndex xStride, T **operands, Nd4jIndex *yStrides, T *dz, Nd4jIndex zStride, T *scalars, T **extraParams, Nd4jIndex N) {
+            if (numOps < 1 || N < 1)
+                return;
+
+            Nd4jIndex numBlocks = (N + FUSED_BLOCK_SIZE - 1) / FUSED_BLOCK_SIZE;
+
+            int elementsPerThread = N / ELEMENT_THRESHOLD_FOR(OP_CLASS_PAIRWISE);
+            int _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
+            _threads = nd4j::math::nd4j_min<int>(_threads, MAX_THREADS_FOR(OP_CLASS_PAIRWISE));
+
+#pragma omp parallel num_threads(_threads) if (_threads > 1) proc_bind(AFFINITY) default(shared)
+            {
+                // intermediate results of the chain live here
+                T buffer[FUSED_BLOCK_SIZE];
+
+#pragma omp for schedule(static)
+                for (Nd4jIndex b = 0; b < numBlocks; b++) {
+                    Nd4jIndex start = b * FUSED_BLOCK_SIZE;
+                    int length = (int) nd4j::math::nd4j_min<Nd4jIndex>(FUSED_BLOCK_SIZE, N - start);
+
+                    T *src = dx + start * xStride;
+                    Nd4jIndex srcStride = xStride;
+
+                    for (int o = 0; o < numOps; o++) {
+                        // only last op in chain writes to memory
+                        bool last = o == numOps - 1;
+                        T *dst = last ? dz + start * zStride : buffer;
+                        Nd4jIndex dstStride = last ? zStride : 1;
+
+                        T *y = nullptr;
+                        Nd4jIndex yStride = 0;
+                        if (opTypes[o] == FUSED_OP_PAIRWISE) {
+                            yStride = yStrides[o];
+                            y = operands[o] + start * yStride;
+                        }
+
+                        T scalar = scalars != nullptr ? scalars[o] : (T) 0.0f;
+                        T *extras = extraParams != nullptr ? extraParams[o] : nullptr;
+
+                        execBlock(opTypes[o], opNums[o], src, srcStride, y, yStride, dst, dstStride, scalar, extras, length);
+
+                        src = dst;
+                        srcStride = dstStride;
+                    }
+                }
+            }
+        }
+
+        template <typename T>
+        void GRIDFused<T>::execShaped(int numOps, int *opTypes, int *opNums, T *dx, int *xShapeInfo, T **operands, int **operandShapes, T *dz, int *zShapeInfo, T *scalars, T **extraParams) {
+            if (numOps < 1)
+                return;
+
+            Nd4jIndex N = shape::length(xShapeInfo);
+            char order = shape::order(xShapeInfo);
+
+            bool strided = shape::elementWiseStride(xShapeInfo) >= 1 && shape::elementWiseStride(zShapeInfo) >= 1 && shape::order(zShapeInfo) == order && shape::length(zShapeInfo) == N;
+
+            std::vector<Nd4jIndex> yStrides(numOps, 0L);
+            for (int o = 0; o < numOps && strided; o++) {
+                if (opTypes[o] != FUSED_OP_PAIRWISE)
+                    continue;
+
+                auto yShape = operandShapes[o];
+                strided = shape::elementWiseStride(yShape) >= 1 && shape::order(yShape) == order && shape::length(yShape) == N;
+                yStrides[o] = shape::elementWiseStride(yShape);
+            }
+
+            if (strided) {
+                execStrided(numOps, opTypes, opNums, dx, shape::elementWiseStride(xShapeInfo), operands, yStrides.data(), dz, shape::elementWiseStride(zShapeInfo), scalars, extraParams, N);
+                return;
+            }
+
+            // there's no way to walk all arrays with single stride, so ops are applied one by one: first one goes x -> z, others go z -> z
+            for (int o = 0; o < numOps; o++) {
+                T *src = o == 0 ? dx : dz;
+                int *srcShape = o == 0 ? xShapeInfo : zShapeInfo;
+
+                T scalar = scalars != nullptr ? scalars[o] : (T) 0.0f;
+                T *extras = extraParams != nullptr ? extraParams[o] : nullptr;
+
+                if (opTypes[o] == FUSED_OP_SCALAR) {
+                    functions::scalar::ScalarTransform<T>::transform(opNums[o], src, srcShape, dz, zShapeInfo, scalar, extras);
+                } else if (opTypes[o] == FUSED_OP_TRANSFORM) {
+                    functions::transform::Transform<T>::exec(opNums[o], src, srcShape, dz, zShapeInfo, extras, nullptr, nullptr);
+                } else if (opTypes[o] == FUSED_OP_PAIRWISE) {
+                    functions::pairwise_transforms::PairWiseTransform<T>::exec(opNums[o], src, srcShape, operands[o], operandShapes[o], dz, zShapeInfo, extras);
+                }
+            }
+        }
+
+        template class ND4J_EXPORT GRIDFused<float>;
+        template class ND4J_EXPORT GRIDFused<float16>;
+        template class ND4J_EXPORT GRIDFused<double>;
+    }
+}
@@ -27,9 +27,9 @@ namespace functions {
             int tadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
             int numTads =shape::length(xShapeInfo) / tadLength;
 
-            int tadsPerThread = numTads / TAD_THRESHOLD;
+            int tadsPerThread = numTads / TAD_THRESHOLD_FOR(OP_CLASS_SCALAR);
             int num_threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
-            num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
+            num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_SCALAR));
 
             // main loop, rolling along tads
 #pragma omp parallel for schedule(guided) num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared)
@@ -123,7 +123,7 @@ namespace functions {
                               int *indexes,
                               int *resultIndexes) {
             const Nd4jIndex n = shape::length(xShapeInfo);
-#pragma omp parallel for simd schedule(guided) if (n > ELEMENT_THRESHOLD) proc_bind(AFFINITY) default(shared)
+#pragma omp parallel for simd schedule(guided) if (n > ELEMENT_THRESHOLD_FOR(OP_CLASS_SCALAR)) proc_bind(AFFINITY) default(shared)
             for (Nd4jIndex i = 0; i < n; i++) {
                 result[resultIndexes[i]] = OpType::op(x[indexes[i]], scalar,extraParams);
             }
@@ -207,7 +207,7 @@ namespace functions {
                     int xOffset = shape::offset(xShapeInfo);
                     int resultOffset = shape::offset(resultShapeInfo);
 
-#pragma omp parallel for simd schedule(guided) if (n > ELEMENT_THRESHOLD) proc_bind(AFFINITY) default(shared)
+#pragma omp parallel for simd schedule(guided) if (n > ELEMENT_THRESHOLD_FOR(OP_CLASS_SCALAR)) proc_bind(AFFINITY) default(shared)
                     for (Nd4jIndex i = 0; i < n; i++) {
                         int *xIdx = shape::ind2sub(xRank, xShape, i);
                         int *resultIdx = shape::ind2sub(resultRank, resultShape, i);
@@ -230,18 +230,15 @@ namespace functions {
             template<typename T>
             template<typename OpType>
             void ScalarTransform<T>::transform(T *x, int xStride, T *result, int resultStride, T scalar, T *extraParams, const Nd4jIndex n) {
-/*
-                Nd4jIndex elementsPerThread = n / ELEMENT_THRESHOLD;
-                int num_threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-                num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
-*/
-                int num_threads = 1;
-                Nd4jIndex span = 100;// (n / num_threads) + 8;
+                Nd4jIndex elementsPerThread = n / ELEMENT_THRESHOLD_FOR(OP_CLASS_SCALAR);
+                int num_threads = (int) nd4j::math::nd4j_max<Nd4jIndex>(1, nd4j::math::nd4j_min<Nd4jIndex>(elementsPerThread, MAX_THREADS_FOR(OP_CLASS_SCALAR)));
 
                 if (xStride == 1 && resultStride == 1) {
                     if (num_threads > 1) {
 #pragma omp parallel num_threads(num_threads) if (num_threads>1) proc_bind(AFFINITY) default(shared)
                         {
+                            // we might get less threads than requested
+                            Nd4jIndex span = (n / omp_get_num_threads()) + 8;
                             Nd4jIndex tid = omp_get_thread_num();
                             Nd4jIndex start = span * tid;
                             Nd4jIndex end = span * (tid + 1);
@@ -263,6 +260,8 @@ namespace functions {
                     if (num_threads > 1) {
 #pragma omp parallel num_threads(num_threads) if (num_threads>1) proc_bind(AFFINITY) default(shared)
                         {
+                            // we might get less threads than requested
+                            Nd4jIndex span = (n / omp_get_num_threads()) + 8;
                             Nd4jIndex tid = omp_get_thread_num();
                             Nd4jIndex start = span * tid;
                             Nd4jIndex end = span * (tid + 1);
@@ -0,0 +1,82 @@
+#ifndef LIBND4J_GRID_FUSED_H
+#define LIBND4J_GRID_FUSED_H
+
+#include <dll.h>
+#include <pointercast.h>
+
+// number of elements processed by the whole chain at once. block of intermediate values stays in L1
+#define FUSED_BLOCK_SIZE 1024
+
+// op types, the same as used by execMetaPredicate* on cuda side
+#define FUSED_OP_SCALAR 0
+#define FUSED_OP_TRANSFORM 1
+#define FUSED_OP_PAIRWISE 2
+
+namespace functions {
+    namespace grid {
+        /**
+         * CPU meta-op engine: executes chain of elementwise legacy ops (Scalar, Transform, PairWise) as single pass over memory.
+         *
+         * Input is split into blocks of FUSED_BLOCK_SIZE elements, and each op of the chain is applied to the whole block
+         * before moving to next block, so intermediate results never leave cache.
+         * Op k reads result of op k - 1, PairWise ops use operands[k] as Y, Scalar ops use scalars[k].
+         *
+         * PLEASE NOTE: Transform ops with requiresSpecial (i.e. SoftMax) can't be fused, use isFusable() to check.
+         * @tparam T
+         */
+        template <typename T>
+        class ND4J_EXPORT GRIDFused {
+        private:
+            template<typename OpType>
+            static void transformBlock(T *x, Nd4jIndex xStride, T *z, Nd4jIndex zStride, T *extraParams, int length);
+
+            template<typename OpType>
+            static void scalarBlock(T *x, Nd4jIndex xStride, T *z, Nd4jIndex zStride, T scalar, T *extraParams, int length);
+
+            template<typename OpType>
+            static void pairwiseBlock(T *x, Nd4jIndex xStride, T *y, Nd4jIndex yStride, T *z, Nd4jIndex zStride, T *extraParams, int length);
+
+            template<typename OpType>
+            static void checkSpecial(bool *special);
+
+            static void execBlock(int opType, int opNum, T *x, Nd4jIndex xStride, T *y, Nd4jIndex yStride, T *z, Nd4jIndex zStride, T scalar, T *extraParams, int length);
+        public:
+            /**
+             * This method checks if given op can be part of fused chain
+             * @param opType - FUSED_OP_SCALAR, FUSED_OP_TRANSFORM or FUSED_OP_PAIRWISE
+             * @param opNum
+             * @return
+             */
+            static bool isFusable(int opType, int opNum);
+
+            /**
+             * This method executes chain over strided buffers
+             *
+             * @param numOps - number of ops in chain
+             * @param opTypes - op type per op
+             * @param opNums - op number per op
+             * @param dx - input of first op
+             * @param xStride
+             * @param operands - Y buffer per op, only used for PairWise ops
+             * @param yStrides - Y stride per op, only used for PairWise ops
+             * @param dz - output of last op, can be equal to dx
+             * @param zStride
+             * @param scalars - scalar per op, only used for Scalar ops
+             * @param extraParams - extra params per op, can be nullptr
+             * @param N - number of elements
+             */
+            static void execStrided(int numOps, int *opTypes, int *opNums, T *dx, Nd4jIndex xStride, T **operands, Nd4jIndex *yStrides, T *dz, Nd4jIndex zStride, T *scalars, T **extraParams, Nd4jIndex N);
+
+            /**
+             * This method executes chain over arrays described by shapeInfo.
+             * If all arrays have the same order and positive elementwise stride - single fused pass is used.
+             * Otherwise ops are applied one by one, in place over dz.
+             *
+             * @param operandShapes - Y shapeInfo per op, only used for PairWise ops
+             */
+            static void execShaped(int numOps, int *opTypes, int *opNums, T *dx, int *xShapeInfo, T **operands, int **operandShapes, T *dz, int *zShapeInfo, T *scalars, T **extraParams);
+        };
+    }
+}
+
+#endif //LIBND4J_GRID_FUSED_H
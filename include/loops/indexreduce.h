@@ -426,7 +426,7 @@ template<typename OpType>
 				else {
 
 					if (xElementWiseStride == 1) {
-						if(length < ELEMENT_THRESHOLD) {
+						if(length < ELEMENT_THRESHOLD_FOR(OP_CLASS_INDEX_REDUCE)) {
 // FIXME: proper reduction to be used here
 //#pragma omp simd
 							for (Nd4jIndex i = 0; i < length; i++) {
@@ -439,7 +439,7 @@ template<typename OpType>
 							return startingIndex.index;
 						}
 						else {
-							BlockInformation info(length, ELEMENT_THRESHOLD);
+							BlockInformation info(length, ELEMENT_THRESHOLD_FOR(OP_CLASS_INDEX_REDUCE));
 
 #pragma omp parallel num_threads(info.threads) if (info.threads > 1) default(shared)
 
@@ -517,7 +517,7 @@ template<typename OpType>
 				const Nd4jIndex resultLength = shape::length(resultShapeInfoBuffer);
 				IndexValue<T> *startingIndex = new IndexValue<T>[resultLength];
 
-#pragma omp parallel for schedule(guided) if (resultLength > TAD_THRESHOLD) default(shared)
+#pragma omp parallel for schedule(guided) if (resultLength > TAD_THRESHOLD_FOR(OP_CLASS_INDEX_REDUCE)) default(shared)
 				for (Nd4jIndex i = 0; i < resultLength; i++) {
 					IndexValue<T> val = OpType::startingIndexValue(x);
 					startingIndex[i] = val;
@@ -563,7 +563,7 @@ template<typename OpType>
 					int rank = shape::rank(tadShapeShapeInfo);
 
 
-#pragma omp  parallel for schedule(guided) if (resultLength > TAD_THRESHOLD) default(shared)
+#pragma omp  parallel for schedule(guided) if (resultLength > TAD_THRESHOLD_FOR(OP_CLASS_INDEX_REDUCE)) default(shared)
 					for(Nd4jIndex i = 0; i < resultLength; i++) {
                         Nd4jIndex offset = tadOffsets[i];
 
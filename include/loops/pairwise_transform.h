@@ -183,9 +183,9 @@ namespace functions {
                         int *resultShape = shape::shapeOf(resultShapeBuffer);
                         int *resultStride = shape::stride(resultShapeBuffer);
 
-                        int elementsPerThread = n / ELEMENT_THRESHOLD;
+                        int elementsPerThread = n / ELEMENT_THRESHOLD_FOR(OP_CLASS_PAIRWISE);
                         int num_threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-                        num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
+                        num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_PAIRWISE));
 
 #pragma omp parallel for schedule(guided) num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared) private(xCoord, resultCoord)
                         for (Nd4jIndex i = 0; i < n; i++) {
@@ -248,9 +248,9 @@ namespace functions {
 
                     // tad-oriented rotation technically
 
-                    int tadsPerThread = xShape[0] / TAD_THRESHOLD;
+                    int tadsPerThread = xShape[0] / TAD_THRESHOLD_FOR(OP_CLASS_PAIRWISE);
                     int num_threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
-                    num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
+                    num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_PAIRWISE));
 
 #pragma omp parallel for schedule(guided) num_threads(num_threads) if (num_threads>1) proc_bind(AFFINITY) default(shared)
 for (Nd4jIndex i = 0; i < xShape[0]; i++) {
@@ -327,9 +327,9 @@ for (Nd4jIndex i = 0; i < xShape[0]; i++) {
                     int *resultShape = shape::shapeOf(resultShapeBuffer);
                     int *resultStride = shape::stride(resultShapeBuffer);
 
-                    int elementsPerThread = n / ELEMENT_THRESHOLD;
+                    int elementsPerThread = n / ELEMENT_THRESHOLD_FOR(OP_CLASS_PAIRWISE);
                     int num_threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-                    num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
+                    num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_PAIRWISE));
 
                     int xCoord[MAX_RANK];
                     int yCoord[MAX_RANK];
@@ -374,9 +374,9 @@ for (Nd4jIndex i = 0; i < xShape[0]; i++) {
                              Nd4jIndex resultStride,
                              T *extraParams,
                              const Nd4jIndex n) {
-                int elementsPerThread = n / ELEMENT_THRESHOLD;
+                int elementsPerThread = n / ELEMENT_THRESHOLD_FOR(OP_CLASS_PAIRWISE);
                 int _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-                _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
+                _threads = nd4j::math::nd4j_min<int>(_threads, MAX_THREADS_FOR(OP_CLASS_PAIRWISE));
 
                 int span = (n / _threads) + 8;
 
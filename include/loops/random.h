@@ -124,9 +124,9 @@ namespace functions {
 
                 nd4j::random::RandomBuffer *buffer = reinterpret_cast<nd4j::random::RandomBuffer *> (state);
 
-                int elementsPerThread = length / ELEMENT_THRESHOLD;
+                int elementsPerThread = length / ELEMENT_THRESHOLD_FOR(OP_CLASS_RANDOM);
                 int _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-                _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
+                _threads = nd4j::math::nd4j_min<int>(_threads, MAX_THREADS_FOR(OP_CLASS_RANDOM));
 
                 if (xEWS >= 1 && yEWS >= 1 && zEWS >= 1) {
                     if (xEWS == 1 && yEWS == 1 && zEWS == 1) {
@@ -260,9 +260,9 @@ namespace functions {
 
                 nd4j::random::RandomBuffer *buffer = reinterpret_cast<nd4j::random::RandomBuffer *> (state);
 
-                Nd4jIndex elementsPerThread = length / ELEMENT_THRESHOLD;
+                Nd4jIndex elementsPerThread = length / ELEMENT_THRESHOLD_FOR(OP_CLASS_RANDOM);
                 Nd4jIndex _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-                _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
+                _threads = nd4j::math::nd4j_min<int>(_threads, MAX_THREADS_FOR(OP_CLASS_RANDOM));
 
                 if (xEWS >= 1 && zEWS >= 1) {
                     if (xEWS == 1 && zEWS == 1) {
@@ -369,9 +369,9 @@ namespace functions {
 
                 nd4j::random::RandomBuffer *buffer = reinterpret_cast<nd4j::random::RandomBuffer *> (state);
 
-                Nd4jIndex elementsPerThread = length / ELEMENT_THRESHOLD;
+                Nd4jIndex elementsPerThread = length / ELEMENT_THRESHOLD_FOR(OP_CLASS_RANDOM);
                 Nd4jIndex _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-                _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
+                _threads = nd4j::math::nd4j_min<int>(_threads, MAX_THREADS_FOR(OP_CLASS_RANDOM));
 
                 if (ews >= 1) {
                     if (ews == 1) {
@@ -537,9 +537,9 @@ template<typename OpType>
                 int numTads = shape::length(xShapeInfo) / tadLength;
                 int tadEWS = shape::elementWiseStride(tadOnlyShapeInfo);
 
-                int tadsPerThread = resultLength / TAD_THRESHOLD;
+                int tadsPerThread = resultLength / TAD_THRESHOLD_FOR(OP_CLASS_REDUCE);
                 int num_threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
-                num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
+                num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_REDUCE));
 
                 if (tadEWS > 0 && (numTads == 1 || shape::isVector(tadOnlyShapeInfo) || shape::isScalar(tadOnlyShapeInfo))) {
 
@@ -623,7 +623,7 @@ template<typename OpType>
             static T _CUDA_H execScalar(const T *x, int xElementWiseStride, Nd4jIndex length, T *extraParams) {
                 T startingVal = OpType::startingValue(x);
                 if (xElementWiseStride == 1) {
-                    if (length < ELEMENT_THRESHOLD) {
+                    if (length < ELEMENT_THRESHOLD_FOR(OP_CLASS_REDUCE)) {
                         T local = OpType::startingValue(x);
 
 // FIXME: proper reduction to be used here
@@ -639,7 +639,7 @@ template<typename OpType>
 
                     else {
                         T finalVal = startingVal;
-                        BlockInformation info(length, ELEMENT_THRESHOLD);
+                        BlockInformation info(length, ELEMENT_THRESHOLD_FOR(OP_CLASS_REDUCE));
                         T *blocks = new T[info.threads];
 
 #pragma omp parallel num_threads(info.threads) if (info.threads > 1) proc_bind(AFFINITY) default(shared)
@@ -684,7 +684,7 @@ template<typename OpType>
                 }
 
                 else {
-                    if (length < ELEMENT_THRESHOLD) {
+                    if (length < ELEMENT_THRESHOLD_FOR(OP_CLASS_REDUCE)) {
                         T local = OpType::startingValue(x);
 
 // FIXME: proper reduction should be used here
@@ -700,7 +700,7 @@ template<typename OpType>
                     }
 
                     T finalVal = startingVal;
-                    BlockInformation info(length, ELEMENT_THRESHOLD);
+                    BlockInformation info(length, ELEMENT_THRESHOLD_FOR(OP_CLASS_REDUCE));
                     T *blocks = new T[info.threads];
 
 
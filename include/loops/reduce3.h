@@ -22,6 +22,10 @@
 #include <ops/ops.h>
 #include <op_boilerplate.h>
 
+#ifndef __CUDACC__
+#include <helpers/AllPairs.h>
+#endif
+
 #ifdef __CUDACC__
 #include <cuda.h>
 #include <cuda_runtime.h>
@@ -932,65 +936,55 @@ template<typename OpType>
                 int xTads = shape::length(xShapeInfo) / xTadLength;
                 int yTads = shape::length(yShapeInfo) / yTadLength;
 
-                int *xShape = shape::shapeOf(xTadShapeInfo);
-                int *xStride = shape::stride(xTadShapeInfo);
-                int xRank = shape::rank(xTadShapeInfo);
-
-                int *yShape = shape::shapeOf(yTadShapeInfo);
-                int *yStride = shape::stride(yTadShapeInfo);
-                int yRank = shape::rank(yTadShapeInfo);
-
-
-                int xCoord[MAX_RANK];
-                int yCoord[MAX_RANK];
-
-                T startingVal = OpType::startingValue(x);
-
-#pragma  omp parallel for proc_bind(AFFINITY) default(shared) private(xCoord, yCoord)
-                for (int r = 0; r < xTads; r++) {
-                    Nd4jIndex xOffset = xOffsets[r];
-
-                    T *lX = x + xOffset;
-
-                    for (int g = 0; g < yTads; g++) {
-                        int yOffset = yOffsets[g];
-                        T *lY = y + yOffset;
-
-                        int ri = (r * yTads) + g;
-
-                        T *localExtraParams = nullptr;
-                        if (OpType::extraParamsLen > 0)
-                            localExtraParams = new T[OpType::extraParamsLen];
-                        for (int extraParamsIdx = 0; extraParamsIdx < OpType::extraParamsLen; extraParamsIdx++) {
-                            localExtraParams[extraParamsIdx] = startingVal;
-                        }
+                nd4j::AllPairs<T>::template exec<OpType>(x, xTadShapeInfo, xOffsets, xTads, y, yTadShapeInfo, yOffsets, yTads, xTadLength, extraParams, result);
+            }
 
-                        for (int f = 0; f < xTadLength; f++) {
-                            if (shape::order(yTadShapeInfo) == 'c') {
-                                shape::ind2subC(yRank, yShape, f, yCoord);
-                            } else {
-                                shape::ind2sub(yRank, yShape, f, yCoord);
-                            }
 
-                            if (shape::order(xTadShapeInfo) == 'c') {
-                                shape::ind2subC(xRank, xShape, f, xCoord);
-                            } else {
-                                shape::ind2sub(xRank, xShape, f, xCoord);
-                            }
-
-                            Nd4jIndex xO = shape::getOffset(0, xShape, xStride, xCoord, xRank);
-                            Nd4jIndex yO = shape::getOffset(0, yShape, yStride, yCoord, yRank);
+            /**
+             * Top-k variant of execAll: for every TAD of x only k best matching TADs of y are kept, sorted from best to worst.
+             * Similarities (dot, cosine similarity) prefer larger values, all other ops prefer smaller ones.
+             *
+             * @param values - [xTads, k] output values
+             * @param indices - [xTads, k] output indices of y TADs
+             */
+            template<typename OpType>
+            static void execAllTopK(
+                    T *x,
+                    int *xShapeInfo,
+                    T *extraParams,
+                    T *y,
+                    int *yShapeInfo,
+                    int *dimension,
+                    int dimensionLength, int *xTadShapeInfo, Nd4jIndex *xOffsets, int *yTadShapeInfo, Nd4jIndex *yOffsets,
+                    int k, T *values, Nd4jIndex *indices) {
 
-                            result[ri] = OpType::update(result[ri], OpType::op(lX[xO], lY[yO], localExtraParams), localExtraParams);
-                        }
+                int xTadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
+                int yTadLength = shape::tadLength(yShapeInfo, dimension, dimensionLength);
 
-                        result[ri] = OpType::postProcess(result[ri], xTadLength, localExtraParams);
+                int xTads = shape::length(xShapeInfo) / xTadLength;
+                int yTads = shape::length(yShapeInfo) / yTadLength;
 
-                        if (localExtraParams != nullptr)
-                            delete[] localExtraParams;
-                    }
-                }
+                nd4j::AllPairs<T>::template topK<OpType>(x, xTadShapeInfo, xOffsets, xTads, y, yTadShapeInfo, yOffsets, yTads, xTadLength, extraParams, k, values, indices);
+            }
 
+            static void execAllTopK(const int opNum,
+                              T *x,
+                              int *xShapeInfo,
+                              T *extraParamsVals,
+                              T *y,
+                              int *yShapeInfo,
+                              int *dimension,
+                              int dimensionLength,
+                              int *xTadShapeInfo, Nd4jIndex *xOffsets,
+                              int *yTadShapeInfo, Nd4jIndex *yOffsets,
+                              int k, T *values, Nd4jIndex *indices) {
+                DISPATCH_BY_OPNUM(execAllTopK, PARAMS(x,
+                                               xShapeInfo,
+                                               extraParamsVals,
+                                               y, yShapeInfo,
+                                               dimension,
+                                               dimensionLength, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets,
+                                               k, values, indices), REDUCE3_OPS);
             }
 
 
@@ -1137,9 +1131,6 @@ template<typename OpType>
                     }
                 }
                 else {
-                    T startingVal = OpType::startingValue(x);
-
-                    Nd4jIndex resultLength = shape::length(resultShapeInfoBuffer);
                     shape::TAD xTad(xShapeInfo, dimension, dimensionLength);
                     xTad.createTadOnlyShapeInfo();
                     xTad.createOffsets();
@@ -1149,76 +1140,95 @@ template<typename OpType>
                     yTad.createTadOnlyShapeInfo();
                     yTad.createOffsets();
 
-                    /**
-                     * The element wise stride belong longs to a reduction index.
-                     * When used out of order, we can get rid of the data
-                     * dependencies and rely on using the max dimension
-                     * specified for stride instead.
-                     * Say we take the sum(0,1) along long arr
-                     * we can use arr.stride(1) as a representation
-                     * along long which to iterate.
-                     */
-                    int tadElementWiseStride = shape::elementWiseStride(xTad.tadOnlyShapeInfo);
-                    int yElementWiseStride = shape::elementWiseStride(yTad.tadOnlyShapeInfo);
-                    int tadLength = shape::length(xTad.tadOnlyShapeInfo);
-                    if (tadElementWiseStride >= 1 && yElementWiseStride >= 1) {
-#pragma omp parallel for proc_bind(AFFINITY) default(shared)
-                        for (Nd4jIndex i = 0; i < resultLength; i++) {
-                            T *localExtraParams = nullptr;
-                            if (OpType::extraParamsLen > 0)
-                                localExtraParams = new T[OpType::extraParamsLen];
-                            for (int extraParamsIdx = 0; extraParamsIdx < OpType::extraParamsLen; extraParamsIdx++) {
-                                localExtraParams[extraParamsIdx] = startingVal;
-                            }
-
-                            Nd4jIndex offset = xTad.tadOffsets[i];
-                            Nd4jIndex yOffset = yTad.tadOffsets[i];
-                            result[i] = OpType::op(x[offset], y[yOffset], localExtraParams);
-                            for (int j = 1; j < tadLength; j++) {
-                                result[i] = OpType::update(result[i], OpType::op(x[offset + tadElementWiseStride * j],
-                                                                                 y[yOffset + yElementWiseStride * j],
-                                                                                 localExtraParams), localExtraParams);
-                            }
+                    exec<OpType>(x, xShapeInfo, extraParams, y, yShapeInfo, result, resultShapeInfoBuffer, dimension, dimensionLength, xTad.tadOnlyShapeInfo, xTad.tadOffsets, yTad.tadOnlyShapeInfo, yTad.tadOffsets);
+                }
+            }
 
-                            result[i] = OpType::postProcess(result[i], tadLength, localExtraParams);
+            /**
+             * Same as above, but uses precomputed TADs for both x and y (i.e. from TadCache)
+             */
+            template<typename OpType>
+            static void exec(
+                    T *x,
+                    int *xShapeInfo,
+                    T *extraParams,
+                    T *y,
+                    int *yShapeInfo,
+                    T *result,
+                    int *resultShapeInfoBuffer,
+                    int *dimension,
+                    int dimensionLength,
+                    int *xTadShapeInfo,
+                    Nd4jIndex *xTadOffsets,
+                    int *yTadShapeInfo,
+                    Nd4jIndex *yTadOffsets) {
 
-                            if (localExtraParams != nullptr)
-                                delete[] localExtraParams;
-                        }
-                    } else {
-                        shape::TAD xTad(xShapeInfo, dimension, dimensionLength);
-                        xTad.createTadOnlyShapeInfo();
-                        xTad.createOffsets();
+                T startingVal = OpType::startingValue(x);
 
+                Nd4jIndex resultLength = shape::length(resultShapeInfoBuffer);
 
-                        shape::TAD yTad(yShapeInfo, dimension, dimensionLength);
-                        yTad.createTadOnlyShapeInfo();
-                        yTad.createOffsets();
-                        int tadsPerThread = resultLength / TAD_THRESHOLD;
-                        int num_threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
-                        num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
+                /**
+                 * The element wise stride belong longs to a reduction index.
+                 * When used out of order, we can get rid of the data
+                 * dependencies and rely on using the max dimension
+                 * specified for stride instead.
+                 * Say we take the sum(0,1) along long arr
+                 * we can use arr.stride(1) as a representation
+                 * along long which to iterate.
+                 */
+                int tadElementWiseStride = shape::elementWiseStride(xTadShapeInfo);
+                int yElementWiseStride = shape::elementWiseStride(yTadShapeInfo);
+                int tadLength = shape::length(xTadShapeInfo);
+                int tadsPerThread = resultLength / TAD_THRESHOLD_FOR(OP_CLASS_REDUCE3);
+                int num_threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
+                num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_REDUCE3));
 
+                if (tadElementWiseStride >= 1 && yElementWiseStride >= 1 && shape::order(xTadShapeInfo) == shape::order(yTadShapeInfo)) {
 
-#pragma omp  parallel for schedule(guided) num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared)
-                        for (int i = 0; i < resultLength; i++) {
-                            Nd4jIndex xOffset = xTad.tadOffsets[i];
-                            Nd4jIndex yOffset = yTad.tadOffsets[i];
-                            int coord[MAX_RANK];
-
-                            T start = OpType::startingValue(x + xOffset);
-
-                            for (int j = 0; j < shape::length(xTad.tadOnlyShapeInfo); j++) {
-                                shape::ind2subC(shape::rank(xTad.tadOnlyShapeInfo), shape::shapeOf(xTad.tadOnlyShapeInfo), j, coord);
-                                int xOffset2 = shape::getOffset(xOffset,shape::shapeOf(xTad.tadOnlyShapeInfo),shape::stride(xTad.tadOnlyShapeInfo),coord,shape::rank(xTad.tadOnlyShapeInfo));
-                                int yOffset2 = shape::getOffset(yOffset,shape::shapeOf(yTad.tadOnlyShapeInfo),shape::stride(yTad.tadOnlyShapeInfo),coord,shape::rank(yTad.tadOnlyShapeInfo));
-                                start = OpType::update(start, OpType::op(x[xOffset2], y[yOffset2],extraParams), extraParams);
-                            }
+#pragma omp parallel for num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared)
+                    for (Nd4jIndex i = 0; i < resultLength; i++) {
+                        T *localExtraParams = nullptr;
+                        if (OpType::extraParamsLen > 0)
+                            localExtraParams = new T[OpType::extraParamsLen];
+                        for (int extraParamsIdx = 0; extraParamsIdx < OpType::extraParamsLen; extraParamsIdx++) {
+                            localExtraParams[extraParamsIdx] = startingVal;
+                        }
 
-                            result[i] = OpType::postProcess(start, shape::length(xTad.tadOnlyShapeInfo), extraParams);
+                        Nd4jIndex offset = xTadOffsets[i];
+                        Nd4jIndex yOffset = yTadOffsets[i];
+                        result[i] = OpType::op(x[offset], y[yOffset], localExtraParams);
+                        for (int j = 1; j < tadLength; j++) {
+                            result[i] = OpType::update(result[i], OpType::op(x[offset + tadElementWiseStride * j],
+                                                                             y[yOffset + yElementWiseStride * j],
+                                                                             localExtraParams), localExtraParams);
                         }
+
+                        result[i] = OpType::postProcess(result[i], tadLength, localExtraParams);
+
+                        if (localExtraParams != nullptr)
+                            delete[] localExtraParams;
                     }
+                } else {
+                    int tadRank = shape::rank(xTadShapeInfo);
+                    int *xTadShape = shape::shapeOf(xTadShapeInfo);
 
+#pragma omp  parallel for schedule(guided) num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared)
+                    for (int i = 0; i < resultLength; i++) {
+                        Nd4jIndex xOffset = xTadOffsets[i];
+                        Nd4jIndex yOffset = yTadOffsets[i];
+                        int coord[MAX_RANK];
+
+                        T start = OpType::startingValue(x + xOffset);
+
+                        for (int j = 0; j < tadLength; j++) {
+                            shape::ind2subC(tadRank, xTadShape, j, coord);
+                            Nd4jIndex xOffset2 = shape::getOffset(xOffset, xTadShape, shape::stride(xTadShapeInfo), coord, tadRank);
+                            Nd4jIndex yOffset2 = shape::getOffset(yOffset, shape::shapeOf(yTadShapeInfo), shape::stride(yTadShapeInfo), coord, shape::rank(yTadShapeInfo));
+                            start = OpType::update(start, OpType::op(x[xOffset2], y[yOffset2], extraParams), extraParams);
+                        }
 
+                        result[i] = OpType::postProcess(start, tadLength, extraParams);
+                    }
                 }
             }
 
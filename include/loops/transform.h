@@ -325,9 +325,9 @@ template<typename OpType>
                              T *extraParams,
                              const int n) {
 
-                int elementsPerThread = n / ELEMENT_THRESHOLD;
+                int elementsPerThread = n / ELEMENT_THRESHOLD_FOR(OP_CLASS_TRANSFORM);
                 int num_threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-                num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
+                num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_TRANSFORM));
 
                 int span = (n / num_threads) + 8;
 
@@ -27,6 +27,7 @@
 #include <types/int8.h>
 #include <types/int16.h>
 #include <types/uint16.h>
+#include <ops/specials.h>
 
 typedef union
 {
@@ -616,77 +617,12 @@ void convertToThreshold(void *dx, Nd4jIndex N, void *dz) {
     // integer: enc length
     // integer: dec length
     // float: threshold
-    FloatBits fb;
-    T *x = (T *) dx;
-    int *z = (int *) dz;
-    int limit = z[0];
-    fb.i_ = z[2];
-    float threshold = fb.f_;
-
-    // FIXME: int limit is sad thing here, 2B elements limitation
-    z[1] = (int) N;
-
-    // we use 3 as offset, since first 12 bytes are occupied with header
-    int flimit = limit + 4;
-    volatile int cnt = 4;
-    volatile bool flag = false;
-#pragma omp parallel for schedule(guided) default(shared)
-    for (int e = 0; e < N;  e++) {
-        bool flag_load;
-#pragma omp atomic read
-        flag_load = flag;
-        if (flag_load)
-            continue;
-
-        T cUpd = x[e];
-        if (cUpd >= (T) threshold) {
-            int idx;
-#pragma omp atomic capture
-            idx = cnt++;
-
-            if (idx >= flimit) {
-#pragma omp atomic write
-                flag = true;
-                continue;
-            }
-
-            z[idx] = e + 1;
-            x[e] -= (T) threshold;
-        } else if (cUpd <= (T) -threshold) {
-            int idx;
-#pragma omp atomic capture
-            idx = cnt++;
-
-            if (idx >= flimit) {
-#pragma omp atomic write
-                flag = true;
-                continue;
-            }
-
-            z[idx] = -e - 1;
-            x[e] += (T) threshold;
-        }
-    }
+    nd4j::SpecialMethods<T>::encodeThresholdGeneric((T *) dx, N, (int *) dz);
 }
 
 template <typename T>
 void convertFromThreshold(void *dx, Nd4jIndex N, void *dz) {
-    FloatBits fb;
-    T *z = (T *) dz;
-    int *x = (int *) dx;
-    int limit = x[0];
-    fb.i_ = x[2];
-    float threshold = fb.f_;
-
-    // we use 3 as offset, since first 12 bytes are occupied with header
-    int flimit = limit + 4;
-
-#pragma omp parallel for schedule(guided)
-    for (int e = 4; e < flimit; e++) {
-        int el = x[e];
-        int ael = nd4j::math::nd4j_abs<int>(el) - 1;
-        z[ael] += el > 0 ? threshold : -threshold;
-    }
+    nd4j::SpecialMethods<T>::decodeThresholdGeneric(dx, N, (T *) dz);
 }
 
 /*
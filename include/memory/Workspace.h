@@ -15,6 +15,12 @@
 #include <pointercast.h>
 #include <types/float16.h>
 
+// all pointers returned by Workspace are aligned to this number of bytes
+#define WORKSPACE_ALIGNMENT 64
+
+// minimal size of spill chunk
+#define WORKSPACE_MIN_SPILL_CHUNK 65536
+
 namespace nd4j {
     namespace memory {
 
@@ -25,13 +31,22 @@ namespace nd4j {
             DEVICE,
         };
 
+        /**
+         * CPU workspace is a bump allocator over single memory block:
+         * - pointers returned by allocateBytes are always aligned to WORKSPACE_ALIGNMENT bytes
+         * - shared offset is advanced with CAS, so allocations never take a lock unless block is exhausted
+         * - optionally, each thread carves its own sub-arena out of the block, and allocates within it without any atomics
+         * - allocations that don't fit into the block go to chained spill chunks, which grow geometrically
+         *
+         * On scopeIn() spills are released, and block is resized to fit everything allocated during previous cycle.
+         */
         class ND4J_EXPORT Workspace {
         protected:
-            char* _ptrHost;
-            char* _ptrDevice;
+            char* _ptrHost = nullptr;
+            char* _ptrDevice = nullptr;
 
-            bool _allocatedHost;
-            bool _allocatedDevice;
+            bool _allocatedHost = false;
+            bool _allocatedDevice = false;
 
             std::atomic<Nd4jIndex> _offset;
 
@@ -41,13 +56,34 @@ namespace nd4j {
             std::mutex _mutexAllocation;
             std::mutex _mutexSpills;
 
-            std::vector<void*> _spills;
+            struct SpillChunk {
+                char* _ptr;
+                Nd4jIndex _size;
+                Nd4jIndex _offset;
+            };
+
+            // spill chunks, last one is the one being filled
+            std::vector<SpillChunk> _spills;
 
             std::atomic<Nd4jIndex> _spillsSize;
             std::atomic<Nd4jIndex> _cycleAllocations;
 
+            // counters
+            std::atomic<Nd4jIndex> _spillsCount;
+            std::atomic<Nd4jIndex> _contention;
+
+            // unique id of this workspace & its current cycle, used to invalidate per-thread sub-arenas
+            Nd4jIndex _id;
+            std::atomic<Nd4jIndex> _generation;
+
+            // size of per-thread sub-arena, 0 means sub-arenas are disabled
+            Nd4jIndex _threadArenaSize = 0;
+
             void init(Nd4jIndex bytes);
             void freeSpills();
+
+            void* allocateShared(Nd4jIndex numBytes);
+            void* allocateSpill(Nd4jIndex numBytes);
         public:
             Workspace(Nd4jIndex initialSize = 0);
             ~Workspace();
@@ -56,6 +92,28 @@ namespace nd4j {
             Nd4jIndex getCurrentOffset();
             Nd4jIndex getSpilledSize();
 
+            /**
+             * Number of allocations that didn't fit into main block
+             */
+            Nd4jIndex getSpillsCount();
+
+            /**
+             * Number of spill chunks allocated during current cycle
+             */
+            Nd4jIndex getSpillChunks();
+
+            /**
+             * Number of failed attempts to advance shared offset, caused by concurrent allocations
+             */
+            Nd4jIndex getContentionCount();
+
+            /**
+             * This method enables per-thread sub-arenas of given size. 0 disables them.
+             * Allocations bigger than quarter of sub-arena always go to shared block.
+             */
+            void setThreadArenaSize(Nd4jIndex bytes);
+            Nd4jIndex getThreadArenaSize();
+
 //            bool resizeSupported();
 
             void* allocateBytes(Nd4jIndex numBytes);
@@ -16,9 +16,43 @@
 namespace nd4j {
     namespace memory {
 
+        // per-thread sub-arena. each thread keeps one, for the workspace it used last
+        struct ThreadArena {
+            Nd4jIndex _id = -1;
+            Nd4jIndex _generation = -1;
+            char* _ptr = nullptr;
+            Nd4jIndex _size = 0;
+            Nd4jIndex _offset = 0;
+        };
+
+        static thread_local ThreadArena _threadArena;
+
+        static std::atomic<Nd4jIndex> _workspaceIds(0);
+
+        static inline Nd4jIndex alignedLength(Nd4jIndex numBytes) {
+            return (numBytes + WORKSPACE_ALIGNMENT - 1) / WORKSPACE_ALIGNMENT * WORKSPACE_ALIGNMENT;
+        }
+
+        // original pointer is stored right before aligned one
+        static void* alignedMalloc(Nd4jIndex numBytes) {
+            char* raw = (char *) malloc(numBytes + WORKSPACE_ALIGNMENT + sizeof(void*));
+            if (raw == nullptr)
+                return nullptr;
+
+            auto aligned = (char *) alignedLength((Nd4jIndex) (raw + sizeof(void*)));
+            reinterpret_cast<void**>(aligned)[-1] = raw;
+
+            return aligned;
+        }
+
+        static void alignedFree(void* ptr) {
+            if (ptr != nullptr)
+                free(reinterpret_cast<void**>(ptr)[-1]);
+        }
+
         Workspace::Workspace(Nd4jIndex initialSize) {
             if (initialSize > 0) {
-                this->_ptrHost = (char *) malloc(initialSize);
+                this->_ptrHost = (char *) alignedMalloc(initialSize);
 
                 if (this->_ptrHost == nullptr)
                     throw "Workspace allocation failed";
@@ -32,14 +66,22 @@ namespace nd4j {
             this->_offset = 0;
             this->_cycleAllocations = 0;
             this->_spillsSize = 0;
+            this->_spillsCount = 0;
+            this->_contention = 0;
+            this->_id = _workspaceIds++;
+            this->_generation = 0;
         }
 
         void Workspace::init(Nd4jIndex bytes) {
             if (this->_currentSize < bytes) {
                 if (this->_allocatedHost)
-                    free((void *)this->_ptrHost);
+                    alignedFree(this->_ptrHost);
+
+                this->_ptrHost =(char *) alignedMalloc(bytes);
+
+                if (this->_ptrHost == nullptr)
+                    throw "Workspace allocation failed";
 
-                this->_ptrHost =(char *) malloc(bytes);
                 this->_currentSize = bytes;
                 this->_allocatedHost = true;
             }
@@ -47,19 +89,20 @@ namespace nd4j {
 
         void Workspace::freeSpills() {
             _spillsSize = 0;
+            _spillsCount = 0;
 
             if (_spills.size() < 1)
                 return;
 
-            for (auto v:_spills)
-                free(v);
+            for (auto &v:_spills)
+                alignedFree(v._ptr);
 
             _spills.clear();
         }
 
         Workspace::~Workspace() {
             if (this->_allocatedHost)
-                free((void *)this->_ptrHost);
+                alignedFree(this->_ptrHost);
 
             freeSpills();
         }
@@ -73,48 +116,125 @@ namespace nd4j {
             return _offset.load();
         }
 
+        void* Workspace::allocateShared(Nd4jIndex numBytes) {
+            auto offset = _offset.load();
 
-        void* Workspace::allocateBytes(Nd4jIndex numBytes) {
-            void* result = nullptr;
-            this->_cycleAllocations += numBytes;
-            this->_mutexAllocation.lock();
+            do {
+                if (offset + numBytes > _currentSize)
+                    return nullptr;
 
-            if (_offset.load() + numBytes > _currentSize) {
-                this->_mutexAllocation.unlock();
+                // on failure offset is updated with the actual value, so we just retry
+                if (_offset.compare_exchange_weak(offset, offset + numBytes))
+                    return (void *) (_ptrHost + offset);
+
+                _contention++;
+            } while (true);
+        }
 
-                void *p = malloc(numBytes);
+        void* Workspace::allocateSpill(Nd4jIndex numBytes) {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
 
-                _mutexSpills.lock();
-                _spills.push_back(p);
-                _mutexSpills.unlock();
+            if (_spills.empty() || _spills.back()._offset + numBytes > _spills.back()._size) {
+                // each next chunk is at least twice bigger than previous one
+                Nd4jIndex chunkSize = nd4j::math::nd4j_max<Nd4jIndex>(WORKSPACE_MIN_SPILL_CHUNK, numBytes);
+                if (!_spills.empty())
+                    chunkSize = nd4j::math::nd4j_max<Nd4jIndex>(chunkSize, _spills.back()._size * 2);
 
-                _spillsSize += numBytes;
+                SpillChunk chunk;
+                chunk._ptr = (char *) alignedMalloc(chunkSize);
+                chunk._size = chunkSize;
+                chunk._offset = 0;
 
-                return p;
+                if (chunk._ptr == nullptr)
+                    throw "Workspace spill allocation failed";
+
+                _spills.emplace_back(chunk);
             }
 
-            _offset += numBytes;
-            result = (void *)(_ptrHost + _offset.load());
+            auto &chunk = _spills.back();
+            auto result = chunk._ptr + chunk._offset;
+            chunk._offset += numBytes;
+
+            return (void *) result;
+        }
 
-            this->_mutexAllocation.unlock();
+        void* Workspace::allocateBytes(Nd4jIndex numBytes) {
+            // everything is padded, so next allocation stays aligned as well
+            auto length = alignedLength(numBytes);
+
+            if (_threadArenaSize > 0 && length <= _threadArenaSize / 4) {
+                auto &arena = _threadArena;
+
+                if (arena._id != _id || arena._generation != _generation.load() || arena._offset + length > arena._size) {
+                    // shared block is consumed by whole sub-arenas, so that's what next cycle has to fit
+                    this->_cycleAllocations += _threadArenaSize;
+
+                    // carving new sub-arena out of the shared block. if block is exhausted, arena still tracks its usage, but memory comes from spills
+                    arena._id = _id;
+                    arena._generation = _generation.load();
+                    arena._ptr = (char *) allocateShared(_threadArenaSize);
+                    arena._size = _threadArenaSize;
+                    arena._offset = 0;
+                }
+
+                auto result = arena._ptr + arena._offset;
+                arena._offset += length;
+
+                if (arena._ptr != nullptr)
+                    return (void *) result;
+            } else {
+                this->_cycleAllocations += length;
+
+                auto result = allocateShared(length);
+                if (result != nullptr)
+                    return result;
+            }
 
-            return result;
+            // spilled size is reported in requested bytes
+            _spillsSize += numBytes;
+            _spillsCount++;
+
+            return allocateSpill(length);
         }
 
         void Workspace::scopeIn() {
             freeSpills();
             init(_cycleAllocations.load());
             _cycleAllocations = 0;
+            _generation++;
         }
 
         void Workspace::scopeOut() {
             _offset = 0;
+            _generation++;
         }
 
         Nd4jIndex Workspace::getSpilledSize() {
             return _spillsSize.load();
         }
 
+        Nd4jIndex Workspace::getSpillsCount() {
+            return _spillsCount.load();
+        }
+
+        Nd4jIndex Workspace::getSpillChunks() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+            return (Nd4jIndex) _spills.size();
+        }
+
+        Nd4jIndex Workspace::getContentionCount() {
+            return _contention.load();
+        }
+
+        void Workspace::setThreadArenaSize(Nd4jIndex bytes) {
+            _threadArenaSize = bytes > 0 ? alignedLength(bytes) : 0;
+            _generation++;
+        }
+
+        Nd4jIndex Workspace::getThreadArenaSize() {
+            return _threadArenaSize;
+        }
+
         void* Workspace::allocateBytes(nd4j::memory::MemoryType type, Nd4jIndex numBytes) {
             if (type == DEVICE)
                 throw "CPU backend doesn't have device memory";
@@ -129,4 +249,3 @@ namespace nd4j {
         }
     }
 }
-
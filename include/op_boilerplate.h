@@ -52,6 +52,11 @@
 #define ELEMENT_THRESHOLD nd4j::Environment::getInstance()->elementwiseThreshold()
 #define TAD_THRESHOLD nd4j::Environment::getInstance()->tadThreshold()
 
+// per op class thresholds, see OP_CLASS_* in Environment.h. Tuned values are used if available, global ones otherwise
+#define ELEMENT_THRESHOLD_FOR(OP_CLASS) nd4j::Environment::getInstance()->elementwiseThreshold(OP_CLASS)
+#define TAD_THRESHOLD_FOR(OP_CLASS) nd4j::Environment::getInstance()->tadThreshold(OP_CLASS)
+#define MAX_THREADS_FOR(OP_CLASS) nd4j::Environment::getInstance()->maxThreads(OP_CLASS, omp_get_max_threads())
+
 #define EXTRACT(...) EXTRACT __VA_ARGS__ 
 #define NOTHING_EXTRACT 
 #define PASTE(x, ...) x ## __VA_ARGS__ 
@@ -1378,6 +1383,7 @@ struct __registratorDouble_##NAME {\
 
 #define OVERWRITE_RESULT(A)     this->overwriteResult(block, 0, A)
 #define OVERWRITE_2_RESULTS(A, B)     this->overwriteResult(block, 0, A); this->overwriteResult(block, 1, B)
+#define OVERWRITE_3_RESULTS(A, B, C)     this->overwriteResult(block, 0, A); this->overwriteResult(block, 1, B); this->overwriteResult(block, 2, C)
 #define STORE_RESULT(A)     this->storeResult(block, 0, A)
 #define STORE_2_RESULTS(A, B)   this->storeResult(block, 0, A); this->storeResult(block, 1, B)
 #define STORE_3_RESULTS(A, B, C)    this->storeResult(block, 0, A); this->storeResult(block, 1, B); this->storeResult(block, 2, C)
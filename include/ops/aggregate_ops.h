@@ -6,6 +6,7 @@
 
 #include <ops/ops.h>
 #include <templatemath.h>
+#include <vector>
 
 #define HS_MAX_EXP 6.0f
 
@@ -27,6 +28,18 @@
  */
 namespace aggregateOps {
 
+    /**
+     * Per-thread heap scratch for SkipGram/CBOW: it only grows, and is reused by subsequent calls on the same thread
+     */
+    template<typename T>
+    inline T* threadScratch(int length) {
+        static thread_local std::vector<T> scratch;
+        if ((int) scratch.size() < length)
+            scratch.resize(length);
+
+        return scratch.data();
+    }
+
     template<typename T>
     class GEMM {
     public:
@@ -475,7 +488,7 @@ namespace aggregateOps {
             int isInference = indexArguments[8];
 
 
-            T *neu1e = new T[vectorLength];
+            T *neu1e = threadScratch<T>(vectorLength);
             std::memset(neu1e, 0, sizeof(T) * vectorLength);
 
             T *args[4];
@@ -550,8 +563,6 @@ namespace aggregateOps {
                     inferenceVector[x] += neu1e[x];
                 }
             }
-
-            delete[] neu1e;
         }
 
 #ifdef __CUDACC__
@@ -701,8 +712,8 @@ namespace aggregateOps {
             int *codes = intArrays[2];
 
 
-            T *neu1 = new T[vectorLength];
-            T *neu1e = new T[vectorLength];
+            T *neu1 = threadScratch<T>(vectorLength * 2);
+            T *neu1e = neu1 + vectorLength;
             std::memset(neu1, 0, sizeof(T) * vectorLength);
             std::memset(neu1e, 0, sizeof(T) * vectorLength);
 
@@ -804,9 +815,6 @@ namespace aggregateOps {
             }
 
 
-
-            delete[] neu1;
-            delete[] neu1e;
         }
 
 
@@ -151,6 +151,7 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(select, 3, 1, false, 0, 0);
         DECLARE_CUSTOM_OP(shape_of, 1, 1, false, 0, 0);
         DECLARE_CUSTOM_OP(gather, 2, 1, false, 0, 1);
+        DECLARE_CUSTOM_OP(embedding_bag, 2, 1, false, 0, 0);
         DECLARE_CUSTOM_OP(crelu, 1, 1, false, 0, 0);        
         DECLARE_CUSTOM_OP(crelu_bp, 2, 1, false, 0, 0);
         DECLARE_CUSTOM_OP(biasadd_bp, 3, 2, false, 0, 0);
@@ -166,6 +167,7 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(softmaxCrossEntropy, 3, 1, false, 1, 1);      
         DECLARE_CUSTOM_OP(batchnorm, 5, 1, false, 1, 2);
         DECLARE_CUSTOM_OP(unique, 1, 2, false, 0, 0);
+        DECLARE_CUSTOM_OP(unique_with_counts, 1, 3, false, 0, 0);
         DECLARE_CUSTOM_OP(lstmCell, 8, 2, false, 3, 2);
         DECLARE_CUSTOM_OP(set_seed, -2, 1, false, 0, -2);
         DECLARE_CUSTOM_OP(get_seed, -2, 1, false, 0, 0);
@@ -183,6 +185,8 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(sru_bp,      8, 4, true,  0, 0);
         DECLARE_CUSTOM_OP(sru_bp_logic,8, 4, true,  0, 0);
         DECLARE_CUSTOM_OP(sru_bi_bp,   8, 4, true,  0, 0);
+        DECLARE_CUSTOM_OP(lstm,        8, 2, false, 3, 2);
+        DECLARE_CUSTOM_OP(lstm_bp,     9, 8, false, 3, 2);
                 
         DECLARE_CONFIGURABLE_OP(clipbyvalue, 1, 1, true, 2, 0);
         DECLARE_CONFIGURABLE_OP(clipbynorm, 1, 1, true, 1, 0);
@@ -14,6 +14,7 @@
 #include <helpers/helper_hash.h>
 #include <array/ShapeList.h>
 #include <array/ResultSet.h>
+#include <ops/declarable/ShapeCache.h>
 //#include <ops/declarable/declarable_ops.h>
 
 #include <chrono>
@@ -87,6 +88,14 @@ namespace nd4j {
             */
             bool prepareOutputs(Context<T>& block);
 
+            /**
+             * This method returns output shapes for given input shapes, using ShapeCache whenever possible
+             */
+            std::shared_ptr<ShapePack> inferOutputShape(ShapeList* inputShape, Context<T>& block);
+
+            // op identity for ShapeCache
+            Nd4jIndex shapeCacheHash();
+
             //std::vector<int>* calculateOutputShape(std::vector<int>* inputShape, nd4j::graph::Block<T>& block);
         public:
             // for special cases, like BooleanOps
@@ -112,6 +121,12 @@ namespace nd4j {
             */
             virtual ShapeList* calculateOutputShape(ShapeList* inputShape, nd4j::graph::Context<T>& block) = 0;
 
+            /**
+             * This method returns output shapes previously cached for given input shapes and arguments, or nullptr if there's nothing cached yet.
+             * Shape function is never called here.
+             */
+            std::shared_ptr<ShapePack> cachedOutputShape(ShapeList* inputShape, std::vector<T>& tArgs, std::vector<int>& iArgs);
+
             /**
              * Returns opName
              *
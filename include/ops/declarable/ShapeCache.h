@@ -0,0 +1,102 @@
+#ifndef LIBND4J_SHAPECACHE_H
+#define LIBND4J_SHAPECACHE_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <array/ShapeList.h>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nd4j {
+    namespace ops {
+        /**
+         * This class holds output shapeInfos of one op invocation. Instances are immutable, and shared between all users of the same key.
+         */
+        class ND4J_EXPORT ShapePack {
+        protected:
+            std::vector<int*> _shapes;
+        public:
+            // shapes are copied, so original ShapeList can be destroyed as usual
+            explicit ShapePack(ShapeList* shapes);
+            ~ShapePack();
+
+            int size();
+
+            // pointers are non-const only because NDArray constructors want it that way. don't modify contents.
+            int* at(int idx);
+            std::vector<int*>& shapes();
+        };
+
+        /**
+         * This class is process-wide LRU cache for output shapes of DeclarableOps, keyed by op hash, input shapes and op arguments.
+         *
+         * Shape functions that read input arrays (not only their shapes) are detected on first call, and their ops are never cached.
+         */
+        class ND4J_EXPORT ShapeCache {
+        private:
+            struct KeyHash {
+                size_t operator()(const std::vector<int>& key) const;
+            };
+
+            typedef std::pair<std::vector<int>, std::shared_ptr<ShapePack>> Entry;
+
+            // most recently used entries are kept at front
+            std::list<Entry> _lru;
+            std::unordered_map<std::vector<int>, std::list<Entry>::iterator, KeyHash> _map;
+            std::unordered_set<Nd4jIndex> _uncacheable;
+            std::mutex _mutex;
+
+            int _capacity = 4096;
+            std::atomic<bool> _enabled;
+
+            std::atomic<Nd4jIndex> _hits;
+            std::atomic<Nd4jIndex> _misses;
+
+            ShapeCache();
+            ~ShapeCache() = default;
+        public:
+            static ShapeCache* getInstance();
+
+            /**
+             * This method builds cache key: [opHash, sizeOfT, numInputs, input shapeInfos, numIArgs, iArgs, numTArgs, tArgs bytes]
+             *
+             * @param tArgs - raw T arguments, compared bitwise
+             * @param tArgsBytes - size of tArgs in bytes
+             */
+            static std::vector<int> buildKey(Nd4jIndex opHash, int sizeOfT, ShapeList* inputShapes, std::vector<int>* iArgs, void* tArgs, int tArgsBytes);
+
+            /**
+             * This method returns cached shapes for given key, or nullptr
+             */
+            std::shared_ptr<ShapePack> lookup(const std::vector<int>& key);
+
+            /**
+             * This method stores copy of given shapes, and returns it
+             */
+            std::shared_ptr<ShapePack> store(const std::vector<int>& key, ShapeList* shapes);
+
+            bool isCacheable(Nd4jIndex opHash);
+            void markUncacheable(Nd4jIndex opHash);
+
+            bool isEnabled();
+            void setEnabled(bool reallyEnabled);
+
+            void setCapacity(int capacity);
+            int capacity();
+
+            int size();
+            void clear();
+
+            Nd4jIndex hits();
+            Nd4jIndex misses();
+            void resetCounters();
+        };
+    }
+}
+
+#endif //LIBND4J_SHAPECACHE_H
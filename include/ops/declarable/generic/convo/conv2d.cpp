@@ -10,6 +10,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <declarable/generic/helpers/convolutions.h>
+#include <ops/declarable/helpers/conv2d.h>
 
 
 
@@ -65,6 +66,25 @@ namespace nd4j {
             REQUIRE_TRUE(output->sizeAt(0) == batchSize && output->sizeAt(1) == outDepth && output->sizeAt(2) == oY && output->sizeAt(3) == oX, 0, "Expected output shape is [%i, %i, %i, %i] but got [%i, %i, %i, %i] instead", batchSize, outDepth, oY, oX, output->sizeAt(0), output->sizeAt(1), output->sizeAt(2), output->sizeAt(3))
             REQUIRE_TRUE(output->lengthOf() == prod, 0, "Z should have total length of %i, but got %i instead", prod, output->lengthOf());
 
+            // optional 10th argument forces specific algorithm
+            const int requested = block.getIArguments()->size() > 9 ? INT_ARG(9) : CONV2D_ALGO_AUTO;
+            const int algorithm = helpers::_conv2dAlgorithm(input, weights, output, kY, kX, sY, sX, dY, dX, requested);
+
+            if (algorithm != CONV2D_ALGO_IM2COL) {
+                nd4j_debug("Conv2D: using algorithm %i\n", algorithm);
+
+                if (algorithm == CONV2D_ALGO_WINOGRAD)
+                    helpers::_conv2dWinograd(input, weights, bias, output, pY, pX);
+                else if (algorithm == CONV2D_ALGO_DIRECT)
+                    helpers::_conv2dDirect(input, weights, bias, output, kY, kX, sY, sX, pY, pX, dY, dX);
+                else
+                    helpers::_conv2dImplicitGemm(input, weights, bias, output, kY, kX, sY, sX, pY, pX, dY, dX);
+
+                STORE_RESULT(*output);
+
+                return ND4J_STATUS_OK;
+            }
+
             std::unique_ptr<NDArray<T>> col(new NDArray<T>('c', {batchSize, oY, oX, inDepth, kY, kX}));
             std::unique_ptr<NDArray<T>> col2(col.get()->permute({0, 3, 4, 5, 1, 2}));
 
@@ -184,6 +204,21 @@ namespace nd4j {
             if (isSameMode)
                 ConvolutionUtils<T>::_calcPadding2D(pY, pX, oY, oX, inY, inX, kY, kX, sY, sX, dY, dX);
 
+            // everything except explicitly requested im2col goes via implicit GEMM, if arrays are contiguous
+            const int requested = block.getIArguments()->size() > 9 ? INT_ARG(9) : CONV2D_ALGO_AUTO;
+            if (requested != CONV2D_ALGO_IM2COL && helpers::_conv2dAlgorithm(input, weights, epsilonNext, kY, kX, sY, sX, dY, dX, CONV2D_ALGO_IMPLICIT_GEMM) != CONV2D_ALGO_IM2COL
+                && epsilon->ordering() == 'c' && epsilon->ews() == 1 && gradW->ordering() == 'c' && gradW->ews() == 1) {
+                helpers::_conv2dBpImplicitGemm(input, weights, epsilonNext, epsilon, gradW, gradB, kY, kX, sY, sX, pY, pX, dY, dX);
+
+                if (bias == nullptr) {
+                    STORE_2_RESULTS(*epsilon, *gradW);
+                } else {
+                    STORE_3_RESULTS(*epsilon, *gradW, *gradB);
+                }
+
+                return ND4J_STATUS_OK;
+            }
+
             auto epsilonNext2d = epsilonNext->permute({1, 0, 2, 3});
             epsilonNext2d->reshapei('c', {outDepth, batchSize * oY * oX});
 
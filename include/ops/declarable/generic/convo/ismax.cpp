@@ -3,6 +3,7 @@
 //
 
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/TadCache.h>
 
 namespace nd4j {
     namespace ops {
@@ -109,12 +110,10 @@ namespace nd4j {
                 //moving all dimensions (in sorted order)
                 //to the back.
                 //permuted version of the x shape info for setting up the tad problem
-                shape::TAD tad(x->getShapeInfo(), dimensions.data(), dimensionsLength);
-                tad.createTadOnlyShapeInfo();
-                tad.createOffsets();
+                auto tad = nd4j::TadCache::getInstance()->tadForDimensions(x->getShapeInfo(), dimensions.data(), dimensionsLength);
 
-                int *tadShapeShapeInfo = tad.tadOnlyShapeInfo;
-                Nd4jIndex* tadOffsets = tad.tadOffsets;
+                int *tadShapeShapeInfo = tad->tadOnlyShapeInfo();
+                Nd4jIndex* tadOffsets = tad->tadOffsets();
 
                 int tadLength = shape::tadLength(x->getShapeInfo(), dimensions.data(), dimensionsLength);
                 int tads = x->lengthOf() / tadLength;
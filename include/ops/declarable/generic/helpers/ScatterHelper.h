@@ -2,11 +2,19 @@
 //  @author raver119@gmail.com
 //
 
+#ifndef LIBND4J_SCATTERHELPER_H
+#define LIBND4J_SCATTERHELPER_H
 
 #include <pointercast.h>
 #include <op_boilerplate.h>
 #include <NDArray.h>
 #include <NDArrayFactory.h>
+#include <helpers/TadCache.h>
+#include <helpers/ShapeUtils.h>
+#include <Environment.h>
+#include <algorithm>
+#include <type_traits>
+#include <omp.h>
 
 
 namespace nd4j {
@@ -14,74 +22,240 @@ namespace nd4j {
 
         template <typename T>
         class ScatterHelper {
-        public:
+        private:
+            /**
+             * Rows of array, addressed without NDArray views: row r starts at offsets[r], or at r * rowStride if there are no offsets.
+             * Single element rows have no TAD shape.
+             */
+            struct Rows {
+                T* buffer = nullptr;
+                Nd4jIndex* offsets = nullptr;
+                Nd4jIndex rowStride = 0;
+                int* tadShape = nullptr;
+                Nd4jIndex length = 1;
+                int ews = 1;
+                Nd4jIndex numRows = 0;
+                std::shared_ptr<TadPack> pack;
+                std::vector<Nd4jIndex> holder;
+
+                FORCEINLINE T* row(Nd4jIndex r) {
+                    return buffer + (offsets != nullptr ? offsets[r] : r * rowStride);
+                }
+
+                // offset of f-th element within row, in c order. Used only for rows without elementwise stride
+                FORCEINLINE Nd4jIndex offsetOf(Nd4jIndex f) {
+                    int coords[MAX_RANK];
+                    shape::ind2subC(shape::rank(tadShape), shape::shapeOf(tadShape), f, coords);
+                    return shape::getOffset(0, shape::shapeOf(tadShape), shape::stride(tadShape), coords, shape::rank(tadShape));
+                }
+            };
+
+            // every element of vector is a row
+            static void elementRows(NDArray<T>* array, Rows& rows) {
+                rows.buffer = array->getBuffer();
+                rows.numRows = array->lengthOf();
+                int ews = shape::elementWiseStride(array->getShapeInfo());
+                if (ews >= 1) {
+                    rows.rowStride = ews;
+                } else {
+                    rows.holder.resize(rows.numRows);
+                    int coords[MAX_RANK];
+                    for (Nd4jIndex e = 0; e < rows.numRows; e++) {
+                        shape::ind2subC(array->rankOf(), array->shapeOf(), e, coords);
+                        rows.holder[e] = shape::getOffset(0, array->shapeOf(), array->stridesOf(), coords, array->rankOf());
+                    }
+
+                    rows.offsets = rows.holder.data();
+                }
+            }
+
+            static void tadRows(NDArray<T>* array, std::vector<int>& dimensions, Rows& rows) {
+                std::vector<int> copy(dimensions);
+                std::sort(copy.begin(), copy.end());
+
+                rows.pack = nd4j::TadCache::getInstance()->tadForDimensions(array->getShapeInfo(), copy);
+                rows.buffer = array->getBuffer();
+                rows.offsets = rows.pack->tadOffsets();
+                rows.tadShape = rows.pack->tadOnlyShapeInfo();
+                rows.length = shape::length(rows.tadShape);
+                rows.ews = shape::elementWiseStride(rows.tadShape);
+                rows.numRows = rows.pack->numberOfTads();
+            }
+
             template <typename OpClass>
-            static FORCEINLINE Nd4jStatus scatter_apply(NDArray<T>* output, NDArray<T>* indices, NDArray<T>* updates) {
-                NDArray<T>* input = output;
-                int indicesLength = (int) indices->lengthOf();
+            static FORCEINLINE void applyRow(Rows& zRows, T* z, Rows& uRows, T* u) {
+                Nd4jIndex length = zRows.length;
+                if (zRows.ews == 1 && uRows.ews == 1) {
+#pragma omp simd
+                    for (Nd4jIndex f = 0; f < length; f++)
+                        z[f] = OpClass::op(z[f], u[f], nullptr);
+                } else if (zRows.ews >= 1 && uRows.ews >= 1) {
+                    Nd4jIndex zStride = zRows.ews;
+                    Nd4jIndex uStride = uRows.ews;
+                    for (Nd4jIndex f = 0; f < length; f++)
+                        z[f * zStride] = OpClass::op(z[f * zStride], u[f * uStride], nullptr);
+                } else {
+                    for (Nd4jIndex f = 0; f < length; f++) {
+                        Nd4jIndex zOffset = zRows.ews >= 1 ? f * zRows.ews : zRows.offsetOf(f);
+                        Nd4jIndex uOffset = uRows.ews >= 1 ? f * uRows.ews : uRows.offsetOf(f);
+                        z[zOffset] = OpClass::op(z[zOffset], u[uOffset], nullptr);
+                    }
+                }
+            }
 
-            if ((indices->isVector() && input->isVector() && updates->isVector()) ||
-                (input->isScalar() && input->isScalar() && updates->isScalar()) ||
-                (input->isVector() && indices->isScalar() && updates->isScalar()) ) {
-                
-                for (int e = 0; e < indicesLength; e++) {
-                    int idx = (int) indices->getScalar(e);
-                    
-                    T t0 = input->getScalar(idx);
-                    T t1 = updates->getScalar(e);
-                    
-                    output->putScalar(idx, OpClass::op(t0, t1, nullptr));
+            /**
+             * Applies update rows to target rows. Updates are grouped by target row, so every target row is owned by single thread,
+             * and updates of the same row are applied in their original order: result is the same as serial one, bit for bit.
+             *
+             * If deterministic is false, scatter_add & scatter_sub may split heavily duplicated rows between threads: partial sums
+             * are merged in order threads finish, so rounding may differ from run to run.
+             */
+            template <typename OpClass>
+            static Nd4jStatus scatter(Rows& zRows, Rows& uRows, std::vector<Nd4jIndex>& targets, bool deterministic) {
+                Nd4jIndex numUpdates = (Nd4jIndex) targets.size();
+
+                if (zRows.tadShape != nullptr && uRows.tadShape != nullptr) {
+                    REQUIRE_TRUE(shape::shapeEquals(zRows.tadShape, uRows.tadShape), 0, "scatter: updates shapes should match");
+                } else {
+                    REQUIRE_TRUE(zRows.length == uRows.length, 0, "scatter: updates shapes should match");
                 }
-            } else if (indices->isVector() || indices->isScalar()) {
-                std::vector<int> idc;
-                std::vector<int> idcU;
+                REQUIRE_TRUE(uRows.numRows >= numUpdates, 0, "scatter: number of updates should match number of indices");
 
-                for (int e = 0; e < indicesLength; e++) {
-                    idc.push_back((int) indices->getScalar(e));
-                    idcU.push_back(e);
+                for (Nd4jIndex e = 0; e < numUpdates; e++) {
+                    if (targets[e] < 0 || targets[e] >= zRows.numRows) {
+                        nd4j_printf("Index %lld is out of range [0..%lld)\n", (long long) targets[e], (long long) zRows.numRows);
+                        return ND4J_STATUS_BAD_INPUT;
+                    }
                 }
 
-                std::vector<int> tadDimension = ShapeUtils<T>::convertAxisToTadTarget(input->rankOf(), {0});
-                auto tadsOperand = NDArrayFactory<T>::multipleTensorsAlongDimension(output, idc, tadDimension);
-                auto tadsUpdate = NDArrayFactory<T>::multipleTensorsAlongDimension(updates, idcU, tadDimension);
+                constexpr bool isCopy = std::is_same<OpClass, simdOps::Copy<T>>::value;
+                constexpr bool isAdditive = std::is_same<OpClass, simdOps::Add<T>>::value || std::is_same<OpClass, simdOps::Subtract<T>>::value;
 
-                auto z0 = tadsOperand->at(0);
-                auto z1 = tadsUpdate->at(0);
+                int num_threads = (int) nd4j::math::nd4j_min<Nd4jIndex>(numUpdates * zRows.length / ELEMENT_THRESHOLD_FOR(OP_CLASS_PAIRWISE), MAX_THREADS_FOR(OP_CLASS_PAIRWISE));
+                num_threads = nd4j::math::nd4j_max<int>(1, num_threads);
 
-                REQUIRE_TRUE(z0->isSameShape(z1), 0, "scatter_add: updates shapes should match");
+                if (num_threads == 1) {
+                    for (Nd4jIndex e = 0; e < numUpdates; e++)
+                        applyRow<OpClass>(zRows, zRows.row(targets[e]), uRows, uRows.row(e));
 
-                for (int e = 0; e < tadsOperand->size(); e++) {
-                    auto t0 = tadsOperand->at(e);
-                    auto t1 = tadsUpdate->at(e);
-                    
-                    t0->template applyPairwiseTransform<OpClass>(t1, nullptr);
+                    return ND4J_STATUS_OK;
                 }
 
-                delete tadsOperand;
-                delete tadsUpdate;
-            }  else if (indices->isMatrix() || indices->rankOf() >= 2) {
-                auto _input = input->reshape(input->ordering(), {input->sizeAt(0), -1});
-                auto _updates = updates->reshape(updates->ordering(), {indicesLength, (int) updates->lengthOf() / indicesLength});
+                // (target, update) pairs sorted lexicographically: groups by target, original order within group
+                std::vector<std::pair<Nd4jIndex, Nd4jIndex>> pairs(numUpdates);
+                for (Nd4jIndex e = 0; e < numUpdates; e++)
+                    pairs[e] = std::make_pair(targets[e], e);
+
+                std::sort(pairs.begin(), pairs.end());
+
+                std::vector<Nd4jIndex> groups;
+                for (Nd4jIndex e = 0; e < numUpdates; e++)
+                    if (e == 0 || pairs[e].first != pairs[e - 1].first)
+                        groups.emplace_back(e);
 
-                auto tadsOperand = NDArrayFactory<T>::allTensorsAlongDimension(_input, {1});
-                auto tadsUpdates = NDArrayFactory<T>::allTensorsAlongDimension(_updates, {1});
+                Nd4jIndex numGroups = (Nd4jIndex) groups.size();
+                groups.emplace_back(numUpdates);
 
-                for (int e = 0; e < indicesLength; e++) {
-                    int idx = indices->getScalar(e);
-                    
-                    auto t0 = tadsOperand->at(idx);
-                    auto t1 = tadsUpdates->at(e);
+                // rows with more duplicates than average thread share are split between threads, if that's allowed
+                Nd4jIndex hotSize = nd4j::math::nd4j_max<Nd4jIndex>(2 * num_threads, numUpdates / num_threads);
+                bool splitHot = !deterministic && isAdditive;
+                std::vector<Nd4jIndex> hot;
 
-                    t0->template applyPairwiseTransform<OpClass>(t1, nullptr);
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 16) proc_bind(AFFINITY) default(shared)
+                for (Nd4jIndex g = 0; g < numGroups; g++) {
+                    Nd4jIndex start = groups[g];
+                    Nd4jIndex end = groups[g + 1];
+                    T* z = zRows.row(pairs[start].first);
+
+                    if (isCopy) {
+                        // only last write survives
+                        applyRow<OpClass>(zRows, z, uRows, uRows.row(pairs[end - 1].second));
+                    } else if (splitHot && end - start >= hotSize) {
+#pragma omp critical
+                        hot.emplace_back(g);
+                    } else {
+                        for (Nd4jIndex e = start; e < end; e++)
+                            applyRow<OpClass>(zRows, z, uRows, uRows.row(pairs[e].second));
+                    }
                 }
 
-                delete _input;
-                delete _updates;
+                for (auto g: hot) {
+                    Nd4jIndex start = groups[g];
+                    Nd4jIndex end = groups[g + 1];
+                    T* z = zRows.row(pairs[start].first);
+
+                    // partials are contiguous, so they're combined with plain Add
+                    Rows pRows;
+                    pRows.length = zRows.length;
 
-                delete tadsOperand;
-                delete tadsUpdates;
+#pragma omp parallel num_threads(num_threads) proc_bind(AFFINITY) default(shared)
+                    {
+                        std::vector<T> partial(zRows.length, (T) 0.0f);
+
+#pragma omp for schedule(static)
+                        for (Nd4jIndex e = start; e < end; e++)
+                            applyRow<simdOps::Add<T>>(pRows, partial.data(), uRows, uRows.row(pairs[e].second));
+
+#pragma omp critical
+                        applyRow<OpClass>(zRows, z, pRows, partial.data());
+                    }
+                }
+
+                return ND4J_STATUS_OK;
             }
+
+        public:
+            /**
+             * Applies OpClass to output rows selected by indices, and corresponding rows of updates.
+             * Set deterministic to false to let duplicated rows of scatter_add/scatter_sub be reduced in arbitrary order.
+             */
+            template <typename OpClass>
+            static Nd4jStatus scatter_apply(NDArray<T>* output, NDArray<T>* indices, NDArray<T>* updates, bool deterministic = true) {
+                NDArray<T>* input = output;
+                int indicesLength = (int) indices->lengthOf();
+
+                std::vector<Nd4jIndex> targets(indicesLength);
+                for (int e = 0; e < indicesLength; e++)
+                    targets[e] = (Nd4jIndex) indices->getScalar(e);
+
+                Rows zRows;
+                Rows uRows;
+
+                if ((indices->isVector() && input->isVector() && updates->isVector()) ||
+                    (input->isScalar() && input->isScalar() && updates->isScalar()) ||
+                    (input->isVector() && indices->isScalar() && updates->isScalar()) ) {
+
+                    elementRows(output, zRows);
+                    elementRows(updates, uRows);
+
+                    return scatter<OpClass>(zRows, uRows, targets, deterministic);
+                } else if (indices->isVector() || indices->isScalar()) {
+                    std::vector<int> tadDimension = ShapeUtils<T>::convertAxisToTadTarget(input->rankOf(), {0});
+
+                    tadRows(output, tadDimension, zRows);
+                    tadRows(updates, tadDimension, uRows);
+
+                    return scatter<OpClass>(zRows, uRows, targets, deterministic);
+                } else if (indices->isMatrix() || indices->rankOf() >= 2) {
+                    auto _input = input->reshape(input->ordering(), {input->sizeAt(0), -1});
+                    auto _updates = updates->reshape(updates->ordering(), {indicesLength, (int) updates->lengthOf() / indicesLength});
+
+                    std::vector<int> tadDimension({1});
+                    tadRows(_input, tadDimension, zRows);
+                    tadRows(_updates, tadDimension, uRows);
+
+                    auto status = scatter<OpClass>(zRows, uRows, targets, deterministic);
+
+                    delete _input;
+                    delete _updates;
+
+                    return status;
+                }
+
+                return ND4J_STATUS_OK;
             }
         };
     }
-}
\ No newline at end of file
+}
+
+#endif
@@ -17,9 +17,10 @@ namespace nd4j {
             if (!block.isInplace())
                 output->assign(input);
 
-            ScatterHelper<T>::template scatter_apply<simdOps::Subtract<T>>(output, indices, updates);        
+            // optional int arg 0: when it's 0, duplicated indices may be reduced in arbitrary order
+            bool deterministic = block.getIArguments()->size() > 0 ? INT_ARG(0) != 0 : true;
 
-            return ND4J_STATUS_OK;
+            return ScatterHelper<T>::template scatter_apply<simdOps::Subtract<T>>(output, indices, updates, deterministic);
         }
         DECLARE_SYN(ScatterSub, scatter_sub);
     }
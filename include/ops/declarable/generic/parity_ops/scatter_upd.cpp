@@ -17,9 +17,7 @@ namespace nd4j {
             if (!block.isInplace())
                 output->assign(input);
 
-            ScatterHelper<T>::template scatter_apply<simdOps::Copy<T>>(output, indices, updates);        
-
-            return ND4J_STATUS_OK;
+            return ScatterHelper<T>::template scatter_apply<simdOps::Copy<T>>(output, indices, updates);
         }
         DECLARE_SYN(ScatterUpdate, scatter_upd);
     }
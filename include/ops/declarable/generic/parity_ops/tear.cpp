@@ -3,7 +3,7 @@
 //
 
 #include <ops/declarable/CustomOperations.h>
-#include <TAD.h>
+#include <helpers/TadCache.h>
 
 namespace nd4j {
     namespace ops {
@@ -35,15 +35,14 @@ namespace nd4j {
             std::vector<int> dims(*block.getIArguments());
             std::sort(dims.begin(), dims.end());
 
-            shape::TAD tad(inShape, dims.data(), (int) dims.size());
-            tad.createTadOnlyShapeInfo();
+            auto tad = nd4j::TadCache::getInstance()->tadForDimensions(inShape, dims);
             Nd4jIndex numTads = shape::length(inShape) / shape::tadLength(inShape, dims.data(), (int) dims.size());
 
             auto result = new ShapeList();
             for (int e = 0; e < numTads; e++) {
                 int *newShape;
-                ALLOCATE(newShape, block.getWorkspace(), shape::shapeInfoLength(tad.tadOnlyShapeInfo), int);
-                memcpy(newShape, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
+                ALLOCATE(newShape, block.getWorkspace(), shape::shapeInfoLength(tad->tadOnlyShapeInfo()), int);
+                memcpy(newShape, tad->tadOnlyShapeInfo(), shape::shapeInfoByteLength(tad->tadOnlyShapeInfo()));
                 result->push_back(newShape);
             }
 
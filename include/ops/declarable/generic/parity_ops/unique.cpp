@@ -3,30 +3,28 @@
 //
 
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/unique.h>
 
 namespace nd4j {
     namespace ops {
-        // FIXME: this op badly needs perf improvements!
+        /**
+         * Unique values of input, in order of first occurrence, and index of first occurrence of every value
+         */
         CUSTOM_OP_IMPL(unique, 1, 2, false, 0, 0) {
             auto x = INPUT_VARIABLE(0);
             std::vector<T> values;
-            std::vector<int> indices;
-
-            for (int e = 0; e < x->lengthOf(); e++) {
-                T v = x->getScalar(e);
-                if (std::find(values.begin(), values.end(), v) == values.end()) {
-                    values.emplace_back(v);
-                    indices.emplace_back(e);
-                }
-            }
+            std::vector<Nd4jIndex> indices;
 
+            helpers::_unique<T>(x, values, indices);
 
             auto vec_uniq = new NDArray<T>('c', {1, (int) values.size()});
             auto vec_idx = new NDArray<T>('c', {1, (int) values.size()});
 
-            for (int e = 0; e < vec_uniq->lengthOf(); e++) {
-                vec_uniq->putScalar(e, values.at(e));
-                vec_idx->putScalar(e, indices.at(e));
+            T* uniq = vec_uniq->getBuffer();
+            T* idx = vec_idx->getBuffer();
+            for (int e = 0; e < (int) values.size(); e++) {
+                uniq[e] = values[e];
+                idx[e] = (T) indices[e];
             }
 
             OVERWRITE_2_RESULTS(vec_uniq, vec_idx);
@@ -48,5 +46,52 @@ namespace nd4j {
             }
             return shapeList;
         }
+
+        /**
+         * TF unique_with_counts: unique values in order of first occurrence, index into unique values for every
+         * input element (shaped as input), and number of occurrences of every unique value
+         */
+        CUSTOM_OP_IMPL(unique_with_counts, 1, 3, false, 0, 0) {
+            auto x = INPUT_VARIABLE(0);
+            std::vector<T> values;
+            std::vector<Nd4jIndex> indices;
+            std::vector<Nd4jIndex> inverse;
+            std::vector<Nd4jIndex> counts;
+
+            helpers::_unique<T>(x, values, indices, &inverse, &counts);
+
+            auto vec_uniq = new NDArray<T>('c', {1, (int) values.size()});
+            auto vec_idx = new NDArray<T>('c', x->getShapeAsVector());
+            auto vec_cnt = new NDArray<T>('c', {1, (int) values.size()});
+
+            T* uniq = vec_uniq->getBuffer();
+            T* cnt = vec_cnt->getBuffer();
+            for (int e = 0; e < (int) values.size(); e++) {
+                uniq[e] = values[e];
+                cnt[e] = (T) counts[e];
+            }
+
+            T* idx = vec_idx->getBuffer();
+            Nd4jIndex length = x->lengthOf();
+
+#pragma omp parallel for if (length > ELEMENT_THRESHOLD) schedule(static) proc_bind(AFFINITY) default(shared)
+            for (Nd4jIndex e = 0; e < length; e++)
+                idx[e] = (T) inverse[e];
+
+            OVERWRITE_3_RESULTS(vec_uniq, vec_idx, vec_cnt);
+
+            return ND4J_STATUS_OK;
+        }
+
+        DECLARE_SHAPE_FN(unique_with_counts) {
+            auto shapeList = new ShapeList();
+            for (int e = 0; e < 3; e++) {
+                int* newshape;
+                ALLOCATE(newshape, block.getWorkspace(), shape::shapeInfoLength(inputShape->at(0)), int);
+                shape::shapeBuffer(shape::rank(inputShape->at(0)), shape::shapeOf(inputShape->at(0)), newshape);
+                shapeList->push_back(newshape);
+            }
+            return shapeList;
+        }
     }
-}
\ No newline at end of file
+}
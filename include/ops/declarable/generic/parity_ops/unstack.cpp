@@ -3,6 +3,7 @@
 //
 
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/TadCache.h>
 
 namespace nd4j {
     namespace ops {
@@ -52,15 +53,14 @@ namespace nd4j {
                 if (e != dim)
                     dims.emplace_back(e);
 
-            shape::TAD tad(inShape, dims.data(), (int) dims.size());
-            tad.createTadOnlyShapeInfo();
+            auto tad = nd4j::TadCache::getInstance()->tadForDimensions(inShape, dims);
             Nd4jIndex numTads = shape::length(inShape) / shape::tadLength(inShape, dims.data(), (int) dims.size());
 
             auto result = new ShapeList();
             for (int e = 0; e < numTads; e++) {
                 int *newShape;
-                ALLOCATE(newShape, block.getWorkspace(), shape::shapeInfoLength(tad.tadOnlyShapeInfo), int);
-                memcpy(newShape, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
+                ALLOCATE(newShape, block.getWorkspace(), shape::shapeInfoLength(tad->tadOnlyShapeInfo()), int);
+                memcpy(newShape, tad->tadOnlyShapeInfo(), shape::shapeInfoByteLength(tad->tadOnlyShapeInfo()));
                 result->push_back(newShape);
             }
 
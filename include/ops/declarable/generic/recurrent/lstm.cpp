@@ -0,0 +1,179 @@
+//
+// implementation of whole-sequence LSTM with peep hole connections and projection, same cell as lstmCell op
+//
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/lstm.h>
+#include <vector>
+
+namespace nd4j {
+namespace ops {
+
+//////////////////////////////////////////////////////////////////////////
+// returns c-ordered contiguous version of array, copy is tracked in garbage list
+template <typename T>
+static NDArray<T>* contiguous(NDArray<T>* array, std::vector<NDArray<T>*>& garbage) {
+    if (array->ordering() == 'c' && array->ews() == 1)
+        return array;
+
+    auto result = array->dup('c');
+    garbage.push_back(result);
+    return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void validateLstmShapes(NDArray<T>* x, NDArray<T>* h0, NDArray<T>* c0, NDArray<T>* Wx, NDArray<T>* Wh, NDArray<T>* Wc, NDArray<T>* Wp, NDArray<T>* b, bool projection) {
+    const int bS       = x->sizeAt(1);
+    const int inSize   = x->sizeAt(2);
+    const int numProj  = h0->sizeAt(1);
+    const int numUnits = c0->sizeAt(1);
+
+    if (x->rankOf() != 3)
+        throw "CUSTOM_OP lstm: input must have rank 3: [time x batchSize x inSize] !";
+
+    if (h0->sizeAt(0) != bS || c0->sizeAt(0) != bS)
+        throw "CUSTOM_OP lstm: the shape[0] of initial cell output or initial cell state must be equal to batch size !";
+
+    if (!Wx->isSameShape({inSize, 4*numUnits}))
+        throw "CUSTOM_OP lstm: the shape of input-to-hidden weights is wrong !";
+
+    if (!Wh->isSameShape({numProj, 4*numUnits}))
+        throw "CUSTOM_OP lstm: the shape of hidden-to-hidden weights is wrong !";
+
+    if (!Wc->isSameShape({1, 3*numUnits}))
+        throw "CUSTOM_OP lstm: the shape of diagonal weights is wrong !";
+
+    if (!Wp->isSameShape({numUnits, numProj}))
+        throw "CUSTOM_OP lstm: the shape of projection weights is wrong !";
+
+    if (!b->isSameShape({1, 4*numUnits}))
+        throw "CUSTOM_OP lstm: the shape of biases is wrong !";
+
+    if (!projection && numUnits != numProj)
+        throw "CUSTOM_OP lstm: projection option is switched of, and in this case output dimensionality for the projection matrices (numProj) must be equal to number of units in lstm !";
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+CUSTOM_OP_IMPL(lstm, 8, 2, false, 3, 2) {
+
+    NDArray<T>* x   = INPUT_VARIABLE(0);                    // input [time x batchSize x inSize]
+    NDArray<T>* h0  = INPUT_VARIABLE(1);                    // initial cell output [batchSize x numProj], in case of projection=false -> numProj=numUnits!!!
+    NDArray<T>* c0  = INPUT_VARIABLE(2);                    // initial cell state  [batchSize x numUnits]
+
+    NDArray<T>* Wx  = INPUT_VARIABLE(3);                    // input-to-hidden  weights, [inSize  x 4*numUnits]
+    NDArray<T>* Wh  = INPUT_VARIABLE(4);                    // hidden-to-hidden weights, [numProj x 4*numUnits]
+    NDArray<T>* Wc  = INPUT_VARIABLE(5);                    // diagonal weights for peephole connections [1 x 3*numUnits]
+    NDArray<T>* Wp  = INPUT_VARIABLE(6);                    // projection weights [numUnits x numProj]
+    NDArray<T>* b   = INPUT_VARIABLE(7);                    // biases, [1 x 4*numUnits]
+
+    NDArray<T>* h   = OUTPUT_VARIABLE(0);                   // cell outputs [time x batchSize x numProj], for all time steps
+    NDArray<T>* c   = OUTPUT_VARIABLE(1);                   // cell states  [time x batchSize x numUnits], for all time steps
+
+    const bool peephole   = (bool)INT_ARG(0);               // if true, provide peephole connections
+    const bool projection = (bool)INT_ARG(1);               // if true, then projection is performed, if false then numProj==numUnits is mandatory!!!!
+    const T clippingCellValue = T_ARG(0);                   // clipping value for ct, if it is not equal to zero, then cell state is clipped
+    const T clippingProjValue = T_ARG(1);                   // clipping value for projected ht, if it is not equal to zero, then projected cell output is clipped
+    const T forgetBias        = T_ARG(2);
+
+    std::vector<NDArray<T>*> garbage;
+    helpers::_lstmForward<T>(contiguous(x, garbage), contiguous(h0, garbage), contiguous(c0, garbage), contiguous(Wx, garbage), contiguous(Wh, garbage),
+                             contiguous(Wc, garbage), contiguous(Wp, garbage), contiguous(b, garbage), h, c,
+                             peephole, projection, clippingCellValue, clippingProjValue, forgetBias);
+
+    for (auto array: garbage)
+        delete array;
+
+    return ND4J_STATUS_OK;
+}
+
+DECLARE_SHAPE_FN(lstm) {
+
+    const int time     = (INPUT_VARIABLE(0))->sizeAt(0);
+    const int bS       = (INPUT_VARIABLE(0))->sizeAt(1);
+    const int numProj  = (INPUT_VARIABLE(1))->sizeAt(1);
+    const int numUnits = (INPUT_VARIABLE(2))->sizeAt(1);
+
+    validateLstmShapes<T>(INPUT_VARIABLE(0), INPUT_VARIABLE(1), INPUT_VARIABLE(2), INPUT_VARIABLE(3), INPUT_VARIABLE(4), INPUT_VARIABLE(5), INPUT_VARIABLE(6), INPUT_VARIABLE(7), (bool)INT_ARG(1));
+
+    int *outShapeInfo1(nullptr), *outShapeInfo2(nullptr);
+    ALLOCATE(outShapeInfo1, block.getWorkspace(), 10, int);
+    ALLOCATE(outShapeInfo2, block.getWorkspace(), 10, int);
+
+    outShapeInfo1[0] = outShapeInfo2[0] = 3;
+    outShapeInfo1[1] = outShapeInfo2[1] = time;
+    outShapeInfo1[2] = outShapeInfo2[2] = bS;
+    outShapeInfo1[3] = numProj;
+    outShapeInfo2[3] = numUnits;
+
+    shape::updateStrides(outShapeInfo1, 'c');
+    shape::updateStrides(outShapeInfo2, 'c');
+
+    return new ShapeList({outShapeInfo1, outShapeInfo2});
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+CUSTOM_OP_IMPL(lstm_bp, 9, 8, false, 3, 2) {
+
+    NDArray<T>* x    = INPUT_VARIABLE(0);                   // input [time x batchSize x inSize]
+    NDArray<T>* h0   = INPUT_VARIABLE(1);                   // initial cell output [batchSize x numProj]
+    NDArray<T>* c0   = INPUT_VARIABLE(2);                   // initial cell state  [batchSize x numUnits]
+    NDArray<T>* Wx   = INPUT_VARIABLE(3);                   // [inSize  x 4*numUnits]
+    NDArray<T>* Wh   = INPUT_VARIABLE(4);                   // [numProj x 4*numUnits]
+    NDArray<T>* Wc   = INPUT_VARIABLE(5);                   // [1 x 3*numUnits]
+    NDArray<T>* Wp   = INPUT_VARIABLE(6);                   // [numUnits x numProj]
+    NDArray<T>* b    = INPUT_VARIABLE(7);                   // [1 x 4*numUnits]
+    NDArray<T>* dLdh = INPUT_VARIABLE(8);                   // gradient wrt cell outputs [time x batchSize x numProj]
+
+    // gradients wrt inputs 0..7, same shapes
+    NDArray<T>* dLdx  = OUTPUT_VARIABLE(0);
+    NDArray<T>* dLdh0 = OUTPUT_VARIABLE(1);
+    NDArray<T>* dLdc0 = OUTPUT_VARIABLE(2);
+    NDArray<T>* dLdWx = OUTPUT_VARIABLE(3);
+    NDArray<T>* dLdWh = OUTPUT_VARIABLE(4);
+    NDArray<T>* dLdWc = OUTPUT_VARIABLE(5);
+    NDArray<T>* dLdWp = OUTPUT_VARIABLE(6);
+    NDArray<T>* dLdb  = OUTPUT_VARIABLE(7);
+
+    const bool peephole   = (bool)INT_ARG(0);
+    const bool projection = (bool)INT_ARG(1);
+    const T clippingCellValue = T_ARG(0);
+    const T clippingProjValue = T_ARG(1);
+    const T forgetBias        = T_ARG(2);
+
+    if (!dLdh->isSameShape({x->sizeAt(0), x->sizeAt(1), h0->sizeAt(1)}))
+        throw "CUSTOM_OP lstm_bp: the shape of gradient wrt cell outputs is wrong !";
+
+    std::vector<NDArray<T>*> garbage;
+    helpers::_lstmBackward<T>(contiguous(x, garbage), contiguous(h0, garbage), contiguous(c0, garbage), contiguous(Wx, garbage), contiguous(Wh, garbage),
+                              contiguous(Wc, garbage), contiguous(Wp, garbage), contiguous(b, garbage), contiguous(dLdh, garbage),
+                              dLdx, dLdh0, dLdc0, dLdWx, dLdWh, dLdWc, dLdWp, dLdb,
+                              peephole, projection, clippingCellValue, clippingProjValue, forgetBias);
+
+    for (auto array: garbage)
+        delete array;
+
+    return ND4J_STATUS_OK;
+}
+
+DECLARE_SHAPE_FN(lstm_bp) {
+
+    validateLstmShapes<T>(INPUT_VARIABLE(0), INPUT_VARIABLE(1), INPUT_VARIABLE(2), INPUT_VARIABLE(3), INPUT_VARIABLE(4), INPUT_VARIABLE(5), INPUT_VARIABLE(6), INPUT_VARIABLE(7), (bool)INT_ARG(1));
+
+    auto shapeList = new ShapeList();
+    for (int e = 0; e < 8; e++) {
+        int* inShape = inputShape->at(e);
+        int* newShape = nullptr;
+        ALLOCATE(newShape, block.getWorkspace(), shape::shapeInfoLength(inShape), int);
+        memcpy(newShape, inShape, shape::shapeInfoByteLength(inShape));
+        shape::updateStrides(newShape, 'c');
+        shapeList->push_back(newShape);
+    }
+
+    return shapeList;
+}
+
+}
+}
@@ -7,6 +7,7 @@
 #include <op_boilerplate.h>
 #include <ops/declarable/CustomOperations.h>
 #include <NDArray.h>
+#include <ops/declarable/helpers/sru.h>
 
 
 namespace nd4j {
@@ -52,6 +53,12 @@ CUSTOM_OP_IMPL(sru, 5, 2, false, 0, 0) {
     const int bS     = input->shapeOf()[0];                     // bS - batch size
     const int K      = input->shapeOf()[1];                     // K - number of features
     const int N      = input->shapeOf()[2];                     // N - number of time steps
+
+    // whole-sequence fused kernel, available for c-ordered contiguous arrays
+    if (helpers::_sruFusable<T>({input, weights, bias, init, mask, output, state})) {
+        helpers::_sruForward<T>(input, weights, bias, init, mask, output, state);
+        return ND4J_STATUS_OK;
+    }
     
     // multiplication matrix = matmul(weights,input)
     NDArray<T>* wi = NDArrayFactory<T>::mmulHelper(weights, input, nullptr, (T)1., (T)0.);      //       U [bS x 3K x N]    
@@ -244,6 +251,12 @@ CUSTOM_OP_IMPL(sru_bp, 8, 4, true, 0, 0) {
     const int bS      = input->shapeOf()[0];                     
     const int K       = input->shapeOf()[1];                     
     const int N       = input->shapeOf()[2];                     // N - number of time steps
+
+    // whole-sequence fused kernel, available for c-ordered contiguous arrays
+    if (helpers::_sruFusable<T>({input, weights, bias, init, state, inGradCt, inGradH, mask, gradX, gradW, gradB, gradInit})) {
+        helpers::_sruBackward<T>(input, weights, bias, init, state, inGradCt, inGradH, mask, gradX, gradW, gradB, gradInit);
+        return ND4J_STATUS_OK;
+    }
     
     NDArray<T>* gradBias = new NDArray<T>(input->ordering(), {bS, 2*K, N});
     NDArray<T>* gradU    = new NDArray<T>(input->ordering(), {bS, 3*K, N});
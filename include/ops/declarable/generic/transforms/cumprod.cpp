@@ -11,13 +11,17 @@ namespace nd4j {
             auto input = INPUT_VARIABLE(0);
             auto output = OUTPUT_VARIABLE(0);
 
+            // optional T args: exclusive & reverse flags
+            bool exclusive = block.getTArguments()->size() > 0 && T_ARG(0) != (T) 0.0f;
+            bool reverse = block.getTArguments()->size() > 1 && T_ARG(1) != (T) 0.0f;
+
             if (block.getIArguments()->size() == 0 && block.width() == 1) {
                 // all at once case
-                nd4j::ops::helpers::_prefix<T, simdOps::Multiply<T>>(input->buffer(), input->shapeInfo(), output->buffer(), output->shapeInfo());
+                nd4j::ops::helpers::_prefix<T, simdOps::Multiply<T>>(input->buffer(), input->shapeInfo(), output->buffer(), output->shapeInfo(), exclusive, reverse);
             } else {
                 std::vector<int> dims = ShapeUtils<T>::convertAxisToTadTarget(input->rankOf(), *(block.getIArguments()));
 
-                nd4j::ops::helpers::_prefix<T, simdOps::Multiply<T>>(input, output, dims);
+                nd4j::ops::helpers::_prefix<T, simdOps::Multiply<T>>(input, output, dims, exclusive, reverse);
             }
 
             return ND4J_STATUS_OK;
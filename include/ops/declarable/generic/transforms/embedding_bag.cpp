@@ -0,0 +1,59 @@
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/gather.h>
+#include <vector>
+
+namespace nd4j {
+    namespace ops {
+        /**
+         * Embedding bag: gather of table rows fused with their reduction, so gathered tensor is never materialized.
+         *
+         * Input 0: table [numRows, ...]
+         * Input 1: indices [numBags, bagSize], negative indices are padding.
+         *          PLEASE NOTE: indices have the same data type as table, so for float16 only rows below 2048 are addressed exactly.
+         *          NativeOps gather* takes int indices, and should be used for larger tables.
+         * Int arg 0: 0 for sum (default), 1 for mean
+         *
+         * Output: [numBags, ...], row b is sum or mean of table rows selected by indices row b
+         */
+        CUSTOM_OP_IMPL(embedding_bag, 2, 1, false, 0, 0) {
+            auto table = INPUT_VARIABLE(0);
+            auto indices = INPUT_VARIABLE(1);
+            auto output = OUTPUT_VARIABLE(0);
+
+            bool mean = block.getIArguments()->size() > 0 && INT_ARG(0) == 1;
+
+            Nd4jIndex numBags = indices->rankOf() > 1 ? indices->sizeAt(0) : 1;
+            Nd4jIndex bagSize = numBags > 0 ? indices->lengthOf() / numBags : 0;
+
+            REQUIRE_TRUE(table->rankOf() > 1, 0, "embedding_bag: table should have rank 2 or higher");
+            REQUIRE_TRUE(output->sizeAt(0) == numBags, 0, "embedding_bag: output should have row per bag");
+
+            std::vector<int> idx(indices->lengthOf());
+            for (int e = 0; e < (int) idx.size(); e++)
+                idx[e] = (int) indices->getIndexedScalar(e);
+
+            helpers::_embeddingBag<T, int>(table->getBuffer(), table->getShapeInfo(), output->getBuffer(), output->getShapeInfo(), idx.data(), numBags, bagSize, mean);
+
+            STORE_RESULT(*output);
+
+            return ND4J_STATUS_OK;
+        }
+
+        DECLARE_SHAPE_FN(embedding_bag) {
+            auto tableShape = inputShape->at(0);
+            auto indicesShape = inputShape->at(1);
+
+            std::vector<int> shape(shape::rank(tableShape));
+            for (int e = 1; e < shape::rank(tableShape); e++)
+                shape[e] = shape::sizeAt(tableShape, e);
+
+            shape[0] = shape::rank(indicesShape) > 1 ? shape::sizeAt(indicesShape, 0) : 1;
+
+            int *newShape;
+            ALLOCATE(newShape, block.getWorkspace(), shape::shapeInfoLength(shape::rank(tableShape)), int);
+            shape::shapeBuffer(shape.size(), shape.data(), newShape);
+
+            return new ShapeList(newShape);
+        }
+    }
+}
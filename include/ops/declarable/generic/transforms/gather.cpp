@@ -4,6 +4,7 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include <helpers/ShapeUtils.h>
+#include <ops/declarable/helpers/gather.h>
 #include <vector>
 #include <numeric>
 
@@ -21,39 +22,15 @@ CUSTOM_OP_IMPL(gather, 2, 1, false, 0, 1) {
 	NDArray<T>* output  = OUTPUT_VARIABLE(0);
 
 	int axis = block.getIArguments()->at(0);
-    
-    
-    // first case: indices consist of only one scalar
-   	if(indices->isScalar()) {
-   		std::vector<int> dimensions = ShapeUtils<T>::evalDimsToExclude(input->rankOf(), {axis});
-   		shape::TAD tad(input->getShapeInfo(), dimensions.data(), dimensions.size());
-   		tad.createTadOnlyShapeInfo();
-    	tad.createOffsets();
-    	NDArray<T> tadArr(input->getBuffer() + tad.tadOffsets[(int)indices->getScalar(0)], tad.tadOnlyShapeInfo);
-    	output->assign(&tadArr);
-   	}
-   	// second case: indices is vector
-   	else if(indices->isVector()) {   	
-   		ResultSet<T>* listOut = NDArrayFactory<T>::allTensorsAlongDimension(output, ShapeUtils<T>::evalDimsToExclude(output->rankOf(), {axis}));
-   		ResultSet<T>* listIn  = NDArrayFactory<T>::allTensorsAlongDimension(input,  ShapeUtils<T>::evalDimsToExclude(input->rankOf(),  {axis}));
-   		for(int i = 0; i < listOut->size(); ++i)
-   			listOut->at(i)->assign(listIn->at((int)indices->getIndexedScalar(i)));
-   		delete listOut;
-   		delete listIn;
-   	}
-   	// third case: indices is usual n-dim array
-   	else {
-   		std::vector<int> dimsOut(indices->rankOf());
-   		std::iota(dimsOut.begin(), dimsOut.end(), axis);   // fill with axis, axis+1, ... indices->rankOf()-1
-   		std::vector<int> temp1 = ShapeUtils<T>::evalDimsToExclude(output->rankOf(), dimsOut);
-   		std::vector<int> temp2 = ShapeUtils<T>::evalDimsToExclude(input->rankOf(),  {axis});
-   		ResultSet<T>* listOut = NDArrayFactory<T>::allTensorsAlongDimension(output, temp1);
-   		ResultSet<T>* listIn = NDArrayFactory<T>::allTensorsAlongDimension(input,  temp2 );
-   		for(int i = 0; i < listOut->size(); ++i)
-   			listOut->at(i)->assign(listIn->at((int)indices->getIndexedScalar(i)));
-   		delete listOut;
-   		delete listIn;
-   	}
+	if(axis < 0)
+		axis += input->rankOf();
+
+	// indices are converted once, then all slices are copied by single kernel: scalar index gives one slice, vector or n-dim indices give slice per index
+	std::vector<int> idx(indices->lengthOf());
+	for(int i = 0; i < (int) idx.size(); ++i)
+		idx[i] = (int) indices->getIndexedScalar(i);
+
+	helpers::_gather<T, int>(input->getBuffer(), input->getShapeInfo(), output->getBuffer(), output->getShapeInfo(), axis, idx.data(), (Nd4jIndex) idx.size());
 
     STORE_RESULT(*output);	
 
@@ -3,6 +3,7 @@
 //
 
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/TadCache.h>
 #include <vector>
 #include <numeric>
 
@@ -84,16 +85,12 @@ void recursiveLoop(const int mode, Context<T>& block, NDArray<T>* input, const N
 	// then we use this array for tads building, every time while recursion the number of built tads becomes bigger 
 	dimensions.erase(dimensions.begin());    	
     // build tad basing on output array, also create auxiliary arrays pointing on required output array ranges
-    shape::TAD tadOut(output->getShapeInfo(), dimensions.data(), dimensions.size());
-    tadOut.createTadOnlyShapeInfo();
-    tadOut.createOffsets();
-    NDArray<T> subArrOut(output->getBuffer(), tadOut.tadOnlyShapeInfo, block.getWorkspace());
-    NDArray<T> subArr(output->getBuffer(), tadOut.tadOnlyShapeInfo, block.getWorkspace());
+    auto tadOut = nd4j::TadCache::getInstance()->tadForDimensions(output->getShapeInfo(), dimensions);
+    NDArray<T> subArrOut(output->getBuffer(), tadOut->tadOnlyShapeInfo(), block.getWorkspace());
+    NDArray<T> subArr(output->getBuffer(), tadOut->tadOnlyShapeInfo(), block.getWorkspace());
 	// build tad basing on input array, also create auxiliary array pointing on required input array range
-    shape::TAD tadIn(input->getShapeInfo(), dimensions.data(), dimensions.size());
-    tadIn.createTadOnlyShapeInfo();
-    tadIn.createOffsets();
-	NDArray<T> subArrIn(input->getBuffer(), tadIn.tadOnlyShapeInfo, block.getWorkspace());
+    auto tadIn = nd4j::TadCache::getInstance()->tadForDimensions(input->getShapeInfo(), dimensions);
+	NDArray<T> subArrIn(input->getBuffer(), tadIn->tadOnlyShapeInfo(), block.getWorkspace());
 	// these indices take into account recursion and always point to actual tads numbers
 	outIdx = outIdx*output->shapeOf()[dim+1];
 	inIdx  = inIdx*input->shapeOf()[dim+1];
@@ -111,8 +108,8 @@ void recursiveLoop(const int mode, Context<T>& block, NDArray<T>* input, const N
 			recursiveLoop(mode, block, input, paddings, output, dimensions, dim+1, inIdx + k, outIdx + i);
 		else {
    			// shift buffers pointers to actual element position
-   			subArrOut.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + i]);
-   			subArrIn.setBuffer (input->getBuffer()  + tadIn.tadOffsets[inIdx + i - (int)paddings->getScalar(dim,0)]);		    			   			
+   			subArrOut.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + i]);
+   			subArrIn.setBuffer (input->getBuffer()  + tadIn->tadOffsets()[inIdx + i - (int)paddings->getScalar(dim,0)]);		    			   			
    			leftOffset = (int)paddings->getScalar(dim+1,0);
    			// most inner loop, corresponds to last dim = rank-1
    			switch (mode) {
@@ -150,37 +147,37 @@ void recursiveLoop(const int mode, Context<T>& block, NDArray<T>* input, const N
 	switch (mode) {
 		case 0:			// CONSTANT mode
 			for(int j = 1;  j <= leftOffset; ++j) {														// fill left side with zeros
-				subArrOut.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + leftOffset - j]);
+				subArrOut.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + leftOffset - j]);
    				subArrOut.assign((T)0.);
    			}
    			for(int j = (output->shapeOf()[dim] - leftOffset); j < output->shapeOf()[dim]; ++j) {		// fill left side with zeros
-   				subArrOut.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + j]);
+   				subArrOut.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + j]);
    				subArrOut.assign((T)0.);
 			}	
 			break;
 
 		case 1:			// REFLECT mode	
 			for(int j = 1;  j <= leftOffset; ++j) {														// fill left side 
-   				subArr.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + leftOffset + j]);
-   				subArrOut.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + leftOffset - j]);
+   				subArr.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + leftOffset + j]);
+   				subArrOut.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + leftOffset - j]);
    				subArrOut.assign(&subArr);
    			}   			
 			for(int j = (output->shapeOf()[dim] - leftOffset); j < output->shapeOf()[dim]; ++j) {		// fill right side
-				subArr.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + output->shapeOf()[dim] + leftOffset - 1 - j]);
-   				subArrOut.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + j]);
+				subArr.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + output->shapeOf()[dim] + leftOffset - 1 - j]);
+   				subArrOut.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + j]);
    				subArrOut.assign(&subArr);				
 			}	
 			break;
 
 		case 2:			// SYMMETRIC mode	
 			for(int j = 1;  j <= leftOffset; ++j) {														// fill left side
-   				subArr.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + leftOffset + j - 1]);
-   				subArrOut.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + leftOffset - j]);
+   				subArr.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + leftOffset + j - 1]);
+   				subArrOut.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + leftOffset - j]);
    				subArrOut.assign(&subArr);
    			}   		
 			for(int j = (output->shapeOf()[dim] - leftOffset); j < output->shapeOf()[dim]; ++j) {		// fill right side
-				subArr.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + output->shapeOf()[dim] + leftOffset - j]);
-   				subArrOut.setBuffer(output->getBuffer() + tadOut.tadOffsets[outIdx + j]);
+				subArr.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + output->shapeOf()[dim] + leftOffset - j]);
+   				subArrOut.setBuffer(output->getBuffer() + tadOut->tadOffsets()[outIdx + j]);
    				subArrOut.assign(&subArr);		
    			}
    			break;
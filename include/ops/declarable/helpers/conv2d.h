@@ -0,0 +1,62 @@
+#ifndef LIBND4J_CONV2D_HELPERS_H
+#define LIBND4J_CONV2D_HELPERS_H
+
+#include <pointercast.h>
+#include <types/float16.h>
+#include <NDArray.h>
+
+// conv2d algorithms, algorithm can be requested explicitly via optional 10th integer argument of conv2d/conv2d_bp
+#define CONV2D_ALGO_AUTO 0
+#define CONV2D_ALGO_IM2COL 1
+#define CONV2D_ALGO_DIRECT 2
+#define CONV2D_ALGO_IMPLICIT_GEMM 3
+#define CONV2D_ALGO_WINOGRAD 4
+
+// max number of elements in column tile used by implicit GEMM & Winograd, instead of full im2col buffer
+#define CONV2D_TILE_LENGTH 262144
+
+// number of output channels computed together by direct kernel, so each input row is reused for all of them
+#define CONV2D_DIRECT_BLOCK 4
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            /**
+             * This method picks conv2d algorithm for given layer shape. All arrays are NCHW, weights are [oC, iC, kH, kW].
+             * Requested algorithm is used if it's applicable, otherwise heuristic choice is made:
+             * - Winograd F(2x2, 3x3) for 3x3 stride 1 non-dilated kernels with enough channels
+             * - direct kernel for layers with small reduction dimension, i.e. first layers with few input channels
+             * - implicit GEMM for everything else
+             * Arrays which aren't c-ordered & contiguous always go to im2col path.
+             */
+            template <typename T>
+            int _conv2dAlgorithm(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* output, int kH, int kW, int sH, int sW, int dH, int dW, int requested);
+
+            /**
+             * Direct convolution, blocked over output channels. No intermediate buffers at all.
+             */
+            template <typename T>
+            void _conv2dDirect(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* bias, NDArray<T>* output, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+
+            /**
+             * GEMM over column tiles: only CONV2D_TILE_LENGTH elements of im2col buffer exist at any moment. 1x1 kernels don't use columns at all.
+             */
+            template <typename T>
+            void _conv2dImplicitGemm(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* bias, NDArray<T>* output, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+
+            /**
+             * Winograd F(2x2, 3x3): 16 GEMMs over transformed weights & input tiles. Stride 1, dilation 1 only.
+             */
+            template <typename T>
+            void _conv2dWinograd(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* bias, NDArray<T>* output, int pH, int pW);
+
+            /**
+             * Backprop via implicit GEMM: gradW and epsilon are accumulated tile by tile. gradB is optional.
+             */
+            template <typename T>
+            void _conv2dBpImplicitGemm(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* epsilonNext, NDArray<T>* epsilon, NDArray<T>* gradW, NDArray<T>* gradB, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+        }
+    }
+}
+
+#endif //LIBND4J_CONV2D_HELPERS_H
@@ -0,0 +1,480 @@
+#include <ops/declarable/helpers/conv2d.h>
+#include <ops/gemm.h>
+#include <vector>
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            template <typename T>
+            static bool isContiguous(NDArray<T>* array) {
+                return array == nullptr || (array->ordering() == 'c' && array->ews() == 1);
+            }
+
+            template <typename T>
+            static std::vector<T> biasValues(NDArray<T>* bias, int oC) {
+                std::vector<T> result(oC, (T) 0.0f);
+                if (bias != nullptr)
+                    for (int e = 0; e < oC; e++)
+                        result[e] = bias->getScalar(e);
+
+                return result;
+            }
+
+            /**
+             * Fills K x tileLength columns for output pixels [p0, p0 + tileLength) of single image
+             */
+            template <typename T>
+            static void fillColumns(T* image, T* columns, Nd4jIndex p0, int tileLength, int iC, int iH, int iW, int oW, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW) {
+                int K = iC * kH * kW;
+
+#pragma omp parallel for schedule(static) if (K * tileLength > 4096)
+                for (int k = 0; k < K; k++) {
+                    int ic = k / (kH * kW);
+                    int kh = (k / kW) % kH;
+                    int kw = k % kW;
+
+                    T* x = image + (Nd4jIndex) ic * iH * iW;
+                    T* col = columns + (Nd4jIndex) k * tileLength;
+
+                    for (int j = 0; j < tileLength; j++) {
+                        Nd4jIndex p = p0 + j;
+                        int oh = (int) (p / oW);
+                        int ow = (int) (p % oW);
+                        int ih = oh * sH - pH + kh * dH;
+                        int iw = ow * sW - pW + kw * dW;
+
+                        col[j] = ih >= 0 && ih < iH && iw >= 0 && iw < iW ? x[ih * iW + iw] : (T) 0.0f;
+                    }
+                }
+            }
+
+            /**
+             * Accumulates K x tileLength columns back into single image, that's col2im for one tile
+             */
+            template <typename T>
+            static void accumulateColumns(T* columns, T* image, Nd4jIndex p0, int tileLength, int iC, int iH, int iW, int oW, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW) {
+                // different channels never overlap, so we go parallel over them
+#pragma omp parallel for schedule(static) if (iC > 1)
+                for (int ic = 0; ic < iC; ic++) {
+                    T* x = image + (Nd4jIndex) ic * iH * iW;
+
+                    for (int kh = 0; kh < kH; kh++) {
+                        for (int kw = 0; kw < kW; kw++) {
+                            T* col = columns + (Nd4jIndex) ((ic * kH + kh) * kW + kw) * tileLength;
+
+                            for (int j = 0; j < tileLength; j++) {
+                                Nd4jIndex p = p0 + j;
+                                int oh = (int) (p / oW);
+                                int ow = (int) (p % oW);
+                                int ih = oh * sH - pH + kh * dH;
+                                int iw = ow * sW - pW + kw * dW;
+
+                                if (ih >= 0 && ih < iH && iw >= 0 && iw < iW)
+                                    x[ih * iW + iw] += col[j];
+                            }
+                        }
+                    }
+                }
+            }
+
+            static int tileLength(int K, Nd4jIndex numPixels) {
+                Nd4jIndex length = nd4j::math::nd4j_max<Nd4jIndex>(64, CONV2D_TILE_LENGTH / nd4j::math::nd4j_max<int>(K, 1));
+                return (int) nd4j::math::nd4j_min<Nd4jIndex>(length, numPixels);
+            }
+
+            template <typename T>
+            int _conv2dAlgorithm(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* output, int kH, int kW, int sH, int sW, int dH, int dW, int requested) {
+                if (!isContiguous(input) || !isContiguous(weights) || !isContiguous(output))
+                    return CONV2D_ALGO_IM2COL;
+
+                const int iC = input->sizeAt(1);
+                const int oC = weights->sizeAt(0);
+                const int oH = output->sizeAt(2);
+                const int oW = output->sizeAt(3);
+
+                bool winogradApplicable = kH == 3 && kW == 3 && sH == 1 && sW == 1 && dH == 1 && dW == 1;
+
+                switch (requested) {
+                    case CONV2D_ALGO_IM2COL:
+                    case CONV2D_ALGO_DIRECT:
+                    case CONV2D_ALGO_IMPLICIT_GEMM:
+                        return requested;
+                    case CONV2D_ALGO_WINOGRAD:
+                        if (winogradApplicable)
+                            return requested;
+                    default:
+                        break;
+                }
+
+                // half precision doesn't have enough mantissa for Winograd transforms
+                if (winogradApplicable && sizeof(T) >= 4 && iC >= 8 && oC >= 8 && oH >= 4 && oW >= 4)
+                    return CONV2D_ALGO_WINOGRAD;
+
+                // GEMM isn't efficient for short reduction dimension
+                if (iC * kH * kW < 32)
+                    return CONV2D_ALGO_DIRECT;
+
+                return CONV2D_ALGO_IMPLICIT_GEMM;
+            }
+
+            template <typename T>
+            void _conv2dDirect(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* bias, NDArray<T>* output, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW) {
+                const int bS = input->sizeAt(0);
+                const int iC = input->sizeAt(1);
+                const int iH = input->sizeAt(2);
+                const int iW = input->sizeAt(3);
+                const int oC = weights->sizeAt(0);
+                const int oH = output->sizeAt(2);
+                const int oW = output->sizeAt(3);
+
+                const Nd4jIndex iHW = (Nd4jIndex) iH * iW;
+                const Nd4jIndex oHW = (Nd4jIndex) oH * oW;
+
+                T* in = input->getBuffer();
+                T* w = weights->getBuffer();
+                T* out = output->getBuffer();
+
+                auto b = biasValues(bias, oC);
+
+                const int ocBlocks = (oC + CONV2D_DIRECT_BLOCK - 1) / CONV2D_DIRECT_BLOCK;
+
+#pragma omp parallel for schedule(guided)
+                for (int idx = 0; idx < bS * ocBlocks; idx++) {
+                    int n = idx / ocBlocks;
+                    int oc0 = (idx % ocBlocks) * CONV2D_DIRECT_BLOCK;
+                    int ocN = nd4j::math::nd4j_min<int>(CONV2D_DIRECT_BLOCK, oC - oc0);
+
+                    T* z = out + ((Nd4jIndex) n * oC + oc0) * oHW;
+
+                    for (int o = 0; o < ocN; o++) {
+                        T value = b[oc0 + o];
+                        T* zp = z + o * oHW;
+                        for (Nd4jIndex e = 0; e < oHW; e++)
+                            zp[e] = value;
+                    }
+
+                    for (int ic = 0; ic < iC; ic++) {
+                        T* x = in + ((Nd4jIndex) n * iC + ic) * iHW;
+
+                        for (int kh = 0; kh < kH; kh++) {
+                            for (int kw = 0; kw < kW; kw++) {
+                                T wv[CONV2D_DIRECT_BLOCK];
+                                for (int o = 0; o < ocN; o++)
+                                    wv[o] = w[(((Nd4jIndex) (oc0 + o) * iC + ic) * kH + kh) * kW + kw];
+
+                                // range of output columns that hit the image for this kernel column
+                                int offset = kw * dW - pW;
+                                int owStart = offset >= 0 ? 0 : (-offset + sW - 1) / sW;
+                                int owEnd = iW - 1 - offset < 0 ? 0 : nd4j::math::nd4j_min<int>(oW, (iW - 1 - offset) / sW + 1);
+
+                                for (int oh = 0; oh < oH; oh++) {
+                                    int ih = oh * sH - pH + kh * dH;
+                                    if (ih < 0 || ih >= iH)
+                                        continue;
+
+                                    T* xr = x + ih * iW + offset;
+
+                                    for (int o = 0; o < ocN; o++) {
+                                        T* zr = z + o * oHW + oh * oW;
+                                        T v = wv[o];
+
+#pragma omp simd
+                                        for (int ow = owStart; ow < owEnd; ow++)
+                                            zr[ow] += v * xr[ow * sW];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            template <typename T>
+            void _conv2dImplicitGemm(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* bias, NDArray<T>* output, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW) {
+                const int bS = input->sizeAt(0);
+                const int iC = input->sizeAt(1);
+                const int iH = input->sizeAt(2);
+                const int iW = input->sizeAt(3);
+                const int oC = weights->sizeAt(0);
+                const int oH = output->sizeAt(2);
+                const int oW = output->sizeAt(3);
+
+                const int K = iC * kH * kW;
+                const Nd4jIndex iHW = (Nd4jIndex) iH * iW;
+                const Nd4jIndex oHW = (Nd4jIndex) oH * oW;
+
+                T* in = input->getBuffer();
+                T* w = weights->getBuffer();
+                T* out = output->getBuffer();
+
+                // pointwise convolution is plain GEMM over input image
+                bool pointwise = kH == 1 && kW == 1 && sH == 1 && sW == 1 && pH == 0 && pW == 0 && oH == iH && oW == iW;
+
+                int tile = tileLength(K, oHW);
+                std::vector<T> columns(pointwise ? 0 : (Nd4jIndex) K * tile);
+
+                for (int n = 0; n < bS; n++) {
+                    T* image = in + (Nd4jIndex) n * iC * iHW;
+                    T* z = out + (Nd4jIndex) n * oC * oHW;
+
+                    if (pointwise) {
+                        nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasNoTrans, oC, (int) oHW, K, (T) 1.0f, w, K, image, (int) oHW, (T) 0.0f, z, (int) oHW);
+                        continue;
+                    }
+
+                    for (Nd4jIndex p0 = 0; p0 < oHW; p0 += tile) {
+                        int length = (int) nd4j::math::nd4j_min<Nd4jIndex>(tile, oHW - p0);
+
+                        fillColumns(image, columns.data(), p0, length, iC, iH, iW, oW, kH, kW, sH, sW, pH, pW, dH, dW);
+                        nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasNoTrans, oC, length, K, (T) 1.0f, w, K, columns.data(), length, (T) 0.0f, z + p0, (int) oHW);
+                    }
+                }
+
+                if (bias != nullptr) {
+                    auto b = biasValues(bias, oC);
+
+#pragma omp parallel for schedule(static)
+                    for (int idx = 0; idx < bS * oC; idx++) {
+                        T* zp = out + (Nd4jIndex) idx * oHW;
+                        T value = b[idx % oC];
+                        for (Nd4jIndex e = 0; e < oHW; e++)
+                            zp[e] += value;
+                    }
+                }
+            }
+
+            template <typename T>
+            void _conv2dWinograd(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* bias, NDArray<T>* output, int pH, int pW) {
+                const int bS = input->sizeAt(0);
+                const int iC = input->sizeAt(1);
+                const int iH = input->sizeAt(2);
+                const int iW = input->sizeAt(3);
+                const int oC = weights->sizeAt(0);
+                const int oH = output->sizeAt(2);
+                const int oW = output->sizeAt(3);
+
+                const Nd4jIndex iHW = (Nd4jIndex) iH * iW;
+                const Nd4jIndex oHW = (Nd4jIndex) oH * oW;
+
+                // each tile produces 2x2 outputs out of 4x4 inputs
+                const int tH = (oH + 1) / 2;
+                const int tW = (oW + 1) / 2;
+                const Nd4jIndex numTiles = (Nd4jIndex) bS * tH * tW;
+
+                T* in = input->getBuffer();
+                T* w = weights->getBuffer();
+                T* out = output->getBuffer();
+
+                auto b = biasValues(bias, oC);
+
+                // U = G g G^T, stored as 16 matrices of [oC, iC]
+                std::vector<T> U((Nd4jIndex) 16 * oC * iC);
+
+#pragma omp parallel for schedule(static)
+                for (int idx = 0; idx < oC * iC; idx++) {
+                    T* g = w + (Nd4jIndex) idx * 9;
+                    T gg[4][3];
+
+                    for (int c = 0; c < 3; c++) {
+                        gg[0][c] = g[c];
+                        gg[1][c] = (g[c] + g[3 + c] + g[6 + c]) * (T) 0.5f;
+                        gg[2][c] = (g[c] - g[3 + c] + g[6 + c]) * (T) 0.5f;
+                        gg[3][c] = g[6 + c];
+                    }
+
+                    for (int r = 0; r < 4; r++) {
+                        T u[4];
+                        u[0] = gg[r][0];
+                        u[1] = (gg[r][0] + gg[r][1] + gg[r][2]) * (T) 0.5f;
+                        u[2] = (gg[r][0] - gg[r][1] + gg[r][2]) * (T) 0.5f;
+                        u[3] = gg[r][2];
+
+                        for (int c = 0; c < 4; c++)
+                            U[(Nd4jIndex) (r * 4 + c) * oC * iC + idx] = u[c];
+                    }
+                }
+
+                // tiles are processed in chunks, so transformed buffers stay bounded
+                Nd4jIndex chunk = nd4j::math::nd4j_max<Nd4jIndex>(16, CONV2D_TILE_LENGTH / (16 * nd4j::math::nd4j_max<int>(iC, oC)));
+                chunk = nd4j::math::nd4j_min<Nd4jIndex>(chunk, numTiles);
+
+                std::vector<T> V((Nd4jIndex) 16 * iC * chunk);
+                std::vector<T> M((Nd4jIndex) 16 * oC * chunk);
+
+                for (Nd4jIndex t0 = 0; t0 < numTiles; t0 += chunk) {
+                    int length = (int) nd4j::math::nd4j_min<Nd4jIndex>(chunk, numTiles - t0);
+
+                    // V = B^T d B
+#pragma omp parallel for schedule(static)
+                    for (Nd4jIndex idx = 0; idx < (Nd4jIndex) length * iC; idx++) {
+                        int j = (int) (idx / iC);
+                        int ic = (int) (idx % iC);
+
+                        Nd4jIndex tile = t0 + j;
+                        int n = (int) (tile / (tH * tW));
+                        int th = (int) ((tile / tW) % tH);
+                        int tw = (int) (tile % tW);
+
+                        T* x = in + ((Nd4jIndex) n * iC + ic) * iHW;
+                        int h0 = th * 2 - pH;
+                        int w0 = tw * 2 - pW;
+
+                        T d[4][4];
+                        for (int r = 0; r < 4; r++)
+                            for (int c = 0; c < 4; c++) {
+                                int ih = h0 + r;
+                                int iw = w0 + c;
+                                d[r][c] = ih >= 0 && ih < iH && iw >= 0 && iw < iW ? x[ih * iW + iw] : (T) 0.0f;
+                            }
+
+                        T bd[4][4];
+                        for (int c = 0; c < 4; c++) {
+                            bd[0][c] = d[0][c] - d[2][c];
+                            bd[1][c] = d[1][c] + d[2][c];
+                            bd[2][c] = d[2][c] - d[1][c];
+                            bd[3][c] = d[1][c] - d[3][c];
+                        }
+
+                        for (int r = 0; r < 4; r++) {
+                            T v[4];
+                            v[0] = bd[r][0] - bd[r][2];
+                            v[1] = bd[r][1] + bd[r][2];
+                            v[2] = bd[r][2] - bd[r][1];
+                            v[3] = bd[r][1] - bd[r][3];
+
+                            for (int c = 0; c < 4; c++)
+                                V[((Nd4jIndex) (r * 4 + c) * iC + ic) * length + j] = v[c];
+                        }
+                    }
+
+                    // M[xi] = U[xi] * V[xi], 16 independent GEMMs
+                    for (int xi = 0; xi < 16; xi++)
+                        nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasNoTrans, oC, length, iC, (T) 1.0f, U.data() + (Nd4jIndex) xi * oC * iC, iC, V.data() + (Nd4jIndex) xi * iC * length, length, (T) 0.0f, M.data() + (Nd4jIndex) xi * oC * length, length);
+
+                    // Y = A^T m A
+#pragma omp parallel for schedule(static)
+                    for (Nd4jIndex idx = 0; idx < (Nd4jIndex) length * oC; idx++) {
+                        int j = (int) (idx / oC);
+                        int oc = (int) (idx % oC);
+
+                        Nd4jIndex tile = t0 + j;
+                        int n = (int) (tile / (tH * tW));
+                        int th = (int) ((tile / tW) % tH);
+                        int tw = (int) (tile % tW);
+
+                        T m[4][4];
+                        for (int r = 0; r < 4; r++)
+                            for (int c = 0; c < 4; c++)
+                                m[r][c] = M[((Nd4jIndex) (r * 4 + c) * oC + oc) * length + j];
+
+                        T am[2][4];
+                        for (int c = 0; c < 4; c++) {
+                            am[0][c] = m[0][c] + m[1][c] + m[2][c];
+                            am[1][c] = m[1][c] - m[2][c] - m[3][c];
+                        }
+
+                        T* z = out + ((Nd4jIndex) n * oC + oc) * oHW;
+                        for (int r = 0; r < 2; r++) {
+                            int oh = th * 2 + r;
+                            if (oh >= oH)
+                                continue;
+
+                            T y0 = am[r][0] + am[r][1] + am[r][2];
+                            T y1 = am[r][1] - am[r][2] - am[r][3];
+
+                            int ow = tw * 2;
+                            z[oh * oW + ow] = y0 + b[oc];
+                            if (ow + 1 < oW)
+                                z[oh * oW + ow + 1] = y1 + b[oc];
+                        }
+                    }
+                }
+            }
+
+            template <typename T>
+            void _conv2dBpImplicitGemm(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* epsilonNext, NDArray<T>* epsilon, NDArray<T>* gradW, NDArray<T>* gradB, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW) {
+                const int bS = input->sizeAt(0);
+                const int iC = input->sizeAt(1);
+                const int iH = input->sizeAt(2);
+                const int iW = input->sizeAt(3);
+                const int oC = weights->sizeAt(0);
+                const int oH = epsilonNext->sizeAt(2);
+                const int oW = epsilonNext->sizeAt(3);
+
+                const int K = iC * kH * kW;
+                const Nd4jIndex iHW = (Nd4jIndex) iH * iW;
+                const Nd4jIndex oHW = (Nd4jIndex) oH * oW;
+
+                T* in = input->getBuffer();
+                T* w = weights->getBuffer();
+                T* eps = epsilonNext->getBuffer();
+                T* gI = epsilon->getBuffer();
+                T* gW = gradW->getBuffer();
+
+                int tile = tileLength(K, oHW);
+                std::vector<T> columns((Nd4jIndex) K * tile);
+
+                gradW->assign((T) 0.0f);
+                epsilon->assign((T) 0.0f);
+
+                for (int n = 0; n < bS; n++) {
+                    T* image = in + (Nd4jIndex) n * iC * iHW;
+                    T* gImage = gI + (Nd4jIndex) n * iC * iHW;
+                    T* e = eps + (Nd4jIndex) n * oC * oHW;
+
+                    for (Nd4jIndex p0 = 0; p0 < oHW; p0 += tile) {
+                        int length = (int) nd4j::math::nd4j_min<Nd4jIndex>(tile, oHW - p0);
+
+                        // gradW += eps_tile * columns^T
+                        fillColumns(image, columns.data(), p0, length, iC, iH, iW, oW, kH, kW, sH, sW, pH, pW, dH, dW);
+                        nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasTrans, oC, K, length, (T) 1.0f, e + p0, (int) oHW, columns.data(), length, (T) 1.0f, gW, K);
+
+                        // columns = W^T * eps_tile, and then it's folded back into epsilon
+                        nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasTrans, CblasNoTrans, K, length, oC, (T) 1.0f, w, K, e + p0, (int) oHW, (T) 0.0f, columns.data(), length);
+                        accumulateColumns(columns.data(), gImage, p0, length, iC, iH, iW, oW, kH, kW, sH, sW, pH, pW, dH, dW);
+                    }
+                }
+
+                if (gradB != nullptr) {
+                    std::vector<T> sums(oC, (T) 0.0f);
+
+#pragma omp parallel for schedule(static)
+                    for (int oc = 0; oc < oC; oc++) {
+                        T sum = (T) 0.0f;
+                        for (int n = 0; n < bS; n++) {
+                            T* ep = eps + ((Nd4jIndex) n * oC + oc) * oHW;
+                            for (Nd4jIndex p = 0; p < oHW; p++)
+                                sum += ep[p];
+                        }
+
+                        sums[oc] = sum;
+                    }
+
+                    for (int oc = 0; oc < oC; oc++)
+                        gradB->putScalar(oc, sums[oc]);
+                }
+            }
+
+
+            template int _conv2dAlgorithm<float>(NDArray<float>* input, NDArray<float>* weights, NDArray<float>* output, int kH, int kW, int sH, int sW, int dH, int dW, int requested);
+            template int _conv2dAlgorithm<float16>(NDArray<float16>* input, NDArray<float16>* weights, NDArray<float16>* output, int kH, int kW, int sH, int sW, int dH, int dW, int requested);
+            template int _conv2dAlgorithm<double>(NDArray<double>* input, NDArray<double>* weights, NDArray<double>* output, int kH, int kW, int sH, int sW, int dH, int dW, int requested);
+
+            template void _conv2dDirect<float>(NDArray<float>* input, NDArray<float>* weights, NDArray<float>* bias, NDArray<float>* output, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+            template void _conv2dDirect<float16>(NDArray<float16>* input, NDArray<float16>* weights, NDArray<float16>* bias, NDArray<float16>* output, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+            template void _conv2dDirect<double>(NDArray<double>* input, NDArray<double>* weights, NDArray<double>* bias, NDArray<double>* output, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+
+            template void _conv2dImplicitGemm<float>(NDArray<float>* input, NDArray<float>* weights, NDArray<float>* bias, NDArray<float>* output, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+            template void _conv2dImplicitGemm<float16>(NDArray<float16>* input, NDArray<float16>* weights, NDArray<float16>* bias, NDArray<float16>* output, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+            template void _conv2dImplicitGemm<double>(NDArray<double>* input, NDArray<double>* weights, NDArray<double>* bias, NDArray<double>* output, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+
+            template void _conv2dWinograd<float>(NDArray<float>* input, NDArray<float>* weights, NDArray<float>* bias, NDArray<float>* output, int pH, int pW);
+            template void _conv2dWinograd<float16>(NDArray<float16>* input, NDArray<float16>* weights, NDArray<float16>* bias, NDArray<float16>* output, int pH, int pW);
+            template void _conv2dWinograd<double>(NDArray<double>* input, NDArray<double>* weights, NDArray<double>* bias, NDArray<double>* output, int pH, int pW);
+
+            template void _conv2dBpImplicitGemm<float>(NDArray<float>* input, NDArray<float>* weights, NDArray<float>* epsilonNext, NDArray<float>* epsilon, NDArray<float>* gradW, NDArray<float>* gradB, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+            template void _conv2dBpImplicitGemm<float16>(NDArray<float16>* input, NDArray<float16>* weights, NDArray<float16>* epsilonNext, NDArray<float16>* epsilon, NDArray<float16>* gradW, NDArray<float16>* gradB, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+            template void _conv2dBpImplicitGemm<double>(NDArray<double>* input, NDArray<double>* weights, NDArray<double>* epsilonNext, NDArray<double>* epsilon, NDArray<double>* gradW, NDArray<double>* gradB, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW);
+        }
+    }
+}
@@ -0,0 +1,260 @@
+#include <ops/ops.h>
+#include <helpers/shape.h>
+#include <helpers/TadCache.h>
+#include <op_boilerplate.h>
+#include <Environment.h>
+#include <ops/declarable/helpers/gather.h>
+#include <cstring>
+#include <vector>
+#include <omp.h>
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            /**
+             * C order walk over TAD, offset is updated incrementally instead of ind2subC for every element
+             */
+            class TadWalker {
+            private:
+                int _rank;
+                int *_shape;
+                int *_stride;
+                int _coords[MAX_RANK];
+                Nd4jIndex _offset = 0;
+
+            public:
+                explicit TadWalker(int *shapeInfo) {
+                    _rank = shape::rank(shapeInfo);
+                    _shape = shape::shapeOf(shapeInfo);
+                    _stride = shape::stride(shapeInfo);
+                    for (int d = 0; d < _rank; d++)
+                        _coords[d] = 0;
+                }
+
+                FORCEINLINE Nd4jIndex offset() {
+                    return _offset;
+                }
+
+                FORCEINLINE void next() {
+                    for (int d = _rank - 1; d >= 0; d--) {
+                        if (++_coords[d] < _shape[d]) {
+                            _offset += _stride[d];
+                            return;
+                        }
+
+                        _offset -= (Nd4jIndex) (_shape[d] - 1) * _stride[d];
+                        _coords[d] = 0;
+                    }
+                }
+            };
+
+            /**
+             * Element f of linear TAD in c order is at f * ews
+             */
+            static FORCEINLINE bool _isLinear(int* shapeInfo) {
+                return shape::elementWiseStride(shapeInfo) >= 1 && (shape::order(shapeInfo) == 'c' || shape::isVector(shapeInfo) || shape::length(shapeInfo) == 1);
+            }
+
+            template <typename T>
+            static FORCEINLINE void _copyRow(T* x, int* xTadShape, int xEws, T* z, int* zTadShape, int zEws, Nd4jIndex length) {
+                if (xEws == 1 && zEws == 1) {
+                    memcpy(z, x, length * sizeof(T));
+                } else if (xEws >= 1 && zEws >= 1) {
+                    for (Nd4jIndex f = 0; f < length; f++)
+                        z[f * zEws] = x[f * xEws];
+                } else {
+                    TadWalker xWalker(xTadShape);
+                    TadWalker zWalker(zTadShape);
+                    for (Nd4jIndex f = 0; f < length; f++) {
+                        z[zWalker.offset()] = x[xWalker.offset()];
+                        xWalker.next();
+                        zWalker.next();
+                    }
+                }
+            }
+
+            template <typename T>
+            static FORCEINLINE void _addRow(T* x, int* xTadShape, int xEws, T* z, int* zTadShape, int zEws, Nd4jIndex length) {
+                if (xEws == 1 && zEws == 1) {
+#pragma omp simd
+                    for (Nd4jIndex f = 0; f < length; f++)
+                        z[f] += x[f];
+                } else if (xEws >= 1 && zEws >= 1) {
+                    for (Nd4jIndex f = 0; f < length; f++)
+                        z[f * zEws] += x[f * xEws];
+                } else {
+                    TadWalker xWalker(xTadShape);
+                    TadWalker zWalker(zTadShape);
+                    for (Nd4jIndex f = 0; f < length; f++) {
+                        z[zWalker.offset()] += x[xWalker.offset()];
+                        xWalker.next();
+                        zWalker.next();
+                    }
+                }
+            }
+
+            template <typename T>
+            static FORCEINLINE void _zeroRow(T* z, int* zTadShape, int zEws, Nd4jIndex length) {
+                if (zEws == 1) {
+                    memset(z, 0, length * sizeof(T));
+                } else if (zEws > 1) {
+                    for (Nd4jIndex f = 0; f < length; f++)
+                        z[f * zEws] = (T) 0.0f;
+                } else {
+                    TadWalker zWalker(zTadShape);
+                    for (Nd4jIndex f = 0; f < length; f++) {
+                        z[zWalker.offset()] = (T) 0.0f;
+                        zWalker.next();
+                    }
+                }
+            }
+
+            template <typename T>
+            static FORCEINLINE void _divideRow(T* z, int* zTadShape, int zEws, Nd4jIndex length, T divisor) {
+                if (zEws >= 1) {
+                    for (Nd4jIndex f = 0; f < length; f++)
+                        z[f * zEws] /= divisor;
+                } else {
+                    TadWalker zWalker(zTadShape);
+                    for (Nd4jIndex f = 0; f < length; f++) {
+                        z[zWalker.offset()] /= divisor;
+                        zWalker.next();
+                    }
+                }
+            }
+
+            template <typename T, typename I>
+            void _gather(T* x, int* xShapeInfo, T* z, int* zShapeInfo, int axis, const I* indices, Nd4jIndex numIndices) {
+                int xRank = shape::rank(xShapeInfo);
+                int zRank = shape::rank(zShapeInfo);
+                if (axis < 0)
+                    axis += xRank;
+
+                int indicesRank = zRank - xRank + 1;
+                int numSlices = shape::shapeOf(xShapeInfo)[axis];
+
+                for (Nd4jIndex e = 0; e < numIndices; e++)
+                    if (indices[e] < 0 || indices[e] >= numSlices)
+                        throw "gather: index is out of range";
+
+                std::vector<int> xDims;
+                for (int d = 0; d < xRank; d++)
+                    if (d != axis)
+                        xDims.emplace_back(d);
+
+                // z slices span all dimensions except ones taken by indices
+                std::vector<int> zDims;
+                for (int d = 0; d < zRank; d++)
+                    if (d < axis || d >= axis + indicesRank)
+                        zDims.emplace_back(d);
+
+                auto xPack = nd4j::TadCache::getInstance()->tadForDimensions(xShapeInfo, xDims);
+                int *xTadShape = xPack->tadOnlyShapeInfo();
+                Nd4jIndex *xOffsets = xPack->tadOffsets();
+
+                // scalar index: whole z is single slice
+                std::shared_ptr<TadPack> zPack;
+                int *zTadShape = zShapeInfo;
+                Nd4jIndex zSingle = 0;
+                Nd4jIndex *zOffsets = &zSingle;
+                if (indicesRank > 0) {
+                    zPack = nd4j::TadCache::getInstance()->tadForDimensions(zShapeInfo, zDims);
+                    if (zPack->numberOfTads() != numIndices)
+                        throw "gather: output shape doesn't match number of indices";
+
+                    zTadShape = zPack->tadOnlyShapeInfo();
+                    zOffsets = zPack->tadOffsets();
+                } else if (numIndices != 1) {
+                    throw "gather: output shape doesn't match number of indices";
+                }
+
+                Nd4jIndex tadLength = shape::length(xTadShape);
+                if (shape::length(zTadShape) != tadLength)
+                    throw "gather: output slices don't match input slices";
+
+                // -1 means slices are walked via TadWalker
+                int xEws = _isLinear(xTadShape) ? shape::elementWiseStride(xTadShape) : -1;
+                int zEws = _isLinear(zTadShape) ? shape::elementWiseStride(zTadShape) : -1;
+
+                int num_threads = (int) nd4j::math::nd4j_min<Nd4jIndex>(numIndices * tadLength / ELEMENT_THRESHOLD_FOR(OP_CLASS_TRANSFORM), MAX_THREADS_FOR(OP_CLASS_TRANSFORM));
+                num_threads = nd4j::math::nd4j_max<int>(1, num_threads);
+
+#pragma omp parallel for num_threads(num_threads) if (num_threads > 1) schedule(static) proc_bind(AFFINITY) default(shared)
+                for (Nd4jIndex e = 0; e < numIndices; e++)
+                    _copyRow<T>(x + xOffsets[(Nd4jIndex) indices[e]], xTadShape, xEws, z + zOffsets[e], zTadShape, zEws, tadLength);
+            }
+
+            template <typename T, typename I>
+            void _embeddingBag(T* x, int* xShapeInfo, T* z, int* zShapeInfo, const I* indices, Nd4jIndex numBags, Nd4jIndex bagSize, bool mean) {
+                int numRows = shape::shapeOf(xShapeInfo)[0];
+                for (Nd4jIndex e = 0; e < numBags * bagSize; e++)
+                    if (indices[e] >= numRows)
+                        throw "embedding_bag: index is out of range";
+
+                std::vector<int> xDims;
+                for (int d = 1; d < shape::rank(xShapeInfo); d++)
+                    xDims.emplace_back(d);
+
+                std::vector<int> zDims;
+                for (int d = 1; d < shape::rank(zShapeInfo); d++)
+                    zDims.emplace_back(d);
+
+                auto xPack = nd4j::TadCache::getInstance()->tadForDimensions(xShapeInfo, xDims);
+                auto zPack = nd4j::TadCache::getInstance()->tadForDimensions(zShapeInfo, zDims);
+                if (zPack->numberOfTads() != numBags)
+                    throw "embedding_bag: output shape doesn't match number of bags";
+
+                int *xTadShape = xPack->tadOnlyShapeInfo();
+                int *zTadShape = zPack->tadOnlyShapeInfo();
+                Nd4jIndex *xOffsets = xPack->tadOffsets();
+                Nd4jIndex *zOffsets = zPack->tadOffsets();
+
+                Nd4jIndex tadLength = shape::length(xTadShape);
+                if (shape::length(zTadShape) != tadLength)
+                    throw "embedding_bag: output rows don't match input rows";
+
+                int xEws = _isLinear(xTadShape) ? shape::elementWiseStride(xTadShape) : -1;
+                int zEws = _isLinear(zTadShape) ? shape::elementWiseStride(zTadShape) : -1;
+
+                int num_threads = (int) nd4j::math::nd4j_min<Nd4jIndex>(numBags * bagSize * tadLength / ELEMENT_THRESHOLD_FOR(OP_CLASS_TRANSFORM), MAX_THREADS_FOR(OP_CLASS_TRANSFORM));
+                num_threads = nd4j::math::nd4j_max<int>(1, num_threads);
+
+                // every bag is owned by single thread, so rows are accumulated right in z, in order of indices
+#pragma omp parallel for num_threads(num_threads) if (num_threads > 1) schedule(static) proc_bind(AFFINITY) default(shared)
+                for (Nd4jIndex b = 0; b < numBags; b++) {
+                    T *zRow = z + zOffsets[b];
+                    _zeroRow<T>(zRow, zTadShape, zEws, tadLength);
+
+                    Nd4jIndex count = 0;
+                    for (Nd4jIndex j = 0; j < bagSize; j++) {
+                        Nd4jIndex idx = (Nd4jIndex) indices[b * bagSize + j];
+                        if (idx < 0)
+                            continue;
+
+                        _addRow<T>(x + xOffsets[idx], xTadShape, xEws, zRow, zTadShape, zEws, tadLength);
+                        count++;
+                    }
+
+                    if (mean && count > 1)
+                        _divideRow<T>(zRow, zTadShape, zEws, tadLength, (T) count);
+                }
+            }
+
+            template void _gather<float, int>(float* x, int* xShapeInfo, float* z, int* zShapeInfo, int axis, const int* indices, Nd4jIndex numIndices);
+            template void _gather<float16, int>(float16* x, int* xShapeInfo, float16* z, int* zShapeInfo, int axis, const int* indices, Nd4jIndex numIndices);
+            template void _gather<double, int>(double* x, int* xShapeInfo, double* z, int* zShapeInfo, int axis, const int* indices, Nd4jIndex numIndices);
+
+            template void _gather<float, Nd4jIndex>(float* x, int* xShapeInfo, float* z, int* zShapeInfo, int axis, const Nd4jIndex* indices, Nd4jIndex numIndices);
+            template void _gather<float16, Nd4jIndex>(float16* x, int* xShapeInfo, float16* z, int* zShapeInfo, int axis, const Nd4jIndex* indices, Nd4jIndex numIndices);
+            template void _gather<double, Nd4jIndex>(double* x, int* xShapeInfo, double* z, int* zShapeInfo, int axis, const Nd4jIndex* indices, Nd4jIndex numIndices);
+
+            template void _embeddingBag<float, int>(float* x, int* xShapeInfo, float* z, int* zShapeInfo, const int* indices, Nd4jIndex numBags, Nd4jIndex bagSize, bool mean);
+            template void _embeddingBag<float16, int>(float16* x, int* xShapeInfo, float16* z, int* zShapeInfo, const int* indices, Nd4jIndex numBags, Nd4jIndex bagSize, bool mean);
+            template void _embeddingBag<double, int>(double* x, int* xShapeInfo, double* z, int* zShapeInfo, const int* indices, Nd4jIndex numBags, Nd4jIndex bagSize, bool mean);
+
+            template void _embeddingBag<float, Nd4jIndex>(float* x, int* xShapeInfo, float* z, int* zShapeInfo, const Nd4jIndex* indices, Nd4jIndex numBags, Nd4jIndex bagSize, bool mean);
+            template void _embeddingBag<float16, Nd4jIndex>(float16* x, int* xShapeInfo, float16* z, int* zShapeInfo, const Nd4jIndex* indices, Nd4jIndex numBags, Nd4jIndex bagSize, bool mean);
+            template void _embeddingBag<double, Nd4jIndex>(double* x, int* xShapeInfo, double* z, int* zShapeInfo, const Nd4jIndex* indices, Nd4jIndex numBags, Nd4jIndex bagSize, bool mean);
+        }
+    }
+}
@@ -0,0 +1,273 @@
+#include <ops/declarable/helpers/lstm.h>
+#include <ops/gemm.h>
+#include <templatemath.h>
+#include <vector>
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            /**
+             * Same clipping lstmCell uses: values outside of [-limit, limit] are replaced with limit
+             */
+            template <typename T>
+            static inline T clipValue(T value, T limit, char* clipped) {
+                if (limit < (T) 0.0f)
+                    limit = -limit;
+
+                bool result = value < -limit || value > limit;
+                if (clipped != nullptr)
+                    *clipped = (char) result;
+
+                return result ? limit : value;
+            }
+
+            /**
+             * Forward pass over whole sequence. Gates are stored post-activation in Z [time x bS x 4*numUnits] in order i, f, g, o.
+             * Hn holds cell outputs before projection, it's the same buffer as H when projection is off.
+             * clipC/clipH are optional masks of clipped elements, used by backward pass.
+             */
+            template <typename T>
+            static void lstmSequence(T* x, T* h0, T* c0, T* Wx, T* Wh, T* Wc, T* Wp, T* b, T* Z, T* H, T* C, T* Hn, char* clipC, char* clipH,
+                                     int time, int bS, int inSize, int numUnits, int numProj, bool peephole, bool projection, T clipCell, T clipProj, T forgetBias) {
+                const int U = numUnits;
+                const int G = 4 * numUnits;
+                const Nd4jIndex rows = (Nd4jIndex) time * bS;
+
+                // Z = X * Wx + b for all time steps at once
+#pragma omp parallel for schedule(static) if (rows * G > 32768)
+                for (Nd4jIndex r = 0; r < rows; r++)
+                    memcpy(Z + r * G, b, G * sizeof(T));
+
+                nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasNoTrans, (int) rows, G, inSize, (T) 1.0f, x, inSize, Wx, G, (T) 1.0f, Z, G);
+
+                for (int t = 0; t < time; t++) {
+                    T* hPrev = t == 0 ? h0 : H + (Nd4jIndex) (t - 1) * bS * numProj;
+                    T* cPrev = t == 0 ? c0 : C + (Nd4jIndex) (t - 1) * bS * U;
+                    T* z = Z + (Nd4jIndex) t * bS * G;
+                    T* ct = C + (Nd4jIndex) t * bS * U;
+                    T* hn = Hn + (Nd4jIndex) t * bS * U;
+                    char* cc = clipC == nullptr ? nullptr : clipC + (Nd4jIndex) t * bS * U;
+
+                    // z += h_{t-1} * Wh
+                    nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasNoTrans, bS, G, numProj, (T) 1.0f, hPrev, numProj, Wh, G, (T) 1.0f, z, G);
+
+                    // fused gates: single pass over [bS x numUnits]
+#pragma omp parallel for schedule(static) collapse(2) if (bS * U > 4096)
+                    for (int e = 0; e < bS; e++) {
+                        for (int u = 0; u < U; u++) {
+                            T* ze = z + (Nd4jIndex) e * G;
+                            T cp = cPrev[e * U + u];
+
+                            T zi = ze[u];
+                            T zf = ze[U + u];
+                            if (peephole) {
+                                zi += cp * Wc[u];
+                                zf += cp * Wc[U + u];
+                            }
+
+                            T it = nd4j::math::nd4j_sigmoid<T>(zi);
+                            T ft = nd4j::math::nd4j_sigmoid<T>(zf + forgetBias);
+                            T gt = nd4j::math::nd4j_tanh<T>(ze[2 * U + u]);
+
+                            T cv = ft * cp + it * gt;
+                            if (clipCell != (T) 0.0f)
+                                cv = clipValue<T>(cv, clipCell, cc == nullptr ? nullptr : cc + e * U + u);
+                            else if (cc != nullptr)
+                                cc[e * U + u] = 0;
+
+                            T zo = ze[3 * U + u];
+                            if (peephole)
+                                zo += cv * Wc[2 * U + u];
+
+                            T ot = nd4j::math::nd4j_sigmoid<T>(zo);
+
+                            ze[u] = it;
+                            ze[U + u] = ft;
+                            ze[2 * U + u] = gt;
+                            ze[3 * U + u] = ot;
+
+                            ct[e * U + u] = cv;
+                            hn[e * U + u] = ot * nd4j::math::nd4j_tanh<T>(cv);
+                        }
+                    }
+
+                    if (projection) {
+                        T* ht = H + (Nd4jIndex) t * bS * numProj;
+                        nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasNoTrans, bS, numProj, U, (T) 1.0f, hn, U, Wp, numProj, (T) 0.0f, ht, numProj);
+
+                        if (clipProj != (T) 0.0f || clipH != nullptr) {
+                            char* ch = clipH == nullptr ? nullptr : clipH + (Nd4jIndex) t * bS * numProj;
+                            for (int e = 0; e < bS * numProj; e++) {
+                                if (clipProj != (T) 0.0f)
+                                    ht[e] = clipValue<T>(ht[e], clipProj, ch == nullptr ? nullptr : ch + e);
+                                else
+                                    ch[e] = 0;
+                            }
+                        }
+                    }
+                }
+            }
+
+            template <typename T>
+            void _lstmForward(NDArray<T>* x, NDArray<T>* h0, NDArray<T>* c0, NDArray<T>* Wx, NDArray<T>* Wh, NDArray<T>* Wc, NDArray<T>* Wp, NDArray<T>* b, NDArray<T>* h, NDArray<T>* c, bool peephole, bool projection, T clipCell, T clipProj, T forgetBias) {
+                const int time = x->sizeAt(0);
+                const int bS = x->sizeAt(1);
+                const int inSize = x->sizeAt(2);
+                const int numUnits = c0->sizeAt(1);
+                const int numProj = h0->sizeAt(1);
+
+                std::vector<T> Z((Nd4jIndex) time * bS * 4 * numUnits);
+                std::vector<T> Hn(projection ? (Nd4jIndex) time * bS * numUnits : 0);
+
+                lstmSequence<T>(x->getBuffer(), h0->getBuffer(), c0->getBuffer(), Wx->getBuffer(), Wh->getBuffer(), Wc->getBuffer(), Wp->getBuffer(), b->getBuffer(),
+                                Z.data(), h->getBuffer(), c->getBuffer(), projection ? Hn.data() : h->getBuffer(), nullptr, nullptr,
+                                time, bS, inSize, numUnits, numProj, peephole, projection, clipCell, clipProj, forgetBias);
+            }
+
+            template <typename T>
+            void _lstmBackward(NDArray<T>* x, NDArray<T>* h0, NDArray<T>* c0, NDArray<T>* Wx, NDArray<T>* Wh, NDArray<T>* Wc, NDArray<T>* Wp, NDArray<T>* b, NDArray<T>* dLdh,
+                               NDArray<T>* dLdx, NDArray<T>* dLdh0, NDArray<T>* dLdc0, NDArray<T>* dLdWx, NDArray<T>* dLdWh, NDArray<T>* dLdWc, NDArray<T>* dLdWp, NDArray<T>* dLdb,
+                               bool peephole, bool projection, T clipCell, T clipProj, T forgetBias) {
+                const int time = x->sizeAt(0);
+                const int bS = x->sizeAt(1);
+                const int inSize = x->sizeAt(2);
+                const int U = c0->sizeAt(1);
+                const int P = h0->sizeAt(1);
+                const int G = 4 * U;
+                const Nd4jIndex rows = (Nd4jIndex) time * bS;
+
+                std::vector<T> Z(rows * G);
+                std::vector<T> H(rows * P);
+                std::vector<T> C(rows * U);
+                std::vector<T> Hn(projection ? rows * U : 0);
+                std::vector<char> clipC(rows * U);
+                std::vector<char> clipH(projection ? rows * P : 0);
+
+                T* wc = Wc->getBuffer();
+                T* c0b = c0->getBuffer();
+
+                lstmSequence<T>(x->getBuffer(), h0->getBuffer(), c0b, Wx->getBuffer(), Wh->getBuffer(), wc, Wp->getBuffer(), b->getBuffer(),
+                                Z.data(), H.data(), C.data(), projection ? Hn.data() : H.data(), clipC.data(), projection ? clipH.data() : nullptr,
+                                time, bS, inSize, U, P, peephole, projection, clipCell, clipProj, forgetBias);
+
+                std::vector<T> dZ(rows * G);
+                std::vector<T> dH(bS * P, (T) 0.0f);        // gradient wrt h_t coming from step t+1
+                std::vector<T> dC(bS * U, (T) 0.0f);        // gradient wrt c_t coming from step t+1
+                std::vector<T> dHt(bS * P);
+                std::vector<T> dHn(projection ? bS * U : 0);
+                std::vector<T> dWc(3 * U, (T) 0.0f);
+
+                T* dWp = dLdWp->getBuffer();
+                memset(dWp, 0, dLdWp->lengthOf() * sizeof(T));
+
+                T* gH = dLdh->getBuffer();
+                for (int t = time - 1; t >= 0; t--) {
+                    T* dht = dHt.data();
+                    T* gh = gH + (Nd4jIndex) t * bS * P;
+                    for (int e = 0; e < bS * P; e++)
+                        dht[e] = gh[e] + dH[e];
+
+                    T* dhn = dht;
+                    if (projection) {
+                        char* ch = clipH.data() + (Nd4jIndex) t * bS * P;
+                        for (int e = 0; e < bS * P; e++)
+                            if (ch[e])
+                                dht[e] = (T) 0.0f;
+
+                        // dWp += Hn_t^T * dh_t, dHn = dh_t * Wp^T
+                        nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasTrans, CblasNoTrans, U, P, bS, (T) 1.0f, Hn.data() + (Nd4jIndex) t * bS * U, U, dht, P, (T) 1.0f, dWp, P);
+                        nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasTrans, bS, U, P, (T) 1.0f, dht, P, Wp->getBuffer(), P, (T) 0.0f, dHn.data(), U);
+                        dhn = dHn.data();
+                    }
+
+                    T* z = Z.data() + (Nd4jIndex) t * bS * G;
+                    T* dz = dZ.data() + (Nd4jIndex) t * bS * G;
+                    T* ct = C.data() + (Nd4jIndex) t * bS * U;
+                    T* cPrev = t == 0 ? c0b : C.data() + (Nd4jIndex) (t - 1) * bS * U;
+                    char* cc = clipC.data() + (Nd4jIndex) t * bS * U;
+
+                    // peephole gradients are accumulated per unit, so units are split between threads
+#pragma omp parallel for schedule(static) if (bS * U > 4096)
+                    for (int u = 0; u < U; u++) {
+                        for (int e = 0; e < bS; e++) {
+                            T* ze = z + (Nd4jIndex) e * G;
+                            T* dze = dz + (Nd4jIndex) e * G;
+                            T it = ze[u];
+                            T ft = ze[U + u];
+                            T gt = ze[2 * U + u];
+                            T ot = ze[3 * U + u];
+                            T cv = ct[e * U + u];
+                            T cp = cPrev[e * U + u];
+                            T tc = nd4j::math::nd4j_tanh<T>(cv);
+                            T dh = dhn[e * U + u];
+
+                            T dzo = dh * tc * ot * ((T) 1.0f - ot);
+                            T dc = dC[e * U + u] + dh * ot * ((T) 1.0f - tc * tc);
+                            if (peephole)
+                                dc += dzo * wc[2 * U + u];
+
+                            if (cc[e * U + u])
+                                dc = (T) 0.0f;
+
+                            T dzi = dc * gt * it * ((T) 1.0f - it);
+                            T dzf = dc * cp * ft * ((T) 1.0f - ft);
+                            T dzg = dc * it * ((T) 1.0f - gt * gt);
+
+                            T dcp = dc * ft;
+                            if (peephole) {
+                                dcp += dzi * wc[u] + dzf * wc[U + u];
+                                dWc[u] += dzi * cp;
+                                dWc[U + u] += dzf * cp;
+                                dWc[2 * U + u] += dzo * cv;
+                            }
+
+                            dC[e * U + u] = dcp;
+                            dze[u] = dzi;
+                            dze[U + u] = dzf;
+                            dze[2 * U + u] = dzg;
+                            dze[3 * U + u] = dzo;
+                        }
+                    }
+
+                    // gradient wrt h_{t-1}: dz_t * Wh^T
+                    nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasTrans, bS, P, G, (T) 1.0f, dz, G, Wh->getBuffer(), G, (T) 0.0f, dH.data(), P);
+                }
+
+                memcpy(dLdh0->getBuffer(), dH.data(), bS * P * sizeof(T));
+                memcpy(dLdc0->getBuffer(), dC.data(), bS * U * sizeof(T));
+                memcpy(dLdWc->getBuffer(), dWc.data(), 3 * U * sizeof(T));
+
+                // everything below is done for all time steps at once
+                // dX = dZ * Wx^T
+                nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasTrans, (int) rows, inSize, G, (T) 1.0f, dZ.data(), G, Wx->getBuffer(), G, (T) 0.0f, dLdx->getBuffer(), inSize);
+
+                // dWx = X^T * dZ
+                nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasTrans, CblasNoTrans, inSize, G, (int) rows, (T) 1.0f, x->getBuffer(), inSize, dZ.data(), G, (T) 0.0f, dLdWx->getBuffer(), G);
+
+                // dWh = [h0, h_0 ... h_{time-2}]^T * dZ
+                nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasTrans, CblasNoTrans, P, G, bS, (T) 1.0f, h0->getBuffer(), P, dZ.data(), G, (T) 0.0f, dLdWh->getBuffer(), G);
+                if (time > 1)
+                    nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasTrans, CblasNoTrans, P, G, (int) (rows - bS), (T) 1.0f, H.data(), P, dZ.data() + (Nd4jIndex) bS * G, G, (T) 1.0f, dLdWh->getBuffer(), G);
+
+                // db = sum of dZ rows
+                T* db = dLdb->getBuffer();
+#pragma omp parallel for schedule(static) if (rows * G > 32768)
+                for (int g = 0; g < G; g++) {
+                    T sum = (T) 0.0f;
+                    for (Nd4jIndex r = 0; r < rows; r++)
+                        sum += dZ[r * G + g];
+                    db[g] = sum;
+                }
+            }
+
+
+            template void _lstmForward<float>(NDArray<float>* x, NDArray<float>* h0, NDArray<float>* c0, NDArray<float>* Wx, NDArray<float>* Wh, NDArray<float>* Wc, NDArray<float>* Wp, NDArray<float>* b, NDArray<float>* h, NDArray<float>* c, bool peephole, bool projection, float clipCell, float clipProj, float forgetBias);
+            template void _lstmForward<float16>(NDArray<float16>* x, NDArray<float16>* h0, NDArray<float16>* c0, NDArray<float16>* Wx, NDArray<float16>* Wh, NDArray<float16>* Wc, NDArray<float16>* Wp, NDArray<float16>* b, NDArray<float16>* h, NDArray<float16>* c, bool peephole, bool projection, float16 clipCell, float16 clipProj, float16 forgetBias);
+            template void _lstmForward<double>(NDArray<double>* x, NDArray<double>* h0, NDArray<double>* c0, NDArray<double>* Wx, NDArray<double>* Wh, NDArray<double>* Wc, NDArray<double>* Wp, NDArray<double>* b, NDArray<double>* h, NDArray<double>* c, bool peephole, bool projection, double clipCell, double clipProj, double forgetBias);
+
+            template void _lstmBackward<float>(NDArray<float>* x, NDArray<float>* h0, NDArray<float>* c0, NDArray<float>* Wx, NDArray<float>* Wh, NDArray<float>* Wc, NDArray<float>* Wp, NDArray<float>* b, NDArray<float>* dLdh, NDArray<float>* dLdx, NDArray<float>* dLdh0, NDArray<float>* dLdc0, NDArray<float>* dLdWx, NDArray<float>* dLdWh, NDArray<float>* dLdWc, NDArray<float>* dLdWp, NDArray<float>* dLdb, bool peephole, bool projection, float clipCell, float clipProj, float forgetBias);
+            template void _lstmBackward<float16>(NDArray<float16>* x, NDArray<float16>* h0, NDArray<float16>* c0, NDArray<float16>* Wx, NDArray<float16>* Wh, NDArray<float16>* Wc, NDArray<float16>* Wp, NDArray<float16>* b, NDArray<float16>* dLdh, NDArray<float16>* dLdx, NDArray<float16>* dLdh0, NDArray<float16>* dLdc0, NDArray<float16>* dLdWx, NDArray<float16>* dLdWh, NDArray<float16>* dLdWc, NDArray<float16>* dLdWp, NDArray<float16>* dLdb, bool peephole, bool projection, float16 clipCell, float16 clipProj, float16 forgetBias);
+            template void _lstmBackward<double>(NDArray<double>* x, NDArray<double>* h0, NDArray<double>* c0, NDArray<double>* Wx, NDArray<double>* Wh, NDArray<double>* Wc, NDArray<double>* Wp, NDArray<double>* b, NDArray<double>* dLdh, NDArray<double>* dLdx, NDArray<double>* dLdh0, NDArray<double>* dLdc0, NDArray<double>* dLdWx, NDArray<double>* dLdWh, NDArray<double>* dLdWc, NDArray<double>* dLdWp, NDArray<double>* dLdb, bool peephole, bool projection, double clipCell, double clipProj, double forgetBias);
+        }
+    }
+}
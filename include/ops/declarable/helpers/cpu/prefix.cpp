@@ -4,85 +4,219 @@
 
 #include <ops/ops.h>
 #include <helpers/shape.h>
-#include <helpers/TAD.h>
-#include <NDArrayFactory.h>
+#include <helpers/TadCache.h>
+#include <op_boilerplate.h>
+#include <Environment.h>
 #include <ops/declarable/helpers/prefix.h>
+#include <type_traits>
+#include <omp.h>
 
 namespace nd4j {
     namespace ops {
         namespace helpers {
             template <typename T, typename OpName>
-            void _prefix(T* x, int* xShapeInfo, T* z, int* zShapeInfo) {
-                auto length = shape::length(xShapeInfo);
+            static FORCEINLINE T _identity() {
+                return std::is_same<OpName, simdOps::Multiply<T>>::value ? (T) 1.0f : (T) 0.0f;
+            }
+
+            template <typename T, typename OpName>
+            static T _reduceBlock(T* x, Nd4jIndex xStride, Nd4jIndex length) {
+                T result = _identity<T, OpName>();
+                for (Nd4jIndex e = 0; e < length; e++)
+                    result = OpName::op(result, x[e * xStride]);
+
+                return result;
+            }
 
-                if (shape::elementWiseStride(xShapeInfo) == 1 && shape::elementWiseStride(zShapeInfo) == 1 && shape::order(xShapeInfo) == 'c' && shape::order(zShapeInfo) == 'c') {
-                    T sum = (T) 0;                    
-#pragma omp simd                    
-                    for (int e = 0; e < length; e++) {
-                        sum = OpName::op(sum, x[e]);
-                        z[e] = sum;
+            template <typename T, typename OpName>
+            static void _scanBlock(T* x, Nd4jIndex xStride, T* z, Nd4jIndex zStride, Nd4jIndex length, T carry, bool exclusive) {
+                if (exclusive) {
+                    // x & z may be the same buffer, so input is read before output is written
+                    for (Nd4jIndex e = 0; e < length; e++) {
+                        T v = x[e * xStride];
+                        z[e * zStride] = carry;
+                        carry = OpName::op(carry, v);
+                    }
+                } else if (xStride == 1 && zStride == 1) {
+                    for (Nd4jIndex e = 0; e < length; e++) {
+                        carry = OpName::op(carry, x[e]);
+                        z[e] = carry;
                     }
                 } else {
-                    int xCoord[MAX_RANK];
-                    int zCoord[MAX_RANK];
-                    T sum = (T) 0;  
+                    for (Nd4jIndex e = 0; e < length; e++) {
+                        carry = OpName::op(carry, x[e * xStride]);
+                        z[e * zStride] = carry;
+                    }
+                }
+            }
+
+            /**
+             * Scan over strided vector. Long vectors are split into per-thread blocks: every block is reduced first,
+             * block sums are scanned serially, and then every block is scanned again starting from its carry.
+             */
+            template <typename T, typename OpName>
+            static void _scan(T* x, Nd4jIndex xStride, T* z, Nd4jIndex zStride, Nd4jIndex length, bool exclusive, bool reverse, bool allowParallel) {
+                if (length < 1)
+                    return;
+
+                // reverse scan is forward scan over the same memory with negated strides
+                if (reverse) {
+                    x += (length - 1) * xStride;
+                    z += (length - 1) * zStride;
+                    xStride = -xStride;
+                    zStride = -zStride;
+                }
+
+                int num_threads = 1;
+                if (allowParallel) {
+                    // every element is touched twice, so block needs to be at least 2 thresholds long
+                    num_threads = (int) nd4j::math::nd4j_min<Nd4jIndex>(length / (2 * ELEMENT_THRESHOLD_FOR(OP_CLASS_TRANSFORM)), MAX_THREADS_FOR(OP_CLASS_TRANSFORM));
+                    num_threads = nd4j::math::nd4j_max<int>(1, num_threads);
+                }
+
+                if (num_threads <= 1) {
+                    _scanBlock<T, OpName>(x, xStride, z, zStride, length, _identity<T, OpName>(), exclusive);
+                    return;
+                }
 
-                    int xRank = shape::rank(xShapeInfo);
-                    int zRank = shape::rank(zShapeInfo);
+                std::vector<T> carries(num_threads);
 
-                    int *xShape = shape::shapeOf(xShapeInfo);
-                    int *zShape = shape::shapeOf(zShapeInfo);
+#pragma omp parallel num_threads(num_threads) proc_bind(AFFINITY) default(shared)
+                {
+                    // runtime may give us less threads than requested
+                    int threads = omp_get_num_threads();
+                    int tid = omp_get_thread_num();
 
-                    int *xStride = shape::stride(xShapeInfo);
-                    int *zStride = shape::stride(zShapeInfo);
+                    Nd4jIndex blockLength = (length + threads - 1) / threads;
+                    Nd4jIndex start = nd4j::math::nd4j_min<Nd4jIndex>(tid * blockLength, length);
+                    Nd4jIndex end = nd4j::math::nd4j_min<Nd4jIndex>(start + blockLength, length);
 
-                    for (int e = 0; e < length; e++) {
-                        shape::ind2subC(xRank, xShape, e, xCoord);
-                        shape::ind2subC(zRank, zShape, e, zCoord);
+                    carries[tid] = _reduceBlock<T, OpName>(x + start * xStride, xStride, end - start);
 
-                        Nd4jIndex xOffset = shape::getOffset(0, xShape, xStride, xCoord, xRank);
-                        Nd4jIndex zOffset = shape::getOffset(0, zShape, zStride, zCoord, zRank);
+#pragma omp barrier
 
-                        sum = OpName::op(sum, x[xOffset]);
-                        z[zOffset] = sum;
+#pragma omp single
+                    {
+                        T carry = _identity<T, OpName>();
+                        for (int b = 0; b < threads; b++) {
+                            T sum = carries[b];
+                            carries[b] = carry;
+                            carry = OpName::op(carry, sum);
+                        }
                     }
+
+                    _scanBlock<T, OpName>(x + start * xStride, xStride, z + start * zStride, zStride, end - start, carries[tid], exclusive);
                 }
-            };
+            }
+
+            /**
+             * Linear c-order traversal of array is plain strided walk over memory
+             */
+            static FORCEINLINE bool _isLinear(int* shapeInfo) {
+                return shape::elementWiseStride(shapeInfo) >= 1 && (shape::order(shapeInfo) == 'c' || shape::isVector(shapeInfo) || shape::length(shapeInfo) == 1);
+            }
+
+            /**
+             * Copies array into contiguous buffer in c order, or back if toBuffer is false. Offsets are updated incrementally, without ind2subC per element
+             */
+            template <typename T>
+            static void _copyLinear(T* x, int* shapeInfo, T* buffer, bool toBuffer) {
+                int rank = shape::rank(shapeInfo);
+                int *shape = shape::shapeOf(shapeInfo);
+                int *stride = shape::stride(shapeInfo);
+                Nd4jIndex length = shape::length(shapeInfo);
+
+                int coords[MAX_RANK];
+                for (int d = 0; d < rank; d++)
+                    coords[d] = 0;
+
+                Nd4jIndex offset = 0;
+                for (Nd4jIndex e = 0; e < length; e++) {
+                    if (toBuffer)
+                        buffer[e] = x[offset];
+                    else
+                        x[offset] = buffer[e];
+
+                    for (int d = rank - 1; d >= 0; d--) {
+                        if (++coords[d] < shape[d]) {
+                            offset += stride[d];
+                            break;
+                        }
+
+                        offset -= (Nd4jIndex) (shape[d] - 1) * stride[d];
+                        coords[d] = 0;
+                    }
+                }
+            }
 
             template <typename T, typename OpName>
-            void _prefix(NDArray<T>* x, NDArray<T>* z, std::vector<int>& dims) {
-                auto xTads = NDArrayFactory<T>::allTensorsAlongDimension(x, dims);
-                auto zTads = NDArrayFactory<T>::allTensorsAlongDimension(z, dims);
-                int t = xTads->size();
+            static void _prefixSingle(T* x, int* xShapeInfo, T* z, int* zShapeInfo, bool exclusive, bool reverse, bool allowParallel) {
+                auto length = shape::length(xShapeInfo);
+
+                if (_isLinear(xShapeInfo) && _isLinear(zShapeInfo)) {
+                    _scan<T, OpName>(x, shape::elementWiseStride(xShapeInfo), z, shape::elementWiseStride(zShapeInfo), length, exclusive, reverse, allowParallel);
+                    return;
+                }
+
+                // arbitrary strides: scan is done over contiguous copy
+                std::vector<T> buffer(length);
+                _copyLinear<T>(x, xShapeInfo, buffer.data(), true);
+                _scan<T, OpName>(buffer.data(), 1, buffer.data(), 1, length, exclusive, reverse, allowParallel);
+                _copyLinear<T>(z, zShapeInfo, buffer.data(), false);
+            }
 
-#pragma omp parallel for schedule(guided)
-                for (int e = 0; e < t; e++) {
-                    auto tx = xTads->at(e);
-                    auto tz = zTads->at(e);
+            template <typename T, typename OpName>
+            void _prefix(T* x, int* xShapeInfo, T* z, int* zShapeInfo, bool exclusive, bool reverse) {
+                _prefixSingle<T, OpName>(x, xShapeInfo, z, zShapeInfo, exclusive, reverse, true);
+            };
 
-                    _prefix<T, OpName>(tx->buffer(), tx->shapeInfo(), tz->buffer(), tz->shapeInfo());
+            template <typename T, typename OpName>
+            void _prefix(NDArray<T>* x, NDArray<T>* z, std::vector<int>& dims, bool exclusive, bool reverse) {
+                auto xTads = nd4j::TadCache::getInstance()->tadForDimensions(x->getShapeInfo(), dims);
+                auto zTads = nd4j::TadCache::getInstance()->tadForDimensions(z->getShapeInfo(), dims);
+
+                int numTads = xTads->numberOfTads();
+                int *xTadShape = xTads->tadOnlyShapeInfo();
+                int *zTadShape = zTads->tadOnlyShapeInfo();
+                Nd4jIndex *xOffsets = xTads->tadOffsets();
+                Nd4jIndex *zOffsets = zTads->tadOffsets();
+
+                // few long TADs are scanned one by one, with parallelism within each TAD
+                if (numTads < MAX_THREADS_FOR(OP_CLASS_TRANSFORM)) {
+                    for (int e = 0; e < numTads; e++)
+                        _prefixSingle<T, OpName>(x->getBuffer() + xOffsets[e], xTadShape, z->getBuffer() + zOffsets[e], zTadShape, exclusive, reverse, true);
+
+                    return;
                 }
 
-                delete xTads;
-                delete zTads;
+                Nd4jIndex tadLength = shape::length(xTadShape);
+                int num_threads = nd4j::math::nd4j_max<int>(1, numTads / TAD_THRESHOLD_FOR(OP_CLASS_TRANSFORM));
+                if ((Nd4jIndex) numTads * tadLength < ELEMENT_THRESHOLD_FOR(OP_CLASS_TRANSFORM))
+                    num_threads = 1;
+
+                num_threads = nd4j::math::nd4j_min<int>(num_threads, MAX_THREADS_FOR(OP_CLASS_TRANSFORM));
+
+#pragma omp parallel for num_threads(num_threads) if (num_threads > 1) schedule(guided) proc_bind(AFFINITY) default(shared)
+                for (int e = 0; e < numTads; e++)
+                    _prefixSingle<T, OpName>(x->getBuffer() + xOffsets[e], xTadShape, z->getBuffer() + zOffsets[e], zTadShape, exclusive, reverse, false);
             };
 
-            template void _prefix<float, simdOps::Add<float>>(float* x, int* xShapeInfo, float* z, int* zShapeInfo);
-            template void _prefix<float16, simdOps::Add<float16>>(float16* x, int* xShapeInfo, float16* z, int* zShapeInfo);
-            template void _prefix<double, simdOps::Add<double>>(double* x, int* xShapeInfo, double* z, int* zShapeInfo);
+            template void _prefix<float, simdOps::Add<float>>(float* x, int* xShapeInfo, float* z, int* zShapeInfo, bool exclusive, bool reverse);
+            template void _prefix<float16, simdOps::Add<float16>>(float16* x, int* xShapeInfo, float16* z, int* zShapeInfo, bool exclusive, bool reverse);
+            template void _prefix<double, simdOps::Add<double>>(double* x, int* xShapeInfo, double* z, int* zShapeInfo, bool exclusive, bool reverse);
 
-            template void _prefix<float, simdOps::Multiply<float>>(float* x, int* xShapeInfo, float* z, int* zShapeInfo);
-            template void _prefix<float16, simdOps::Multiply<float16>>(float16* x, int* xShapeInfo, float16* z, int* zShapeInfo);
-            template void _prefix<double, simdOps::Multiply<double>>(double* x, int* xShapeInfo, double* z, int* zShapeInfo);
+            template void _prefix<float, simdOps::Multiply<float>>(float* x, int* xShapeInfo, float* z, int* zShapeInfo, bool exclusive, bool reverse);
+            template void _prefix<float16, simdOps::Multiply<float16>>(float16* x, int* xShapeInfo, float16* z, int* zShapeInfo, bool exclusive, bool reverse);
+            template void _prefix<double, simdOps::Multiply<double>>(double* x, int* xShapeInfo, double* z, int* zShapeInfo, bool exclusive, bool reverse);
 
 
-            template void _prefix<float, simdOps::Add<float>>(NDArray<float>* x, NDArray<float>* z, std::vector<int>& dims);
-            template void _prefix<float16, simdOps::Add<float16>>(NDArray<float16>* x, NDArray<float16>* z, std::vector<int>& dims);
-            template void _prefix<double, simdOps::Add<double>>(NDArray<double>* x, NDArray<double>* z, std::vector<int>& dims);
+            template void _prefix<float, simdOps::Add<float>>(NDArray<float>* x, NDArray<float>* z, std::vector<int>& dims, bool exclusive, bool reverse);
+            template void _prefix<float16, simdOps::Add<float16>>(NDArray<float16>* x, NDArray<float16>* z, std::vector<int>& dims, bool exclusive, bool reverse);
+            template void _prefix<double, simdOps::Add<double>>(NDArray<double>* x, NDArray<double>* z, std::vector<int>& dims, bool exclusive, bool reverse);
 
-            template void _prefix<float, simdOps::Multiply<float>>(NDArray<float>* x, NDArray<float>* z, std::vector<int>& dims);
-            template void _prefix<float16, simdOps::Multiply<float16>>(NDArray<float16>* x, NDArray<float16>* z, std::vector<int>& dims);
-            template void _prefix<double, simdOps::Multiply<double>>(NDArray<double>* x, NDArray<double>* z, std::vector<int>& dims);
+            template void _prefix<float, simdOps::Multiply<float>>(NDArray<float>* x, NDArray<float>* z, std::vector<int>& dims, bool exclusive, bool reverse);
+            template void _prefix<float16, simdOps::Multiply<float16>>(NDArray<float16>* x, NDArray<float16>* z, std::vector<int>& dims, bool exclusive, bool reverse);
+            template void _prefix<double, simdOps::Multiply<double>>(NDArray<double>* x, NDArray<double>* z, std::vector<int>& dims, bool exclusive, bool reverse);
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,200 @@
+#include <ops/declarable/helpers/sru.h>
+#include <ops/gemm.h>
+#include <templatemath.h>
+#include <vector>
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            template <typename T>
+            bool _sruFusable(std::initializer_list<NDArray<T>*> arrays) {
+                for (auto array: arrays)
+                    if (array != nullptr && (array->ordering() != 'c' || array->ews() != 1))
+                        return false;
+
+                return true;
+            }
+
+            /**
+             * Copies [bS x K x N] input into [K x bS*N] buffer, applying mask on the fly, so all time steps of all batches go into single GEMM
+             */
+            template <typename T>
+            static void packInput(T* x, T* mask, T* xm, int bS, int K, int N) {
+                Nd4jIndex ld = (Nd4jIndex) bS * N;
+#pragma omp parallel for schedule(static) collapse(2) if (ld * K > 32768)
+                for (int b = 0; b < bS; b++) {
+                    for (int k = 0; k < K; k++) {
+                        T m = mask == nullptr ? (T) 1.0f : mask[b * K + k];
+                        T* src = x + ((Nd4jIndex) b * K + k) * N;
+                        T* dst = xm + k * ld + (Nd4jIndex) b * N;
+                        for (int t = 0; t < N; t++)
+                            dst[t] = src[t] * m;
+                    }
+                }
+            }
+
+            template <typename T>
+            void _sruForward(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* bias, NDArray<T>* init, NDArray<T>* mask, NDArray<T>* output, NDArray<T>* state) {
+                const int bS = input->sizeAt(0);
+                const int K  = input->sizeAt(1);
+                const int N  = input->sizeAt(2);
+                const Nd4jIndex ld = (Nd4jIndex) bS * N;
+
+                std::vector<T> xm(K * ld);
+                std::vector<T> U(3 * K * ld);
+
+                packInput<T>(input->getBuffer(), mask == nullptr ? nullptr : mask->getBuffer(), xm.data(), bS, K, N);
+
+                // U [3K x bS*N] = W [3K x K] * Xm [K x bS*N]
+                nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasNoTrans, 3 * K, (int) ld, K, (T) 1.0f, weights->getBuffer(), K, xm.data(), (int) ld, (T) 0.0f, U.data(), (int) ld);
+
+                T* b = bias->getBuffer();
+                T* c0 = init->getBuffer();
+                T* h = output->getBuffer();
+                T* c = state->getBuffer();
+
+#pragma omp parallel for schedule(static) collapse(2) if (bS * K > 32)
+                for (int e = 0; e < bS; e++) {
+                    for (int k = 0; k < K; k++) {
+                        Nd4jIndex offset = (Nd4jIndex) e * N;
+                        T* uz = U.data() + k * ld + offset;
+                        T* uf = U.data() + (K + k) * ld + offset;
+                        T* ur = U.data() + (2 * K + k) * ld + offset;
+                        T* x = xm.data() + k * ld + offset;
+                        T* ht = h + ((Nd4jIndex) e * K + k) * N;
+                        T* ct = c + ((Nd4jIndex) e * K + k) * N;
+                        T bF = b[k];
+                        T bR = b[K + k];
+                        T cur = c0[e * K + k];
+
+                        for (int t = 0; t < N; t++) {
+                            T ft = nd4j::math::nd4j_sigmoid<T>(uf[t] + bF);
+                            T rt = nd4j::math::nd4j_sigmoid<T>(ur[t] + bR);
+                            cur = ft * (cur - uz[t]) + uz[t];
+                            T gt = nd4j::math::nd4j_tanh<T>(cur);
+
+                            ct[t] = cur;
+                            ht[t] = rt * (gt - x[t]) + x[t];
+                        }
+                    }
+                }
+            }
+
+            template <typename T>
+            void _sruBackward(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* bias, NDArray<T>* init, NDArray<T>* state, NDArray<T>* inGradCt, NDArray<T>* inGradH, NDArray<T>* mask, NDArray<T>* gradX, NDArray<T>* gradW, NDArray<T>* gradB, NDArray<T>* gradInit) {
+                const int bS = input->sizeAt(0);
+                const int K  = input->sizeAt(1);
+                const int N  = input->sizeAt(2);
+                const Nd4jIndex ld = (Nd4jIndex) bS * N;
+
+                T* m = mask == nullptr ? nullptr : mask->getBuffer();
+
+                std::vector<T> xm(K * ld);
+                std::vector<T> U(3 * K * ld);
+                std::vector<T> gU(3 * K * ld);
+                std::vector<T> gHX(K * ld);
+                std::vector<T> gBias(2 * K * bS, (T) 0.0f);
+
+                packInput<T>(input->getBuffer(), m, xm.data(), bS, K, N);
+
+                nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasNoTrans, 3 * K, (int) ld, K, (T) 1.0f, weights->getBuffer(), K, xm.data(), (int) ld, (T) 0.0f, U.data(), (int) ld);
+
+                T* b = bias->getBuffer();
+                T* c0 = init->getBuffer();
+                T* c = state->getBuffer();
+                T* gH = inGradH->getBuffer();
+                T* gC = inGradCt->getBuffer();
+
+#pragma omp parallel for schedule(static) collapse(2) if (bS * K > 32)
+                for (int e = 0; e < bS; e++) {
+                    for (int k = 0; k < K; k++) {
+                        Nd4jIndex offset = (Nd4jIndex) e * N;
+                        T* uz = U.data() + k * ld + offset;
+                        T* uf = U.data() + (K + k) * ld + offset;
+                        T* ur = U.data() + (2 * K + k) * ld + offset;
+                        T* gz = gU.data() + k * ld + offset;
+                        T* gf = gU.data() + (K + k) * ld + offset;
+                        T* gr = gU.data() + (2 * K + k) * ld + offset;
+                        T* ghx = gHX.data() + k * ld + offset;
+                        T* x = xm.data() + k * ld + offset;
+                        T* ct = c + ((Nd4jIndex) e * K + k) * N;
+                        T* ght = gH + ((Nd4jIndex) e * K + k) * N;
+                        T bF = b[k];
+                        T bR = b[K + k];
+                        T gc = gC[e * K + k];
+                        T sumF = (T) 0.0f;
+                        T sumR = (T) 0.0f;
+
+                        for (int t = N - 1; t >= 0; t--) {
+                            T ft = nd4j::math::nd4j_sigmoid<T>(uf[t] + bF);
+                            T rt = nd4j::math::nd4j_sigmoid<T>(ur[t] + bR);
+                            T gt = nd4j::math::nd4j_tanh<T>(ct[t]);
+                            T prev = t > 0 ? ct[t - 1] : c0[e * K + k];
+
+                            T gradR = ght[t] * (gt - x[t]) * ((T) 1.0f - rt) * rt;
+                            T gradCt = ght[t] * rt * ((T) 1.0f - gt * gt) + gc;
+                            T gradF = gradCt * (prev - uz[t]) * ((T) 1.0f - ft) * ft;
+
+                            ghx[t] = ght[t] * ((T) 1.0f - rt);
+                            gz[t] = gradCt * ((T) 1.0f - ft);
+                            gf[t] = gradF;
+                            gr[t] = gradR;
+                            gc = gradCt * ft;
+
+                            sumF += gradF;
+                            sumR += gradR;
+                        }
+
+                        gC[e * K + k] = gc;
+                        gBias[e * 2 * K + k] = sumF;
+                        gBias[e * 2 * K + K + k] = sumR;
+                    }
+                }
+
+                gradInit->assign(inGradCt);
+
+                // gradB is reduced over batches in fixed order, so results don't depend on number of threads
+                T* gB = gradB->getBuffer();
+                for (int k = 0; k < 2 * K; k++) {
+                    T sum = (T) 0.0f;
+                    for (int e = 0; e < bS; e++)
+                        sum += gBias[e * 2 * K + k];
+                    gB[k] = sum;
+                }
+
+                // gradX [K x bS*N] = W^T [K x 3K] * gradU [3K x bS*N] + gradHX, highway gradient goes in as C with beta = 1
+                nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasTrans, CblasNoTrans, K, (int) ld, 3 * K, (T) 1.0f, weights->getBuffer(), K, gU.data(), (int) ld, (T) 1.0f, gHX.data(), (int) ld);
+
+                T* gX = gradX->getBuffer();
+#pragma omp parallel for schedule(static) collapse(2) if (ld * K > 32768)
+                for (int e = 0; e < bS; e++) {
+                    for (int k = 0; k < K; k++) {
+                        T mk = m == nullptr ? (T) 1.0f : m[e * K + k];
+                        T* src = gHX.data() + k * ld + (Nd4jIndex) e * N;
+                        T* dst = gX + ((Nd4jIndex) e * K + k) * N;
+                        for (int t = 0; t < N; t++)
+                            dst[t] = src[t] * mk;
+                    }
+                }
+
+                // gradW [bS x 3K x K], per batch: gradU_b [3K x N] * Xm_b^T [N x K]
+                T* gW = gradW->getBuffer();
+                for (int e = 0; e < bS; e++)
+                    nd4j::blas::GEMM<T>::op(CblasRowMajor, CblasNoTrans, CblasTrans, 3 * K, K, N, (T) 1.0f, gU.data() + (Nd4jIndex) e * N, (int) ld, xm.data() + (Nd4jIndex) e * N, (int) ld, (T) 0.0f, gW + (Nd4jIndex) e * 3 * K * K, K);
+            }
+
+
+            template bool _sruFusable<float>(std::initializer_list<NDArray<float>*> arrays);
+            template bool _sruFusable<float16>(std::initializer_list<NDArray<float16>*> arrays);
+            template bool _sruFusable<double>(std::initializer_list<NDArray<double>*> arrays);
+
+            template void _sruForward<float>(NDArray<float>* input, NDArray<float>* weights, NDArray<float>* bias, NDArray<float>* init, NDArray<float>* mask, NDArray<float>* output, NDArray<float>* state);
+            template void _sruForward<float16>(NDArray<float16>* input, NDArray<float16>* weights, NDArray<float16>* bias, NDArray<float16>* init, NDArray<float16>* mask, NDArray<float16>* output, NDArray<float16>* state);
+            template void _sruForward<double>(NDArray<double>* input, NDArray<double>* weights, NDArray<double>* bias, NDArray<double>* init, NDArray<double>* mask, NDArray<double>* output, NDArray<double>* state);
+
+            template void _sruBackward<float>(NDArray<float>* input, NDArray<float>* weights, NDArray<float>* bias, NDArray<float>* init, NDArray<float>* state, NDArray<float>* inGradCt, NDArray<float>* inGradH, NDArray<float>* mask, NDArray<float>* gradX, NDArray<float>* gradW, NDArray<float>* gradB, NDArray<float>* gradInit);
+            template void _sruBackward<float16>(NDArray<float16>* input, NDArray<float16>* weights, NDArray<float16>* bias, NDArray<float16>* init, NDArray<float16>* state, NDArray<float16>* inGradCt, NDArray<float16>* inGradH, NDArray<float16>* mask, NDArray<float16>* gradX, NDArray<float16>* gradW, NDArray<float16>* gradB, NDArray<float16>* gradInit);
+            template void _sruBackward<double>(NDArray<double>* input, NDArray<double>* weights, NDArray<double>* bias, NDArray<double>* init, NDArray<double>* state, NDArray<double>* inGradCt, NDArray<double>* inGradH, NDArray<double>* mask, NDArray<double>* gradX, NDArray<double>* gradW, NDArray<double>* gradB, NDArray<double>* gradInit);
+        }
+    }
+}
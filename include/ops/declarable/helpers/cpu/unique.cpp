@@ -0,0 +1,252 @@
+#include <helpers/shape.h>
+#include <op_boilerplate.h>
+#include <Environment.h>
+#include <ops/declarable/helpers/unique.h>
+#include <algorithm>
+#include <cstring>
+#include <omp.h>
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            template <typename T>
+            static FORCEINLINE uint64_t _hash(T value) {
+                double d = static_cast<double>(value);
+
+                // -0.0 == 0.0, so both must land into the same bucket
+                if (d == 0.0)
+                    d = 0.0;
+
+                uint64_t h;
+                memcpy(&h, &d, sizeof(h));
+
+                // splitmix64 finalizer: low bits pick slot, high bits pick partition
+                h ^= h >> 30;
+                h *= 0xbf58476d1ce4e5b9ULL;
+                h ^= h >> 27;
+                h *= 0x94d049bb133111ebULL;
+                h ^= h >> 31;
+                return h;
+            }
+
+            static FORCEINLINE int _partition(uint64_t hash, int numPartitions) {
+                return (int) ((hash >> 32) % (uint64_t) numPartitions);
+            }
+
+            /**
+             * Open-addressing table with linear probing. Capacity is chosen up front for known number of insertions,
+             * so table never grows. Entries are kept in insertion order.
+             */
+            template <typename T>
+            class UniqueTable {
+            public:
+                std::vector<T> values;
+                std::vector<Nd4jIndex> first;
+                std::vector<Nd4jIndex> counts;
+
+            private:
+                std::vector<uint64_t> _hashes;
+                std::vector<Nd4jIndex> _slots;
+                uint64_t _mask;
+
+            public:
+                explicit UniqueTable(Nd4jIndex insertions) {
+                    uint64_t capacity = 16;
+                    while (capacity < (uint64_t) insertions * 2)
+                        capacity <<= 1;
+
+                    _slots.assign(capacity, -1);
+                    _mask = capacity - 1;
+                }
+
+                /**
+                 * Returns local id of value. Insertions must come in increasing index order, so first index is set once
+                 */
+                FORCEINLINE Nd4jIndex insert(T value, uint64_t hash, Nd4jIndex index) {
+                    uint64_t slot = hash & _mask;
+                    while (true) {
+                        Nd4jIndex id = _slots[slot];
+                        if (id < 0) {
+                            id = (Nd4jIndex) values.size();
+                            _slots[slot] = id;
+                            values.emplace_back(value);
+                            first.emplace_back(index);
+                            counts.emplace_back(1);
+                            _hashes.emplace_back(hash);
+                            return id;
+                        }
+
+                        if (_hashes[id] == hash && values[id] == value) {
+                            counts[id]++;
+                            return id;
+                        }
+
+                        slot = (slot + 1) & _mask;
+                    }
+                }
+            };
+
+            template <typename T>
+            void _unique(NDArray<T>* x, std::vector<T>& values, std::vector<Nd4jIndex>& firstIndices, std::vector<Nd4jIndex>* inverse, std::vector<Nd4jIndex>* counts) {
+                Nd4jIndex length = x->lengthOf();
+
+                values.clear();
+                firstIndices.clear();
+                if (inverse != nullptr)
+                    inverse->resize(length);
+
+                if (counts != nullptr)
+                    counts->clear();
+
+                if (length == 0)
+                    return;
+
+                int num_threads = (int) nd4j::math::nd4j_min<Nd4jIndex>(length / ELEMENT_THRESHOLD_FOR(OP_CLASS_TRANSFORM), MAX_THREADS_FOR(OP_CLASS_TRANSFORM));
+                num_threads = nd4j::math::nd4j_max<int>(1, num_threads);
+
+                // elements are read in c order, as plain strided walk when possible
+                int *shapeInfo = x->getShapeInfo();
+                int ews = shape::elementWiseStride(shapeInfo);
+                T *data = x->getBuffer();
+                Nd4jIndex stride = ews;
+                std::vector<T> holder;
+                if (ews < 1 || (shape::order(shapeInfo) != 'c' && !shape::isVector(shapeInfo) && length > 1)) {
+                    holder.resize(length);
+
+#pragma omp parallel for num_threads(num_threads) if (num_threads > 1) schedule(static) proc_bind(AFFINITY) default(shared)
+                    for (Nd4jIndex e = 0; e < length; e++)
+                        holder[e] = x->getScalar(e);
+
+                    data = holder.data();
+                    stride = 1;
+                }
+
+                if (num_threads == 1) {
+                    // single table, entries are in first occurrence order already
+                    UniqueTable<T> table(length);
+                    for (Nd4jIndex e = 0; e < length; e++) {
+                        T v = data[e * stride];
+                        Nd4jIndex id = table.insert(v, _hash<T>(v), e);
+                        if (inverse != nullptr)
+                            (*inverse)[e] = id;
+                    }
+
+                    values.swap(table.values);
+                    firstIndices.swap(table.first);
+                    if (counts != nullptr)
+                        counts->swap(table.counts);
+
+                    return;
+                }
+
+                // every value belongs to exactly one partition, selected by hash, so partitions are deduplicated independently
+                int numPartitions = num_threads;
+                Nd4jIndex chunk = (length + numPartitions - 1) / numPartitions;
+                std::vector<uint64_t> hashes(length);
+                std::vector<Nd4jIndex> histogram((size_t) numPartitions * numPartitions, 0);
+
+#pragma omp parallel for num_threads(num_threads) schedule(static) proc_bind(AFFINITY) default(shared)
+                for (int c = 0; c < numPartitions; c++) {
+                    Nd4jIndex start = nd4j::math::nd4j_min<Nd4jIndex>(c * chunk, length);
+                    Nd4jIndex end = nd4j::math::nd4j_min<Nd4jIndex>(start + chunk, length);
+                    Nd4jIndex *local = histogram.data() + (size_t) c * numPartitions;
+                    for (Nd4jIndex e = start; e < end; e++) {
+                        hashes[e] = _hash<T>(data[e * stride]);
+                        local[_partition(hashes[e], numPartitions)]++;
+                    }
+                }
+
+                // histogram becomes scatter offsets: partition-major, chunk-minor, so indices within partition stay sorted
+                std::vector<Nd4jIndex> partitionStart(numPartitions + 1, 0);
+                Nd4jIndex offset = 0;
+                for (int p = 0; p < numPartitions; p++) {
+                    partitionStart[p] = offset;
+                    for (int c = 0; c < numPartitions; c++) {
+                        Nd4jIndex cnt = histogram[(size_t) c * numPartitions + p];
+                        histogram[(size_t) c * numPartitions + p] = offset;
+                        offset += cnt;
+                    }
+                }
+                partitionStart[numPartitions] = length;
+
+                std::vector<Nd4jIndex> order(length);
+
+#pragma omp parallel for num_threads(num_threads) schedule(static) proc_bind(AFFINITY) default(shared)
+                for (int c = 0; c < numPartitions; c++) {
+                    Nd4jIndex start = nd4j::math::nd4j_min<Nd4jIndex>(c * chunk, length);
+                    Nd4jIndex end = nd4j::math::nd4j_min<Nd4jIndex>(start + chunk, length);
+                    Nd4jIndex *local = histogram.data() + (size_t) c * numPartitions;
+                    for (Nd4jIndex e = start; e < end; e++)
+                        order[local[_partition(hashes[e], numPartitions)]++] = e;
+                }
+
+                std::vector<UniqueTable<T>*> tables(numPartitions);
+
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic) proc_bind(AFFINITY) default(shared)
+                for (int p = 0; p < numPartitions; p++) {
+                    auto table = new UniqueTable<T>(partitionStart[p + 1] - partitionStart[p]);
+                    for (Nd4jIndex i = partitionStart[p]; i < partitionStart[p + 1]; i++) {
+                        Nd4jIndex e = order[i];
+                        Nd4jIndex id = table->insert(data[e * stride], hashes[e], e);
+                        if (inverse != nullptr)
+                            (*inverse)[e] = id;
+                    }
+
+                    tables[p] = table;
+                }
+
+                // merge: entry references are marked at their first index, and ranks are assigned by single ordered pass
+                std::vector<Nd4jIndex> tableStart(numPartitions + 1, 0);
+                for (int p = 0; p < numPartitions; p++)
+                    tableStart[p + 1] = tableStart[p] + (Nd4jIndex) tables[p]->values.size();
+
+                Nd4jIndex numUnique = tableStart[numPartitions];
+                std::vector<Nd4jIndex> &marks = order;
+                std::fill(marks.begin(), marks.end(), -1);
+
+#pragma omp parallel for num_threads(num_threads) schedule(static) proc_bind(AFFINITY) default(shared)
+                for (int p = 0; p < numPartitions; p++) {
+                    auto &first = tables[p]->first;
+                    for (Nd4jIndex id = 0; id < (Nd4jIndex) first.size(); id++)
+                        marks[first[id]] = tableStart[p] + id;
+                }
+
+                std::vector<Nd4jIndex> ranks(numUnique);
+                Nd4jIndex rank = 0;
+                for (Nd4jIndex e = 0; e < length; e++)
+                    if (marks[e] >= 0)
+                        ranks[marks[e]] = rank++;
+
+                values.resize(numUnique);
+                firstIndices.resize(numUnique);
+                if (counts != nullptr)
+                    counts->resize(numUnique);
+
+#pragma omp parallel for num_threads(num_threads) schedule(static) proc_bind(AFFINITY) default(shared)
+                for (int p = 0; p < numPartitions; p++) {
+                    auto table = tables[p];
+                    for (Nd4jIndex id = 0; id < (Nd4jIndex) table->values.size(); id++) {
+                        Nd4jIndex r = ranks[tableStart[p] + id];
+                        values[r] = table->values[id];
+                        firstIndices[r] = table->first[id];
+                        if (counts != nullptr)
+                            (*counts)[r] = table->counts[id];
+                    }
+                }
+
+                if (inverse != nullptr) {
+#pragma omp parallel for num_threads(num_threads) schedule(static) proc_bind(AFFINITY) default(shared)
+                    for (Nd4jIndex e = 0; e < length; e++)
+                        (*inverse)[e] = ranks[tableStart[_partition(hashes[e], numPartitions)] + (*inverse)[e]];
+                }
+
+                for (auto table: tables)
+                    delete table;
+            }
+
+            template void _unique<float>(NDArray<float>* x, std::vector<float>& values, std::vector<Nd4jIndex>& firstIndices, std::vector<Nd4jIndex>* inverse, std::vector<Nd4jIndex>* counts);
+            template void _unique<float16>(NDArray<float16>* x, std::vector<float16>& values, std::vector<Nd4jIndex>& firstIndices, std::vector<Nd4jIndex>* inverse, std::vector<Nd4jIndex>* counts);
+            template void _unique<double>(NDArray<double>* x, std::vector<double>& values, std::vector<Nd4jIndex>& firstIndices, std::vector<Nd4jIndex>* inverse, std::vector<Nd4jIndex>* counts);
+        }
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef LIBND4J_GATHER_HELPER_H
+#define LIBND4J_GATHER_HELPER_H
+
+#include <pointercast.h>
+#include <types/float16.h>
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            /**
+             * Gather of x slices along axis. Shape of z must be evaluated already: its rank is rank of x plus rank of indices minus 1,
+             * so scalar index produces single slice. Index buffer is read directly, i.e. it may hold ints or longs.
+             */
+            template <typename T, typename I>
+            void _gather(T* x, int* xShapeInfo, T* z, int* zShapeInfo, int axis, const I* indices, Nd4jIndex numIndices);
+
+            /**
+             * Fused gather + reduce over dimension 0 of x, i.e. embedding bag: row b of z is sum (or mean) of x rows selected by
+             * indices [b * bagSize, (b + 1) * bagSize). Negative indices are padding, they're skipped and aren't counted for mean.
+             */
+            template <typename T, typename I>
+            void _embeddingBag(T* x, int* xShapeInfo, T* z, int* zShapeInfo, const I* indices, Nd4jIndex numBags, Nd4jIndex bagSize, bool mean);
+        }
+    }
+}
+
+#endif
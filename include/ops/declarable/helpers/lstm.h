@@ -0,0 +1,38 @@
+#ifndef LIBND4J_LSTM_HELPERS_H
+#define LIBND4J_LSTM_HELPERS_H
+
+#include <pointercast.h>
+#include <types/float16.h>
+#include <NDArray.h>
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            /**
+             * Whole-sequence LSTM forward pass, same math as lstmCell applied for each time step:
+             * - input projections of all time steps (plus biases) are done with single GEMM up front
+             * - each time step then does one GEMM for recurrent projection, one fused pass over gates, and one GEMM for optional projection
+             * - all buffers are allocated once per sequence
+             *
+             * x [time x bS x inSize], h0 [bS x numProj], c0 [bS x numUnits], Wx [inSize x 4*numUnits], Wh [numProj x 4*numUnits],
+             * Wc [1 x 3*numUnits], Wp [numUnits x numProj], b [1 x 4*numUnits], h [time x bS x numProj], c [time x bS x numUnits]
+             *
+             * All arrays are expected to be c-ordered & contiguous.
+             */
+            template <typename T>
+            void _lstmForward(NDArray<T>* x, NDArray<T>* h0, NDArray<T>* c0, NDArray<T>* Wx, NDArray<T>* Wh, NDArray<T>* Wc, NDArray<T>* Wp, NDArray<T>* b, NDArray<T>* h, NDArray<T>* c, bool peephole, bool projection, T clipCell, T clipProj, T forgetBias);
+
+            /**
+             * Whole-sequence LSTM backward pass for given gradient wrt h [time x bS x numProj].
+             * Forward pass is recomputed with gates stored, weights/inputs gradients are then done with single GEMM each over all time steps.
+             * Gradients wrt clipped values are zero.
+             */
+            template <typename T>
+            void _lstmBackward(NDArray<T>* x, NDArray<T>* h0, NDArray<T>* c0, NDArray<T>* Wx, NDArray<T>* Wh, NDArray<T>* Wc, NDArray<T>* Wp, NDArray<T>* b, NDArray<T>* dLdh,
+                               NDArray<T>* dLdx, NDArray<T>* dLdh0, NDArray<T>* dLdc0, NDArray<T>* dLdWx, NDArray<T>* dLdWh, NDArray<T>* dLdWc, NDArray<T>* dLdWp, NDArray<T>* dLdb,
+                               bool peephole, bool projection, T clipCell, T clipProj, T forgetBias);
+        }
+    }
+}
+
+#endif //LIBND4J_LSTM_HELPERS_H
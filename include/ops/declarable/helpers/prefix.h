@@ -13,11 +13,17 @@
 namespace nd4j {
     namespace ops {
         namespace helpers {
+            /**
+             * Scan of whole array in c order. Exclusive scan starts from op identity, reverse scan goes from last element to first
+             */
             template <typename T, typename OpName>
-            void _prefix(T* x, int* xShapeInfo, T* z, int* zShapeInfo);
+            void _prefix(T* x, int* xShapeInfo, T* z, int* zShapeInfo, bool exclusive = false, bool reverse = false);
 
+            /**
+             * Independent scans of every TAD along given dimensions
+             */
             template <typename T, typename OpName>
-            void _prefix(NDArray<T>* x, NDArray<T>* z, std::vector<int>& dims);
+            void _prefix(NDArray<T>* x, NDArray<T>* z, std::vector<int>& dims, bool exclusive = false, bool reverse = false);
         }
     }
 }
@@ -0,0 +1,38 @@
+#ifndef LIBND4J_SRU_HELPERS_H
+#define LIBND4J_SRU_HELPERS_H
+
+#include <pointercast.h>
+#include <types/float16.h>
+#include <NDArray.h>
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            /**
+             * This method returns true if all given arrays are c-ordered & contiguous, so fused SRU kernels can be used. nullptrs are ignored.
+             */
+            template <typename T>
+            bool _sruFusable(std::initializer_list<NDArray<T>*> arrays);
+
+            /**
+             * Whole-sequence SRU forward pass:
+             * - input projections for all time steps are done with single GEMM up front
+             * - recurrence is element-wise, so each (batch, feature) pair runs over all time steps independently, in one pass and without temporaries
+             *
+             * input [bS x K x N], weights [3K x K], bias [1 x 2K], init [bS x K], mask [bS x K] or nullptr, output & state [bS x K x N]
+             */
+            template <typename T>
+            void _sruForward(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* bias, NDArray<T>* init, NDArray<T>* mask, NDArray<T>* output, NDArray<T>* state);
+
+            /**
+             * Whole-sequence SRU backward pass. inGradCt is updated in place, the same way sru_bp always did.
+             *
+             * gradX [bS x K x N], gradW [bS x 3K x K], gradB [1 x 2K], gradInit [bS x K]
+             */
+            template <typename T>
+            void _sruBackward(NDArray<T>* input, NDArray<T>* weights, NDArray<T>* bias, NDArray<T>* init, NDArray<T>* state, NDArray<T>* inGradCt, NDArray<T>* inGradH, NDArray<T>* mask, NDArray<T>* gradX, NDArray<T>* gradW, NDArray<T>* gradB, NDArray<T>* gradInit);
+        }
+    }
+}
+
+#endif //LIBND4J_SRU_HELPERS_H
@@ -0,0 +1,25 @@
+#ifndef LIBND4J_UNIQUE_HELPER_H
+#define LIBND4J_UNIQUE_HELPER_H
+
+#include <pointercast.h>
+#include <types/float16.h>
+#include <vector>
+#include <NDArray.h>
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            /**
+             * Hash-based deduplication of array elements, taken in c order.
+             *
+             * values & firstIndices are filled in order of first occurrence. If provided, inverse receives index into values
+             * for every input element, and counts receive number of occurrences of every unique value.
+             * Equality is the same as operator==, i.e. -0.0 equals 0.0 and every NaN is unique.
+             */
+            template <typename T>
+            void _unique(NDArray<T>* x, std::vector<T>& values, std::vector<Nd4jIndex>& firstIndices, std::vector<Nd4jIndex>* inverse = nullptr, std::vector<Nd4jIndex>* counts = nullptr);
+        }
+    }
+}
+
+#endif
@@ -3,6 +3,9 @@
 //
 
 #include <ops/declarable/DeclarableOp.h>
+#include <graph/MemoryPlanner.h>
+#include <graph/OpProfiler.h>
+#include <typeinfo>
 
 namespace nd4j {
     namespace ops {
@@ -100,6 +103,60 @@ namespace nd4j {
 
 
 
+        template <typename T>
+        Nd4jIndex nd4j::ops::DeclarableOp<T>::shapeCacheHash() {
+            // all legacy ops share the same name, so actual class is taken into account as well
+            return this->getOpHash() ^ (Nd4jIndex) typeid(*this).hash_code();
+        }
+
+        template <typename T>
+        std::shared_ptr<ShapePack> nd4j::ops::DeclarableOp<T>::inferOutputShape(ShapeList *inputShape, Context<T> &ctx) {
+            auto cache = ShapeCache::getInstance();
+            auto hash = this->shapeCacheHash();
+
+            bool cacheable = cache->isEnabled() && cache->isCacheable(hash);
+            std::vector<int> key;
+            if (cacheable) {
+                auto tArgs = ctx.getTArguments();
+                key = ShapeCache::buildKey(hash, sizeof(T), inputShape, ctx.getIArguments(), tArgs->data(), (int) (tArgs->size() * sizeof(T)));
+
+                auto pack = cache->lookup(key);
+                if (pack != nullptr)
+                    return pack;
+            }
+
+            auto reads = ctx.variableReads();
+            auto outSha = this->calculateOutputShape(inputShape, ctx);
+
+            std::shared_ptr<ShapePack> pack;
+
+            // shape function looked into input arrays, so its result can't be reused for other arrays of the same shape
+            if (ctx.variableReads() != reads) {
+                cache->markUncacheable(hash);
+                pack.reset(new ShapePack(outSha));
+            } else if (cacheable) {
+                pack = cache->store(key, outSha);
+            } else
+                pack.reset(new ShapePack(outSha));
+
+            outSha->destroy();
+            delete outSha;
+
+            return pack;
+        }
+
+        template <typename T>
+        std::shared_ptr<ShapePack> nd4j::ops::DeclarableOp<T>::cachedOutputShape(ShapeList *inputShape, std::vector<T> &tArgs, std::vector<int> &iArgs) {
+            auto cache = ShapeCache::getInstance();
+            auto hash = this->shapeCacheHash();
+
+            if (!cache->isEnabled() || !cache->isCacheable(hash))
+                return nullptr;
+
+            auto key = ShapeCache::buildKey(hash, sizeof(T), inputShape, &iArgs, tArgs.data(), (int) (tArgs.size() * sizeof(T)));
+            return cache->lookup(key);
+        }
+
         template <typename T>
         bool nd4j::ops::DeclarableOp<T>::prepareOutputs(Context<T> &ctx) {
             auto workspace = ctx.getWorkspace();
@@ -107,6 +164,40 @@ namespace nd4j {
             if (ctx.isInplace()) {
                 // do nothing, getZ result will do the trick
             } else {
+                int numOutputs = _descriptor->getNumberOfOutputs();
+                auto planner = ctx.getVariableSpace() != nullptr ? ctx.getVariableSpace()->memoryPlanner() : nullptr;
+
+                // statically planned outputs are views of arena built once per plan, so there's nothing to infer or allocate
+                if (planner != nullptr && numOutputs > 0) {
+                    bool planned = true;
+                    for (int e = 0; e < numOutputs && planned; e++) {
+                        std::pair<int, int> pair(ctx.nodeId(), e);
+                        planned = planner->hasBuffer(pair);
+                    }
+
+                    if (planned) {
+                        for (int e = 0; e < numOutputs; e++) {
+                            std::pair<int, int> pair(ctx.nodeId(), e);
+                            auto array = planner->array(pair);
+                            memset(array->getBuffer(), 0, array->lengthOf() * sizeof(T));
+
+                            ctx.pushNDArrayToVariableSpace(pair, array, false);
+                        }
+
+                        return true;
+                    }
+                }
+
+                // if caller has provided all outputs - there's nothing to infer or allocate
+                if (numOutputs > 0) {
+                    bool provided = true;
+                    for (int e = 0; e < numOutputs && provided; e++)
+                        provided = ctx.isValueAvailable(e);
+
+                    if (provided)
+                        return true;
+                }
+
                 // if op is not inplace - we should pre-allocate arrays
 
                 ShapeList inSha;
@@ -123,23 +214,25 @@ namespace nd4j {
                     cntIn++;
                 }
 
-                auto outSha = this->calculateOutputShape(&inSha, ctx);
+                auto outSha = this->inferOutputShape(&inSha, ctx);
                 int cnt = 0;
-                for (auto out: *outSha->asVector()) {
+                for (auto out: outSha->shapes()) {
                     // we need to check, if Z is really needed
                     std::pair<int, int> pair(ctx.nodeId(), cnt++);
 
                     if (!ctx.isValueAvailable(pair.second)) {
-                        auto outArr = new NDArray<T>(out, true, workspace);
-
-                        ctx.pushNDArrayToVariableSpace(pair, outArr);
+                        // statically planned output is just a view of arena, as long as actual shape matches the plan
+                        if (planner != nullptr && planner->hasBuffer(pair) && shape::equalsSoft(out, planner->shapeInfo(pair))) {
+                            auto outArr = planner->array(pair);
+                            memset(outArr->getBuffer(), 0, shape::length(out) * sizeof(T));
+
+                            ctx.pushNDArrayToVariableSpace(pair, outArr, false);
+                        } else
+                            ctx.pushNDArrayToVariableSpace(pair, new NDArray<T>(out, true, workspace));
                     } else {
                         // TODO: validate/compare shapes here. existent vs provided in outSha
                     }
                 }
-
-                outSha->destroy();
-                delete outSha;
             }
 
             return true;
@@ -228,6 +321,22 @@ namespace nd4j {
             // ensure number of IArgs, TArgs match our expectations
             REQUIRE_OK(this->validateArguments(*block));
 
+            auto profiler = nd4j::graph::OpProfiler::getInstance();
+            bool profiling = profiler->isEnabled();
+
+            nd4j::graph::ProfilerEvent event;
+            Nd4jIndex wsBefore = 0;
+            if (profiling) {
+                event.start = profiler->now();
+                for (int e = 0; e < (int) block->width(); e++) {
+                    auto array = block->variable(e)->getNDArray();
+                    event.inputShapes.emplace_back(array != nullptr ? array->getShapeAsVector() : std::vector<int>());
+                }
+
+                if (block->getWorkspace() != nullptr)
+                    wsBefore = block->getWorkspace()->getCurrentOffset() + block->getWorkspace()->getSpilledSize();
+            }
+
             // this method will allocate output NDArrays for this op
             this->prepareOutputs(*block);
 
@@ -239,6 +348,27 @@ namespace nd4j {
             auto outerTime = std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count();
             block->setInnerTime(outerTime);
 
+            if (profiling) {
+                event.end = profiler->now();
+                event.name = *this->getOpName();
+                event.category = "op";
+                event.nodeId = block->nodeId();
+                event.threadId = profiler->threadId();
+
+                auto varSpace = block->getVariableSpace();
+                for (int e = 0; varSpace != nullptr && varSpace->hasVariable(block->nodeId(), e); e++) {
+                    auto array = varSpace->getVariable(block->nodeId(), e)->getNDArray();
+                    event.outputShapes.emplace_back(array != nullptr ? array->getShapeAsVector() : std::vector<int>());
+                }
+
+                // workspace might be reset within op, so negative delta means nothing
+                if (block->getWorkspace() != nullptr)
+                    event.workspaceBytes = nd4j::math::nd4j_max<Nd4jIndex>(0, block->getWorkspace()->getCurrentOffset() + block->getWorkspace()->getSpilledSize() - wsBefore);
+
+                event.flops = nd4j::graph::OpProfiler::estimateFlops(event.name, event.inputShapes, event.outputShapes);
+                profiler->record(event);
+            }
+
             return status;
         }
 
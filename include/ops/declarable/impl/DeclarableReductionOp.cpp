@@ -47,9 +47,6 @@ namespace nd4j {
                 return new ShapeList(newShape);
             }
 
-            shape::TAD tad(inputShape->at(0), dims.data(), dims.size());
-            tad.createTadOnlyShapeInfo();
-
             Nd4jIndex tadLength = shape::tadLength(inputShape->at(0), dims.data(), dims.size());
             Nd4jIndex numTads = shape::length(inputShape->at(0)) /  tadLength;
 
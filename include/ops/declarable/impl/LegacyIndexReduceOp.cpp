@@ -4,6 +4,7 @@
 
 #include <ops/declarable/LegacyIndexReduceOp.h>
 #include <helpers/ShapeUtils.h>
+#include <helpers/TadCache.h>
 
 
 namespace nd4j {
@@ -76,11 +77,9 @@ namespace nd4j {
                 if (dims.size() > 1)
                     std::sort(dims.begin(), dims.end());
 
-                shape::TAD tad(x->getShapeInfo(), dims.data(), dims.size());
-                tad.createTadOnlyShapeInfo();
-                tad.createOffsets();
+                auto tad = nd4j::TadCache::getInstance()->tadForDimensions(x->getShapeInfo(), dims);
 
-                NativeOpExcutioner<T>::execIndexReduce(opNum, x->getBuffer(), x->getShapeInfo(), block.getTArguments()->data(), z->getBuffer(), z->getShapeInfo(), dims.data(), (int) dims.size(), tad.tadOnlyShapeInfo, tad.tadOffsets);
+                NativeOpExcutioner<T>::execIndexReduce(opNum, x->getBuffer(), x->getShapeInfo(), block.getTArguments()->data(), z->getBuffer(), z->getShapeInfo(), dims.data(), (int) dims.size(), tad->tadOnlyShapeInfo(), tad->tadOffsets());
             }
 
             STORE_RESULT(*z);
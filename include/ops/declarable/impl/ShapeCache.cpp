@@ -0,0 +1,177 @@
+#include <ops/declarable/ShapeCache.h>
+#include <helpers/shape.h>
+#include <cstring>
+
+namespace nd4j {
+    namespace ops {
+        ShapePack::ShapePack(ShapeList *shapes) {
+            for (auto v: *shapes->asVector()) {
+                int length = shape::shapeInfoLength(shape::rank(v));
+                auto copy = new int[length];
+                memcpy(copy, v, length * sizeof(int));
+
+                _shapes.emplace_back(copy);
+            }
+        }
+
+        ShapePack::~ShapePack() {
+            for (auto v: _shapes)
+                delete[] v;
+        }
+
+        int ShapePack::size() {
+            return (int) _shapes.size();
+        }
+
+        int* ShapePack::at(int idx) {
+            return _shapes.at(idx);
+        }
+
+        std::vector<int*>& ShapePack::shapes() {
+            return _shapes;
+        }
+
+        size_t ShapeCache::KeyHash::operator()(const std::vector<int> &key) const {
+            // FNV-1a over key elements
+            uint64_t hash = 14695981039346656037ULL;
+            for (auto v: key) {
+                hash ^= (uint64_t) (unsigned int) v;
+                hash *= 1099511628211ULL;
+            }
+
+            return (size_t) hash;
+        }
+
+        ShapeCache::ShapeCache() {
+            _enabled.store(true);
+            _hits.store(0);
+            _misses.store(0);
+        }
+
+        ShapeCache* ShapeCache::getInstance() {
+            static ShapeCache instance;
+            return &instance;
+        }
+
+        std::vector<int> ShapeCache::buildKey(Nd4jIndex opHash, int sizeOfT, ShapeList *inputShapes, std::vector<int> *iArgs, void *tArgs, int tArgsBytes) {
+            std::vector<int> key;
+            key.reserve(16);
+
+            key.emplace_back((int) (opHash & 0xFFFFFFFFLL));
+            key.emplace_back((int) (opHash >> 32));
+            key.emplace_back(sizeOfT);
+
+            key.emplace_back(inputShapes->size());
+            for (auto v: *inputShapes->asVector())
+                key.insert(key.end(), v, v + shape::shapeInfoLength(shape::rank(v)));
+
+            key.emplace_back((int) iArgs->size());
+            key.insert(key.end(), iArgs->begin(), iArgs->end());
+
+            // tArgs are compared bitwise, tail is zero-padded
+            int tLength = (tArgsBytes + (int) sizeof(int) - 1) / (int) sizeof(int);
+            key.emplace_back(tArgsBytes);
+            size_t offset = key.size();
+            key.resize(offset + tLength, 0);
+            if (tArgsBytes > 0)
+                memcpy(key.data() + offset, tArgs, tArgsBytes);
+
+            return key;
+        }
+
+        std::shared_ptr<ShapePack> ShapeCache::lookup(const std::vector<int> &key) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto it = _map.find(key);
+            if (it == _map.end()) {
+                _misses++;
+                return nullptr;
+            }
+
+            // moving entry to front
+            _lru.splice(_lru.begin(), _lru, it->second);
+            _hits++;
+            return it->second->second;
+        }
+
+        std::shared_ptr<ShapePack> ShapeCache::store(const std::vector<int> &key, ShapeList *shapes) {
+            std::shared_ptr<ShapePack> pack(new ShapePack(shapes));
+
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // someone else might have stored the same shapes meanwhile
+            auto it = _map.find(key);
+            if (it != _map.end()) {
+                _lru.splice(_lru.begin(), _lru, it->second);
+                return it->second->second;
+            }
+
+            _lru.emplace_front(key, pack);
+            _map[key] = _lru.begin();
+
+            while ((int) _lru.size() > _capacity) {
+                _map.erase(_lru.back().first);
+                _lru.pop_back();
+            }
+
+            return pack;
+        }
+
+        bool ShapeCache::isCacheable(Nd4jIndex opHash) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _uncacheable.count(opHash) == 0;
+        }
+
+        void ShapeCache::markUncacheable(Nd4jIndex opHash) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _uncacheable.insert(opHash);
+        }
+
+        bool ShapeCache::isEnabled() {
+            return _enabled.load();
+        }
+
+        void ShapeCache::setEnabled(bool reallyEnabled) {
+            _enabled.store(reallyEnabled);
+        }
+
+        void ShapeCache::setCapacity(int capacity) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _capacity = capacity < 1 ? 1 : capacity;
+            while ((int) _lru.size() > _capacity) {
+                _map.erase(_lru.back().first);
+                _lru.pop_back();
+            }
+        }
+
+        int ShapeCache::capacity() {
+            return _capacity;
+        }
+
+        int ShapeCache::size() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return (int) _lru.size();
+        }
+
+        void ShapeCache::clear() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _map.clear();
+            _lru.clear();
+            _uncacheable.clear();
+        }
+
+        Nd4jIndex ShapeCache::hits() {
+            return _hits.load();
+        }
+
+        Nd4jIndex ShapeCache::misses() {
+            return _misses.load();
+        }
+
+        void ShapeCache::resetCounters() {
+            _hits.store(0);
+            _misses.store(0);
+        }
+    }
+}
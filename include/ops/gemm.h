@@ -8,20 +8,60 @@
 #include <cblas.h>
 #include <templatemath.h>
 
+// register tile of the micro-kernel: GEMM_MR rows of A by GEMM_NR columns of B
+#define GEMM_MR 8
+#define GEMM_NR 4
+
+// cache blocking: A block of GEMM_MC x GEMM_KC stays in L2, B panel of GEMM_KC x GEMM_NC stays in L3
+#define GEMM_MC 128
+#define GEMM_KC 256
+#define GEMM_NC 2048
 
 namespace nd4j {
      namespace blas {
 
+        /**
+         * Type used for packed panels & accumulation. Half precision gets widened to float while packing.
+         */
+        template <typename T>
+        struct GemmAccumulator {
+            typedef T type;
+        };
 
+        template <>
+        struct GemmAccumulator<float16> {
+            typedef float type;
+        };
 
 
         template <typename T>
         class GEMM {
         protected:
+            typedef typename GemmAccumulator<T>::type Acc;
+
             static inline int linearIndexC(int rows, int cols, int r, int c);
             static inline int linearIndexF(int rows, int cols, int r, int c);
             static T* transpose(int orderSource, int orderTarget, int rows, int cols, T *source);
 
+            /**
+             * Packs mc x kc block of op(A), starting at (row, col), into GEMM_MR-row panels. Tails are zero-padded.
+             */
+            static void packA(int mc, int kc, T *A, int lda, bool transA, int row, int col, Acc *buffer);
+
+            /**
+             * Packs kc x nc block of op(B), starting at (row, col), into GEMM_NR-column panels. Tails are zero-padded.
+             */
+            static void packB(int kc, int nc, T *B, int ldb, bool transB, int row, int col, Acc *buffer);
+
+            /**
+             * Computes GEMM_MR x GEMM_NR tile of packed A panel by packed B panel, result is stored column-wise into tile
+             */
+            static inline void microKernel(int kc, Acc *a, Acc *b, Acc *tile);
+
+            /**
+             * Column-major GEMM over blocked & packed operands: C = alpha * op(A) * op(B) + C
+             */
+            static void blocked(bool transA, bool transB, int M, int N, int K, T alpha, T *A, int lda, T *B, int ldb, T *C, int ldc);
 
         public:
             static void op(int Order, int TransA, int TransB, int M, int N, int K, T alpha, T *A, int lda, T *B, int ldb, T beta, T *C, int ldc);
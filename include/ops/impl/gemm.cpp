@@ -3,6 +3,7 @@
 //
 
 #include <gemm.h>
+#include <omp.h>
 
 namespace nd4j {
     namespace blas {
@@ -36,70 +37,215 @@ namespace nd4j {
         }
 
         template <typename T>
-        void GEMM<T>::op(int Order, int TransA, int TransB,
-                       int M, int N, int K,
-                       T alpha,
-                       T *A, int lda,
-                       T *B, int ldb,
-                       T beta,
-                       T *C, int ldc) {
+        void GEMM<T>::packA(int mc, int kc, T *A, int lda, bool transA, int row, int col, Acc *buffer) {
+            for (int ir = 0; ir < mc; ir += GEMM_MR) {
+                int mr = nd4j::math::nd4j_min<int>(GEMM_MR, mc - ir);
+                Acc *panel = buffer + (Nd4jIndex) ir * kc;
+
+                if (!transA) {
+                    // op(A)(i, p) = A[i + p * lda], rows are contiguous
+                    for (int p = 0; p < kc; p++) {
+                        T *src = A + (Nd4jIndex) (col + p) * lda + row + ir;
+                        Acc *dst = panel + p * GEMM_MR;
+                        int i = 0;
+                        for (; i < mr; i++)
+                            dst[i] = (Acc) src[i];
+
+                        for (; i < GEMM_MR; i++)
+                            dst[i] = (Acc) 0.0f;
+                    }
+                } else {
+                    // op(A)(i, p) = A[p + i * lda], columns are contiguous
+                    for (int i = 0; i < mr; i++) {
+                        T *src = A + (Nd4jIndex) (row + ir + i) * lda + col;
+                        for (int p = 0; p < kc; p++)
+                            panel[p * GEMM_MR + i] = (Acc) src[p];
+                    }
 
-            // optionally handle transpose
-            // we want C always here
-            T *aT = TransA != CblasTrans ? transpose(CblasColMajor, CblasRowMajor, M, K, A) : A;
+                    for (int i = mr; i < GEMM_MR; i++)
+                        for (int p = 0; p < kc; p++)
+                            panel[p * GEMM_MR + i] = (Acc) 0.0f;
+                }
+            }
+        }
 
-            // we want F always here
-            T *bT = TransB == CblasTrans ? transpose(CblasRowMajor, CblasColMajor, K, N, B) : B;
+        template <typename T>
+        void GEMM<T>::packB(int kc, int nc, T *B, int ldb, bool transB, int row, int col, Acc *buffer) {
+            int numPanels = (nc + GEMM_NR - 1) / GEMM_NR;
+
+#pragma omp parallel for if (numPanels > 4) schedule(static) proc_bind(close)
+            for (int jp = 0; jp < numPanels; jp++) {
+                int jr = jp * GEMM_NR;
+                int nr = nd4j::math::nd4j_min<int>(GEMM_NR, nc - jr);
+                Acc *panel = buffer + (Nd4jIndex) jr * kc;
+
+                if (!transB) {
+                    // op(B)(p, j) = B[p + j * ldb], columns are contiguous
+                    for (int j = 0; j < nr; j++) {
+                        T *src = B + (Nd4jIndex) (col + jr + j) * ldb + row;
+                        for (int p = 0; p < kc; p++)
+                            panel[p * GEMM_NR + j] = (Acc) src[p];
+                    }
+                } else {
+                    // op(B)(p, j) = B[j + p * ldb], rows are contiguous
+                    for (int p = 0; p < kc; p++) {
+                        T *src = B + (Nd4jIndex) (row + p) * ldb + col + jr;
+                        for (int j = 0; j < nr; j++)
+                            panel[p * GEMM_NR + j] = (Acc) src[j];
+                    }
+                }
 
+                for (int j = nr; j < GEMM_NR; j++)
+                    for (int p = 0; p < kc; p++)
+                        panel[p * GEMM_NR + j] = (Acc) 0.0f;
+            }
+        }
 
-            if (beta == (T) 0.0f) {
-                int length = M*N;
-                if (length <= 8192) {
+        template <typename T>
+        void GEMM<T>::microKernel(int kc, Acc *a, Acc *b, Acc *tile) {
+            Acc acc[GEMM_NR][GEMM_MR];
+
+            for (int j = 0; j < GEMM_NR; j++) {
 #pragma omp simd
-                    for (int r = 0; r < length; r++)
-                        C[r] = (T) 0.0f;
-                } else {
-#pragma omp parallel for simd
-                    for (int r = 0; r < length; r++)
-                        C[r] = (T) 0.0f;
-                }
+                for (int i = 0; i < GEMM_MR; i++)
+                    acc[j][i] = (Acc) 0.0f;
             }
 
+            // rank-1 updates of the register tile, inner loop is vectorized over GEMM_MR rows
+            for (int p = 0; p < kc; p++) {
+                for (int j = 0; j < GEMM_NR; j++) {
+                    Acc bv = b[j];
+#pragma omp simd
+                    for (int i = 0; i < GEMM_MR; i++)
+                        acc[j][i] += a[i] * bv;
+                }
 
-#pragma omp parallel for proc_bind(spread)
-            for (int r = 0; r < M; r++) {
+                a += GEMM_MR;
+                b += GEMM_NR;
+            }
 
-                int aIdx = linearIndexC(M, K, r, 0);
-                T *aX = aT + aIdx;
+            for (int j = 0; j < GEMM_NR; j++) {
+#pragma omp simd
+                for (int i = 0; i < GEMM_MR; i++)
+                    tile[j * GEMM_MR + i] = acc[j][i];
+            }
+        }
 
-                for (int c = 0; c < N; c++) {
-                    int zIdx = linearIndexF(M, N, r, c);
+        template <typename T>
+        void GEMM<T>::blocked(bool transA, bool transB, int M, int N, int K, T alpha, T *A, int lda, T *B, int ldb, T *C, int ldc) {
+            const Acc _alpha = (Acc) alpha;
+
+            const int kcMax = nd4j::math::nd4j_min<int>(GEMM_KC, K);
+            const int ncMax = nd4j::math::nd4j_min<int>(GEMM_NC, N);
+            const int mcMax = nd4j::math::nd4j_min<int>(GEMM_MC, M);
+
+            const int threads = omp_get_max_threads();
+            const bool parallel = (Nd4jIndex) M * N * K > 32768;
+
+            // packing buffers are bounded by block sizes, not by problem size
+            Acc *bPacked = new Acc[(Nd4jIndex) kcMax * (((ncMax + GEMM_NR - 1) / GEMM_NR) * GEMM_NR)];
+            Acc *aPacked = new Acc[(Nd4jIndex) threads * kcMax * (((mcMax + GEMM_MR - 1) / GEMM_MR) * GEMM_MR)];
+            const Nd4jIndex aStride = (Nd4jIndex) kcMax * (((mcMax + GEMM_MR - 1) / GEMM_MR) * GEMM_MR);
+
+            for (int jc = 0; jc < N; jc += GEMM_NC) {
+                int nc = nd4j::math::nd4j_min<int>(GEMM_NC, N - jc);
+                int nPanels = (nc + GEMM_NR - 1) / GEMM_NR;
+
+                for (int pc = 0; pc < K; pc += GEMM_KC) {
+                    int kc = nd4j::math::nd4j_min<int>(GEMM_KC, K - pc);
+
+                    packB(kc, nc, B, ldb, transB, pc, jc, bPacked);
+
+                    // macro-tiles: M blocks, optionally split along N when there are fewer M blocks than threads
+                    int mBlocks = (M + GEMM_MC - 1) / GEMM_MC;
+                    int nGroups = mBlocks >= threads ? 1 : nd4j::math::nd4j_min<int>(nPanels, (threads + mBlocks - 1) / mBlocks);
+                    int tasks = mBlocks * nGroups;
+
+#pragma omp parallel for if (parallel && tasks > 1) schedule(dynamic, 1) proc_bind(close)
+                    for (int t = 0; t < tasks; t++) {
+                        int ic = (t / nGroups) * GEMM_MC;
+                        int g = t % nGroups;
+                        int mc = nd4j::math::nd4j_min<int>(GEMM_MC, M - ic);
+                        int pStart = (Nd4jIndex) g * nPanels / nGroups;
+                        int pEnd = (Nd4jIndex) (g + 1) * nPanels / nGroups;
+
+                        Acc *aBlock = aPacked + omp_get_thread_num() * aStride;
+                        Acc tile[GEMM_MR * GEMM_NR];
+
+                        packA(mc, kc, A, lda, transA, ic, pc, aBlock);
+
+                        for (int jp = pStart; jp < pEnd; jp++) {
+                            int jr = jp * GEMM_NR;
+                            int nr = nd4j::math::nd4j_min<int>(GEMM_NR, nc - jr);
+                            Acc *bPanel = bPacked + (Nd4jIndex) jr * kc;
+
+                            for (int ir = 0; ir < mc; ir += GEMM_MR) {
+                                int mr = nd4j::math::nd4j_min<int>(GEMM_MR, mc - ir);
+
+                                microKernel(kc, aBlock + (Nd4jIndex) ir * kc, bPanel, tile);
+
+                                T *cTile = C + (Nd4jIndex) (jc + jr) * ldc + ic + ir;
+                                for (int j = 0; j < nr; j++) {
+                                    T *cCol = cTile + (Nd4jIndex) j * ldc;
+                                    Acc *tCol = tile + j * GEMM_MR;
+                                    for (int i = 0; i < mr; i++)
+                                        cCol[i] = (T) ((Acc) cCol[i] + _alpha * tCol[i]);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
 
-                    T dot = (T) 0.0f;
+            delete[] aPacked;
+            delete[] bPacked;
+        }
 
-                    if (alpha != (T) 0.0f) {
-                        int bIdx = linearIndexF(K, N, 0, c);
+        template <typename T>
+        void GEMM<T>::op(int Order, int TransA, int TransB,
+                       int M, int N, int K,
+                       T alpha,
+                       T *A, int lda,
+                       T *B, int ldb,
+                       T beta,
+                       T *C, int ldc) {
 
-                        T *bX = bT + bIdx;
+            if (M <= 0 || N <= 0)
+                return;
 
-                        dot = nd4j::math::nd4j_dot<T>(aX, bX, K) * alpha;
-                    }
+            bool transA = TransA == CblasTrans || TransA == CblasConjTrans;
+            bool transB = TransB == CblasTrans || TransB == CblasConjTrans;
 
-                    if (beta != (T) 0.0f) {
-                        C[zIdx] = dot + beta * C[zIdx];
-                    } else {
-                        C[zIdx] = dot;
-                    }
-                }
+            // row-major C is column-major C^T = op(B)^T * op(A)^T, so we just swap operands
+            if (Order == CblasRowMajor) {
+                nd4j::math::nd4j_swap<int>(M, N);
+                nd4j::math::nd4j_swap<int>(lda, ldb);
+                nd4j::math::nd4j_swap<T*>(A, B);
+                nd4j::math::nd4j_swap<bool>(transA, transB);
             }
 
+            // C = beta * C first, micro-kernels will only accumulate into it
+            if (beta == (T) 0.0f) {
+#pragma omp parallel for if ((Nd4jIndex) M * N > 8192) schedule(static) proc_bind(close)
+                for (int c = 0; c < N; c++) {
+                    T *cCol = C + (Nd4jIndex) c * ldc;
+#pragma omp simd
+                    for (int r = 0; r < M; r++)
+                        cCol[r] = (T) 0.0f;
+                }
+            } else if (beta != (T) 1.0f) {
+#pragma omp parallel for if ((Nd4jIndex) M * N > 8192) schedule(static) proc_bind(close)
+                for (int c = 0; c < N; c++) {
+                    T *cCol = C + (Nd4jIndex) c * ldc;
+                    for (int r = 0; r < M; r++)
+                        cCol[r] = beta * cCol[r];
+                }
+            }
 
-            // if transpose was applied - dismiss transposed arrays
-            if (TransA != CblasTrans)
-                delete[] aT;
+            if (K <= 0 || alpha == (T) 0.0f)
+                return;
 
-            if (TransB == CblasTrans)
-                delete[] bT;
+            blocked(transA, transB, M, N, K, alpha, A, lda, B, ldb, C, ldc);
         }
 
 
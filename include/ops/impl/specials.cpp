@@ -4,9 +4,14 @@
 
 
 #include <pointercast.h>
+#include <op_boilerplate.h>
 #include <helpers/shape.h>
 #include <helpers/TAD.h>
 #include <specials.h>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <stdint.h>
 
 namespace nd4j {
     /**
@@ -434,6 +439,373 @@ namespace nd4j {
         }
     }
 
+    namespace sort {
+        /**
+         * Sortable keys: float bit patterns are mapped to unsigned integers with the same order,
+         * so all comparisons and radix passes are done on plain integers.
+         * Descending order is just inverted keys.
+         */
+        template <typename T>
+        struct SortKey;
+
+        template <>
+        struct SortKey<float> {
+            typedef uint32_t K;
+
+            static inline K encode(float value, bool descending) {
+                K bits;
+                memcpy(&bits, &value, sizeof(K));
+                bits ^= (bits >> 31) != 0 ? 0xFFFFFFFFu : 0x80000000u;
+                return descending ? ~bits : bits;
+            }
+
+            static inline float decode(K key, bool descending) {
+                K bits = descending ? ~key : key;
+                bits ^= (bits >> 31) != 0 ? 0x80000000u : 0xFFFFFFFFu;
+
+                float value;
+                memcpy(&value, &bits, sizeof(K));
+                return value;
+            }
+        };
+
+        template <>
+        struct SortKey<double> {
+            typedef uint64_t K;
+
+            static inline K encode(double value, bool descending) {
+                K bits;
+                memcpy(&bits, &value, sizeof(K));
+                bits ^= (bits >> 63) != 0 ? 0xFFFFFFFFFFFFFFFFULL : 0x8000000000000000ULL;
+                return descending ? ~bits : bits;
+            }
+
+            static inline double decode(K key, bool descending) {
+                K bits = descending ? ~key : key;
+                bits ^= (bits >> 63) != 0 ? 0x8000000000000000ULL : 0xFFFFFFFFFFFFFFFFULL;
+
+                double value;
+                memcpy(&value, &bits, sizeof(K));
+                return value;
+            }
+        };
+
+        template <>
+        struct SortKey<float16> {
+            typedef uint16_t K;
+
+            static inline K encode(float16 value, bool descending) {
+                K bits;
+                memcpy(&bits, &value, sizeof(K));
+                bits ^= (bits >> 15) != 0 ? (K) 0xFFFF : (K) 0x8000;
+                return descending ? (K) ~bits : bits;
+            }
+
+            static inline float16 decode(K key, bool descending) {
+                K bits = descending ? (K) ~key : key;
+                bits ^= (bits >> 15) != 0 ? (K) 0x8000 : (K) 0xFFFF;
+
+                float16 value;
+                memcpy(&value, &bits, sizeof(K));
+                return value;
+            }
+        };
+
+        /**
+         * LSD radix sort with 8-bit digits. Values are optional, and are moved together with keys.
+         * All digit histograms are built in one pass, and digits shared by all keys are skipped.
+         */
+        template <typename K, typename V>
+        static void radixSort(K *keys, V *values, Nd4jIndex length, K *tmpKeys, V *tmpValues) {
+            const int numDigits = (int) sizeof(K);
+            std::vector<Nd4jIndex> histogram(numDigits * 256, 0);
+
+            for (Nd4jIndex e = 0; e < length; e++) {
+                K key = keys[e];
+                for (int d = 0; d < numDigits; d++)
+                    histogram[d * 256 + ((key >> (d * 8)) & 0xFF)]++;
+            }
+
+            K *srcKeys = keys;
+            K *dstKeys = tmpKeys;
+            V *srcValues = values;
+            V *dstValues = tmpValues;
+
+            for (int d = 0; d < numDigits; d++) {
+                Nd4jIndex *counts = histogram.data() + d * 256;
+                int shift = d * 8;
+
+                // all keys have the same digit here, so this pass wouldn't move anything
+                if (counts[(srcKeys[0] >> shift) & 0xFF] == length)
+                    continue;
+
+                Nd4jIndex sum = 0;
+                for (int b = 0; b < 256; b++) {
+                    Nd4jIndex c = counts[b];
+                    counts[b] = sum;
+                    sum += c;
+                }
+
+                if (values != nullptr) {
+                    for (Nd4jIndex e = 0; e < length; e++) {
+                        K key = srcKeys[e];
+                        Nd4jIndex pos = counts[(key >> shift) & 0xFF]++;
+                        dstKeys[pos] = key;
+                        dstValues[pos] = srcValues[e];
+                    }
+                } else {
+                    for (Nd4jIndex e = 0; e < length; e++) {
+                        K key = srcKeys[e];
+                        dstKeys[counts[(key >> shift) & 0xFF]++] = key;
+                    }
+                }
+
+                std::swap(srcKeys, dstKeys);
+                std::swap(srcValues, dstValues);
+            }
+
+            if (srcKeys != keys) {
+                memcpy(keys, srcKeys, length * sizeof(K));
+                if (values != nullptr)
+                    memcpy(values, srcValues, length * sizeof(V));
+            }
+        }
+
+        // stable insertion sort, used for short arrays
+        template <typename K, typename V>
+        static void insertionSort(K *keys, V *values, Nd4jIndex length) {
+            for (Nd4jIndex e = 1; e < length; e++) {
+                K key = keys[e];
+                V value = values != nullptr ? values[e] : V();
+
+                Nd4jIndex f = e - 1;
+                while (f >= 0 && keys[f] > key) {
+                    keys[f + 1] = keys[f];
+                    if (values != nullptr)
+                        values[f + 1] = values[f];
+                    f--;
+                }
+
+                keys[f + 1] = key;
+                if (values != nullptr)
+                    values[f + 1] = value;
+            }
+        }
+
+        template <typename K, typename V>
+        static void sortSequential(K *keys, V *values, Nd4jIndex length, K *tmpKeys, V *tmpValues) {
+            if (length < 2)
+                return;
+
+            if (length < SORT_RADIX_THRESHOLD)
+                insertionSort(keys, values, length);
+            else
+                radixSort(keys, values, length, tmpKeys, tmpValues);
+        }
+
+        /**
+         * Merge path: number of elements taken from a, among first diagonal elements of stable merge of a and b
+         */
+        template <typename K>
+        static Nd4jIndex coRank(Nd4jIndex diagonal, K *a, Nd4jIndex lengthA, K *b, Nd4jIndex lengthB) {
+            Nd4jIndex lo = nd4j::math::nd4j_max<Nd4jIndex>(0, diagonal - lengthB);
+            Nd4jIndex hi = nd4j::math::nd4j_min<Nd4jIndex>(diagonal, lengthA);
+
+            // looking for the largest i such that a[i - 1] <= b[diagonal - i]
+            while (lo < hi) {
+                Nd4jIndex i = (lo + hi + 1) / 2;
+                Nd4jIndex j = diagonal - i;
+
+                if (j >= lengthB || a[i - 1] <= b[j])
+                    lo = i;
+                else
+                    hi = i - 1;
+            }
+
+            return lo;
+        }
+
+        template <typename K, typename V>
+        static void mergeSequential(K *a, V *va, Nd4jIndex lengthA, K *b, V *vb, Nd4jIndex lengthB, K *z, V *vz) {
+            Nd4jIndex i = 0, j = 0, k = 0;
+            while (i < lengthA && j < lengthB) {
+                if (b[j] < a[i]) {
+                    if (vz != nullptr)
+                        vz[k] = vb[j];
+                    z[k++] = b[j++];
+                } else {
+                    if (vz != nullptr)
+                        vz[k] = va[i];
+                    z[k++] = a[i++];
+                }
+            }
+
+            memcpy(z + k, a + i, (lengthA - i) * sizeof(K));
+            memcpy(z + k + lengthA - i, b + j, (lengthB - j) * sizeof(K));
+
+            if (vz != nullptr) {
+                memcpy(vz + k, va + i, (lengthA - i) * sizeof(V));
+                memcpy(vz + k + lengthA - i, vb + j, (lengthB - j) * sizeof(V));
+            }
+        }
+
+        /**
+         * Parallel sort: each thread radix-sorts its own chunk, and then sorted runs are merged pairwise.
+         * Each merge is split into equal parts by merge path, so all threads are busy during every round.
+         */
+        template <typename K, typename V>
+        static void sortKeys(K *keys, V *values, Nd4jIndex length, int numThreads) {
+            if (length < 2)
+                return;
+
+            std::vector<K> tmpKeys(length);
+            std::vector<V> tmpValues(values != nullptr ? length : 0);
+            V *tmpValuesPtr = values != nullptr ? tmpValues.data() : nullptr;
+
+            if (numThreads < 2 || length < SORT_PARALLEL_THRESHOLD) {
+                sortSequential(keys, values, length, tmpKeys.data(), tmpValuesPtr);
+                return;
+            }
+
+            int numRuns = numThreads;
+            std::vector<Nd4jIndex> bounds(numRuns + 1);
+            for (int r = 0; r <= numRuns; r++)
+                bounds[r] = length * r / numRuns;
+
+#pragma omp parallel for num_threads(numThreads) schedule(static, 1)
+            for (int r = 0; r < numRuns; r++)
+                sortSequential(keys + bounds[r], values != nullptr ? values + bounds[r] : nullptr, bounds[r + 1] - bounds[r], tmpKeys.data() + bounds[r], tmpValuesPtr != nullptr ? tmpValuesPtr + bounds[r] : nullptr);
+
+            K *srcKeys = keys;
+            K *dstKeys = tmpKeys.data();
+            V *srcValues = values;
+            V *dstValues = tmpValuesPtr;
+
+            while (bounds.size() > 2) {
+                std::vector<Nd4jIndex> merged;
+                int numPairs = ((int) bounds.size() - 1) / 2;
+
+                for (int p = 0; p < numPairs; p++) {
+                    Nd4jIndex start = bounds[p * 2];
+                    Nd4jIndex middle = bounds[p * 2 + 1];
+                    Nd4jIndex end = bounds[p * 2 + 2];
+
+                    K *a = srcKeys + start;
+                    K *b = srcKeys + middle;
+                    Nd4jIndex lengthA = middle - start;
+                    Nd4jIndex lengthB = end - middle;
+
+#pragma omp parallel for num_threads(numThreads) schedule(static, 1)
+                    for (int t = 0; t < numThreads; t++) {
+                        Nd4jIndex d0 = (lengthA + lengthB) * t / numThreads;
+                        Nd4jIndex d1 = (lengthA + lengthB) * (t + 1) / numThreads;
+                        Nd4jIndex i0 = coRank(d0, a, lengthA, b, lengthB);
+                        Nd4jIndex i1 = coRank(d1, a, lengthA, b, lengthB);
+
+                        mergeSequential(a + i0, srcValues != nullptr ? srcValues + start + i0 : nullptr, i1 - i0,
+                                        b + d0 - i0, srcValues != nullptr ? srcValues + middle + d0 - i0 : nullptr, (d1 - i1) - (d0 - i0),
+                                        dstKeys + start + d0, dstValues != nullptr ? dstValues + start + d0 : nullptr);
+                    }
+
+                    merged.emplace_back(start);
+                }
+
+                // odd run is just moved to the other buffer
+                if ((bounds.size() - 1) % 2 == 1) {
+                    Nd4jIndex start = bounds[bounds.size() - 2];
+                    memcpy(dstKeys + start, srcKeys + start, (length - start) * sizeof(K));
+                    if (values != nullptr)
+                        memcpy(dstValues + start, srcValues + start, (length - start) * sizeof(V));
+
+                    merged.emplace_back(start);
+                }
+
+                merged.emplace_back(length);
+                bounds.swap(merged);
+
+                std::swap(srcKeys, dstKeys);
+                std::swap(srcValues, dstValues);
+            }
+
+            if (srcKeys != keys) {
+                memcpy(keys, srcKeys, length * sizeof(K));
+                if (values != nullptr)
+                    memcpy(values, srcValues, length * sizeof(V));
+            }
+        }
+
+        // offsets are resolved once per element, not once per comparison
+        template <typename T, typename K>
+        static void gatherKeys(T *x, int *xShapeInfo, K *keys, Nd4jIndex length, bool descending) {
+            int ews = shape::elementWiseStride(xShapeInfo);
+
+            if (ews >= 1) {
+#pragma omp parallel for schedule(static) if (length > ELEMENT_THRESHOLD)
+                for (Nd4jIndex e = 0; e < length; e++)
+                    keys[e] = SortKey<T>::encode(x[e * ews], descending);
+            } else {
+                int rank = shape::rank(xShapeInfo);
+                int *shape = shape::shapeOf(xShapeInfo);
+                int *stride = shape::stride(xShapeInfo);
+
+#pragma omp parallel for schedule(static) if (length > ELEMENT_THRESHOLD)
+                for (Nd4jIndex e = 0; e < length; e++) {
+                    int coord[MAX_RANK];
+                    shape::ind2subC(rank, shape, e, coord);
+                    keys[e] = SortKey<T>::encode(x[shape::getOffset(0, shape, stride, coord, rank)], descending);
+                }
+            }
+        }
+
+        template <typename T, typename K>
+        static void scatterKeys(K *keys, T *x, int *xShapeInfo, Nd4jIndex length, bool descending) {
+            int ews = shape::elementWiseStride(xShapeInfo);
+
+            if (ews >= 1) {
+#pragma omp parallel for schedule(static) if (length > ELEMENT_THRESHOLD)
+                for (Nd4jIndex e = 0; e < length; e++)
+                    x[e * ews] = SortKey<T>::decode(keys[e], descending);
+            } else {
+                int rank = shape::rank(xShapeInfo);
+                int *shape = shape::shapeOf(xShapeInfo);
+                int *stride = shape::stride(xShapeInfo);
+
+#pragma omp parallel for schedule(static) if (length > ELEMENT_THRESHOLD)
+                for (Nd4jIndex e = 0; e < length; e++) {
+                    int coord[MAX_RANK];
+                    shape::ind2subC(rank, shape, e, coord);
+                    x[shape::getOffset(0, shape, stride, coord, rank)] = SortKey<T>::decode(keys[e], descending);
+                }
+            }
+        }
+
+        // plain copy with the same addressing rules as keys
+        template <typename T>
+        static void copyStrided(T *x, int *xShapeInfo, T *z, Nd4jIndex length, bool toContiguous) {
+            int ews = shape::elementWiseStride(xShapeInfo);
+            int rank = shape::rank(xShapeInfo);
+            int *shape = shape::shapeOf(xShapeInfo);
+            int *stride = shape::stride(xShapeInfo);
+
+#pragma omp parallel for schedule(static) if (length > ELEMENT_THRESHOLD)
+            for (Nd4jIndex e = 0; e < length; e++) {
+                Nd4jIndex offset;
+                if (ews >= 1)
+                    offset = e * ews;
+                else {
+                    int coord[MAX_RANK];
+                    shape::ind2subC(rank, shape, e, coord);
+                    offset = shape::getOffset(0, shape, stride, coord, rank);
+                }
+
+                if (toContiguous)
+                    z[e] = x[offset];
+                else
+                    x[offset] = z[e];
+            }
+        }
+    }
+
     template <typename T>
     int SpecialMethods<T>::getPosition(int *xShapeInfo, int index) {
         int xEWS = shape::elementWiseStride(xShapeInfo);
@@ -547,24 +919,78 @@ namespace nd4j {
 
     template<typename T>
     void SpecialMethods<T>::sortGeneric(T *x, int *xShapeInfo, bool descending) {
-        quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
+        typedef typename sort::SortKey<T>::K K;
+        Nd4jIndex length = shape::length(xShapeInfo);
+
+        std::vector<K> keys(length);
+        sort::gatherKeys(x, xShapeInfo, keys.data(), length, descending);
+        sort::sortKeys<K, int>(keys.data(), nullptr, length, omp_get_max_threads());
+        sort::scatterKeys(keys.data(), x, xShapeInfo, length, descending);
     }
 
     template<typename T>
     void SpecialMethods<T>::sortTadGeneric(T *x, int *xShapeInfo, int *dimension, int dimensionLength, int *tadShapeInfo, Nd4jIndex *tadOffsets, bool descending) {
-        //quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
+        typedef typename sort::SortKey<T>::K K;
         Nd4jIndex xLength = shape::length(xShapeInfo);
         Nd4jIndex xTadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
         int numTads = xLength / xTadLength;
 
-#pragma omp parallel for
-        for (int r = 0; r < numTads; r++) {
-            T *dx = x + tadOffsets[r];
+        // few long TADs are sorted one by one, with all threads involved
+        if (numTads < omp_get_max_threads() && xTadLength >= SORT_PARALLEL_THRESHOLD) {
+            for (int r = 0; r < numTads; r++)
+                sortGeneric(x + tadOffsets[r], tadShapeInfo, descending);
+
+            return;
+        }
+
+#pragma omp parallel
+        {
+            // buffers are allocated once per thread, and reused for all TADs of this thread
+            std::vector<K> keys(xTadLength);
+            std::vector<K> tmpKeys(xTadLength);
+
+#pragma omp for schedule(guided)
+            for (int r = 0; r < numTads; r++) {
+                T *dx = x + tadOffsets[r];
 
-            quickSort_parallel(dx, tadShapeInfo, xTadLength, 1, descending);
+                sort::gatherKeys(dx, tadShapeInfo, keys.data(), xTadLength, descending);
+                sort::sortSequential<K, int>(keys.data(), nullptr, xTadLength, tmpKeys.data(), nullptr);
+                sort::scatterKeys(keys.data(), dx, tadShapeInfo, xTadLength, descending);
+            }
         }
     }
 
+    template<typename T>
+    void SpecialMethods<T>::argsortGeneric(T *x, int *xShapeInfo, Nd4jIndex *indices, bool descending) {
+        typedef typename sort::SortKey<T>::K K;
+        Nd4jIndex length = shape::length(xShapeInfo);
+
+        std::vector<K> keys(length);
+        sort::gatherKeys(x, xShapeInfo, keys.data(), length, descending);
+
+#pragma omp parallel for schedule(static) if (length > ELEMENT_THRESHOLD)
+        for (Nd4jIndex e = 0; e < length; e++)
+            indices[e] = e;
+
+        sort::sortKeys(keys.data(), indices, length, omp_get_max_threads());
+    }
+
+    template<typename T>
+    void SpecialMethods<T>::sortByKeyGeneric(T *x, int *xShapeInfo, T *y, int *yShapeInfo, bool descending) {
+        typedef typename sort::SortKey<T>::K K;
+        Nd4jIndex length = shape::length(xShapeInfo);
+
+        std::vector<K> keys(length);
+        std::vector<T> values(length);
+        sort::gatherKeys(x, xShapeInfo, keys.data(), length, descending);
+        sort::copyStrided(y, yShapeInfo, values.data(), length, true);
+
+        sort::sortKeys(keys.data(), values.data(), length, omp_get_max_threads());
+
+        sort::scatterKeys(keys.data(), x, xShapeInfo, length, descending);
+        sort::copyStrided(y, yShapeInfo, values.data(), length, false);
+    }
+
 
     template<typename T>
     void SpecialMethods<T>::decodeBitmapGeneric(void *dx, Nd4jIndex N, T *dz) {
@@ -642,6 +1068,142 @@ namespace nd4j {
         return retVal;
     }
 
+    template<typename T>
+    void SpecialMethods<T>::encodeThresholdP1Generic(T *dx, Nd4jIndex N, int *dz, float threshold) {
+        Nd4jIndex numBlocks = N / THRESHOLD_BLOCK_SIZE + (N % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+        T tt = (T) threshold;
+        int total = 0;
+
+#pragma omp parallel for schedule(static) proc_bind(close) reduction(+:total)
+        for (Nd4jIndex b = 0; b < numBlocks; b++) {
+            Nd4jIndex start = b * THRESHOLD_BLOCK_SIZE;
+            Nd4jIndex end = nd4j::math::nd4j_min<Nd4jIndex>(N, start + THRESHOLD_BLOCK_SIZE);
+
+            int cnt = 0;
+#pragma omp simd reduction(+:cnt)
+            for (Nd4jIndex e = start; e < end; e++)
+                cnt += nd4j::math::nd4j_abs<T>(dx[e]) >= tt ? 1 : 0;
+
+            dz[b + 1] = cnt;
+            total += cnt;
+        }
+
+        dz[0] = total;
+    }
+
+    template<typename T>
+    void SpecialMethods<T>::encodeThresholdP2Generic(int *dx, Nd4jIndex N, int *dz) {
+        int _threads = nd4j::math::nd4j_max<int>(1, N / ELEMENT_THRESHOLD);
+        _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
+
+        // per-thread sums first, then each thread scans its own span starting from sum of all previous spans
+        std::vector<int> sums(_threads + 1, 0);
+
+#pragma omp parallel num_threads(_threads) if (_threads > 1) proc_bind(close) default(shared)
+        {
+            int tid = omp_get_thread_num();
+            int numThreads = omp_get_num_threads();
+            Nd4jIndex span = N / numThreads + (N % numThreads ? 1 : 0);
+            Nd4jIndex start = tid * span;
+            Nd4jIndex end = nd4j::math::nd4j_min<Nd4jIndex>(N, start + span);
+
+            int sum = 0;
+            for (Nd4jIndex e = start; e < end; e++)
+                sum += dx[e];
+
+            sums[tid + 1] = sum;
+
+#pragma omp barrier
+#pragma omp single
+            {
+                for (int t = 1; t <= numThreads; t++)
+                    sums[t] += sums[t - 1];
+            }
+
+            // dx and dz can be the same buffer
+            int acc = sums[tid];
+            for (Nd4jIndex e = start; e < end; e++) {
+                int v = dx[e];
+                dz[e] = acc;
+                acc += v;
+            }
+        }
+    }
+
+    template<typename T>
+    void SpecialMethods<T>::encodeThresholdP3Generic(T *dx, int *offsets, Nd4jIndex N, int *dz) {
+        int limit = dz[0];
+        FloatBits2 fb;
+        fb.i_ = dz[2];
+        T tt = (T) fb.f_;
+
+        Nd4jIndex numBlocks = N / THRESHOLD_BLOCK_SIZE + (N % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+
+        // each block knows its own offset, so blocks are independent
+#pragma omp parallel for schedule(static) proc_bind(close)
+        for (Nd4jIndex b = 0; b < numBlocks; b++) {
+            int idx = offsets[b];
+            if (idx >= limit)
+                continue;
+
+            Nd4jIndex start = b * THRESHOLD_BLOCK_SIZE;
+            Nd4jIndex end = nd4j::math::nd4j_min<Nd4jIndex>(N, start + THRESHOLD_BLOCK_SIZE);
+
+            for (Nd4jIndex e = start; e < end && idx < limit; e++) {
+                T val = dx[e];
+                if (nd4j::math::nd4j_abs<T>(val) >= tt) {
+                    if (val > (T) 0.0f) {
+                        dz[4 + idx++] = (int) e + 1;
+                        dx[e] = val - tt;
+                    } else {
+                        dz[4 + idx++] = -((int) e + 1);
+                        dx[e] = val + tt;
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    int SpecialMethods<T>::encodeThresholdGeneric(T *dx, Nd4jIndex N, int *dz) {
+        FloatBits2 fb;
+        fb.i_ = dz[2];
+
+        // FIXME: int limit is sad thing here, 2B elements limitation
+        dz[1] = (int) N;
+
+        Nd4jIndex numBlocks = N / THRESHOLD_BLOCK_SIZE + (N % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+        std::vector<int> counts(numBlocks + 1);
+
+        encodeThresholdP1Generic(dx, N, counts.data(), fb.f_);
+        int total = counts[0];
+
+        encodeThresholdP2Generic(counts.data() + 1, numBlocks, counts.data() + 1);
+        encodeThresholdP3Generic(dx, counts.data() + 1, N, dz);
+
+        return nd4j::math::nd4j_min<int>(total, dz[0]);
+    }
+
+    template<typename T>
+    void SpecialMethods<T>::decodeThresholdGeneric(void *dx, Nd4jIndex N, T *dz) {
+        int *x = (int *) dx;
+        int limit = x[0];
+        FloatBits2 fb;
+        fb.i_ = x[2];
+        T tt = (T) fb.f_;
+
+        // encoded indices are unique, so updates never collide
+#pragma omp parallel for schedule(static) proc_bind(close)
+        for (int e = 4; e < limit + 4; e++) {
+            int el = x[e];
+            if (el == 0)
+                continue;
+
+            int ael = nd4j::math::nd4j_abs<int>(el) - 1;
+            dz[ael] += el > 0 ? tt : -tt;
+        }
+    }
+
     template class ND4J_EXPORT SpecialMethods<float>;
     template class ND4J_EXPORT SpecialMethods<float16>;
     template class ND4J_EXPORT SpecialMethods<double>;
@@ -11,6 +11,15 @@
 #define TAD_THRESHOLD 2
 #endif
 
+// number of elements covered by one counter of threshold encoder, the same as block size used by cuda encoder
+#define THRESHOLD_BLOCK_SIZE 1024
+
+// arrays shorter than this are sorted with comparison sort, radix sort doesn't pay off there
+#define SORT_RADIX_THRESHOLD 256
+
+// arrays shorter than this are sorted by single thread
+#define SORT_PARALLEL_THRESHOLD 65536
+
 
 namespace nd4j {
     //FIXME: get rid of this redefinition
@@ -39,8 +48,35 @@ namespace nd4j {
         static void sortGeneric(T *x, int *xShapeInfo, bool descending);
         static void sortTadGeneric(T *x, int *xShapeInfo, int *dimension, int dimensionLength, int *tadShapeInfo, Nd4jIndex *tadOffsets, bool descending);
 
+        /**
+         * This method writes into indices positions of x elements in sorted order. x itself isn't modified.
+         * Sort is stable, so equal elements keep their original order.
+         */
+        static void argsortGeneric(T *x, int *xShapeInfo, Nd4jIndex *indices, bool descending);
+
+        /**
+         * This method sorts x, and applies the same permutation to y
+         */
+        static void sortByKeyGeneric(T *x, int *xShapeInfo, T *y, int *yShapeInfo, bool descending);
+
         static void decodeBitmapGeneric(void *dx, Nd4jIndex N, T *dz);
         static Nd4jIndex encodeBitmapGeneric(T *dx, Nd4jIndex N, int *dz, float threshold);
+
+        /**
+         * Threshold encoding is done in 3 phases, so encoded indices are always sorted, and no atomics are involved:
+         * P1 counts eligible elements per THRESHOLD_BLOCK_SIZE block: dz[0] is total, dz[b + 1] is count for block b
+         * P2 is exclusive prefix sum over block counts, which gives write offset for each block
+         * P3 writes signed 1-based indices of eligible elements, starting at dz[4], and subtracts threshold from them
+         *
+         * Encoded buffer header is: [limit, N, threshold bits, reserved]
+         */
+        static void encodeThresholdP1Generic(T *dx, Nd4jIndex N, int *dz, float threshold);
+        static void encodeThresholdP2Generic(int *dx, Nd4jIndex N, int *dz);
+        static void encodeThresholdP3Generic(T *dx, int *offsets, Nd4jIndex N, int *dz);
+
+        // all 3 phases at once, threshold & limit are taken from dz header. returns number of encoded elements
+        static int encodeThresholdGeneric(T *dx, Nd4jIndex N, int *dz);
+        static void decodeThresholdGeneric(void *dx, Nd4jIndex N, T *dz);
     };
 }
 
@@ -0,0 +1,201 @@
+//
+// Hogwild batched word2vec training on top of HierarchicSoftmax/NegativeSampling aggregates
+//
+
+#ifndef LIBND4J_WORD2VEC_H
+#define LIBND4J_WORD2VEC_H
+
+#include <ops/aggregate_ops.h>
+#include <pointercast.h>
+#include <vector>
+#include <algorithm>
+#include <omp.h>
+
+// minimal number of samples per thread, smaller batches are processed with fewer threads
+#define W2V_MIN_SAMPLES_PER_THREAD 64
+
+namespace nd4j {
+
+    /**
+     * Batched word2vec trainer. syn0/syn1/syn1Neg are [vocabSize x vectorLength] row-major, exactly the same layout SkipGram & CBOW aggregates use,
+     * and each sample goes through the same HierarchicSoftmax/NegativeSampling math, so both can be mixed on the same weights.
+     *
+     * Differences vs batch of aggregates:
+     * - samples are split between threads, weights are updated Hogwild-style, without any locks
+     * - each thread allocates its neu1/neu1e scratch once per batch
+     * - negative sampling RNG state is per thread and carries over between samples, like in original word2vec
+     *
+     * Huffman tree is passed once for the whole vocabulary: codes & points are [vocabSize x maxCodeLength], codeLengths is [vocabSize].
+     * Passing nullptr as codes disables hierarchic softmax, negative = 0 disables negative sampling.
+     */
+    template <typename T>
+    class Word2Vec {
+    private:
+        static inline void negativeRounds(T **args, int *idxArgs, T *syn1Neg, T *negTable, T *alpha, int word, int negative, int vocabSize, int negTableLength, int vectorLength, unsigned long long &nextRandom) {
+            int target = word;
+            for (int r = 0; r < negative + 1; r++) {
+                if (r == 0) {
+                    idxArgs[2] = 1;
+                } else {
+                    nextRandom = nextRandom * (unsigned long long) 25214903917 + 11;
+                    target = negTable[(nextRandom >> 16) % negTableLength];
+
+                    if (target <= 0 || target >= vocabSize) target = nextRandom % (vocabSize - 1) + 1;
+                    if (target == word)
+                        continue;
+
+                    idxArgs[2] = 0;
+                }
+
+                args[1] = syn1Neg + ((Nd4jIndex) target * vectorLength);
+                aggregateOps::NegativeSampling<T>::executeAggregate(args, 4, nullptr, 0, idxArgs, 4, nullptr, 0, alpha, 1);
+            }
+        }
+
+        static inline void hsRounds(T **args, int *idxArgs, T *syn1, int *codes, int *points, int *codeLengths, int maxCodeLength, T *alpha, int word, int vectorLength) {
+            int *wordCodes = codes + (Nd4jIndex) word * maxCodeLength;
+            int *wordPoints = points + (Nd4jIndex) word * maxCodeLength;
+            for (int r = 0; r < codeLengths[word]; r++) {
+                args[1] = syn1 + ((Nd4jIndex) wordPoints[r] * vectorLength);
+                idxArgs[2] = wordCodes[r];
+                aggregateOps::HierarchicSoftmax<T>::executeAggregate(args, 4, nullptr, 0, idxArgs, 4, nullptr, 0, alpha, 1);
+            }
+        }
+
+        static inline int numThreads(Nd4jIndex numSamples) {
+            Nd4jIndex threads = numSamples / W2V_MIN_SAMPLES_PER_THREAD;
+            return (int) nd4j::math::nd4j_max<Nd4jIndex>(1, nd4j::math::nd4j_min<Nd4jIndex>(threads, omp_get_max_threads()));
+        }
+
+    public:
+        /**
+         * Skip-gram over (word, context) pairs: syn0 row of context is trained against word, same as SkipGram aggregate with syn0Row = context.
+         *
+         * @return number of trained pairs, pairs with negative indices are skipped
+         */
+        static Nd4jIndex skipGram(T *syn0, T *syn1, T *syn1Neg, T *expTable, T *negTable, int *words, int *contexts, Nd4jIndex numPairs,
+                                  int *codes, int *points, int *codeLengths, int maxCodeLength,
+                                  int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, T alpha, unsigned long long seed) {
+
+            Nd4jIndex processed = 0;
+
+#pragma omp parallel num_threads(numThreads(numPairs)) default(shared)
+            {
+                std::vector<T> neu1e(vectorLength);
+                unsigned long long nextRandom = seed + (unsigned long long) omp_get_thread_num();
+
+                T *args[4];
+                int idxArgs[4] = {vectorLength, expLength, 0, 0};
+                args[2] = expTable;
+                args[3] = neu1e.data();
+
+#pragma omp for schedule(static) reduction(+:processed)
+                for (Nd4jIndex e = 0; e < numPairs; e++) {
+                    int word = words[e];
+                    int context = contexts[e];
+                    if (word < 0 || context < 0)
+                        continue;
+
+                    T *l1 = syn0 + ((Nd4jIndex) context * vectorLength);
+                    args[0] = l1;
+                    std::fill(neu1e.begin(), neu1e.end(), (T) 0.0f);
+
+                    if (codes != nullptr)
+                        hsRounds(args, idxArgs, syn1, codes, points, codeLengths, maxCodeLength, &alpha, word, vectorLength);
+
+                    if (negative > 0)
+                        negativeRounds(args, idxArgs, syn1Neg, negTable, &alpha, word, negative, vocabSize, negTableLength, vectorLength, nextRandom);
+
+                    T *error = neu1e.data();
+#pragma omp simd
+                    for (int x = 0; x < vectorLength; x++)
+                        l1[x] += error[x];
+
+                    processed++;
+                }
+            }
+
+            return processed;
+        }
+
+        /**
+         * CBOW: contexts is [numSamples x contextWidth], rows are padded with negative indices. Same math as CBOW aggregate with trainWords = 1.
+         *
+         * @return number of trained samples, samples with negative word or without any context are skipped
+         */
+        static Nd4jIndex cbow(T *syn0, T *syn1, T *syn1Neg, T *expTable, T *negTable, int *words, int *contexts, int contextWidth, Nd4jIndex numSamples,
+                              int *codes, int *points, int *codeLengths, int maxCodeLength,
+                              int vectorLength, int vocabSize, int expLength, int negTableLength, int negative, T alpha, unsigned long long seed) {
+
+            Nd4jIndex processed = 0;
+
+#pragma omp parallel num_threads(numThreads(numSamples)) default(shared)
+            {
+                std::vector<T> neu1(vectorLength);
+                std::vector<T> neu1e(vectorLength);
+                unsigned long long nextRandom = seed + (unsigned long long) omp_get_thread_num();
+
+                T *args[4];
+                int idxArgs[4] = {vectorLength, expLength, 0, 0};
+                args[0] = neu1.data();
+                args[2] = expTable;
+                args[3] = neu1e.data();
+
+#pragma omp for schedule(static) reduction(+:processed)
+                for (Nd4jIndex e = 0; e < numSamples; e++) {
+                    int word = words[e];
+                    int *context = contexts + e * contextWidth;
+                    if (word < 0)
+                        continue;
+
+                    T *hidden = neu1.data();
+                    T *error = neu1e.data();
+                    std::fill(neu1.begin(), neu1.end(), (T) 0.0f);
+                    std::fill(neu1e.begin(), neu1e.end(), (T) 0.0f);
+
+                    int count = 0;
+                    for (int c = 0; c < contextWidth; c++) {
+                        if (context[c] < 0)
+                            continue;
+
+                        T *syn0word = syn0 + ((Nd4jIndex) context[c] * vectorLength);
+#pragma omp simd
+                        for (int x = 0; x < vectorLength; x++)
+                            hidden[x] += syn0word[x];
+
+                        count++;
+                    }
+
+                    if (count == 0)
+                        continue;
+
+#pragma omp simd
+                    for (int x = 0; x < vectorLength; x++)
+                        hidden[x] /= count;
+
+                    if (codes != nullptr)
+                        hsRounds(args, idxArgs, syn1, codes, points, codeLengths, maxCodeLength, &alpha, word, vectorLength);
+
+                    if (negative > 0)
+                        negativeRounds(args, idxArgs, syn1Neg, negTable, &alpha, word, negative, vocabSize, negTableLength, vectorLength, nextRandom);
+
+                    for (int c = 0; c < contextWidth; c++) {
+                        if (context[c] < 0)
+                            continue;
+
+                        T *syn0word = syn0 + ((Nd4jIndex) context[c] * vectorLength);
+#pragma omp simd
+                        for (int x = 0; x < vectorLength; x++)
+                            syn0word[x] += error[x];
+                    }
+
+                    processed++;
+                }
+            }
+
+            return processed;
+        }
+    };
+}
+
+#endif //LIBND4J_WORD2VEC_H
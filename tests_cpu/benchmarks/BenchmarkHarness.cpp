@@ -0,0 +1,306 @@
+#include "BenchmarkHarness.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace nd4j {
+    namespace benchmarks {
+
+        std::string BenchmarkResult::key() const {
+            return suite + "/" + name + "/" + params;
+        }
+
+        double BenchmarkResult::gbps() const {
+            // bytes per microsecond * 1e-3 = GB/s
+            return medianTime > 0.0 ? (double) bytes / medianTime / 1000.0 : 0.0;
+        }
+
+        double BenchmarkResult::gflops() const {
+            return medianTime > 0.0 ? (double) flops / medianTime / 1000.0 : 0.0;
+        }
+
+        void Harness::setWarmup(int warmup) {
+            _warmup = warmup < 0 ? 0 : warmup;
+        }
+
+        void Harness::setIterations(int iterations) {
+            _iterations = iterations < 1 ? 1 : iterations;
+        }
+
+        void Harness::setFilter(const std::string &filter) {
+            _filter = filter;
+        }
+
+        void Harness::setResources(const std::string &path) {
+            _resources = path;
+        }
+
+        void Harness::setBlasLibrary(const std::string &path) {
+            _blasLibrary = path;
+        }
+
+        const std::string& Harness::resources() const {
+            return _resources;
+        }
+
+        const std::string& Harness::blasLibrary() const {
+            return _blasLibrary;
+        }
+
+        bool Harness::matches(const std::string &suite, const std::string &name, const std::string &params) const {
+            if (_filter.empty())
+                return true;
+
+            return (suite + "/" + name + "/" + params).find(_filter) != std::string::npos;
+        }
+
+        static double percentile(const std::vector<double> &sorted, double p) {
+            // nearest-rank percentile
+            auto rank = (int) std::ceil(p / 100.0 * sorted.size());
+            rank = std::max<int>(1, std::min<int>(rank, (int) sorted.size()));
+            return sorted[rank - 1];
+        }
+
+        void Harness::run(const std::string &suite, const std::string &name, const std::string &params, Nd4jIndex bytes, Nd4jIndex flops, std::function<void()> body, std::function<void()> setup) {
+            if (!matches(suite, name, params))
+                return;
+
+            BenchmarkResult result;
+            result.suite = suite;
+            result.name = name;
+            result.params = params;
+            result.bytes = bytes;
+            result.flops = flops;
+
+            std::vector<double> times;
+            try {
+                for (int e = 0; e < _warmup; e++) {
+                    if (setup)
+                        setup();
+
+                    body();
+                }
+
+                for (int e = 0; e < _iterations; e++) {
+                    if (setup)
+                        setup();
+
+                    auto timeStart = std::chrono::steady_clock::now();
+                    body();
+                    auto timeEnd = std::chrono::steady_clock::now();
+
+                    times.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count() / 1000.0);
+                }
+            } catch (const char *message) {
+                result.status = "failed";
+                result.reason = message;
+            } catch (std::exception &e) {
+                result.status = "failed";
+                result.reason = e.what();
+            }
+
+            if (result.status == "ok") {
+                std::sort(times.begin(), times.end());
+
+                double total = 0.0;
+                for (auto v: times)
+                    total += v;
+
+                result.iterations = (int) times.size();
+                result.minTime = times.front();
+                result.medianTime = percentile(times, 50);
+                result.p99Time = percentile(times, 99);
+                result.meanTime = total / times.size();
+            }
+
+            _results.push_back(result);
+
+            // progress goes to stderr, so stdout stays clean for the table
+            fprintf(stderr, "%s: %s\n", result.key().c_str(), result.status.c_str());
+        }
+
+        void Harness::skip(const std::string &suite, const std::string &name, const std::string &params, const std::string &reason) {
+            if (!matches(suite, name, params))
+                return;
+
+            BenchmarkResult result;
+            result.suite = suite;
+            result.name = name;
+            result.params = params;
+            result.status = "skipped";
+            result.reason = reason;
+
+            _results.push_back(result);
+        }
+
+        const std::vector<BenchmarkResult>& Harness::results() const {
+            return _results;
+        }
+
+        void Harness::print() const {
+            printf("%-10s %-28s %-28s %8s %12s %12s %12s %10s %10s\n", "suite", "name", "params", "iters", "min, us", "median, us", "p99, us", "GB/s", "GFLOP/s");
+            for (auto &r: _results) {
+                if (r.status != "ok") {
+                    printf("%-10s %-28s %-28s %s: %s\n", r.suite.c_str(), r.name.c_str(), r.params.c_str(), r.status.c_str(), r.reason.c_str());
+                    continue;
+                }
+
+                printf("%-10s %-28s %-28s %8i %12.1f %12.1f %12.1f %10.3f %10.3f\n", r.suite.c_str(), r.name.c_str(), r.params.c_str(), r.iterations, r.minTime, r.medianTime, r.p99Time, r.gbps(), r.gflops());
+            }
+            fflush(stdout);
+        }
+
+        static void appendString(std::stringstream &stream, const char *key, const std::string &value) {
+            stream << "\"" << key << "\":\"";
+            for (auto c: value) {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if ((unsigned char) c < 0x20)
+                    stream << ' ';
+                else
+                    stream << c;
+            }
+            stream << "\"";
+        }
+
+        std::string Harness::toJson(const BenchmarkResult &result) {
+            std::stringstream stream;
+            stream.precision(9);
+
+            stream << "{";
+            appendString(stream, "suite", result.suite);
+            stream << ",";
+            appendString(stream, "name", result.name);
+            stream << ",";
+            appendString(stream, "params", result.params);
+            stream << ",";
+            appendString(stream, "status", result.status);
+            stream << ",";
+            appendString(stream, "reason", result.reason);
+            stream << ",\"iterations\":" << result.iterations;
+            stream << ",\"min_us\":" << result.minTime << ",\"median_us\":" << result.medianTime << ",\"p99_us\":" << result.p99Time << ",\"mean_us\":" << result.meanTime;
+            stream << ",\"bytes\":" << result.bytes << ",\"flops\":" << result.flops;
+            stream << ",\"gbps\":" << result.gbps() << ",\"gflops\":" << result.gflops();
+            stream << "}";
+
+            return stream.str();
+        }
+
+        /**
+         * Minimal reader for lines written by toJson(): flat object of strings & numbers
+         */
+        static bool readValue(const std::string &line, const std::string &key, std::string &value) {
+            auto pos = line.find("\"" + key + "\":");
+            if (pos == std::string::npos)
+                return false;
+
+            pos += key.size() + 3;
+            value.clear();
+            if (pos < line.size() && line[pos] == '"') {
+                for (pos++; pos < line.size() && line[pos] != '"'; pos++) {
+                    if (line[pos] == '\\' && pos + 1 < line.size())
+                        pos++;
+
+                    value += line[pos];
+                }
+            } else {
+                for (; pos < line.size() && line[pos] != ',' && line[pos] != '}'; pos++)
+                    value += line[pos];
+            }
+
+            return true;
+        }
+
+        bool Harness::fromJson(const std::string &line, BenchmarkResult &result) {
+            std::string value;
+            if (!readValue(line, "suite", result.suite) || !readValue(line, "name", result.name) || !readValue(line, "params", result.params))
+                return false;
+
+            readValue(line, "status", result.status);
+            readValue(line, "reason", result.reason);
+
+            if (readValue(line, "iterations", value))
+                result.iterations = atoi(value.c_str());
+
+            if (readValue(line, "min_us", value))
+                result.minTime = atof(value.c_str());
+
+            if (readValue(line, "median_us", value))
+                result.medianTime = atof(value.c_str());
+
+            if (readValue(line, "p99_us", value))
+                result.p99Time = atof(value.c_str());
+
+            if (readValue(line, "mean_us", value))
+                result.meanTime = atof(value.c_str());
+
+            if (readValue(line, "bytes", value))
+                result.bytes = atoll(value.c_str());
+
+            if (readValue(line, "flops", value))
+                result.flops = atoll(value.c_str());
+
+            return true;
+        }
+
+        bool Harness::writeJson(const std::string &fileName) const {
+            FILE *fp = fopen(fileName.c_str(), "wb");
+            if (fp == nullptr)
+                return false;
+
+            for (auto &r: _results) {
+                auto line = toJson(r);
+                fprintf(fp, "%s\n", line.c_str());
+            }
+
+            fclose(fp);
+            return true;
+        }
+
+        std::vector<BenchmarkResult> Harness::readJson(const std::string &fileName) {
+            std::vector<BenchmarkResult> result;
+
+            std::ifstream file(fileName);
+            std::string line;
+            while (std::getline(file, line)) {
+                BenchmarkResult r;
+                if (fromJson(line, r))
+                    result.push_back(r);
+            }
+
+            return result;
+        }
+
+        int Harness::compare(const std::string &baseline, const std::string &candidate, double tolerance) {
+            auto oldResults = readJson(baseline);
+            auto newResults = readJson(candidate);
+
+            std::map<std::string, BenchmarkResult> oldMap;
+            for (auto &r: oldResults)
+                oldMap[r.key()] = r;
+
+            int regressions = 0;
+            printf("%-70s %12s %12s %9s\n", "benchmark", "old, us", "new, us", "ratio");
+            for (auto &r: newResults) {
+                auto it = oldMap.find(r.key());
+                if (it == oldMap.end() || r.status != "ok" || it->second.status != "ok" || it->second.medianTime <= 0.0)
+                    continue;
+
+                double ratio = r.medianTime / it->second.medianTime;
+                bool regression = ratio > 1.0 + tolerance;
+                if (regression)
+                    regressions++;
+
+                printf("%-70s %12.1f %12.1f %9.3f%s\n", r.key().c_str(), it->second.medianTime, r.medianTime, ratio, regression ? "  REGRESSION" : "");
+            }
+            fflush(stdout);
+
+            return regressions;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef LIBND4J_BENCHMARKHARNESS_H
+#define LIBND4J_BENCHMARKHARNESS_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <pointercast.h>
+
+namespace nd4j {
+    namespace benchmarks {
+
+        /**
+         * Single benchmark measurement. Times are in microseconds, throughput is derived from bytes/flops declared by benchmark
+         */
+        struct BenchmarkResult {
+            std::string suite;
+            std::string name;
+            std::string params;
+
+            int iterations = 0;
+
+            double minTime = 0.0;
+            double medianTime = 0.0;
+            double p99Time = 0.0;
+            double meanTime = 0.0;
+
+            Nd4jIndex bytes = 0;
+            Nd4jIndex flops = 0;
+
+            // status of benchmark: "ok", "skipped" or "failed"
+            std::string status = "ok";
+            std::string reason;
+
+            std::string key() const;
+
+            double gbps() const;
+            double gflops() const;
+        };
+
+        /**
+         * Runs benchmarks with warmup & repetitions, keeps results and exports them as JSON lines, one result per line.
+         * JSON lines from different builds can be compared with compare()
+         */
+        class Harness {
+        protected:
+            int _warmup = 3;
+            int _iterations = 25;
+            std::string _filter;
+            std::string _resources = "../resources";
+            std::string _blasLibrary;
+
+            std::vector<BenchmarkResult> _results;
+        public:
+            Harness() = default;
+            ~Harness() = default;
+
+            void setWarmup(int warmup);
+            void setIterations(int iterations);
+            void setFilter(const std::string &filter);
+            void setResources(const std::string &path);
+            void setBlasLibrary(const std::string &path);
+
+            const std::string& resources() const;
+            const std::string& blasLibrary() const;
+
+            /**
+             * Benchmark is executed only if filter is empty, or it's substring of "suite/name/params"
+             */
+            bool matches(const std::string &suite, const std::string &name, const std::string &params) const;
+
+            /**
+             * Times body over warmup + iterations runs. Setup, if any, is called before every run and isn't timed.
+             * Any exception thrown marks benchmark as failed.
+             *
+             * @param bytes - bytes moved by single run, used for GB/s
+             * @param flops - floating point ops of single run, used for GFLOP/s
+             */
+            void run(const std::string &suite, const std::string &name, const std::string &params, Nd4jIndex bytes, Nd4jIndex flops, std::function<void()> body, std::function<void()> setup = nullptr);
+
+            /**
+             * Records benchmark that can't be executed in this build, i.e. op without benchmark spec or missing BLAS
+             */
+            void skip(const std::string &suite, const std::string &name, const std::string &params, const std::string &reason);
+
+            const std::vector<BenchmarkResult>& results() const;
+
+            /**
+             * Prints human-readable results table to stdout
+             */
+            void print() const;
+
+            static std::string toJson(const BenchmarkResult &result);
+            static bool fromJson(const std::string &line, BenchmarkResult &result);
+
+            bool writeJson(const std::string &fileName) const;
+            static std::vector<BenchmarkResult> readJson(const std::string &fileName);
+
+            /**
+             * Compares median times of benchmarks present in both files. Returns number of benchmarks slower than (1 + tolerance) of baseline
+             */
+            static int compare(const std::string &baseline, const std::string &candidate, double tolerance);
+        };
+
+        void runLoopsBenchmarks(Harness &harness);
+        void runOpsBenchmarks(Harness &harness);
+        void runGemmBenchmarks(Harness &harness);
+        void runGraphBenchmarks(Harness &harness);
+    }
+}
+
+#endif //LIBND4J_BENCHMARKHARNESS_H
@@ -0,0 +1,76 @@
+#include "BenchmarkHarness.h"
+#include <helpers/BlasHelper.h>
+#include <ops/gemm.h>
+#include <vector>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+namespace nd4j {
+    namespace benchmarks {
+
+        /**
+         * Looks up cblas functions either in explicitly given library, or in whatever is linked into this process,
+         * and passes them to BlasHelper, same way as java side does via NativeOps::initializeFunctions
+         */
+        static void initializeBlas(const std::string &library) {
+            Nd4jPointer functions[6] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+#ifndef _WIN32
+            void *handle = RTLD_DEFAULT;
+            if (!library.empty()) {
+                handle = dlopen(library.c_str(), RTLD_NOW | RTLD_GLOBAL);
+                if (handle == nullptr) {
+                    fprintf(stderr, "Unable to load BLAS library [%s]: %s\n", library.c_str(), dlerror());
+                    return;
+                }
+            }
+
+            const char *names[] = {"cblas_sgemv", "cblas_dgemv", "cblas_sgemm", "cblas_dgemm", "cblas_sgemm_batch", "cblas_dgemm_batch"};
+            for (int e = 0; e < 6; e++)
+                functions[e] = (Nd4jPointer) dlsym(handle, names[e]);
+#endif
+            BlasHelper::getInstance()->initializeFunctions(functions);
+        }
+
+        template <typename T>
+        static void runGemm(Harness &harness, const char *type, int M, int N, int K) {
+            std::vector<T> A((size_t) M * K), B((size_t) K * N), C((size_t) M * N);
+            for (size_t e = 0; e < A.size(); e++)
+                A[e] = (T) ((e % 13) * 0.1 - 0.6);
+
+            for (size_t e = 0; e < B.size(); e++)
+                B[e] = (T) ((e % 7) * 0.2 - 0.7);
+
+            auto params = std::string(type) + "/" + std::to_string(M) + "x" + std::to_string(N) + "x" + std::to_string(K);
+            Nd4jIndex bytes = ((Nd4jIndex) M * K + (Nd4jIndex) K * N + (Nd4jIndex) M * N) * sizeof(T);
+            Nd4jIndex flops = 2LL * M * N * K;
+
+            harness.run("gemm", "fallback", params, bytes, flops, [&] {
+                nd4j::blas::GEMM<T>::op(CblasColMajor, CblasNoTrans, CblasNoTrans, M, N, K, (T) 1.0, A.data(), M, B.data(), K, (T) 0.0, C.data(), M);
+            });
+
+            if (!BlasHelper::getInstance()->template hasGEMM<T>()) {
+                harness.skip("gemm", "blas", params, "BLAS isn't available");
+                return;
+            }
+
+            harness.run("gemm", "blas", params, bytes, flops, [&] {
+                if (sizeof(T) == sizeof(float))
+                    BlasHelper::getInstance()->sgemm()(CblasColMajor, CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, (float *) A.data(), M, (float *) B.data(), K, 0.0f, (float *) C.data(), M);
+                else
+                    BlasHelper::getInstance()->dgemm()(CblasColMajor, CblasNoTrans, CblasNoTrans, M, N, K, 1.0, (double *) A.data(), M, (double *) B.data(), K, 0.0, (double *) C.data(), M);
+            });
+        }
+
+        void runGemmBenchmarks(Harness &harness) {
+            initializeBlas(harness.blasLibrary());
+
+            std::vector<std::vector<int>> sizes = {{64, 64, 64}, {256, 256, 256}, {1024, 1024, 1024}, {2048, 64, 512}};
+            for (auto &s: sizes) {
+                runGemm<float>(harness, "float", s[0], s[1], s[2]);
+                runGemm<double>(harness, "double", s[0], s[1], s[2]);
+            }
+        }
+    }
+}
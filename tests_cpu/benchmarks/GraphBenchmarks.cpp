@@ -0,0 +1,56 @@
+#include "BenchmarkHarness.h"
+#include <GraphExecutioner.h>
+#include <ops/declarable/CustomOperations.h>
+#include <algorithm>
+#include <dirent.h>
+
+using namespace nd4j::graph;
+
+namespace nd4j {
+    namespace benchmarks {
+
+        static std::vector<std::string> flatGraphs(const std::string &path) {
+            std::vector<std::string> result;
+
+            DIR *dir = opendir(path.c_str());
+            if (dir == nullptr)
+                return result;
+
+            struct dirent *entry;
+            while ((entry = readdir(dir)) != nullptr) {
+                std::string name(entry->d_name);
+                if (name.size() > 3 && name.substr(name.size() - 3) == ".fb")
+                    result.push_back(name);
+            }
+            closedir(dir);
+
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        void runGraphBenchmarks(Harness &harness) {
+            auto files = flatGraphs(harness.resources());
+            if (files.empty())
+                fprintf(stderr, "No FlatGraphs found in [%s]\n", harness.resources().c_str());
+
+            for (auto &name: files) {
+                auto fileName = harness.resources() + "/" + name;
+
+                // execution modifies variable space, so every run gets freshly imported graph. import itself isn't timed
+                Graph<float> *graph = nullptr;
+                harness.run("graph", name, "float", 0, 0, [&] {
+                    auto status = GraphExecutioner<float>::execute(graph);
+                    if (status != ND4J_STATUS_OK)
+                        throw "graph execution failed";
+                }, [&] {
+                    delete graph;
+                    graph = GraphExecutioner<float>::importFromFlatBuffers(fileName.c_str());
+                    if (graph == nullptr)
+                        throw "graph import failed";
+                });
+
+                delete graph;
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#include "BenchmarkHarness.h"
+#include <NDArray.h>
+#include <ops/ops.h>
+#include <memory>
+
+namespace nd4j {
+    namespace benchmarks {
+
+        /**
+         * Holds array of given shape & layout. "c" and "f" are dense arrays, "strided" is c-ordered view with element-wise stride 2
+         */
+        class LoopsArray {
+        protected:
+            std::unique_ptr<NDArray<float>> _base;
+            std::unique_ptr<NDArray<float>> _view;
+            int _shapeInfo[8];
+        public:
+            LoopsArray(const std::string &layout, int rows, int cols) {
+                if (layout == "strided") {
+                    _base.reset(new NDArray<float>('c', {rows, cols * 2}));
+
+                    // rank, shape, strides, offset, ews, order
+                    int info[] = {2, rows, cols, cols * 2, 2, 0, 2, 99};
+                    std::copy(info, info + 8, _shapeInfo);
+
+                    _view.reset(new NDArray<float>(_base->getBuffer(), _shapeInfo));
+                } else {
+                    _view.reset(new NDArray<float>(layout[0], {rows, cols}));
+                }
+
+                for (int e = 0; e < _view->lengthOf(); e++)
+                    _view->putIndexedScalar(e, (float) ((e % 31) * 0.03 - 0.4));
+            }
+
+            NDArray<float>* array() {
+                return _view.get();
+            }
+        };
+
+        void runLoopsBenchmarks(Harness &harness) {
+            std::vector<std::vector<int>> shapes = {{256, 256}, {1024, 1024}, {64, 16384}};
+            std::vector<std::string> layouts = {"c", "f", "strided"};
+
+            for (auto &shape: shapes) {
+                int rows = shape[0];
+                int cols = shape[1];
+                Nd4jIndex length = (Nd4jIndex) rows * cols;
+                Nd4jIndex size = length * sizeof(float);
+
+                for (auto &layout: layouts) {
+                    auto params = std::to_string(rows) + "x" + std::to_string(cols) + "/" + layout;
+
+                    LoopsArray x(layout, rows, cols);
+                    LoopsArray y(layout, rows, cols);
+                    LoopsArray z(layout, rows, cols);
+                    NDArray<float> row('c', {1, cols});
+                    NDArray<float> tads('c', {1, rows});
+                    row.assign(0.5f);
+
+                    harness.run("loops", "transform/tanh", params, 2 * size, length, [&] {
+                        x.array()->template applyTransform<simdOps::Tanh<float>>(z.array(), nullptr);
+                    });
+
+                    harness.run("loops", "pairwise/add", params, 3 * size, length, [&] {
+                        x.array()->template applyPairwiseTransform<simdOps::Add<float>>(y.array(), z.array(), nullptr);
+                    });
+
+                    harness.run("loops", "broadcast/add", params, 2 * size + cols * sizeof(float), length, [&] {
+                        x.array()->template applyBroadcast<simdOps::Add<float>>({1}, &row, z.array(), nullptr);
+                    });
+
+                    harness.run("loops", "reduce/sum", params, size, length, [&] {
+                        x.array()->template reduceAlongDimension<simdOps::Sum<float>>(&tads, {1});
+                    });
+
+                    harness.run("loops", "reduce3/euclidean", params, 2 * size, 3 * length, [&] {
+                        std::unique_ptr<NDArray<float>> result(x.array()->template applyReduce3<simdOps::EuclideanDistance<float>>(y.array(), {1}));
+                    });
+
+                    harness.run("loops", "indexreduce/imax", params, size, length, [&] {
+                        std::unique_ptr<NDArray<float>> result(x.array()->template applyIndexReduce<simdOps::IndexMax<float>>({1}));
+                    });
+                }
+            }
+        }
+    }
+}
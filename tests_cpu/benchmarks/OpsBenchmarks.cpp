@@ -0,0 +1,204 @@
+#include "BenchmarkHarness.h"
+#include <NDArray.h>
+#include <ops/declarable/OpTuple.h>
+#include <ops/declarable/OpRegistrator.h>
+#include <ops/declarable/CustomOperations.h>
+#include <graph/OpProfiler.h>
+#include <memory>
+#include <set>
+
+namespace nd4j {
+    namespace benchmarks {
+
+        static NDArray<float>* input(const std::vector<int> &shape) {
+            auto array = new NDArray<float>('c', shape);
+            for (int e = 0; e < array->lengthOf(); e++)
+                array->putIndexedScalar(e, (float) ((e % 23) * 0.05 - 0.5));
+
+            return array;
+        }
+
+        static std::string shapesString(const std::vector<NDArray<float>*> &arrays) {
+            std::string result;
+            for (auto array: arrays) {
+                if (!result.empty())
+                    result += ",";
+
+                for (int e = 0; e < array->rankOf(); e++)
+                    result += (e > 0 ? "x" : "") + std::to_string(array->sizeAt(e));
+            }
+
+            return result;
+        }
+
+        /**
+         * Benchmark specs for custom ops: op name, inputs & arguments, same as OpTuple used in tests
+         */
+        static std::vector<nd4j::ops::OpTuple*> specs() {
+            std::vector<nd4j::ops::OpTuple*> result;
+
+            result.push_back(new nd4j::ops::OpTuple("matmul", {input({128, 128}), input({128, 128})}, {}, {}));
+            result.push_back(new nd4j::ops::OpTuple("matmul", {input({512, 512}), input({512, 512})}, {}, {}));
+            result.push_back(new nd4j::ops::OpTuple("softmax", {input({128, 1024})}, {}, {}));
+            result.push_back(new nd4j::ops::OpTuple("transpose", {input({1024, 1024})}, {}, {}));
+            result.push_back(new nd4j::ops::OpTuple("concat", {input({256, 512}), input({256, 512})}, {}, {1}));
+            result.push_back(new nd4j::ops::OpTuple("tile", {input({64, 64})}, {}, {4, 4}));
+
+            // NCHW input, [oC, iC, kH, kW] weights; kH, kW, sH, sW, pH, pW, dH, dW, same mode
+            result.push_back(new nd4j::ops::OpTuple("conv2d", {input({8, 16, 32, 32}), input({32, 16, 3, 3})}, {}, {3, 3, 1, 1, 0, 0, 1, 1, 1}));
+            result.push_back(new nd4j::ops::OpTuple("maxpool2d", {input({8, 16, 32, 32})}, {}, {2, 2, 2, 2, 0, 0, 1, 1, 0}));
+            result.push_back(new nd4j::ops::OpTuple("avgpool2d", {input({8, 16, 32, 32})}, {}, {2, 2, 2, 2, 0, 0, 1, 1, 0}));
+
+            // x, w, b, c0, mask
+            result.push_back(new nd4j::ops::OpTuple("sru", {input({16, 64, 32}), input({192, 64}), input({1, 128}), input({16, 64}), input({16, 64})}, {}, {}));
+
+            // x, h0, c0, Wx, Wh, Wc, Wp, b; clipping, projection clipping, forget bias; peephole, projection
+            result.push_back(new nd4j::ops::OpTuple("lstm", {input({16, 32, 64}), input({32, 64}), input({32, 128}), input({64, 512}), input({64, 512}), input({1, 384}), input({128, 64}), input({1, 512})}, {0.9f, 0.25f, 1.0f}, {1, 1}));
+
+            return result;
+        }
+
+        /**
+         * Default spec only makes sense for ops that take same-shaped inputs: legacy/configurable, boolean and reduction ops.
+         * Custom ops have arbitrary shape contracts, and aren't guaranteed to reject unexpected shapes gracefully,
+         * so they need explicit spec.
+         */
+        static bool hasDefaultSpec(nd4j::ops::DeclarableOp<float> *op) {
+            if (op->getOpDescriptor()->isDivergent())
+                return false;
+
+            return dynamic_cast<nd4j::ops::DeclarableCustomOp<float>*>(op) == nullptr
+                && dynamic_cast<nd4j::ops::DeclarableListOp<float>*>(op) == nullptr
+                && dynamic_cast<nd4j::ops::LogicOp<float>*>(op) == nullptr;
+        }
+
+        /**
+         * Default spec built from op descriptor, for ops without explicit spec: every input is 64x64 matrix,
+         * required T args are 0.5, required int args are 1. Variable number of inputs means 2 inputs.
+         * Ops rejecting such spec are reported as skipped.
+         */
+        static nd4j::ops::OpTuple* defaultSpec(nd4j::ops::DeclarableOp<float> *op) {
+            auto descriptor = op->getOpDescriptor();
+
+            int numInputs = descriptor->getNumberOfInputs();
+            if (numInputs < 0)
+                numInputs = 2;
+
+            int numTArgs = descriptor->getNumberOfTArgs() == -1 ? 1 : nd4j::math::nd4j_max<int>(0, descriptor->getNumberOfTArgs());
+            int numIArgs = descriptor->getNumberOfIArgs() == -1 ? 1 : nd4j::math::nd4j_max<int>(0, descriptor->getNumberOfIArgs());
+
+            // OpTuple doesn't own name, but op lives in registrator till process exit
+            auto spec = new nd4j::ops::OpTuple(op->getOpName()->c_str());
+            for (int e = 0; e < numInputs; e++)
+                spec->addInput(input({64, 64}));
+
+            spec->_tArgs = std::vector<float>(numTArgs, 0.5f);
+            spec->_iArgs = std::vector<int>(numIArgs, 1);
+
+            return spec;
+        }
+
+        /**
+         * Executes op once with given spec. Returns empty string on success, or reason of failure
+         */
+        static std::string probe(nd4j::ops::DeclarableOp<float> *op, nd4j::ops::OpTuple *spec, Nd4jIndex &bytes, Nd4jIndex &flops) {
+            std::unique_ptr<ResultSet<float>> result;
+            try {
+                result.reset(op->execute(spec->_inputs, spec->_tArgs, spec->_iArgs));
+            } catch (const char *message) {
+                return message;
+            } catch (std::exception &e) {
+                return e.what();
+            }
+
+            if (result->status() != ND4J_STATUS_OK)
+                return "op execution failed";
+
+            std::vector<std::vector<int>> inShapes, outShapes;
+            for (auto array: spec->_inputs) {
+                inShapes.push_back(array->getShapeAsVector());
+                bytes += array->lengthOf() * sizeof(float);
+            }
+
+            for (int e = 0; e < result->size(); e++) {
+                outShapes.push_back(result->at(e)->getShapeAsVector());
+                bytes += result->at(e)->lengthOf() * sizeof(float);
+            }
+
+            flops = nd4j::graph::OpProfiler::estimateFlops(*op->getOpName(), inShapes, outShapes);
+            return "";
+        }
+
+        static void benchmarkSpec(Harness &harness, nd4j::ops::OpTuple *spec, bool isDefault) {
+            std::string name(spec->_opName);
+            auto params = shapesString(spec->_inputs);
+            auto op = nd4j::ops::OpRegistrator::getInstance()->getOperationFloat(spec->_opName);
+            if (op == nullptr) {
+                harness.skip("ops", name, params, "op isn't registered");
+                return;
+            }
+
+            if (!harness.matches("ops", name, params))
+                return;
+
+            // flops estimate uses output shapes, so op is executed once upfront
+            Nd4jIndex flops = 0;
+            Nd4jIndex bytes = 0;
+            auto reason = probe(op, spec, bytes, flops);
+            if (!reason.empty()) {
+                harness.skip("ops", name, params, isDefault ? "default spec rejected: " + reason : reason);
+                return;
+            }
+
+            harness.run("ops", name, params, bytes, flops, [&] {
+                std::unique_ptr<ResultSet<float>> result(op->execute(spec->_inputs, spec->_tArgs, spec->_iArgs));
+                if (result->status() != ND4J_STATUS_OK)
+                    throw "op execution failed";
+            });
+        }
+
+        void runOpsBenchmarks(Harness &harness) {
+            auto registrator = nd4j::ops::OpRegistrator::getInstance();
+
+            std::set<std::string> covered;
+            auto list = specs();
+            for (auto spec: list) {
+                covered.insert(std::string(spec->_opName));
+                benchmarkSpec(harness, spec, false);
+                delete spec;
+            }
+
+            // every other registered op gets default spec derived from its descriptor, if its kind allows that
+            std::string ops(registrator->getAllCustomOperations());
+            size_t pos = 0;
+            while (pos < ops.size()) {
+                auto end = ops.find(';', pos);
+                if (end == std::string::npos)
+                    end = ops.size();
+
+                auto name = ops.substr(pos, ops.find(':', pos) - pos);
+                pos = end + 1;
+
+                if (name.empty() || covered.count(name) > 0)
+                    continue;
+
+                // synonyms resolve to the same op, so it's benchmarked once, under its own name
+                auto op = registrator->getOperationFloat(name);
+                if (op == nullptr || covered.count(*op->getOpName()) > 0)
+                    continue;
+
+                covered.insert(name);
+                covered.insert(*op->getOpName());
+
+                if (!hasDefaultSpec(op)) {
+                    harness.skip("ops", *op->getOpName(), "", "no benchmark spec");
+                    continue;
+                }
+
+                auto spec = defaultSpec(op);
+                benchmarkSpec(harness, spec, true);
+                delete spec;
+            }
+        }
+    }
+}
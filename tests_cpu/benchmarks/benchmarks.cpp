@@ -0,0 +1,84 @@
+#include "BenchmarkHarness.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace nd4j::benchmarks;
+
+static void usage() {
+    printf("Usage: benchmarks [options]\n"
+           "  --warmup N             warmup runs per benchmark, default 3\n"
+           "  --iterations N         timed runs per benchmark, default 25\n"
+           "  --filter S             run only benchmarks with S in \"suite/name/params\"\n"
+           "  --suites S             comma-separated suites to run: loops,ops,gemm,graph. default is all\n"
+           "  --output FILE          write results as JSON lines\n"
+           "  --resources DIR        directory with FlatGraphs, default ../resources\n"
+           "  --blas LIB             BLAS library to take cblas functions from\n"
+           "  --compare OLD NEW      compare two JSON lines files, exit code is number of regressions\n"
+           "  --tolerance X          relative slowdown reported as regression, default 0.05\n");
+}
+
+int main(int argc, char **argv) {
+    Harness harness;
+    std::string output;
+    std::string suites = "loops,ops,gemm,graph";
+    std::string baseline, candidate;
+    double tolerance = 0.05;
+
+    for (int e = 1; e < argc; e++) {
+        std::string arg(argv[e]);
+        bool hasValue = e + 1 < argc;
+
+        if (arg == "--warmup" && hasValue)
+            harness.setWarmup(atoi(argv[++e]));
+        else if (arg == "--iterations" && hasValue)
+            harness.setIterations(atoi(argv[++e]));
+        else if (arg == "--filter" && hasValue)
+            harness.setFilter(argv[++e]);
+        else if (arg == "--suites" && hasValue)
+            suites = argv[++e];
+        else if (arg == "--output" && hasValue)
+            output = argv[++e];
+        else if (arg == "--resources" && hasValue)
+            harness.setResources(argv[++e]);
+        else if (arg == "--blas" && hasValue)
+            harness.setBlasLibrary(argv[++e]);
+        else if (arg == "--tolerance" && hasValue)
+            tolerance = atof(argv[++e]);
+        else if (arg == "--compare" && e + 2 < argc) {
+            baseline = argv[++e];
+            candidate = argv[++e];
+        } else {
+            usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (!baseline.empty())
+        return Harness::compare(baseline, candidate, tolerance);
+
+    auto enabled = [&](const char *suite) -> bool {
+        return ("," + suites + ",").find(std::string(",") + suite + ",") != std::string::npos;
+    };
+
+    if (enabled("loops"))
+        runLoopsBenchmarks(harness);
+
+    if (enabled("ops"))
+        runOpsBenchmarks(harness);
+
+    if (enabled("gemm"))
+        runGemmBenchmarks(harness);
+
+    if (enabled("graph"))
+        runGraphBenchmarks(harness);
+
+    harness.print();
+
+    if (!output.empty() && !harness.writeJson(output)) {
+        fprintf(stderr, "Unable to write results to [%s]\n", output.c_str());
+        return 1;
+    }
+
+    return 0;
+}
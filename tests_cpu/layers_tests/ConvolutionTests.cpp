@@ -14,6 +14,7 @@
 #include <NDArrayFactory.h>
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/generic/helpers/convolutions.h>
+#include <ops/declarable/helpers/conv2d.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -967,5 +968,86 @@ TEST_F(ConvolutionTests, Test_Conv1D_ff_2) {
     delete result;
 }
 
+// all algorithms must give the same results as im2col path
+static void testConv2dAlgorithms(int bS, int iC, int iH, int iW, int oC, int kH, int kW, int sH, int sW, int pH, int pW, int dH, int dW, int isSameMode, std::vector<int> algorithms) {
+    NDArray<double> input('c', {bS, iC, iH, iW});
+    NDArray<double> weights('c', {oC, iC, kH, kW});
+    NDArray<double> bias('c', {1, oC});
+
+    for (int e = 0; e < input.lengthOf(); e++)
+        input.putScalar(e, (double) ((e * 37) % 19) / 19.0 - 0.5);
+
+    for (int e = 0; e < weights.lengthOf(); e++)
+        weights.putScalar(e, (double) ((e * 11) % 23) / 23.0 - 0.5);
+
+    NDArrayFactory<double>::linspace(0.1, bias, 0.1);
+
+    nd4j::ops::conv2d<double> op;
+    auto expected = op.execute({&input, &weights, &bias}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, CONV2D_ALGO_IM2COL});
+    ASSERT_EQ(ND4J_STATUS_OK, expected->status());
+
+    for (auto algorithm: algorithms) {
+        auto result = op.execute({&input, &weights, &bias}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, algorithm});
+        ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+        ASSERT_TRUE(expected->at(0)->isSameShape(result->at(0)));
+        ASSERT_TRUE(expected->at(0)->equalsTo(result->at(0)));
+
+        delete result;
+    }
+
+    delete expected;
+}
+
+TEST_F(ConvolutionTests, Conv2D_Algorithms_1) {
+    // 3x3 stride 1: all algorithms, odd output size for partial Winograd tiles
+    testConv2dAlgorithms(2, 8, 7, 9, 8, 3, 3, 1, 1, 1, 1, 1, 1, 0, {CONV2D_ALGO_AUTO, CONV2D_ALGO_DIRECT, CONV2D_ALGO_IMPLICIT_GEMM, CONV2D_ALGO_WINOGRAD});
+}
+
+TEST_F(ConvolutionTests, Conv2D_Algorithms_2) {
+    // strides, dilation & same mode
+    testConv2dAlgorithms(2, 3, 11, 10, 5, 3, 2, 2, 1, 0, 0, 2, 1, 1, {CONV2D_ALGO_AUTO, CONV2D_ALGO_DIRECT, CONV2D_ALGO_IMPLICIT_GEMM});
+}
+
+TEST_F(ConvolutionTests, Conv2D_Algorithms_3) {
+    // pointwise convolution
+    testConv2dAlgorithms(3, 16, 5, 5, 6, 1, 1, 1, 1, 0, 0, 1, 1, 0, {CONV2D_ALGO_AUTO, CONV2D_ALGO_DIRECT, CONV2D_ALGO_IMPLICIT_GEMM});
+}
+
+TEST_F(ConvolutionTests, Conv2D_BP_Algorithms_1) {
+    int bS = 2, iC = 3, iH = 7, iW = 6, oC = 4, kH = 3, kW = 3, sH = 2, sW = 1, pH = 1, pW = 0, dH = 1, dW = 2;
+    int oH = (iH + 2 * pH - ((kH - 1) * dH + 1)) / sH + 1;
+    int oW = (iW + 2 * pW - ((kW - 1) * dW + 1)) / sW + 1;
+
+    NDArray<double> input('c', {bS, iC, iH, iW});
+    NDArray<double> weights('c', {oC, iC, kH, kW});
+    NDArray<double> bias('c', {oC, 1});
+    NDArray<double> epsilonNext('c', {bS, oC, oH, oW});
+
+    for (int e = 0; e < input.lengthOf(); e++)
+        input.putScalar(e, (double) ((e * 37) % 19) / 19.0 - 0.5);
+
+    for (int e = 0; e < weights.lengthOf(); e++)
+        weights.putScalar(e, (double) ((e * 11) % 23) / 23.0 - 0.5);
+
+    for (int e = 0; e < epsilonNext.lengthOf(); e++)
+        epsilonNext.putScalar(e, (double) ((e * 7) % 13) / 13.0 - 0.5);
+
+    nd4j::ops::conv2d_bp<double> op;
+    auto expected = op.execute({&input, &weights, &bias, &epsilonNext}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, 0, CONV2D_ALGO_IM2COL});
+    auto result = op.execute({&input, &weights, &bias, &epsilonNext}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, 0});
+
+    ASSERT_EQ(ND4J_STATUS_OK, expected->status());
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    for (int e = 0; e < 3; e++) {
+        ASSERT_TRUE(expected->at(e)->isSameShape(result->at(e)));
+        ASSERT_TRUE(expected->at(e)->equalsTo(result->at(e)));
+    }
+
+    delete expected;
+    delete result;
+}
+
 
 #endif //LIBND4J_CONVOLUTIONTESTS_H
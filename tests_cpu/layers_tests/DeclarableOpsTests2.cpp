@@ -1,5 +1,6 @@
 #include "testlayers.h"
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/gather.h>
 #include <helpers/helper_hash.h>
 #include <NDArray.h>
 #include <array/NDArrayList.h>
@@ -125,6 +126,71 @@ TEST_F(DeclarableOpsTests2, Gather_test_5) {
 }
 
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests2, Gather_test_6) {
+    // contiguous rows, long enough for parallel copy
+    const int rows = 100;
+    const int columns = 40;
+    const int numIndices = 500;
+
+    NDArray<double> input('c', {rows, columns});
+    NDArray<double> indices('c', {1, numIndices});
+    NDArrayFactory<double>::linspace(1, input);
+
+    for (int e = 0; e < numIndices; e++)
+        indices.putScalar(e, (double) ((e * 37) % rows));
+
+    nd4j::ops::gather<double> op;
+    ResultSet<double>* result = op.execute({&input, &indices}, {}, {0});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    NDArray<double>* output = result->at(0);
+    ASSERT_EQ(numIndices, output->sizeAt(0));
+    ASSERT_EQ(columns, output->sizeAt(1));
+
+    for (int e = 0; e < numIndices; e++)
+        for (int c = 0; c < columns; c++)
+            ASSERT_NEAR(input.getScalar((e * 37) % rows, c), output->getScalar(e, c), 1e-10);
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests2, Gather_test_7) {
+    // int indices are passed to kernel as is
+    NDArray<float> input   ('c', {2,3,4}, {1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24});
+    NDArray<float> output  ('c', {2,2,4});
+    NDArray<float> expected('c', {2,2,4}, {9,10,11,12, 1,2,3,4, 21,22,23,24, 13,14,15,16});
+    int indices[] = {2, 0};
+
+    nd4j::ops::helpers::_gather<float, int>(input.getBuffer(), input.getShapeInfo(), output.getBuffer(), output.getShapeInfo(), 1, indices, 2);
+
+    ASSERT_TRUE(expected.equalsTo(&output));
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests2, EmbeddingBag_test_1) {
+    NDArray<float> table   ('c', {4, 3}, {1, 2, 3, 10, 20, 30, 100, 200, 300, 5, 5, 5});
+    NDArray<float> indices ('c', {3, 2}, {0, 1, 2, 2, 3, -1});
+    NDArray<float> expSum  ('c', {3, 3}, {11, 22, 33, 200, 400, 600, 5, 5, 5});
+    NDArray<float> expMean ('c', {3, 3}, {5.5, 11, 16.5, 100, 200, 300, 5, 5, 5});
+
+    nd4j::ops::embedding_bag<float> op;
+
+    auto result = op.execute({&table, &indices}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_TRUE(expSum.isSameShape(result->at(0)));
+    ASSERT_TRUE(expSum.equalsTo(result->at(0)));
+
+    auto result2 = op.execute({&table, &indices}, {}, {1});
+    ASSERT_EQ(ND4J_STATUS_OK, result2->status());
+    ASSERT_TRUE(expMean.equalsTo(result2->at(0)));
+
+    delete result;
+    delete result2;
+}
+
 TEST_F(DeclarableOpsTests2, YetAnotherMatmulTest_1) {
     NDArray<float> A('c', {3, 3});
     NDArray<float> B('c', {3, 1});
@@ -4217,3 +4283,128 @@ TEST_F(DeclarableOpsTests2, lstmCell_test12) {
 
     delete results;
 }
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests2, lstm_test1) {
+
+    const int time      = 4;
+    const int batchSize = 2;
+    const int inSize    = 5;
+    const int numProj   = 2;
+    const int numUnits  = 3;
+
+    NDArray<double> x   ('c', {time, batchSize, inSize});
+    NDArray<double> h0  ('c', {batchSize, numProj});
+    NDArray<double> c0  ('c', {batchSize, numUnits});
+    NDArray<double> Wx  ('c', {inSize, 4*numUnits});
+    NDArray<double> Wh  ('c', {numProj, 4*numUnits});
+    NDArray<double> Wc  ('c', {1, 3*numUnits});
+    NDArray<double> Wp  ('c', {numUnits, numProj});
+    NDArray<double> b   ('c', {1, 4*numUnits});
+
+    std::vector<NDArray<double>*> inputs({&x, &h0, &c0, &Wx, &Wh, &Wc, &Wp, &b});
+    for (int i = 0; i < (int) inputs.size(); i++)
+        for (int e = 0; e < inputs[i]->lengthOf(); e++)
+            inputs[i]->putScalar(e, 0.8 * sin(0.7 * e + 1.3 * i));
+
+    nd4j::ops::lstm<double> op;
+    nd4j::ops::lstmCell<double> cell;
+    nd4j::ResultSet<double>* results = op.execute({&x, &h0, &c0, &Wx, &Wh, &Wc, &Wp, &b}, {0.9, 0.25, 1.}, {1, 1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    NDArray<double> *h = results->at(0);
+    NDArray<double> *c = results->at(1);
+
+    ASSERT_TRUE(h->isSameShape({time, batchSize, numProj}));
+    ASSERT_TRUE(c->isSameShape({time, batchSize, numUnits}));
+
+    NDArray<double> ht_1(h0);
+    NDArray<double> ct_1(c0);
+    NDArray<double> xt('c', {batchSize, inSize});
+
+    for (int t = 0; t < time; t++) {
+        for (int e = 0; e < xt.lengthOf(); e++)
+            xt.putScalar(e, x.getScalar(t * batchSize * inSize + e));
+
+        nd4j::ResultSet<double>* step = cell.execute({&xt, &ht_1, &ct_1, &Wx, &Wh, &Wc, &Wp, &b}, {0.9, 0.25, 1.}, {1, 1});
+        ASSERT_EQ(ND4J_STATUS_OK, step->status());
+
+        for (int e = 0; e < batchSize * numProj; e++)
+            ASSERT_NEAR(step->at(0)->getScalar(e), h->getScalar(t * batchSize * numProj + e), 1e-10);
+
+        for (int e = 0; e < batchSize * numUnits; e++)
+            ASSERT_NEAR(step->at(1)->getScalar(e), c->getScalar(t * batchSize * numUnits + e), 1e-10);
+
+        ht_1.assign(step->at(0));
+        ct_1.assign(step->at(1));
+
+        delete step;
+    }
+
+    delete results;
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests2, lstm_bp_test1) {
+
+    const int time      = 3;
+    const int batchSize = 2;
+    const int inSize    = 3;
+    const int numProj   = 3;
+    const int numUnits  = 2;
+
+    NDArray<double> x   ('c', {time, batchSize, inSize});
+    NDArray<double> h0  ('c', {batchSize, numProj});
+    NDArray<double> c0  ('c', {batchSize, numUnits});
+    NDArray<double> Wx  ('c', {inSize, 4*numUnits});
+    NDArray<double> Wh  ('c', {numProj, 4*numUnits});
+    NDArray<double> Wc  ('c', {1, 3*numUnits});
+    NDArray<double> Wp  ('c', {numUnits, numProj});
+    NDArray<double> b   ('c', {1, 4*numUnits});
+    NDArray<double> dLdh('c', {time, batchSize, numProj});
+
+    std::vector<NDArray<double>*> inputs({&x, &h0, &c0, &Wx, &Wh, &Wc, &Wp, &b});
+    for (int i = 0; i < (int) inputs.size(); i++)
+        for (int e = 0; e < inputs[i]->lengthOf(); e++)
+            inputs[i]->putScalar(e, 0.8 * sin(0.7 * e + 1.3 * i));
+
+    for (int e = 0; e < dLdh.lengthOf(); e++)
+        dLdh.putScalar(e, cos(0.3 * e));
+
+    nd4j::ops::lstm<double> op;
+    nd4j::ops::lstm_bp<double> opBP;
+
+    // loss = sum(h * dLdh), so dLdh is exactly gradient of loss wrt h
+    auto loss = [&]() -> double {
+        nd4j::ResultSet<double>* results = op.execute({&x, &h0, &c0, &Wx, &Wh, &Wc, &Wp, &b}, {0., 0., 1.}, {1, 1});
+        double sum = 0.;
+        for (int e = 0; e < dLdh.lengthOf(); e++)
+            sum += results->at(0)->getScalar(e) * dLdh.getScalar(e);
+        delete results;
+        return sum;
+    };
+
+    nd4j::ResultSet<double>* gradients = opBP.execute({&x, &h0, &c0, &Wx, &Wh, &Wc, &Wp, &b, &dLdh}, {0., 0., 1.}, {1, 1});
+    ASSERT_EQ(ND4J_STATUS_OK, gradients->status());
+    ASSERT_EQ(8, gradients->size());
+
+    const double eps = 1e-6;
+    for (int i = 0; i < (int) inputs.size(); i++) {
+        ASSERT_TRUE(gradients->at(i)->isSameShape(inputs[i]));
+
+        for (int e = 0; e < inputs[i]->lengthOf(); e++) {
+            double original = inputs[i]->getScalar(e);
+
+            inputs[i]->putScalar(e, original + eps);
+            double plus = loss();
+            inputs[i]->putScalar(e, original - eps);
+            double minus = loss();
+            inputs[i]->putScalar(e, original);
+
+            ASSERT_NEAR((plus - minus) / (2 * eps), gradients->at(i)->getScalar(e), 1e-6);
+        }
+    }
+
+    delete gradients;
+}
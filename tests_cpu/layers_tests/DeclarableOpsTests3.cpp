@@ -109,6 +109,65 @@ TEST_F(DeclarableOpsTests3, Test_Unique_1) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_Unique_2) {
+    NDArray<float> x('c', {1, 9}, {1, 1, 2, 4, 4, 4, 7, 8, 8});
+    NDArray<float> expV('c', {1, 5}, {1, 2, 4, 7, 8});
+    NDArray<float> expI('c', {1, 9}, {0, 0, 1, 2, 2, 2, 3, 4, 4});
+    NDArray<float> expC('c', {1, 5}, {2, 1, 3, 1, 2});
+
+    nd4j::ops::unique_with_counts<float> op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(3, result->size());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+    auto c = result->at(2);
+
+    ASSERT_TRUE(expV.isSameShape(v));
+    ASSERT_TRUE(expV.equalsTo(v));
+
+    ASSERT_TRUE(expI.isSameShape(i));
+    ASSERT_TRUE(expI.equalsTo(i));
+
+    ASSERT_TRUE(expC.isSameShape(c));
+    ASSERT_TRUE(expC.equalsTo(c));
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests3, Test_Unique_3) {
+    // long enough for partitioned path, values come in reverse order of first occurrence
+    const int length = 100000;
+    const int range = 1000;
+    NDArray<double> x('c', {1, length});
+    for (int e = 0; e < length; e++)
+        x.putScalar(e, (double) (range - 1 - (e * 7) % range));
+
+    nd4j::ops::unique_with_counts<double> op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+    auto c = result->at(2);
+
+    ASSERT_EQ(range, v->lengthOf());
+    ASSERT_EQ(length, i->lengthOf());
+
+    for (int e = 0; e < range; e++) {
+        ASSERT_NEAR((double) (range - 1 - (e * 7) % range), v->getScalar(e), 1e-10);
+        ASSERT_NEAR((double) (length / range), c->getScalar(e), 1e-10);
+    }
+
+    for (int e = 0; e < length; e++)
+        ASSERT_NEAR(x.getScalar(e), v->getScalar((int) i->getScalar(e)), 1e-10);
+
+    delete result;
+}
+
 TEST_F(DeclarableOpsTests3, Test_Rint_1) {
     NDArray<float> x('c', {1, 7}, {-1.7, -1.5, -0.2, 0.2, 1.5, 1.7, 2.0});
     NDArray<float> exp('c', {1, 7}, {-2., -2., -0., 0., 2., 2., 2.});
@@ -254,6 +313,84 @@ TEST_F(DeclarableOpsTests3, Test_CumSum_2) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_CumSum_3) {
+    NDArray<float> x('c', {1, 4}, {1, 2, 3, 4});
+    NDArray<float> expE('c', {1, 4}, {0, 1, 3, 6});
+    NDArray<float> expR('c', {1, 4}, {10, 9, 7, 4});
+    NDArray<float> expER('c', {1, 4}, {9, 7, 4, 0});
+
+    nd4j::ops::cumsum<float> op;
+    auto resultE = op.execute({&x}, {1.f}, {});
+    auto resultR = op.execute({&x}, {0.f, 1.f}, {});
+    auto resultER = op.execute({&x}, {1.f, 1.f}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, resultE->status());
+    ASSERT_EQ(ND4J_STATUS_OK, resultR->status());
+    ASSERT_EQ(ND4J_STATUS_OK, resultER->status());
+
+    ASSERT_TRUE(expE.equalsTo(resultE->at(0)));
+    ASSERT_TRUE(expR.equalsTo(resultR->at(0)));
+    ASSERT_TRUE(expER.equalsTo(resultER->at(0)));
+
+    delete resultE;
+    delete resultR;
+    delete resultER;
+}
+
+TEST_F(DeclarableOpsTests3, Test_CumSum_4) {
+    // scan along columns: TADs are strided
+    NDArray<float> x('c', {3, 2}, {1, 2, 3, 4, 5, 6});
+    NDArray<float> exp('c', {3, 2}, {9, 12, 8, 10, 5, 6});
+
+    nd4j::ops::cumsum<float> op;
+    auto result = op.execute({&x}, {0.f, 1.f}, {1});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto z = result->at(0);
+
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests3, Test_CumSum_5) {
+    // long vector, f-ordered input
+    NDArray<double> x('f', {1, 100003});
+    for (int e = 0; e < x.lengthOf(); e++)
+        x.putIndexedScalar(e, (double) (e % 7));
+
+    nd4j::ops::cumsum<double> op;
+    auto result = op.execute({&x}, {1.}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto z = result->at(0);
+    double sum = 0.0;
+    for (int e = 0; e < x.lengthOf(); e++) {
+        ASSERT_NEAR(sum, z->getIndexedScalar(e), 1e-5);
+        sum += (double) (e % 7);
+    }
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests3, Test_CumProd_1) {
+    NDArray<float> x('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    NDArray<float> exp('c', {2, 3}, {1, 2, 6, 4, 20, 120});
+    NDArray<float> expE('c', {2, 3}, {1, 1, 2, 1, 4, 20});
+
+    nd4j::ops::cumprod<float> op;
+    auto result = op.execute({&x}, {}, {0});
+    auto resultE = op.execute({&x}, {1.f}, {0});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(ND4J_STATUS_OK, resultE->status());
+
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+    ASSERT_TRUE(expE.equalsTo(resultE->at(0)));
+
+    delete result;
+    delete resultE;
+}
+
 TEST_F(DeclarableOpsTests3, Test_ListDiff_1) {
     NDArray<float> x('c', {1, 6}, {1, 2, 3, 4, 5, 6});
     NDArray<float> y('c', {1, 3}, {1, 3, 5});
@@ -1430,3 +1567,87 @@ TEST_F(DeclarableOpsTests3, zeta_test7) {
 
 
 
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, ShapeCache_1) {
+    NDArray<float> x('c', {3, 4});
+    NDArray<float> y('c', {3, 4});
+    x.assign(1.0f);
+    y.assign(2.0f);
+
+    auto cache = nd4j::ops::ShapeCache::getInstance();
+    cache->clear();
+    cache->resetCounters();
+
+    nd4j::ops::add<float> op;
+
+    auto result1 = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result1->status());
+    ASSERT_EQ(0, cache->hits());
+    ASSERT_EQ(1, cache->size());
+
+    auto result2 = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result2->status());
+    ASSERT_EQ(1, cache->hits());
+    ASSERT_EQ(1, cache->size());
+
+    ASSERT_TRUE(result1->at(0)->isSameShape(result2->at(0)));
+    ASSERT_NEAR(3.0f, result2->at(0)->meanNumber(), 1e-5f);
+
+    // different arguments mean different key
+    NDArray<float> z('c', {4, 3});
+    auto result3 = op.execute({&z, &z}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result3->status());
+    ASSERT_EQ(2, cache->size());
+
+    std::vector<int> shape({4, 3});
+    ASSERT_TRUE(result3->at(0)->isSameShape(shape));
+
+    delete result1;
+    delete result2;
+    delete result3;
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, ShapeCache_2) {
+    NDArray<float> x('c', {3, 4});
+
+    auto cache = nd4j::ops::ShapeCache::getInstance();
+    cache->clear();
+
+    // transpose shape function reads input array, so it's never cached
+    nd4j::ops::transpose<float> op;
+
+    for (int e = 0; e < 2; e++) {
+        auto result = op.execute({&x}, {}, {});
+        ASSERT_EQ(ND4J_STATUS_OK, result->status());
+        ASSERT_EQ(0, cache->size());
+
+        std::vector<int> shape({4, 3});
+        ASSERT_TRUE(result->at(0)->isSameShape(shape));
+
+        delete result;
+    }
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, ShapeCache_3) {
+    NDArray<float> x('c', {3, 4});
+    NDArray<float> y('c', {3, 4});
+    NDArray<float> z('c', {3, 4});
+    x.assign(1.0f);
+    y.assign(2.0f);
+
+    auto cache = nd4j::ops::ShapeCache::getInstance();
+    cache->clear();
+    cache->resetCounters();
+
+    // all outputs are provided, so shape function isn't involved at all
+    nd4j::ops::add<float> op;
+    auto status = op.execute({&x, &y}, {&z}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, status);
+    ASSERT_EQ(0, cache->misses());
+    ASSERT_EQ(0, cache->size());
+
+    ASSERT_NEAR(3.0f, z.meanNumber(), 1e-5f);
+}
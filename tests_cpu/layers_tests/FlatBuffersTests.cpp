@@ -11,6 +11,9 @@
 #include <graph/Graph.h>
 #include <GraphExecutioner.h>
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/BitwiseUtils.h>
+#include <cstdlib>
+#include <unistd.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -435,6 +438,121 @@ TEST_F(FlatBuffersTest, ReadTensorArrayLoop_1) {
 
 */
 
+TEST_F(FlatBuffersTest, MapFile1) {
+    NDArray<float> exp('c', {3, 1});
+    exp.assign(3.0);
+
+    auto graph = GraphExecutioner<float>::mapFlatBuffers("./resources/reduce_dim.fb");
+    Nd4jStatus status = GraphExecutioner<float>::execute(graph);
+
+    ASSERT_EQ(ND4J_STATUS_OK, status);
+
+    auto z = graph->getVariableSpace()->getVariable(3)->getNDArray();
+
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete graph;
+}
+
+TEST_F(FlatBuffersTest, MapFile2) {
+    auto copied = GraphExecutioner<float>::importFromFlatBuffers("./resources/ae_00.fb");
+    auto mapped = GraphExecutioner<float>::mapFlatBuffers("./resources/ae_00.fb");
+
+    auto copiedVars = copied->getVariableSpace()->getExternalVariables();
+    auto mappedVars = mapped->getVariableSpace()->getExternalVariables();
+
+    ASSERT_EQ(copiedVars->size(), mappedVars->size());
+    ASSERT_TRUE(copied->mappedBuffer() == nullptr);
+    ASSERT_TRUE(mapped->mappedBuffer() != nullptr);
+
+    auto mappedStart = reinterpret_cast<int8_t *>(mapped->mappedBuffer());
+    auto mappedEnd = mappedStart + mapped->mappedLength();
+
+    int zeroCopied = 0;
+    for (int e = 0; e < (int) copiedVars->size(); e++) {
+        auto a = copiedVars->at(e)->getNDArray();
+        auto b = mappedVars->at(e)->getNDArray();
+
+        ASSERT_EQ(copiedVars->at(e)->id(), mappedVars->at(e)->id());
+        ASSERT_FALSE(copiedVars->at(e)->isReadOnly());
+
+        if (a == nullptr)
+            continue;
+
+        // read-only variables are bound to the file itself, so their buffers must lie within mapped range
+        if (mappedVars->at(e)->isReadOnly()) {
+            auto buffer = reinterpret_cast<int8_t *>(b->getBuffer());
+            ASSERT_TRUE(buffer >= mappedStart);
+            ASSERT_TRUE(buffer + b->lengthOf() * sizeof(float) <= mappedEnd);
+            zeroCopied++;
+        }
+
+        ASSERT_TRUE(a->isSameShape(b));
+        ASSERT_TRUE(a->equalsTo(b));
+    }
+
+    // ae_00 is stored big-endian, so on little-endian host everything goes through copy
+    if (!BitwiseUtils::isBE())
+        ASSERT_EQ(0, zeroCopied);
+
+    delete copied;
+    delete mapped;
+}
+
+TEST_F(FlatBuffersTest, MapFile3) {
+    ASSERT_ANY_THROW(GraphExecutioner<float>::mapFlatBuffers("./resources/non_existent_file.fb"));
+    ASSERT_ANY_THROW(GraphExecutioner<float>::mapFlatBuffers("./resources/max_graph.pb.txt"));
+}
+
+TEST_F(FlatBuffersTest, MapFile4) {
+    // graph with float variables in host byte order, so every one of them is eligible for zero-copy
+    flatbuffers::FlatBufferBuilder builder(1024);
+
+    std::vector<float> values[3] = {{1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {-1.f, 0.5f}, {7.f}};
+    std::vector<int> shapes[3] = {{2, 2, 3, 3, 1, 0, 1, 99}, {2, 1, 2, 2, 1, 0, 1, 99}, {2, 1, 1, 1, 1, 0, 1, 99}};
+
+    std::vector<flatbuffers::Offset<FlatVariable>> variables;
+    for (int e = 0; e < 3; e++) {
+        auto bytes = reinterpret_cast<int8_t *>(values[e].data());
+        auto array = CreateFlatArray(builder, builder.CreateVector(shapes[e]), builder.CreateVector(bytes, values[e].size() * sizeof(float)), nd4j::graph::DataType_FLOAT, BitwiseUtils::isBE() ? nd4j::graph::ByteOrder_BE : nd4j::graph::ByteOrder_LE);
+        variables.emplace_back(CreateFlatVariable(builder, CreateIntPair(builder, -(e + 1), 0), 0, 0, array));
+    }
+
+    builder.Finish(CreateFlatGraph(builder, 119, builder.CreateVector(variables)));
+
+    char fileName[] = "/tmp/libnd4j_mapfile_XXXXXX";
+    int fd = mkstemp(fileName);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_EQ((ssize_t) builder.GetSize(), write(fd, builder.GetBufferPointer(), builder.GetSize()));
+    close(fd);
+
+    auto graph = GraphExecutioner<float>::mapFlatBuffers(fileName);
+    unlink(fileName);
+
+    auto mappedStart = reinterpret_cast<int8_t *>(graph->mappedBuffer());
+    auto mappedEnd = mappedStart + graph->mappedLength();
+    ASSERT_TRUE(mappedStart != nullptr);
+
+    for (int e = 0; e < 3; e++) {
+        auto var = graph->getVariableSpace()->getVariable(-(e + 1));
+        auto array = var->getNDArray();
+
+        ASSERT_TRUE(var->isReadOnly());
+
+        auto buffer = reinterpret_cast<int8_t *>(array->getBuffer());
+        ASSERT_TRUE(buffer >= mappedStart);
+        ASSERT_TRUE(buffer + array->lengthOf() * sizeof(float) <= mappedEnd);
+
+        ASSERT_EQ((int) values[e].size(), array->lengthOf());
+        for (int i = 0; i < array->lengthOf(); i++)
+            ASSERT_EQ(values[e][i], array->getScalar(i));
+    }
+
+    delete graph;
+}
+
+
 /*
 TEST_F(FlatBuffersTest, ReadLoops_NestedWhile_1) {
     // TF graph:
@@ -0,0 +1,115 @@
+#include "testlayers.h"
+#include <ops/gemm.h>
+
+class GemmTests : public testing::Test {
+public:
+
+    /**
+     * Plain reference GEMM, element accessors follow cblas conventions for both orders
+     */
+    template <typename T>
+    static void referenceGemm(int order, int transA, int transB, int M, int N, int K, double alpha, T *A, int lda, T *B, int ldb, double beta, T *C, int ldc) {
+        bool rowMajor = order == CblasRowMajor;
+        bool tA = transA == CblasTrans;
+        bool tB = transB == CblasTrans;
+
+        for (int i = 0; i < M; i++) {
+            for (int j = 0; j < N; j++) {
+                double sum = 0.0;
+                for (int k = 0; k < K; k++) {
+                    // op(A)(i, k) & op(B)(k, j)
+                    int ar = tA ? k : i, ac = tA ? i : k;
+                    int br = tB ? j : k, bc = tB ? k : j;
+
+                    double a = (double) A[rowMajor ? ar * lda + ac : ar + ac * lda];
+                    double b = (double) B[rowMajor ? br * ldb + bc : br + bc * ldb];
+                    sum += a * b;
+                }
+
+                int cIdx = rowMajor ? i * ldc + j : i + j * ldc;
+                C[cIdx] = (T) (alpha * sum + (beta == 0.0 ? 0.0 : beta * (double) C[cIdx]));
+            }
+        }
+    }
+
+    template <typename T>
+    static void checkGemm(int order, int transA, int transB, int M, int N, int K, double alpha, double beta, double eps) {
+        bool rowMajor = order == CblasRowMajor;
+
+        // rows x cols of A & B as stored in memory
+        int aRows = transA == CblasTrans ? K : M, aCols = transA == CblasTrans ? M : K;
+        int bRows = transB == CblasTrans ? N : K, bCols = transB == CblasTrans ? K : N;
+
+        // padded leading dimensions, to make sure they are respected
+        int lda = (rowMajor ? aCols : aRows) + 3;
+        int ldb = (rowMajor ? bCols : bRows) + 1;
+        int ldc = (rowMajor ? N : M) + 2;
+
+        int aLen = lda * (rowMajor ? aRows : aCols);
+        int bLen = ldb * (rowMajor ? bRows : bCols);
+        int cLen = ldc * (rowMajor ? M : N);
+
+        std::vector<T> A(aLen), B(bLen), C(cLen), exp(cLen);
+        for (int e = 0; e < aLen; e++)
+            A[e] = (T) ((e % 17) * 0.125 - 1.0);
+
+        for (int e = 0; e < bLen; e++)
+            B[e] = (T) ((e % 13) * 0.25 - 1.5);
+
+        for (int e = 0; e < cLen; e++) {
+            C[e] = (T) ((e % 7) * 0.5);
+            exp[e] = C[e];
+        }
+
+        referenceGemm<T>(order, transA, transB, M, N, K, alpha, A.data(), lda, B.data(), ldb, beta, exp.data(), ldc);
+        nd4j::blas::GEMM<T>::op(order, transA, transB, M, N, K, (T) alpha, A.data(), lda, B.data(), ldb, (T) beta, C.data(), ldc);
+
+        for (int e = 0; e < cLen; e++) {
+            double ex = (double) exp[e];
+            double z = (double) C[e];
+            ASSERT_NEAR(ex, z, eps * nd4j::math::nd4j_max<double>(1.0, nd4j::math::nd4j_abs<double>(ex)));
+        }
+    }
+};
+
+
+TEST_F(GemmTests, Test_AllLayouts_Float_1) {
+    int orders[] = {CblasColMajor, CblasRowMajor};
+    int trans[] = {CblasNoTrans, CblasTrans};
+
+    for (int o : orders)
+        for (int tA : trans)
+            for (int tB : trans)
+                checkGemm<float>(o, tA, tB, 37, 29, 19, 1.0, 0.0, 1e-5);
+}
+
+
+TEST_F(GemmTests, Test_AllLayouts_Double_1) {
+    int orders[] = {CblasColMajor, CblasRowMajor};
+    int trans[] = {CblasNoTrans, CblasTrans};
+
+    for (int o : orders)
+        for (int tA : trans)
+            for (int tB : trans)
+                checkGemm<double>(o, tA, tB, 41, 23, 17, 0.5, 2.0, 1e-10);
+}
+
+
+TEST_F(GemmTests, Test_MultiBlock_Float_1) {
+    // crosses MC, KC & NR boundaries with tails on every axis
+    checkGemm<float>(CblasColMajor, CblasNoTrans, CblasNoTrans, GEMM_MC + 13, 2 * GEMM_NR + 3, GEMM_KC + 7, 1.0, 1.0, 1e-4);
+    checkGemm<float>(CblasRowMajor, CblasTrans, CblasNoTrans, GEMM_MC * 2 + 1, 9, GEMM_KC + 1, -1.0, 0.0, 1e-4);
+}
+
+
+TEST_F(GemmTests, Test_Half_1) {
+    checkGemm<float16>(CblasColMajor, CblasNoTrans, CblasTrans, 19, 11, 9, 1.0, 0.0, 1e-2);
+    checkGemm<float16>(CblasRowMajor, CblasTrans, CblasNoTrans, 19, 11, 9, 1.0, 1.0, 1e-2);
+}
+
+
+TEST_F(GemmTests, Test_Vector_1) {
+    // degenerate shapes: outer product & dot product
+    checkGemm<float>(CblasColMajor, CblasNoTrans, CblasNoTrans, 17, 13, 1, 1.0, 0.0, 1e-5);
+    checkGemm<double>(CblasColMajor, CblasTrans, CblasNoTrans, 1, 1, 301, 1.0, 0.0, 1e-10);
+}
@@ -11,6 +11,8 @@
 #include <graph/Graph.h>
 #include <NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
+#include <ops/declarable/CustomOperations.h>
+#include <graph/OpProfiler.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -80,4 +82,95 @@ TEST_F(GraphExecutionerTests, Test_Implicit_Output_3) {
 
     delete outputs;
     delete graph;
-}
\ No newline at end of file
+}
+
+TEST_F(GraphExecutionerTests, Test_Profiler_1) {
+    auto profiler = OpProfiler::getInstance();
+    profiler->reset();
+    profiler->setEnabled(true);
+
+    auto graph = GraphExecutioner<float>::importFromFlatBuffers("./resources/reduce_dim.fb");
+    auto status = GraphExecutioner<float>::execute(graph);
+
+    profiler->setEnabled(false);
+
+    ASSERT_EQ(ND4J_STATUS_OK, status);
+
+    auto events = profiler->events();
+    ASSERT_FALSE(events.empty());
+
+    int nodes = 0;
+    for (auto &e: events) {
+        ASSERT_TRUE(e.end >= e.start);
+
+        if (e.category == "node")
+            nodes++;
+    }
+    ASSERT_TRUE(nodes > 0);
+
+    auto trace = profiler->chromeTrace();
+    ASSERT_TRUE(trace.find("\"traceEvents\"") != std::string::npos);
+    ASSERT_TRUE(trace.find("\"ph\":\"X\"") != std::string::npos);
+    ASSERT_TRUE(profiler->exportChromeTrace("/tmp/profiler_trace_1.json"));
+
+    profiler->reset();
+    ASSERT_TRUE(profiler->events().empty());
+
+    delete graph;
+}
+
+TEST_F(GraphExecutionerTests, Test_Profiler_2) {
+    NDArray<float> a('c', {4, 3});
+    NDArray<float> b('c', {3, 5});
+    a.assign(1.0f);
+    b.assign(2.0f);
+
+    auto profiler = OpProfiler::getInstance();
+    profiler->reset();
+    profiler->setEnabled(true);
+
+    nd4j::ops::matmul<float> op;
+    for (int e = 0; e < 3; e++) {
+        auto result = op.execute({&a, &b}, {}, {});
+        ASSERT_EQ(ND4J_STATUS_OK, result->status());
+        delete result;
+    }
+
+    profiler->setEnabled(false);
+
+    auto stats = profiler->statistics();
+    ASSERT_EQ(1, stats.size());
+    ASSERT_EQ(std::string("matmul"), stats[0].name);
+    ASSERT_EQ(3, stats[0].calls);
+
+    // 2 * M * N * K per call
+    ASSERT_EQ(3 * 2 * 4 * 5 * 3, stats[0].flops);
+    ASSERT_TRUE(stats[0].percentile(50) >= stats[0].minTime);
+    ASSERT_TRUE(stats[0].percentile(99) <= stats[0].maxTime);
+
+    auto events = profiler->events();
+    ASSERT_EQ(3, events.size());
+    ASSERT_EQ(2, events[0].inputShapes.size());
+    ASSERT_EQ(1, events[0].outputShapes.size());
+    ASSERT_EQ(5, events[0].outputShapes[0][1]);
+
+    profiler->reset();
+}
+
+TEST_F(GraphExecutionerTests, Test_Profiler_3) {
+    ProfilerStats stats;
+    for (int e = 1; e <= 100; e++)
+        stats.update(e * 10, 0, 0);
+
+    ASSERT_EQ(100, stats.calls);
+    ASSERT_EQ(10, stats.minTime);
+    ASSERT_EQ(1000, stats.maxTime);
+
+    // log-linear buckets keep relative error within 1/8
+    ASSERT_NEAR(500, stats.percentile(50), 500 / 8);
+    ASSERT_NEAR(900, stats.percentile(90), 900 / 8);
+    ASSERT_EQ(1000, stats.percentile(100));
+
+    for (Nd4jIndex t: {0LL, 7LL, 8LL, 15LL, 16LL, 1000LL, 123456LL})
+        ASSERT_EQ(ProfilerStats::bucket(t), ProfilerStats::bucket(ProfilerStats::bucketValue(ProfilerStats::bucket(t))));
+}
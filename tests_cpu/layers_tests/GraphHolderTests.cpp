@@ -4,6 +4,8 @@
 
 #include "testlayers.h"
 #include <graph/GraphHolder.h>
+#include <graph/execution/GraphBatcher.h>
+#include <GraphExecutioner.h>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -67,4 +69,164 @@ TEST_F(GraphHolderTests, SimpleTests_3) {
 
 
     delete graph2;
-}
\ No newline at end of file
+}
+
+
+TEST_F(GraphHolderTests, BatcherTests_1) {
+    auto graph = GraphExecutioner<float>::importFromFlatBuffers("./resources/reduce_dim.fb");
+    Nd4jIndex graphId = 121;
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    const int numRequests = 8;
+
+    // long delay, so batch is launched once it's full
+    GraphBatcher<float> batcher(graphId, numRequests, 1000000L);
+
+    std::vector<NDArray<float>*> inputs(numRequests);
+    std::vector<BatchedResult<float>*> results(numRequests);
+
+#pragma omp parallel for num_threads(numRequests) schedule(static, 1)
+    for (int e = 0; e < numRequests; e++) {
+        inputs[e] = new NDArray<float>('c', {1, 3});
+        inputs[e]->assign((float) e + 1);
+
+        std::vector<int> indices({1});
+        std::vector<NDArray<float>*> args({inputs[e]});
+
+        results[e] = batcher.execute(indices, args);
+    }
+
+    for (int e = 0; e < numRequests; e++) {
+        ASSERT_EQ(ND4J_STATUS_OK, results[e]->status());
+        ASSERT_EQ(1, results[e]->size());
+
+        auto z = results[e]->at(0);
+        ASSERT_EQ(1, z->sizeAt(0));
+        ASSERT_NEAR(3.0f * (e + 1), z->getScalar(0), 1e-5f);
+
+        delete results[e];
+        delete inputs[e];
+    }
+
+    ASSERT_EQ(numRequests, batcher.numberOfRequests());
+    ASSERT_TRUE(batcher.numberOfBatches() >= 1);
+    ASSERT_EQ(batcher.numberOfBatches(), (Nd4jIndex) batcher.history().size());
+
+    GraphHolder::getInstance()->dropGraph<float>(graphId);
+}
+// exposes result extraction, so it can be checked against outputs of any layout
+class ExtractingBatcher : public GraphBatcher<float> {
+public:
+    ExtractingBatcher() : GraphBatcher<float>(0) { }
+
+    BatchedResult<float>* extract(NDArray<float>* output, std::vector<int> rows, int position) {
+        auto batch = std::make_shared<Batch>();
+        batch->_rows = rows;
+        for (auto r: rows)
+            batch->_totalRows += r;
+
+        batch->_outputs.emplace_back(output);
+        batch->_batchedOutputs.emplace_back(true);
+
+        return extractResult(batch, position);
+    }
+};
+
+TEST_F(GraphHolderTests, BatcherTests_2) {
+    NDArray<float> output('f', {6, 4});
+    for (int r = 0; r < 6; r++)
+        for (int c = 0; c < 4; c++)
+            output.putScalar(r, c, (float) (r * 10 + c));
+
+    ExtractingBatcher batcher;
+
+    // callers got 1, 3 and 2 rows
+    auto result = batcher.extract(&output, {1, 3, 2}, 1);
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto z = result->at(0);
+    ASSERT_EQ(3, z->sizeAt(0));
+    ASSERT_EQ(4, z->sizeAt(1));
+    ASSERT_EQ(12, z->lengthOf());
+
+    for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 4; c++)
+            ASSERT_NEAR((float) ((r + 1) * 10 + c), z->getScalar(r, c), 1e-5f);
+
+    // detached copy of the same rows
+    auto copy = z->dup('c');
+    ASSERT_NEAR(12.0f * 20.0f + 18.0f, copy->sumNumber(), 1e-3f);
+
+    delete copy;
+    delete result;
+
+    auto last = batcher.extract(&output, {1, 3, 2}, 2);
+    ASSERT_EQ(2, last->at(0)->sizeAt(0));
+    ASSERT_NEAR(40.0f, last->at(0)->getScalar(0, 0), 1e-5f);
+    ASSERT_NEAR(53.0f, last->at(0)->getScalar(1, 3), 1e-5f);
+
+    delete last;
+}
+
+TEST_F(GraphHolderTests, BatcherTests_3) {
+    // output 1 follows input rows, output 2 is constant [4, 2]: the same number of rows as merged batch below
+    auto graph = new Graph<float>();
+
+    auto x = new NDArray<float>('c', {1, 3});
+    auto c = new NDArray<float>('c', {4, 2});
+    c->assign(-5.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, c);
+
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 1, {-1}, {}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 2, {-2}, {}));
+
+    Nd4jIndex graphId = 124;
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    const int numRequests = 2;
+    GraphBatcher<float> batcher(graphId, 4, 1000000L);
+
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(numRequests);
+
+    for (int round = 0; round < 2; round++) {
+        std::vector<NDArray<float>*> inputs(numRequests);
+        std::vector<BatchedResult<float>*> results(numRequests);
+
+#pragma omp parallel for num_threads(numRequests) schedule(static, 1)
+        for (int e = 0; e < numRequests; e++) {
+            inputs[e] = new NDArray<float>('c', {2, 3});
+            inputs[e]->assign(-(float) (e + 1));
+
+            std::vector<int> indices({-1});
+            std::vector<NDArray<float>*> args({inputs[e]});
+
+            results[e] = batcher.execute(indices, args);
+        }
+
+        for (int e = 0; e < numRequests; e++) {
+            ASSERT_EQ(ND4J_STATUS_OK, results[e]->status());
+            ASSERT_EQ(2, results[e]->size());
+
+            auto z = results[e]->at(0);
+            ASSERT_EQ(2, z->sizeAt(0));
+            ASSERT_EQ(3, z->sizeAt(1));
+            ASSERT_NEAR(6.0f * (e + 1), z->sumNumber(), 1e-5f);
+
+            // constant output isn't split, even though its first dimension matches number of merged rows
+            auto k = results[e]->at(1);
+            ASSERT_EQ(4, k->sizeAt(0));
+            ASSERT_EQ(2, k->sizeAt(1));
+            ASSERT_NEAR(40.0f, k->sumNumber(), 1e-5f);
+
+            delete results[e];
+            delete inputs[e];
+        }
+    }
+
+    omp_set_num_threads(threads);
+
+    GraphHolder::getInstance()->dropGraph<float>(graphId);
+}
@@ -11,6 +11,10 @@
 #include <NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <ops/declarable/generic/parity_ops.cpp>
+#include <graph/execution/GraphScheduler.h>
+#include <graph/execution/GraphWorkers.h>
+#include <graph/MemoryPlanner.h>
+#include <graph/execution/GraphFuser.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -1268,4 +1272,376 @@ TEST_F(GraphTests, Test_Clone_2) {
 
     delete graph;
     delete clone;
-}
\ No newline at end of file
+}
+
+TEST_F(GraphTests, Scheduler_WideGraph_1) {
+    auto graph = new Graph<float>();
+
+    auto x = new NDArray<float>(5, 5, 'c');
+    x->assign(-2.0);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // 8 independent abs() nodes, reduced by a tree of pairwise adds
+    for (int e = 1; e <= 8; e++)
+        graph->addNode(new Node<float>(OpType_TRANSFORM, 0, e, {-1}, {9 + (e - 1) / 2}));
+
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 9, {1, 2}, {13}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 10, {3, 4}, {13}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 11, {5, 6}, {14}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 12, {7, 8}, {14}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 13, {9, 10}, {15}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 14, {11, 12}, {15}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 15, {13, 14}, {}));
+
+    graph->buildGraph();
+
+    ASSERT_TRUE(GraphScheduler<float>::isApplicable(graph));
+    ASSERT_EQ(8, GraphScheduler<float>::maxLayerWidth(graph));
+
+    FlowPath flowPath;
+    graph->getVariableSpace()->setFlowPath(&flowPath);
+
+    GraphScheduler<float> scheduler(graph, graph->getVariableSpace(), 4);
+    ASSERT_EQ(ND4J_STATUS_OK, scheduler.execute());
+
+    ASSERT_TRUE(graph->getVariableSpace()->hasVariable(15));
+
+    auto z = graph->getVariableSpace()->getVariable(15)->getNDArray();
+
+    ASSERT_NEAR(16.0, z->reduceNumber<simdOps::Mean<float>>(), 1e-5);
+
+    graph->getVariableSpace()->setFlowPath(nullptr);
+    delete graph;
+}
+
+TEST_F(GraphTests, Scheduler_Ordering_1) {
+    auto graph = new Graph<float>();
+
+    auto x = new NDArray<float>(5, 5, 'c');
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // 4 branches of dependent nodes: a = -x; b = a - x; c = b * a
+    for (int e = 0; e < 4; e++) {
+        int a = 1 + e * 3;
+        graph->addNode(new Node<float>(OpType_TRANSFORM, 6, a, {-1}, {a + 1, a + 2}));
+        graph->addNode(new Node<float>(OpType_PAIRWISE, 9, a + 1, {a, -1}, {a + 2}));
+        graph->addNode(new Node<float>(OpType_PAIRWISE, 6, a + 2, {a + 1, a}, {13 + e / 2}));
+    }
+
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 13, {3, 6}, {15}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 14, {9, 12}, {15}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 15, {13, 14}, {}));
+
+    graph->buildGraph();
+
+    FlowPath flowPath;
+    graph->getVariableSpace()->setFlowPath(&flowPath);
+
+    // outputs of previous run stay in VariableSpace, so node executed before its inputs would read stale values
+    int threads = -1;
+    for (int r = 1; r <= 20; r++) {
+        x->assign((float) -r);
+
+        GraphScheduler<float> scheduler(graph, graph->getVariableSpace(), 4);
+        ASSERT_EQ(ND4J_STATUS_OK, scheduler.execute());
+
+        auto z = graph->getVariableSpace()->getVariable(15)->getNDArray();
+        ASSERT_NEAR(8.0 * r * r, z->reduceNumber<simdOps::Mean<float>>(), 1e-3);
+
+        // workers are persistent: pool doesn't grow from run to run
+        if (threads < 0)
+            threads = GraphWorkers::getInstance()->numberOfThreads();
+
+        ASSERT_TRUE(threads >= 3);
+        ASSERT_EQ(threads, GraphWorkers::getInstance()->numberOfThreads());
+    }
+
+    graph->getVariableSpace()->setFlowPath(nullptr);
+    delete graph;
+}
+
+TEST_F(GraphTests, Scheduler_Exception_1) {
+    auto graph = new Graph<float>();
+
+    auto x = new NDArray<float>(5, 5, 'c');
+    x->assign(-2.0);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // node 4 reads variable that doesn't exist, so its op throws on one of workers
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 1, {-1}, {5}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 2, {-1}, {5}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 3, {-1}, {6}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 4, {-7}, {6}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 5, {1, 2}, {7}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 6, {3, 4}, {7}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 7, {5, 6}, {}));
+
+    graph->buildGraph();
+
+    FlowPath flowPath;
+    graph->getVariableSpace()->setFlowPath(&flowPath);
+
+    GraphScheduler<float> scheduler(graph, graph->getVariableSpace(), 4);
+    ASSERT_THROW(scheduler.execute(), const char*);
+
+    // consumers of failed node are never executed
+    ASSERT_FALSE(graph->getVariableSpace()->hasVariable(6) && graph->getVariableSpace()->getVariable(6)->getNDArray() != nullptr);
+    ASSERT_FALSE(graph->getVariableSpace()->hasVariable(7) && graph->getVariableSpace()->getVariable(7)->getNDArray() != nullptr);
+
+    graph->getVariableSpace()->setFlowPath(nullptr);
+    delete graph;
+}
+
+TEST_F(GraphTests, Scheduler_Fused_1) {
+    auto graph = new Graph<float>();
+
+    auto x = new NDArray<float>(5, 5, 'c');
+    x->assign(-2.0);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // two independent chains: abs -> neg, and neg -> abs
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 1, {-1}, {2}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 6, 2, {1}, {5}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 6, 3, {-1}, {4}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 4, {3}, {5}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 5, {2, 4}, {}));
+
+    graph->buildGraph();
+
+    GraphFuser<float> fuser(graph);
+    ASSERT_TRUE(fuser.isDeferred(1));
+    ASSERT_TRUE(fuser.isDeferred(3));
+
+    FlowPath flowPath;
+    graph->getVariableSpace()->setFlowPath(&flowPath);
+
+    GraphScheduler<float> scheduler(graph, graph->getVariableSpace(), 2, &fuser);
+    ASSERT_EQ(ND4J_STATUS_OK, scheduler.execute());
+
+    // intermediate results of chains never reach VariableSpace
+    ASSERT_FALSE(graph->getVariableSpace()->hasVariable(1) && graph->getVariableSpace()->getVariable(1)->getNDArray() != nullptr);
+    ASSERT_FALSE(graph->getVariableSpace()->hasVariable(3) && graph->getVariableSpace()->getVariable(3)->getNDArray() != nullptr);
+
+    auto z = graph->getVariableSpace()->getVariable(5)->getNDArray();
+    ASSERT_NEAR(0.0, z->reduceNumber<simdOps::Sum<float>>(), 1e-5);
+
+    graph->getVariableSpace()->setFlowPath(nullptr);
+    delete graph;
+}
+
+
+TEST_F(GraphTests, MemoryPlanner_Chain_1) {
+    auto graph = new Graph<float>();
+
+    auto x = new NDArray<float>(5, 5, 'c');
+    x->assign(-2.0);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 1, {-1}, {2}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 2, 2, {1}, {3}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 3, {2}, {4}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 4, {3}, {5}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 5, {4}, {}));
+
+    MemoryPlanner<float> planner(graph);
+    ASSERT_EQ(ND4J_STATUS_OK, planner.plan());
+
+    // 5 outputs, but only 2 of them are alive at any layer
+    ASSERT_EQ(5, planner.numberOfBuffers());
+    ASSERT_EQ(5 * 128, planner.totalSize());
+    ASSERT_EQ(2 * 128, planner.arenaSize());
+
+    graph->getVariableSpace()->setMemoryPlanner(&planner);
+
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner<float>::execute(graph));
+
+    std::pair<int, int> last(5, 0);
+    auto z = graph->getVariableSpace()->getVariable(5)->getNDArray();
+
+    ASSERT_TRUE(planner.buffer(last) == z->getBuffer());
+    ASSERT_NEAR(0.4161468, z->reduceNumber<simdOps::Mean<float>>(), 1e-5);
+
+    // second run reuses the same arena
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner<float>::execute(graph));
+    ASSERT_TRUE(planner.buffer(last) == graph->getVariableSpace()->getVariable(5)->getNDArray()->getBuffer());
+
+    graph->getVariableSpace()->setMemoryPlanner(nullptr);
+    delete graph;
+}
+
+TEST_F(GraphTests, MemoryPlanner_Inplace_1) {
+    auto graph = new Graph<float>();
+
+    auto x = new NDArray<float>(5, 5, 'c');
+    x->assign(-2.0);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // node 2 negates output of node 1 in place, and node 4 reads it 2 layers later
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 1, {-1}, {2}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 6, 2, {1}, {3, 4}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 3, {2}, {4}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 4, {3, 2}, {}));
+
+    graph->getMapped()->at(2)->getContextPrototype()->markInplace(true);
+
+    MemoryPlanner<float> planner(graph);
+    ASSERT_EQ(ND4J_STATUS_OK, planner.plan());
+
+    // output of node 1 is alive till node 4, so output of node 3 can't take its place
+    std::pair<int, int> first(1, 0);
+    std::pair<int, int> third(3, 0);
+    ASSERT_EQ(3, planner.numberOfBuffers());
+    ASSERT_NE(planner.offset(first), planner.offset(third));
+
+    graph->getVariableSpace()->setMemoryPlanner(&planner);
+
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner<float>::execute(graph));
+
+    // |-2| - 2
+    auto z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_NEAR(0.0, z->reduceNumber<simdOps::Sum<float>>(), 1e-5);
+
+    graph->getVariableSpace()->setMemoryPlanner(nullptr);
+    delete graph;
+}
+
+TEST_F(GraphTests, MemoryPlanner_Executioner_1) {
+    auto graph = new Graph<float>();
+
+    auto x = new NDArray<float>(5, 5, 'c');
+    x->assign(-2.0);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 1, {-1}, {2}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 2, 2, {1}, {3}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 3, {2}, {}));
+
+    nd4j::Environment::getInstance()->setStaticMemoryPlanning(true);
+
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner<float>::execute(graph));
+
+    auto planner = graph->getVariableSpace()->memoryPlanner();
+    ASSERT_TRUE(planner != nullptr);
+    ASSERT_TRUE(graph->ownsMemoryPlanner(planner));
+
+    std::pair<int, int> last(3, 0);
+    auto z = graph->getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_TRUE(planner->array(last) == z);
+    ASSERT_NEAR(0.4161468, z->reduceNumber<simdOps::Mean<float>>(), 1e-5);
+
+    // the same views are used by next run
+    x->assign(-1.0);
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner<float>::execute(graph));
+    ASSERT_TRUE(z == graph->getVariableSpace()->getVariable(3)->getNDArray());
+    ASSERT_NEAR(0.5403023, z->reduceNumber<simdOps::Mean<float>>(), 1e-5);
+
+    // new input shape invalidates the plan
+    auto y = new NDArray<float>(3, 4, 'c');
+    y->assign(-2.0);
+    graph->getVariableSpace()->getVariable(-1)->setNDArray(y);
+    delete x;
+    ASSERT_FALSE(planner->isActual());
+
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner<float>::execute(graph));
+    ASSERT_TRUE(planner->isActual());
+
+    z = graph->getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_EQ(12, z->lengthOf());
+    ASSERT_TRUE(planner->array(last) == z);
+    ASSERT_NEAR(0.4161468, z->reduceNumber<simdOps::Mean<float>>(), 1e-5);
+
+    nd4j::Environment::getInstance()->setStaticMemoryPlanning(false);
+
+    delete graph;
+}
+
+TEST_F(GraphTests, FusedChain_1) {
+    auto graph = new Graph<float>();
+
+    auto x = new NDArray<float>('c', {4, 600});
+    auto b = new NDArray<float>('c', {4, 600});
+    NDArray<float> exp('c', {4, 600});
+
+    for (int e = 0; e < x->lengthOf(); e++) {
+        x->putScalar(e, (e % 50) / 25.0f - 1.0f);
+        b->putScalar(e, 0.1f);
+        exp.putScalar(e, nd4j::math::nd4j_abs<float>(nd4j::math::nd4j_tanh<float>((x->getScalar(e) + 0.1f) * 2.0f)));
+    }
+
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, b);
+
+    // bias add -> scale -> tanh -> abs
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 0, 1, {-1, -2}, {2}));
+    graph->addNode(new Node<float>(OpType_SCALAR, 2, 2, {1}, {3}, {}, 2.0f));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 15, 3, {2}, {4}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 4, {3}, {}));
+
+    graph->buildGraph();
+
+    GraphFuser<float> fuser(graph);
+    ASSERT_EQ(1, fuser.numberOfChains());
+    ASSERT_TRUE(fuser.isDeferred(1));
+    ASSERT_TRUE(fuser.isDeferred(3));
+    ASSERT_TRUE(fuser.isChainTail(4));
+
+    nd4j::Environment::getInstance()->setElementwiseFusion(true);
+    auto status = GraphExecutioner<float>::execute(graph);
+    nd4j::Environment::getInstance()->setElementwiseFusion(false);
+
+    ASSERT_EQ(ND4J_STATUS_OK, status);
+
+    auto z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    // intermediate results aren't materialized
+    ASSERT_FALSE(graph->getVariableSpace()->hasVariable(2) && graph->getVariableSpace()->getVariable(2)->getNDArray() != nullptr);
+
+    delete graph;
+}
+
+TEST_F(GraphTests, FusedChain_2) {
+    auto graph = new Graph<float>();
+
+    auto x = new NDArray<float>('c', {5, 5});
+    x->assign(-2.0);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // node 2 is consumed twice, so chain is broken there
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 1, {-1}, {2}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 2, 2, {1}, {3, 4}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 0, 3, {2}, {5}));
+    graph->addNode(new Node<float>(OpType_TRANSFORM, 6, 4, {2}, {5}));
+    graph->addNode(new Node<float>(OpType_PAIRWISE, 9, 5, {3, 4}, {}));
+
+    graph->buildGraph();
+
+    // chains are {1, 2} and {3, 5}: node 4 output is ready before node 5 executes
+    GraphFuser<float> fuser(graph);
+    ASSERT_EQ(2, fuser.numberOfChains());
+    ASSERT_TRUE(fuser.isChainTail(2));
+    ASSERT_TRUE(fuser.isChainTail(5));
+    ASSERT_FALSE(fuser.isDeferred(2));
+    ASSERT_TRUE(fuser.isDeferred(3));
+    ASSERT_FALSE(fuser.isDeferred(4));
+
+    nd4j::Environment::getInstance()->setElementwiseFusion(true);
+    auto status = GraphExecutioner<float>::execute(graph);
+    nd4j::Environment::getInstance()->setElementwiseFusion(false);
+
+    ASSERT_EQ(ND4J_STATUS_OK, status);
+
+    // node 2 output is cos(2), which is negative: |cos(2)| - (-cos(2)) gives zero
+    auto z = graph->getVariableSpace()->getVariable(5)->getNDArray();
+    ASSERT_NEAR(0.0f, z->reduceNumber<simdOps::Sum<float>>(), 1e-5);
+
+    delete graph;
+}
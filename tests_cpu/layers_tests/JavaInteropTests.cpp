@@ -7,7 +7,10 @@
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/GraphHolder.h>
+#include <ops/specials.h>
+#include <ops/aggregate_ops.h>
 #include "testlayers.h"
+#include <algorithm>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -17,6 +20,42 @@ public:
 
 };
 
+// small word2vec model with artificial Huffman tree, shared by word2vec tests
+struct Word2VecFixture {
+    int vocabSize = 10;
+    int vectorLength = 8;
+    int expLength = 1000;
+    int maxCodeLength = 3;
+    int negTableLength = 100;
+
+    std::vector<double> syn0, syn1, syn1Neg, expTable, negTable;
+    std::vector<int> codes, points, codeLengths;
+
+    Word2VecFixture() {
+        for (int e = 0; e < vocabSize * vectorLength; e++) {
+            syn0.push_back(sin(e * 0.37) * 0.5);
+            syn1.push_back(cos(e * 0.11) * 0.3);
+            syn1Neg.push_back(sin(e * 0.71) * 0.3);
+        }
+
+        for (int e = 0; e < expLength; e++) {
+            double v = exp((e / (double) expLength * 2 - 1) * HS_MAX_EXP);
+            expTable.push_back(v / (v + 1));
+        }
+
+        for (int e = 0; e < negTableLength; e++)
+            negTable.push_back((double) (e % vocabSize));
+
+        for (int w = 0; w < vocabSize; w++) {
+            codeLengths.push_back(maxCodeLength);
+            for (int c = 0; c < maxCodeLength; c++) {
+                codes.push_back((w >> c) & 1);
+                points.push_back((w + c) % (vocabSize - 1));
+            }
+        }
+    }
+};
+
 
 TEST_F(JavaInteropTests, TestShapeExposure1) {
     NDArray<float> input('c', {1, 2, 5, 4});
@@ -280,6 +319,131 @@ TEST_F(JavaInteropTests, TestInplace_1) {
     ASSERT_NEAR(1.0, input.meanNumber(), 1e-5);
 }
 
+TEST_F(JavaInteropTests, Test_DirectOutputs_1) {
+    NDArray<float> x('c', {5, 5});
+    NDArray<float> y('c', {5, 5});
+    NDArray<float> z('c', {5, 5});
+    x.assign(1.0f);
+    y.assign(2.0f);
+
+    nd4j::ops::ShapeCache::getInstance()->clear();
+
+    NativeOps nativeOps;
+    nd4j::ops::add<float> op;
+
+    Nd4jPointer ptrsInBuffer[] = {(Nd4jPointer) x.getBuffer(), (Nd4jPointer) y.getBuffer()};
+    Nd4jPointer ptrsInShapes[] = {(Nd4jPointer) x.getShapeInfo(), (Nd4jPointer) y.getShapeInfo()};
+
+    Nd4jPointer ptrsOutBuffers[] = {(Nd4jPointer) z.getBuffer()};
+    Nd4jPointer ptrsOutShapes[] = {(Nd4jPointer) z.getShapeInfo()};
+
+    // first call goes through ResultSet and fills shape cache, second one writes into z directly
+    for (int e = 0; e < 2; e++) {
+        z.assign(0.0f);
+
+        Nd4jStatus status = nativeOps.execCustomOpFloat(nullptr, op.getOpHash(), ptrsInBuffer, ptrsInShapes, 2, ptrsOutBuffers, ptrsOutShapes, 1, nullptr, 0, nullptr, 0, false);
+        ASSERT_EQ(ND4J_STATUS_OK, status);
+
+        ASSERT_NEAR(3.0f, z.meanNumber(), 1e-5f);
+    }
+
+    std::vector<int> iArgs;
+    std::vector<float> tArgs;
+    ShapeList inShapes({x.getShapeInfo(), y.getShapeInfo()});
+    ASSERT_TRUE(op.cachedOutputShape(&inShapes, tArgs, iArgs) != nullptr);
+}
+
+TEST_F(JavaInteropTests, Test_Threshold_1) {
+    // 3 blocks, last one is partial
+    int N = THRESHOLD_BLOCK_SIZE * 2 + 100;
+    std::vector<float> x(N, 0.0f);
+    std::vector<float> original(N);
+
+    x[1] = 1.5f;
+    x[5] = -2.0f;
+    x[THRESHOLD_BLOCK_SIZE + 7] = 0.9f;
+    x[THRESHOLD_BLOCK_SIZE + 8] = 1.0f;
+    x[N - 1] = -1.0f;
+    original = x;
+
+    NativeOps nativeOps;
+
+    int numBlocks = 3;
+    std::vector<int> blocks(numBlocks + 1, 0);
+    nativeOps.encodeThresholdP1Float(nullptr, x.data(), N, blocks.data(), 1.0f);
+
+    ASSERT_EQ(4, blocks[0]);
+    ASSERT_EQ(2, blocks[1]);
+    ASSERT_EQ(1, blocks[2]);
+    ASSERT_EQ(1, blocks[3]);
+
+    std::vector<int> offsets(numBlocks, 0);
+    nativeOps.encodeThresholdP2Int(nullptr, blocks.data(), numBlocks, offsets.data());
+
+    ASSERT_EQ(0, offsets[0]);
+    ASSERT_EQ(2, offsets[1]);
+    ASSERT_EQ(3, offsets[2]);
+
+    nd4j::FloatBits2 fb;
+    fb.f_ = 1.0f;
+    std::vector<int> encoded(4 + blocks[0], 0);
+    encoded[0] = blocks[0];
+    encoded[1] = N;
+    encoded[2] = fb.i_;
+
+    nativeOps.encodeThresholdP3Float(nullptr, x.data(), offsets.data(), N, encoded.data());
+
+    ASSERT_EQ(2, encoded[4]);
+    ASSERT_EQ(-6, encoded[5]);
+    ASSERT_EQ(THRESHOLD_BLOCK_SIZE + 9, encoded[6]);
+    ASSERT_EQ(-N, encoded[7]);
+
+    // residuals are left in x
+    ASSERT_NEAR(0.5f, x[1], 1e-5f);
+    ASSERT_NEAR(-1.0f, x[5], 1e-5f);
+    ASSERT_NEAR(0.9f, x[THRESHOLD_BLOCK_SIZE + 7], 1e-5f);
+    ASSERT_NEAR(0.0f, x[N - 1], 1e-5f);
+
+    // decoded updates + residuals give back original values
+    nativeOps.decodeThresholdFloat(nullptr, encoded.data(), N, x.data());
+    for (int e = 0; e < N; e++)
+        ASSERT_NEAR(original[e], x[e], 1e-5f);
+}
+
+TEST_F(JavaInteropTests, Test_Threshold_2) {
+    int N = 10000;
+    std::vector<float> x(N, 0.0f);
+    std::vector<float> z(N, 0.0f);
+    for (int e = 0; e < N; e += 7)
+        x[e] = e % 2 == 0 ? 2.0f : -2.0f;
+
+    nd4j::FloatBits2 fb;
+    fb.f_ = 1.0f;
+
+    // buffer has room for 10 elements only, so only first 10 eligible elements are encoded
+    std::vector<int> encoded(4 + 10, 0);
+    encoded[0] = 10;
+    encoded[2] = fb.i_;
+
+    int numEncoded = nd4j::SpecialMethods<float>::encodeThresholdGeneric(x.data(), N, encoded.data());
+
+    ASSERT_EQ(10, numEncoded);
+    ASSERT_EQ(N, encoded[1]);
+    for (int e = 0; e < 10; e++)
+        ASSERT_EQ(e % 2 == 0 ? e * 7 + 1 : -(e * 7 + 1), encoded[4 + e]);
+
+    nd4j::SpecialMethods<float>::decodeThresholdGeneric(encoded.data(), N, z.data());
+
+    for (int e = 0; e < N; e++) {
+        if (e % 7 == 0 && e / 7 < 10) {
+            ASSERT_NEAR(e % 2 == 0 ? 1.0f : -1.0f, z[e], 1e-5f);
+            ASSERT_NEAR(e % 2 == 0 ? 1.0f : -1.0f, x[e], 1e-5f);
+        } else {
+            ASSERT_NEAR(0.0f, z[e], 1e-5f);
+        }
+    }
+}
+
 TEST_F(JavaInteropTests, Test_Synonyms_1) {
     auto op = OpRegistrator::getInstance()->getOperationHalf("RDiv");
     auto opRef = OpRegistrator::getInstance()->getOperationHalf("reversedivide");
@@ -425,4 +589,435 @@ TEST_F(JavaInteropTests, Test_GraphReuse_2) {
     delete res_0;
     delete res_1;
     delete res_2;
-}
\ No newline at end of file
+}
+
+TEST_F(JavaInteropTests, Test_GraphReuse_3) {
+    NativeOps nativeOps;
+
+    uint8_t* data = nd4j::graph::readFlatBuffers("./resources/reduce_dim.fb");
+
+    nativeOps.registerGraphFloat(nullptr, 120, (Nd4jPointer) data);
+    ASSERT_TRUE(GraphHolder::getInstance()->hasGraph<float>(120));
+
+    const int numRequests = 8;
+    std::vector<NDArray<float>*> inputs(numRequests);
+    std::vector<VariablesSet<float>*> results(numRequests);
+
+    // all requests hit the same stored graph at once
+#pragma omp parallel for num_threads(4) schedule(static, 1)
+    for (int e = 0; e < numRequests; e++) {
+        inputs[e] = new NDArray<float>('c', {3, 3});
+        inputs[e]->assign((float) e + 1);
+
+        int idx[] = {1};
+        Nd4jPointer buffers[] = {(Nd4jPointer) inputs[e]->buffer()};
+        Nd4jPointer shapes[] = {(Nd4jPointer) inputs[e]->shapeInfo()};
+
+        results[e] = nativeOps.executeStoredGraphFloat(nullptr, 120, buffers, shapes, idx, 1);
+    }
+
+    for (int e = 0; e < numRequests; e++) {
+        ASSERT_EQ(ND4J_STATUS_OK, results[e]->status());
+        ASSERT_EQ(1, results[e]->size());
+
+        auto z = results[e]->at(0)->getNDArray();
+        NDArray<float> exp('c', {3, 1});
+        exp.assign(3.0f * (e + 1));
+
+        ASSERT_TRUE(exp.equalsTo(z));
+
+        delete results[e];
+        delete inputs[e];
+    }
+
+    nativeOps.unregisterGraph(nullptr, 120);
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph<float>(120));
+
+    delete[] data;
+}
+
+TEST_F(JavaInteropTests, Test_GraphReuse_4) {
+    NativeOps nativeOps;
+
+    uint8_t* data = nd4j::graph::readFlatBuffers("./resources/reduce_dim.fb");
+
+    nativeOps.registerGraphFloat(nullptr, 122, (Nd4jPointer) data);
+    auto graph = GraphHolder::getInstance()->pullGraph<float>(122);
+    auto space = graph->getVariableSpace();
+
+    // graph is built by registration, so executions have nothing left to write into shared VariableSpace
+    std::vector<int> nodeIds;
+    for (auto v: *graph->getMapped())
+        nodeIds.emplace_back(v.first);
+
+    std::vector<NDArray<float>*> nodeArrays;
+    for (auto id: nodeIds) {
+        ASSERT_TRUE(space->hasVariable(id));
+        nodeArrays.emplace_back(space->getVariable(id)->getNDArray());
+    }
+
+    int totalEntries = space->totalEntries();
+    int internalEntries = space->internalEntries();
+
+    std::vector<NDArray<float>*> externalArrays;
+    std::vector<float> externalSums;
+    for (auto v: *space->getExternalVariables()) {
+        externalArrays.emplace_back(v->getNDArray());
+        externalSums.emplace_back(v->getNDArray() == nullptr ? 0.0f : v->getNDArray()->sumNumber());
+    }
+
+    const int numRequests = 64;
+    std::vector<NDArray<float>*> inputs(numRequests);
+    std::vector<VariablesSet<float>*> results(numRequests);
+
+#pragma omp parallel for num_threads(8) schedule(dynamic, 1)
+    for (int e = 0; e < numRequests; e++) {
+        inputs[e] = new NDArray<float>('c', {3, 3});
+        inputs[e]->assign((float) e + 1);
+
+        int idx[] = {1};
+        Nd4jPointer buffers[] = {(Nd4jPointer) inputs[e]->buffer()};
+        Nd4jPointer shapes[] = {(Nd4jPointer) inputs[e]->shapeInfo()};
+
+        results[e] = nativeOps.executeStoredGraphFloat(nullptr, 122, buffers, shapes, idx, 1);
+    }
+
+    for (int e = 0; e < numRequests; e++) {
+        ASSERT_EQ(ND4J_STATUS_OK, results[e]->status());
+
+        NDArray<float> exp('c', {3, 1});
+        exp.assign(3.0f * (e + 1));
+        ASSERT_TRUE(exp.equalsTo(results[e]->at(0)->getNDArray()));
+
+        delete results[e];
+        delete inputs[e];
+    }
+
+    ASSERT_EQ(totalEntries, space->totalEntries());
+    ASSERT_EQ(internalEntries, space->internalEntries());
+
+    for (int e = 0; e < (int) nodeIds.size(); e++)
+        ASSERT_TRUE(nodeArrays[e] == space->getVariable(nodeIds[e])->getNDArray());
+
+    auto externals = space->getExternalVariables();
+    ASSERT_EQ(externalArrays.size(), externals->size());
+    for (int e = 0; e < (int) externals->size(); e++) {
+        auto array = externals->at(e)->getNDArray();
+        ASSERT_TRUE(externalArrays[e] == array);
+        if (array != nullptr)
+            ASSERT_NEAR(externalSums[e], array->sumNumber(), 1e-5f);
+    }
+
+    nativeOps.unregisterGraph(nullptr, 122);
+
+    delete[] data;
+}
+
+static void asyncGraphCallback(Nd4jPointer handle, int status, Nd4jPointer userData) {
+    auto counter = reinterpret_cast<std::atomic<int>*>(userData);
+    if (status == ND4J_STATUS_OK)
+        (*counter)++;
+}
+
+TEST_F(JavaInteropTests, Test_GraphReuse_Async_1) {
+    NativeOps nativeOps;
+
+    uint8_t* data = nd4j::graph::readFlatBuffers("./resources/reduce_dim.fb");
+
+    nativeOps.registerGraphFloat(nullptr, 121, (Nd4jPointer) data);
+    ASSERT_TRUE(GraphHolder::getInstance()->hasGraph<float>(121));
+
+    const int numRequests = 8;
+    std::vector<Nd4jPointer> handles(numRequests);
+    std::atomic<int> counter(0);
+
+    // the same input array is reused for every request, since inputs are copied on submission
+    NDArray<float> input('c', {3, 3});
+    int idx[] = {1};
+    Nd4jPointer buffers[] = {(Nd4jPointer) input.buffer()};
+    Nd4jPointer shapes[] = {(Nd4jPointer) input.shapeInfo()};
+
+    for (int e = 0; e < numRequests; e++) {
+        input.assign((float) e + 1);
+        handles[e] = nativeOps.executeStoredGraphAsyncFloat(nullptr, 121, buffers, shapes, idx, 1, (Nd4jPointer) &asyncGraphCallback, (Nd4jPointer) &counter);
+    }
+
+    for (int e = 0; e < numRequests; e++) {
+        ASSERT_EQ(ND4J_STATUS_OK, nativeOps.waitGraphExecution(handles[e]));
+        ASSERT_TRUE(nativeOps.isGraphExecutionDone(handles[e]));
+
+        auto result = nativeOps.getGraphExecutionResultFloat(handles[e]);
+        ASSERT_EQ(ND4J_STATUS_OK, result->status());
+        ASSERT_EQ(1, result->size());
+
+        NDArray<float> exp('c', {3, 1});
+        exp.assign(3.0f * (e + 1));
+        ASSERT_TRUE(exp.equalsTo(result->at(0)->getNDArray()));
+
+        nativeOps.deleteVariablesSetFloat(result);
+        nativeOps.deleteGraphExecution(handles[e]);
+    }
+
+    ASSERT_EQ(numRequests, counter.load());
+
+    nativeOps.unregisterGraph(nullptr, 121);
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph<float>(121));
+
+    delete[] data;
+}
+
+TEST_F(JavaInteropTests, Test_GraphReuse_Async_2) {
+    NativeOps nativeOps;
+
+    uint8_t* data = nd4j::graph::readFlatBuffers("./resources/reduce_dim.fb");
+
+    nativeOps.registerGraphFloat(nullptr, 123, (Nd4jPointer) data);
+
+    const int numRequests = 8;
+    std::vector<Nd4jPointer> handles(numRequests);
+
+    NDArray<float> input('c', {3, 3});
+    int idx[] = {1};
+    Nd4jPointer buffers[] = {(Nd4jPointer) input.buffer()};
+    Nd4jPointer shapes[] = {(Nd4jPointer) input.shapeInfo()};
+
+    for (int e = 0; e < numRequests; e++) {
+        input.assign((float) e + 1);
+        handles[e] = nativeOps.executeStoredGraphAsyncFloat(nullptr, 123, buffers, shapes, idx, 1, nullptr, nullptr);
+    }
+
+    // graph is dropped while executions are still queued: unregister has to wait for them
+    nativeOps.unregisterGraph(nullptr, 123);
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph<float>(123));
+
+    for (int e = 0; e < numRequests; e++) {
+        ASSERT_EQ(ND4J_STATUS_OK, nativeOps.waitGraphExecution(handles[e]));
+
+        auto result = nativeOps.getGraphExecutionResultFloat(handles[e]);
+        ASSERT_EQ(1, result->size());
+
+        NDArray<float> exp('c', {3, 1});
+        exp.assign(3.0f * (e + 1));
+        ASSERT_TRUE(exp.equalsTo(result->at(0)->getNDArray()));
+
+        nativeOps.deleteVariablesSetFloat(result);
+        nativeOps.deleteGraphExecution(handles[e]);
+    }
+
+    delete[] data;
+}
+
+TEST_F(JavaInteropTests, Test_Sort_1) {
+    NativeOps nativeOps;
+
+    // long enough for parallel radix & merge path
+    int N = 200000;
+    std::vector<float> x(N);
+    for (int e = 0; e < N; e++)
+        x[e] = (float) ((e * 7919) % 1000) - 500.0f + (e % 3) * 0.25f;
+
+    auto exp = x;
+    std::sort(exp.begin(), exp.end());
+
+    int shapeInfo[] = {2, 1, N, N, 1, 0, 1, 99};
+
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+
+    auto asc = x;
+    nativeOps.sortFloat(nullptr, asc.data(), shapeInfo, false);
+
+    auto desc = x;
+    nativeOps.sortFloat(nullptr, desc.data(), shapeInfo, true);
+
+    omp_set_num_threads(threads);
+
+    for (int e = 0; e < N; e++) {
+        ASSERT_EQ(exp[e], asc[e]);
+        ASSERT_EQ(exp[N - e - 1], desc[e]);
+    }
+}
+
+TEST_F(JavaInteropTests, Test_Sort_2) {
+    NativeOps nativeOps;
+
+    // 3x4 matrix with f-like strides, so ews isn't available
+    std::vector<double> x = {5.0, -1.0, 3.0, 0.0, 11.0, -7.5, 2.0, 2.0, 8.0, -0.0, 4.0, 1.0};
+    int shapeInfo[] = {2, 3, 4, 1, 3, 0, -1, 99};
+
+    nativeOps.sortDouble(nullptr, x.data(), shapeInfo, false);
+
+    std::vector<double> exp = {-7.5, -1.0, -0.0, 0.0, 1.0, 2.0, 2.0, 3.0, 4.0, 5.0, 8.0, 11.0};
+    for (int e = 0; e < 12; e++) {
+        int r = e / 4;
+        int c = e % 4;
+        ASSERT_EQ(exp[e], x[r + c * 3]);
+    }
+}
+
+TEST_F(JavaInteropTests, Test_Sort_3) {
+    NativeOps nativeOps;
+
+    // 4 TADs of 300 elements, and float16
+    NDArray<float16> x('c', {4, 300});
+    for (int e = 0; e < x.lengthOf(); e++)
+        x.putScalar(e, (float16) (float) ((e * 31) % 300 - 150));
+
+    NDArray<float16> tad('c', {1, 300});
+    std::vector<Nd4jIndex> tadOffsets = {0, 300, 600, 900};
+    int dimension = 1;
+
+    nativeOps.sortTadHalf(nullptr, x.getBuffer(), x.getShapeInfo(), &dimension, 1, tad.getShapeInfo(), tadOffsets.data(), true);
+
+    for (int r = 0; r < 4; r++)
+        for (int e = 1; e < 300; e++)
+            ASSERT_TRUE((float) x.getScalar(r * 300 + e - 1) >= (float) x.getScalar(r * 300 + e));
+
+    NDArray<float16> y('c', {1, 5});
+    y.putScalar(0, (float16) 3.0f);
+    y.putScalar(1, (float16) -2.0f);
+    y.putScalar(2, (float16) 0.5f);
+    y.putScalar(3, (float16) -8.0f);
+    y.putScalar(4, (float16) 1.0f);
+
+    nativeOps.sortHalf(nullptr, y.getBuffer(), y.getShapeInfo(), false);
+
+    ASSERT_NEAR(-8.0f, (float) y.getScalar(0), 1e-5f);
+    ASSERT_NEAR(-2.0f, (float) y.getScalar(1), 1e-5f);
+    ASSERT_NEAR(0.5f, (float) y.getScalar(2), 1e-5f);
+    ASSERT_NEAR(1.0f, (float) y.getScalar(3), 1e-5f);
+    ASSERT_NEAR(3.0f, (float) y.getScalar(4), 1e-5f);
+}
+
+TEST_F(JavaInteropTests, Test_Argsort_1) {
+    NativeOps nativeOps;
+
+    std::vector<float> x = {3.0f, 1.0f, 2.0f, 1.0f, -4.0f, 2.0f};
+    int shapeInfo[] = {2, 1, 6, 6, 1, 0, 1, 99};
+    std::vector<Nd4jIndex> indices(6);
+
+    nativeOps.argsortFloat(nullptr, x.data(), shapeInfo, indices.data(), false);
+
+    // stable: equal elements keep original order
+    std::vector<Nd4jIndex> exp = {4, 1, 3, 2, 5, 0};
+    ASSERT_EQ(exp, indices);
+
+    // x itself isn't modified
+    ASSERT_EQ(3.0f, x[0]);
+
+    nativeOps.argsortFloat(nullptr, x.data(), shapeInfo, indices.data(), true);
+
+    std::vector<Nd4jIndex> expDesc = {0, 2, 5, 1, 3, 4};
+    ASSERT_EQ(expDesc, indices);
+}
+
+TEST_F(JavaInteropTests, Test_SortByKey_1) {
+    NativeOps nativeOps;
+
+    int N = 1000;
+    std::vector<float> keys(N);
+    std::vector<float> values(N);
+    for (int e = 0; e < N; e++) {
+        keys[e] = (float) ((e * 37) % N);
+        values[e] = keys[e] * 2.0f;
+    }
+
+    int shapeInfo[] = {2, 1, N, N, 1, 0, 1, 99};
+
+    nativeOps.sortByKeyFloat(nullptr, keys.data(), shapeInfo, values.data(), shapeInfo, false);
+
+    for (int e = 0; e < N; e++) {
+        ASSERT_EQ((float) e, keys[e]);
+        ASSERT_EQ((float) e * 2.0f, values[e]);
+    }
+}
+
+TEST_F(JavaInteropTests, Test_SkipGram_1) {
+    NativeOps nativeOps;
+    Word2VecFixture batch;
+    Word2VecFixture sequential;
+
+    std::vector<int> words({1, 2, 3, 4, 5, 6, 7, 8, 9, 1});
+    std::vector<int> contexts({2, 3, 4, 5, 6, 7, 8, 9, 1, 5});
+
+    // hierarchic softmax only, results must be identical to SkipGram aggregates applied one by one
+    nativeOps.execSkipGramDouble(nullptr, batch.syn0.data(), batch.syn1.data(), batch.syn1Neg.data(), batch.expTable.data(), batch.negTable.data(), words.data(), contexts.data(), (Nd4jIndex) words.size(),
+                                 batch.codes.data(), batch.points.data(), batch.codeLengths.data(), batch.maxCodeLength, batch.vectorLength, batch.vocabSize, batch.expLength, batch.negTableLength, 0, 0.025, 119);
+
+    for (int e = 0; e < (int) words.size(); e++) {
+        double *arguments[] = {sequential.syn0.data(), sequential.syn1.data(), sequential.expTable.data(), sequential.syn1Neg.data(), sequential.negTable.data(), nullptr};
+        int indexArguments[] = {contexts[e], sequential.vectorLength, sequential.maxCodeLength, 0, sequential.expLength, sequential.vocabSize, words[e], sequential.negTableLength, 0};
+        int *intArrays[] = {sequential.points.data() + words[e] * sequential.maxCodeLength, sequential.codes.data() + words[e] * sequential.maxCodeLength};
+        double realArguments[] = {0.025, 119.0};
+
+        aggregateOps::SkipGram<double>::executeAggregate(arguments, 6, nullptr, 0, indexArguments, 9, intArrays, 2, realArguments, 2);
+    }
+
+    for (int e = 0; e < (int) batch.syn0.size(); e++) {
+        ASSERT_EQ(sequential.syn0[e], batch.syn0[e]);
+        ASSERT_EQ(sequential.syn1[e], batch.syn1[e]);
+    }
+}
+
+TEST_F(JavaInteropTests, Test_SkipGram_2) {
+    NativeOps nativeOps;
+    Word2VecFixture first;
+    Word2VecFixture second;
+    Word2VecFixture original;
+
+    int numPairs = 1000;
+    std::vector<int> words(numPairs);
+    std::vector<int> contexts(numPairs);
+    for (int e = 0; e < numPairs; e++) {
+        words[e] = 1 + (e * 7) % (first.vocabSize - 1);
+        contexts[e] = 1 + (e * 3) % (first.vocabSize - 1);
+    }
+
+    // negative sampling only, single thread, so both runs must be the same
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    double wps = nativeOps.execSkipGramDouble(nullptr, first.syn0.data(), nullptr, first.syn1Neg.data(), first.expTable.data(), first.negTable.data(), words.data(), contexts.data(), numPairs,
+                                 nullptr, nullptr, nullptr, 0, first.vectorLength, first.vocabSize, first.expLength, first.negTableLength, 5, 0.025, 119);
+    nativeOps.execSkipGramDouble(nullptr, second.syn0.data(), nullptr, second.syn1Neg.data(), second.expTable.data(), second.negTable.data(), words.data(), contexts.data(), numPairs,
+                                 nullptr, nullptr, nullptr, 0, second.vectorLength, second.vocabSize, second.expLength, second.negTableLength, 5, 0.025, 119);
+    omp_set_num_threads(threads);
+
+    ASSERT_TRUE(wps > 0.0);
+    ASSERT_NE(original.syn0, first.syn0);
+    ASSERT_NE(original.syn1Neg, first.syn1Neg);
+    ASSERT_EQ(original.syn1, first.syn1);
+    ASSERT_EQ(first.syn0, second.syn0);
+    ASSERT_EQ(first.syn1Neg, second.syn1Neg);
+}
+
+TEST_F(JavaInteropTests, Test_Cbow_1) {
+    NativeOps nativeOps;
+    Word2VecFixture batch;
+    Word2VecFixture sequential;
+
+    int contextWidth = 3;
+    std::vector<int> words({1, 2, 3, 4});
+    std::vector<int> contexts({2, 3, 4,   5, 6, -1,   7, -1, -1,   8, 9, 1});
+
+    nativeOps.execCbowDouble(nullptr, batch.syn0.data(), batch.syn1.data(), batch.syn1Neg.data(), batch.expTable.data(), batch.negTable.data(), words.data(), contexts.data(), contextWidth, (Nd4jIndex) words.size(),
+                             batch.codes.data(), batch.points.data(), batch.codeLengths.data(), batch.maxCodeLength, batch.vectorLength, batch.vocabSize, batch.expLength, batch.negTableLength, 0, 0.025, 119);
+
+    for (int e = 0; e < (int) words.size(); e++) {
+        std::vector<int> window;
+        for (int c = 0; c < contextWidth; c++)
+            if (contexts[e * contextWidth + c] >= 0)
+                window.push_back(contexts[e * contextWidth + c]);
+
+        double *arguments[] = {sequential.syn0.data(), sequential.syn1.data(), sequential.expTable.data(), sequential.syn1Neg.data(), sequential.negTable.data(), nullptr};
+        int indexArguments[] = {sequential.vectorLength, sequential.maxCodeLength, 0, sequential.expLength, sequential.vocabSize, words[e], sequential.negTableLength, (int) window.size(), 0, 0, 1, 0};
+        int *intArrays[] = {window.data(), sequential.points.data() + words[e] * sequential.maxCodeLength, sequential.codes.data() + words[e] * sequential.maxCodeLength};
+        double realArguments[] = {0.025, 119.0};
+
+        aggregateOps::CBOW<double>::executeAggregate(arguments, 6, nullptr, 0, indexArguments, 12, intArrays, 3, realArguments, 2);
+    }
+
+    for (int e = 0; e < (int) batch.syn0.size(); e++) {
+        ASSERT_EQ(sequential.syn0[e], batch.syn0[e]);
+        ASSERT_EQ(sequential.syn1[e], batch.syn1[e]);
+    }
+}
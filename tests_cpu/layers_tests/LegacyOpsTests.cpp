@@ -11,6 +11,8 @@
 #include <ops/declarable/LegacyReduceOp.h>
 #include <ops/declarable/LegacyIndexReduceOp.h>
 #include <ops/declarable/LegacyBroadcastOp.h>
+#include <loops/grid_fused.h>
+#include <helpers/ThresholdTuner.h>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -263,4 +265,93 @@ TEST_F(LegacyOpsTests, BroadcastingTests_1) {
         ASSERT_TRUE(row.equalsTo(list->at(e)));
 
     delete list;
-}
\ No newline at end of file
+}
+
+TEST_F(LegacyOpsTests, FusedChain_1) {
+    // bias add -> scale -> tanh, as single pass. length isn't multiple of block size on purpose
+    NDArray<float> x('c', {3, 1000});
+    NDArray<float> y('c', {3, 1000});
+    NDArray<float> z('c', {3, 1000});
+    NDArray<float> exp('c', {3, 1000});
+
+    for (int e = 0; e < x.lengthOf(); e++) {
+        x.putScalar(e, (e % 100) / 50.0f - 1.0f);
+        y.putScalar(e, (e % 7) / 10.0f);
+        exp.putScalar(e, nd4j::math::nd4j_tanh<float>((x.getScalar(e) + y.getScalar(e)) * 2.0f));
+    }
+
+    int opTypes[] = {FUSED_OP_PAIRWISE, FUSED_OP_SCALAR, FUSED_OP_TRANSFORM};
+    int opNums[] = {0, 2, 15};
+    float* operands[] = {y.getBuffer(), nullptr, nullptr};
+    int* operandShapes[] = {y.getShapeInfo(), nullptr, nullptr};
+    float scalars[] = {0.0f, 2.0f, 0.0f};
+
+    functions::grid::GRIDFused<float>::execShaped(3, opTypes, opNums, x.getBuffer(), x.getShapeInfo(), operands, operandShapes, z.getBuffer(), z.getShapeInfo(), scalars, nullptr);
+
+    ASSERT_TRUE(exp.equalsTo(&z));
+
+    // different orders can't be walked with single stride, so ops are applied one by one
+    NDArray<float> zF('f', {3, 1000});
+    functions::grid::GRIDFused<float>::execShaped(3, opTypes, opNums, x.getBuffer(), x.getShapeInfo(), operands, operandShapes, zF.getBuffer(), zF.getShapeInfo(), scalars, nullptr);
+
+    ASSERT_TRUE(exp.equalsTo(&zF));
+}
+
+TEST_F(LegacyOpsTests, FusedChain_2) {
+    // SoftMax needs whole array, so it can't be part of chain
+    ASSERT_TRUE(functions::grid::GRIDFused<float>::isFusable(FUSED_OP_TRANSFORM, 15));
+    ASSERT_FALSE(functions::grid::GRIDFused<float>::isFusable(FUSED_OP_TRANSFORM, 38));
+}
+
+TEST_F(LegacyOpsTests, Tuning_Test_1) {
+    auto env = Environment::getInstance();
+    int element = env->elementwiseThreshold();
+    int tad = env->tadThreshold();
+
+    env->setElementwiseThreshold(OP_CLASS_TRANSFORM, 123);
+    env->setTadThreshold(OP_CLASS_REDUCE, 7);
+    env->setMaxThreads(OP_CLASS_REDUCE, 2);
+
+    ASSERT_EQ(123, env->elementwiseThreshold(OP_CLASS_TRANSFORM));
+    ASSERT_EQ(element, env->elementwiseThreshold(OP_CLASS_PAIRWISE));
+    ASSERT_EQ(7, env->tadThreshold(OP_CLASS_REDUCE));
+    ASSERT_EQ(2, env->maxThreads(OP_CLASS_REDUCE, 16));
+    ASSERT_EQ(1, env->maxThreads(OP_CLASS_REDUCE, 1));
+    ASSERT_EQ(16, env->maxThreads(OP_CLASS_TRANSFORM, 16));
+
+    ASSERT_TRUE(env->saveTuning("/tmp/tuning_test_1.txt"));
+    env->resetTuning();
+    ASSERT_EQ(element, env->elementwiseThreshold(OP_CLASS_TRANSFORM));
+
+    ASSERT_TRUE(env->loadTuning("/tmp/tuning_test_1.txt"));
+    ASSERT_EQ(123, env->elementwiseThreshold(OP_CLASS_TRANSFORM));
+    ASSERT_EQ(2, env->maxThreads(OP_CLASS_REDUCE, 16));
+
+    // global value set afterwards wins
+    env->setElementwiseThreshold(element);
+    ASSERT_EQ(element, env->elementwiseThreshold(OP_CLASS_TRANSFORM));
+
+    env->resetTuning();
+    env->setTadThreshold(tad);
+}
+
+TEST_F(LegacyOpsTests, Tuning_Test_2) {
+    auto env = Environment::getInstance();
+    int element = env->elementwiseThreshold();
+
+    ThresholdTuner::calibrateClass(OP_CLASS_SCALAR, 3);
+    int threshold = env->elementwiseThreshold(OP_CLASS_SCALAR);
+    ASSERT_TRUE(threshold > 0);
+
+    // scalar loop is parallel above threshold, so on multicore box crossover is found before largest probe
+    if (omp_get_num_procs() > 1 && omp_get_max_threads() > 1)
+        ASSERT_LT(threshold, TUNER_MAX_LENGTH);
+
+    NDArray<float> x('c', {100, 100});
+    x.assign(2.0f);
+    x.template applyScalar<simdOps::Add<float>>(1.0f);
+    ASSERT_NEAR(30000.0f, x.sumNumber(), 1e-1);
+
+    env->resetTuning();
+    env->setElementwiseThreshold(element);
+}
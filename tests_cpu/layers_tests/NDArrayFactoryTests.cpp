@@ -179,4 +179,86 @@ TEST_F(NDArrayFactoryTests, Test_Concat_1) {
     ASSERT_TRUE(exp.equalsTo(z));
 
     delete z;
-}
\ No newline at end of file
+}
+////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayFactoryTests, Test_Npy_Map_1) {
+    float data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    unsigned int shape[] = {3, 4};
+    cnpy::npy_save<float>("/tmp/npy_map_1.npy", data, shape, 2);
+
+    NDArray<float> exp('c', {3, 4}, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+
+    auto npy = cnpy::npyMap("/tmp/npy_map_1.npy");
+    ASSERT_TRUE(npy.mapping != nullptr);
+
+    // float into float is zero-copy
+    auto x = NDArrayFactory<float>::fromNpy(npy);
+    ASSERT_TRUE(x->getBuffer() == reinterpret_cast<float *>(npy.data));
+    ASSERT_TRUE(exp.isSameShape(x));
+    ASSERT_TRUE(exp.equalsTo(x));
+
+    // float into double is converted
+    auto y = NDArrayFactory<double>::fromNpy(npy);
+    ASSERT_EQ(12, y->lengthOf());
+    ASSERT_NEAR(12.0, y->getScalar(11), 1e-5);
+
+    delete x;
+    delete y;
+    npy.destruct();
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayFactoryTests, Test_Npy_Reader_1) {
+    float data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    unsigned int shape[] = {4, 3};
+    cnpy::npy_save<float>("/tmp/npy_reader_1.npy", data, shape, 2);
+
+    cnpy::NpyReader reader("/tmp/npy_reader_1.npy");
+    ASSERT_EQ(4, reader.rows());
+    ASSERT_EQ(3 * sizeof(float), reader.rowLength());
+
+    float rows[6];
+    ASSERT_EQ(2, reader.readRows(1, 2, reinterpret_cast<char *>(rows)));
+    for (int e = 0; e < 6; e++)
+        ASSERT_NEAR(data[3 + e], rows[e], 1e-5);
+
+    // tail is truncated
+    ASSERT_EQ(1, reader.readRows(3, 2, reinterpret_cast<char *>(rows)));
+    ASSERT_NEAR(10.f, rows[0], 1e-5);
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayFactoryTests, Test_Npz_Map_1) {
+    auto members = cnpy::npzMembers("./resources/arrays.npz");
+    ASSERT_EQ(3, members.size());
+    ASSERT_EQ(std::string("x"), members[0]);
+
+    NDArray<float> expX('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto npyX = cnpy::npzMap("./resources/arrays.npz", "x");
+    auto x = NDArrayFactory<float>::fromNpy(npyX);
+    ASSERT_TRUE(expX.isSameShape(x));
+    ASSERT_TRUE(expX.equalsTo(x));
+
+    // big-endian fortran-ordered int32
+    NDArray<double> expZ('c', {2, 2}, {1, 3, 2, 4});
+    auto npyZ = cnpy::npzMap("./resources/arrays.npz", "z");
+    auto z = NDArrayFactory<double>::fromNpy(npyZ);
+    ASSERT_EQ('f', z->ordering());
+    ASSERT_TRUE(expZ.isSameShape(z));
+    ASSERT_TRUE(expZ.equalsTo(z));
+
+    delete x;
+    delete z;
+    npyX.destruct();
+    npyZ.destruct();
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayFactoryTests, Test_Npz_Map_2) {
+    try {
+        cnpy::npzMap("./resources/arrays.npz", "unknown");
+        ASSERT_TRUE(false);
+    } catch (std::runtime_error &e) {
+        //
+    }
+}
@@ -1556,6 +1556,33 @@ TEST_F(NDArrayTest, applyReduce3Dot) {
     delete result;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, applyReduce3Dot_2) {
+    float xBuff[] = {1, 2, 3, 4, 5, 6};
+    float yBuff[] = {2, 2, 2, 2, 2, 2};
+    int xShapeInfo[] = {2, 2, 3, 3, 1, 0, 1, 99};
+
+    NDArray<float> x(xBuff, xShapeInfo);
+    NDArray<float> y(yBuff, xShapeInfo);
+    NDArray<float> yF('f', {2, 3});
+    yF.assign(2.0f);
+
+    NDArray<float>* result = x.applyReduce3<simdOps::Dot<float>>(&y, {1});
+    ASSERT_EQ(2, result->lengthOf());
+    ASSERT_NEAR(12, result->getScalar(0), 1e-5);
+    ASSERT_NEAR(30, result->getScalar(1), 1e-5);
+    delete result;
+
+    // y in other order goes through coordinates instead of element-wise stride
+    std::vector<int> dims({0});
+    result = x.applyReduce3<simdOps::Dot<float>>(&yF, dims);
+    ASSERT_EQ(3, result->lengthOf());
+    ASSERT_NEAR(10, result->getScalar(0), 1e-5);
+    ASSERT_NEAR(14, result->getScalar(1), 1e-5);
+    ASSERT_NEAR(18, result->getScalar(2), 1e-5);
+    delete result;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(NDArrayTest, applyAllReduce3EuclideanDistance) {
     float xBuff[] =   {1, 2, 3, 4, 5, 6};    
@@ -1576,6 +1603,85 @@ TEST_F(NDArrayTest, applyAllReduce3EuclideanDistance) {
 }
 
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, applyAllReduce3_Blocked_1) {
+    // 48 TADs of length 40 along dimension 0, so TADs are strided columns, and GEMM lowering kicks in for euclidean & cosine
+    NDArray<double> x('c', {40, 48});
+    NDArray<double> y('c', {40, 37});
+    for (int e = 0; e < x.lengthOf(); e++)
+        x.putIndexedScalar(e, sin(0.3 * e) + 0.1);
+
+    for (int e = 0; e < y.lengthOf(); e++)
+        y.putIndexedScalar(e, cos(0.7 * e) - 0.2);
+
+    std::unique_ptr<NDArray<double>> euclidean(x.applyAllReduce3<simdOps::EuclideanDistance<double>>(&y, {0}));
+    std::unique_ptr<NDArray<double>> cosine(x.applyAllReduce3<simdOps::CosineSimilarity<double>>(&y, {0}));
+    std::unique_ptr<NDArray<double>> manhattan(x.applyAllReduce3<simdOps::ManhattanDistance<double>>(&y, {0}));
+
+    ASSERT_EQ(48, euclidean->rows());
+    ASSERT_EQ(37, euclidean->columns());
+
+    for (int r = 0; r < 48; r++) {
+        for (int c = 0; c < 37; c++) {
+            double dot = 0.0, nx = 0.0, ny = 0.0, sq = 0.0, abs = 0.0;
+            for (int e = 0; e < 40; e++) {
+                double a = x.getScalar(e, r);
+                double b = y.getScalar(e, c);
+                dot += a * b;
+                nx += a * a;
+                ny += b * b;
+                sq += (a - b) * (a - b);
+                abs += nd4j::math::nd4j_abs<double>(a - b);
+            }
+
+            ASSERT_NEAR(sqrt(sq), euclidean->getScalar(r, c), 1e-6);
+            ASSERT_NEAR(dot / (sqrt(nx) * sqrt(ny)), cosine->getScalar(r, c), 1e-6);
+            ASSERT_NEAR(abs, manhattan->getScalar(r, c), 1e-6);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, applyAllReduce3_TopK_1) {
+    NDArray<float> x('c', {5, 16});
+    NDArray<float> y('c', {70, 16});
+    for (int e = 0; e < x.lengthOf(); e++)
+        x.putIndexedScalar(e, (float) ((e * 7) % 11) * 0.1f);
+
+    for (int e = 0; e < y.lengthOf(); e++)
+        y.putIndexedScalar(e, (float) ((e * 5) % 13) * 0.1f);
+
+    std::unique_ptr<NDArray<float>> full(x.applyAllReduce3<simdOps::EuclideanDistance<float>>(&y, {1}));
+    std::unique_ptr<NDArray<float>> fullDot(x.applyAllReduce3<simdOps::Dot<float>>(&y, {1}));
+
+    NDArray<float> values('c', {5, 3});
+    NDArray<float> indices('c', {5, 3});
+    NDArray<float> dotValues('c', {5, 3});
+    NDArray<float> dotIndices('c', {5, 3});
+    x.applyAllReduce3TopK<simdOps::EuclideanDistance<float>>(&y, {1}, 3, &values, &indices);
+    x.applyAllReduce3TopK<simdOps::Dot<float>>(&y, {1}, 3, &dotValues, &dotIndices);
+
+    for (int r = 0; r < 5; r++) {
+        // distances are sorted ascending, similarities descending
+        std::vector<std::pair<float, int>> dist, dot;
+        for (int c = 0; c < 70; c++) {
+            dist.push_back(std::make_pair(full->getScalar(r, c), c));
+            dot.push_back(std::make_pair(-fullDot->getScalar(r, c), c));
+        }
+        std::sort(dist.begin(), dist.end());
+        std::sort(dot.begin(), dot.end());
+
+        for (int e = 0; e < 3; e++) {
+            ASSERT_NEAR(dist[e].first, values.getScalar(r, e), 1e-4);
+            ASSERT_NEAR(-dot[e].first, dotValues.getScalar(r, e), 1e-4);
+
+            // indices must point to TADs with matching values, ties can be resolved either way
+            ASSERT_NEAR(values.getScalar(r, e), full->getScalar(r, (int) indices.getScalar(r, e)), 1e-4);
+            ASSERT_NEAR(dotValues.getScalar(r, e), fullDot->getScalar(r, (int) dotIndices.getScalar(r, e)), 1e-4);
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(NDArrayTest, applyReduce3EuclideanDistance) {
     float xBuff[] =   {1, 2, 3, 4, 5, 6};    
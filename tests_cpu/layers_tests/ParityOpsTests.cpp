@@ -504,4 +504,130 @@ TEST_F(ParityOpsTests, Test_Scatter_Add_6) {
 //    ASSERT_TRUE(exp.equalsTo(z));
 
     delete result;
-}
\ No newline at end of file
+}
+
+TEST_F(ParityOpsTests, Test_Scatter_Add_7) {
+    // many duplicated rows, so parallel path is used & rows are grouped
+    const int rows = 50;
+    const int columns = 64;
+    const int numIndices = 4000;
+
+    NDArray<double> matrix('c', {rows, columns});
+    NDArray<double> idc('c', {1, numIndices});
+    NDArray<double> updates('c', {numIndices, columns});
+    NDArray<double> exp('c', {rows, columns});
+
+    for (int e = 0; e < matrix.lengthOf(); e++)
+        matrix.putScalar(e, (double) e / 7.0);
+
+    for (int e = 0; e < numIndices; e++)
+        idc.putScalar(e, (double) ((e * 13) % rows));
+
+    for (int e = 0; e < updates.lengthOf(); e++)
+        updates.putScalar(e, (double) (e % 11) / 3.0);
+
+    // serial reference
+    exp.assign(&matrix);
+    for (int e = 0; e < numIndices; e++) {
+        int r = (int) idc.getScalar(e);
+        for (int c = 0; c < columns; c++)
+            exp.putScalar(r, c, exp.getScalar(r, c) + updates.getScalar(e, c));
+    }
+
+    nd4j::ops::scatter_add<double> op;
+    auto result = op.execute({&matrix, &idc, &updates}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto z = result->at(0);
+
+    for (int e = 0; e < exp.lengthOf(); e++)
+        ASSERT_EQ(exp.getScalar(e), z->getScalar(e));
+
+    // non-deterministic mode may only differ in rounding
+    auto result2 = op.execute({&matrix, &idc, &updates}, {}, {0});
+    ASSERT_EQ(ND4J_STATUS_OK, result2->status());
+    ASSERT_TRUE(exp.equalsTo(result2->at(0), 1e-8));
+
+    delete result;
+    delete result2;
+}
+
+TEST_F(ParityOpsTests, Test_Scatter_Add_8) {
+    // few rows, and row 0 gets most of updates, so it's split between threads
+    const int rows = 4;
+    const int columns = 32;
+    const int numIndices = 8000;
+
+    NDArray<double> matrix('c', {rows, columns});
+    NDArray<double> idc('c', {1, numIndices});
+    NDArray<double> updates('c', {numIndices, columns});
+    NDArray<double> expAdd('c', {rows, columns});
+    NDArray<double> expSub('c', {rows, columns});
+
+    for (int e = 0; e < matrix.lengthOf(); e++)
+        matrix.putScalar(e, (double) e / 5.0);
+
+    for (int e = 0; e < numIndices; e++)
+        idc.putScalar(e, (double) (e < 6000 ? 0 : e % rows));
+
+    for (int e = 0; e < updates.lengthOf(); e++)
+        updates.putScalar(e, (double) (e % 7) / 4.0);
+
+    expAdd.assign(&matrix);
+    expSub.assign(&matrix);
+    for (int e = 0; e < numIndices; e++) {
+        int r = (int) idc.getScalar(e);
+        for (int c = 0; c < columns; c++) {
+            expAdd.putScalar(r, c, expAdd.getScalar(r, c) + updates.getScalar(e, c));
+            expSub.putScalar(r, c, expSub.getScalar(r, c) - updates.getScalar(e, c));
+        }
+    }
+
+    // with 4 threads hot row threshold is 8000 / 4 = 2000 updates, and row 0 gets 6500 of them
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+
+    nd4j::ops::scatter_add<double> opAdd;
+    auto resultAdd = opAdd.execute({&matrix, &idc, &updates}, {}, {0});
+
+    nd4j::ops::scatter_sub<double> opSub;
+    auto resultSub = opSub.execute({&matrix, &idc, &updates}, {}, {0});
+
+    omp_set_num_threads(threads);
+
+    ASSERT_EQ(ND4J_STATUS_OK, resultAdd->status());
+    ASSERT_TRUE(expAdd.equalsTo(resultAdd->at(0), 1e-8));
+
+    ASSERT_EQ(ND4J_STATUS_OK, resultSub->status());
+    ASSERT_TRUE(expSub.equalsTo(resultSub->at(0), 1e-8));
+
+    delete resultAdd;
+    delete resultSub;
+}
+
+TEST_F(ParityOpsTests, Test_Scatter_Update_Duplicates_1) {
+    NDArray<float> matrix('c', {3, 2}, {1, 2, 3, 4, 5, 6});
+    NDArray<float> idc('c', {1, 4}, {2, 0, 2, 2});
+    NDArray<float> updates('c', {4, 2}, {10, 11, 20, 21, 30, 31, 40, 41});
+    NDArray<float> exp('c', {3, 2}, {20, 21, 3, 4, 40, 41});
+
+    nd4j::ops::scatter_upd<float> op;
+    auto result = op.execute({&matrix, &idc, &updates}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
+TEST_F(ParityOpsTests, Test_Scatter_Add_BadIndex_1) {
+    NDArray<float> matrix('c', {2, 2}, {1, 2, 3, 4});
+    NDArray<float> idc('c', {1, 1}, {5});
+    NDArray<float> updates('c', {1, 2}, {1, 1});
+
+    nd4j::ops::scatter_add<float> op;
+    auto result = op.execute({&matrix, &idc, &updates}, {}, {});
+    ASSERT_NE(ND4J_STATUS_OK, result->status());
+
+    delete result;
+}
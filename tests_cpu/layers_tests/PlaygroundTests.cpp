@@ -7,6 +7,10 @@
 #include <chrono>
 #include <Node.h>
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/BlasHelper.h>
+#include <functional>
+#include <NativeOps.h>
+#include <ops/specials.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -251,4 +255,173 @@ TEST_F(PlaygroundTests, ScalarTest_2) {
 
     for (auto v: pool2)
         delete v;
-}
\ No newline at end of file
+}
+
+TEST_F(PlaygroundTests, GemmTest_1) {
+    const int M = 512, N = 512, K = 512;
+    std::vector<float> A(M * K), B(K * N), C(M * N);
+    for (int e = 0; e < M * K; e++) {
+        A[e] = (e % 11) * 0.1f;
+        B[e] = (e % 7) * 0.2f;
+    }
+
+    // previous fallback kernel: transposed copy of A, then independent dot per output element
+    auto legacy = [&] () {
+        float *aT = new float[M * K];
+        for (int r = 0; r < M; r++)
+            for (int c = 0; c < K; c++)
+                aT[r * K + c] = A[c * M + r];
+
+#pragma omp parallel for proc_bind(spread)
+        for (int r = 0; r < M; r++)
+            for (int c = 0; c < N; c++)
+                C[c * M + r] = nd4j::math::nd4j_dot<float>(aT + r * K, B.data() + c * K, K);
+
+        delete[] aT;
+    };
+
+    auto blocked = [&] () {
+        nd4j::blas::GEMM<float>::op(CblasColMajor, CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A.data(), M, B.data(), K, 0.0f, C.data(), M);
+    };
+
+    auto measure = [&] (std::function<void()> func) -> Nd4jIndex {
+        func();
+        auto timeStart = std::chrono::system_clock::now();
+        for (int e = 0; e < numIterations; e++)
+            func();
+        auto timeEnd = std::chrono::system_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count() / numIterations;
+    };
+
+    double flops = 2.0 * M * N * K;
+
+    Nd4jIndex legacyTime = measure(legacy);
+    nd4j_printf("Legacy GEMM time: %lld us; %f GFLOP/s\n", legacyTime, flops / legacyTime / 1e3);
+
+    Nd4jIndex blockedTime = measure(blocked);
+    nd4j_printf("Blocked GEMM time: %lld us; %f GFLOP/s\n", blockedTime, flops / blockedTime / 1e3);
+
+    if (BlasHelper::getInstance()->hasGEMM<float>()) {
+        auto external = [&] () {
+            BlasHelper::getInstance()->sgemm()(CblasColMajor, CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A.data(), M, B.data(), K, 0.0f, C.data(), M);
+        };
+
+        Nd4jIndex externalTime = measure(external);
+        nd4j_printf("External BLAS GEMM time: %lld us; %f GFLOP/s\n", externalTime, flops / externalTime / 1e3);
+    } else {
+        nd4j_printf("External BLAS isn't available, skipping\n", "");
+    }
+}
+
+
+TEST_F(PlaygroundTests, OpOverheadTest_1) {
+    NDArray<float> x('c', {2, 2});
+    NDArray<float> y('c', {2, 2});
+    NDArray<float> z('c', {2, 2});
+
+    nd4j::ops::add<float> op;
+    auto cache = nd4j::ops::ShapeCache::getInstance();
+    int iterations = 10000;
+
+    // outputs are allocated by op, shape function is called every time
+    cache->setEnabled(false);
+    auto timeStart = std::chrono::system_clock::now();
+    for (int e = 0; e < iterations; e++) {
+        auto result = op.execute({&x, &y}, {}, {});
+        delete result;
+    }
+    auto timeEnd = std::chrono::system_clock::now();
+    auto uncachedTime = std::chrono::duration_cast<std::chrono::nanoseconds> (timeEnd - timeStart).count();
+
+    // outputs are allocated by op, output shape comes from cache
+    cache->setEnabled(true);
+    timeStart = std::chrono::system_clock::now();
+    for (int e = 0; e < iterations; e++) {
+        auto result = op.execute({&x, &y}, {}, {});
+        delete result;
+    }
+    timeEnd = std::chrono::system_clock::now();
+    auto cachedTime = std::chrono::duration_cast<std::chrono::nanoseconds> (timeEnd - timeStart).count();
+
+    // outputs are provided by caller
+    timeStart = std::chrono::system_clock::now();
+    for (int e = 0; e < iterations; e++)
+        op.execute({&x, &y}, {&z}, {}, {});
+    timeEnd = std::chrono::system_clock::now();
+    auto providedTime = std::chrono::duration_cast<std::chrono::nanoseconds> (timeEnd - timeStart).count();
+
+    nd4j_printf("Per-call overhead: uncached shapes %lld ns; cached shapes %lld ns; provided outputs %lld ns\n", uncachedTime / iterations, cachedTime / iterations, providedTime / iterations);
+}
+
+
+TEST_F(PlaygroundTests, ThresholdEncoderTest_1) {
+    Nd4jIndex N = 100000000L;
+    float threshold = 1e-3f;
+
+    // ~1% of elements are above threshold
+    std::vector<float> x(N);
+    for (Nd4jIndex e = 0; e < N; e++)
+        x[e] = e % 97 == 0 ? 2e-3f : 1e-5f;
+
+    Nd4jIndex numBlocks = N / THRESHOLD_BLOCK_SIZE + (N % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+    std::vector<int> blocks(numBlocks + 1);
+    std::vector<int> offsets(numBlocks);
+
+    NativeOps nativeOps;
+
+    auto timeStart = std::chrono::system_clock::now();
+
+    nativeOps.encodeThresholdP1Float(nullptr, x.data(), N, blocks.data(), threshold);
+    nativeOps.encodeThresholdP2Int(nullptr, blocks.data(), numBlocks, offsets.data());
+
+    nd4j::FloatBits2 fb;
+    fb.f_ = threshold;
+    std::vector<int> encoded(blocks[0] + 4);
+    encoded[0] = blocks[0];
+    encoded[1] = (int) N;
+    encoded[2] = fb.i_;
+
+    nativeOps.encodeThresholdP3Float(nullptr, x.data(), offsets.data(), N, encoded.data());
+
+    auto timeEnd = std::chrono::system_clock::now();
+    auto encodeTime = std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count();
+
+    timeStart = std::chrono::system_clock::now();
+    nativeOps.decodeThresholdFloat(nullptr, encoded.data(), N, x.data());
+    timeEnd = std::chrono::system_clock::now();
+    auto decodeTime = std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count();
+
+    ASSERT_EQ((int) ((N + 96) / 97), encoded[0]);
+
+    double gb = (double) N * sizeof(float) / 1e9;
+    nd4j_printf("Threshold encoding of %lld elements: %lld us, %f GB/s; decoding: %lld us\n", N, encodeTime, gb / (encodeTime / 1e6), decodeTime);
+}
+
+TEST_F(PlaygroundTests, SortTest_1) {
+    Nd4jIndex N = 10000000L;
+
+    std::vector<float> x(N);
+    for (Nd4jIndex e = 0; e < N; e++)
+        x[e] = (float) ((e * 2654435761L) % 1000003L) - 500000.0f;
+
+    int shapeInfo[] = {2, 1, (int) N, (int) N, 1, 0, 1, 99};
+
+    NativeOps nativeOps;
+
+    auto timeStart = std::chrono::system_clock::now();
+    nativeOps.sortFloat(nullptr, x.data(), shapeInfo, false);
+    auto timeEnd = std::chrono::system_clock::now();
+    auto sortTime = std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count();
+
+    for (Nd4jIndex e = 1; e < N; e++)
+        ASSERT_TRUE(x[e - 1] <= x[e]);
+
+    std::vector<Nd4jIndex> indices(N);
+
+    timeStart = std::chrono::system_clock::now();
+    nativeOps.argsortFloat(nullptr, x.data(), shapeInfo, indices.data(), true);
+    timeEnd = std::chrono::system_clock::now();
+    auto argsortTime = std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count();
+
+    nd4j_printf("Sort of %lld elements: %lld us; argsort: %lld us\n", N, sortTime, argsortTime);
+}
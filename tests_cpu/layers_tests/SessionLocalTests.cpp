@@ -66,4 +66,46 @@ TEST_F(SessionLocalTests, BasicTests_2) {
     }
 }
 
+TEST_F(SessionLocalTests, SharedTests_1) {
+    VariableSpace<float> variableSpace;
+    SessionLocalStorage<float> storage(&variableSpace, nullptr, true);
+    auto alpha = new nd4j::NDArray<float>(5,5,'c');
+    alpha->assign(1.0);
+
+    auto placeholder = new Variable<float>(true);
+
+    variableSpace.putVariable(-1, alpha);
+    variableSpace.putVariable(-2, placeholder);
+
+#pragma omp parallel for num_threads(4)
+    for (int e = 0; e < 4; e++) {
+        storage.startSession();
+
+        auto varSpace = storage.localVariableSpace();
+
+        auto input = new nd4j::NDArray<float>(5,5,'c');
+        input->assign((float) e + 1);
+
+        varSpace->getVariable(-2)->setNDArray(input);
+    }
+
+    ASSERT_EQ(4, storage.numberOfSessions());
+
+    float sum = 0.0f;
+    for (int e = 1; e <= 4; e++) {
+        auto varSpace = storage.localVariableSpace((Nd4jIndex) e);
+
+        // weights aren't copied
+        ASSERT_TRUE(alpha == varSpace->getVariable(-1)->getNDArray());
+
+        // but placeholders are private
+        ASSERT_TRUE(placeholder != varSpace->getVariable(-2));
+        ASSERT_TRUE(varSpace->getVariable(-2)->isPlaceholder());
+        sum += varSpace->getVariable(-2)->getNDArray()->getScalar(0);
+    }
+
+    ASSERT_NEAR(10.0f, sum, 1e-5f);
+    ASSERT_FALSE(placeholder->hasNDArray());
+}
+
 #endif //LIBND4J_SESSIONLOCALTESTS_H
@@ -8,6 +8,7 @@
 #include "testlayers.h"
 #include <NDArray.h>
 #include <NDArrayFactory.h>
+#include <helpers/TadCache.h>
 
 using namespace nd4j;
 
@@ -107,6 +108,58 @@ TEST_F(TadTests, TadEdgeCase_1) {
 
 
 // ///////////////////////////////////////////////////////////////////
+TEST_F(TadTests, TadCache_1) {
+    NDArray<float> x('c', {3, 4, 5});
+    auto cache = TadCache::getInstance();
+
+    auto misses = cache->misses();
+    auto hits = cache->hits();
+
+    std::vector<int> dims({0, 2});
+    auto tadA = cache->tadForDimensions(x.getShapeInfo(), dims);
+    auto tadB = cache->tadForDimensions(x.getShapeInfo(), dims);
+
+    ASSERT_TRUE(tadA.get() == tadB.get());
+    ASSERT_EQ(misses + 1, cache->misses());
+    ASSERT_EQ(hits + 1, cache->hits());
+
+    shape::TAD tad(x.getShapeInfo(), dims.data(), (int) dims.size());
+    tad.createTadOnlyShapeInfo();
+    tad.createOffsets();
+
+    ASSERT_EQ(tad.numTads, tadA->numberOfTads());
+    ASSERT_TRUE(shape::equalsStrict(tad.tadOnlyShapeInfo, tadA->tadOnlyShapeInfo()));
+    for (int e = 0; e < tad.numTads; e++)
+        ASSERT_EQ(tad.tadOffsets[e], tadA->tadOffsets()[e]);
+}
+
+TEST_F(TadTests, TadCache_2) {
+    NDArray<float> x('c', {3, 4, 5});
+    auto cache = TadCache::getInstance();
+    auto capacity = cache->capacity();
+
+    cache->clear();
+    cache->setCapacity(2);
+
+    auto evictions = cache->evictions();
+    auto tad0 = cache->tadForDimensions(x.getShapeInfo(), 0);
+    cache->tadForDimensions(x.getShapeInfo(), 1);
+    cache->tadForDimensions(x.getShapeInfo(), 2);
+
+    ASSERT_EQ(2, cache->size());
+    ASSERT_EQ(evictions + 1, cache->evictions());
+
+    // evicted pack is still valid for its holder
+    ASSERT_EQ(20, tad0->numberOfTads());
+
+    auto misses = cache->misses();
+    auto tad0a = cache->tadForDimensions(x.getShapeInfo(), 0);
+    ASSERT_EQ(misses + 1, cache->misses());
+    ASSERT_FALSE(tad0.get() == tad0a.get());
+
+    cache->setCapacity(capacity);
+}
+
 // TEST_F(TadTests, TestShapeTad_2) {
         
 //     NDArray<float> input('c', {2,1,4,1});
@@ -9,6 +9,7 @@
 #include <NDArray.h>
 #include <Workspace.h>
 #include <MemoryRegistrator.h>
+#include <algorithm>
 
 using namespace nd4j;
 using namespace nd4j::memory;
@@ -171,5 +172,112 @@ TEST_F(WorkspaceTests, CloneTest1) {
     delete clone;
 }
 
+TEST_F(WorkspaceTests, AlignmentTest1) {
+    Workspace ws(65536);
+
+    auto p0 = ws.allocateBytes(3);
+    auto p1 = ws.allocateBytes(17);
+    auto p2 = ws.allocateBytes(65536);
+
+    ASSERT_EQ(0, ((Nd4jIndex) p0) % WORKSPACE_ALIGNMENT);
+    ASSERT_EQ(0, ((Nd4jIndex) p1) % WORKSPACE_ALIGNMENT);
+    ASSERT_EQ(0, ((Nd4jIndex) p2) % WORKSPACE_ALIGNMENT);
+
+    ASSERT_EQ(2 * WORKSPACE_ALIGNMENT, ws.getCurrentOffset());
+    ASSERT_EQ(65536, ws.getSpilledSize());
+}
+
+TEST_F(WorkspaceTests, SpillChunksTest1) {
+    Workspace ws(1024);
+
+    for (int e = 0; e < 100; e++)
+        ws.allocateBytes(512);
+
+    // 2 allocations fit into block, everything else goes into single chunk
+    ASSERT_EQ(98, ws.getSpillsCount());
+    ASSERT_EQ(98 * 512, ws.getSpilledSize());
+    ASSERT_EQ(1, ws.getSpillChunks());
+
+    ws.scopeOut();
+    ws.scopeIn();
+
+    ASSERT_EQ(0, ws.getSpillsCount());
+    ASSERT_EQ(0, ws.getSpillChunks());
+    ASSERT_EQ(100 * 512, ws.getCurrentSize());
+}
+
+TEST_F(WorkspaceTests, ConcurrentTest1) {
+    Workspace ws(1024 * 1024);
+    std::vector<Nd4jIndex> pointers(4096);
+
+#pragma omp parallel for schedule(static)
+    for (int e = 0; e < 4096; e++) {
+        auto p = (int *) ws.allocateBytes(128);
+        p[0] = e;
+        pointers[e] = (Nd4jIndex) p;
+    }
+
+    ASSERT_EQ(4096 * 128, ws.getCurrentOffset());
+    ASSERT_EQ(0, ws.getSpilledSize());
+
+    // all allocations must be distinct
+    std::sort(pointers.begin(), pointers.end());
+    for (int e = 1; e < 4096; e++)
+        ASSERT_TRUE(pointers[e] - pointers[e - 1] >= 128);
+}
+
+TEST_F(WorkspaceTests, ThreadArenaTest1) {
+    Workspace ws(1024 * 1024);
+    ws.setThreadArenaSize(16384);
+
+    ASSERT_EQ(16384, ws.getThreadArenaSize());
+
+    std::vector<int*> pointers(1024);
+
+#pragma omp parallel for schedule(static)
+    for (int e = 0; e < 1024; e++) {
+        auto p = (int *) ws.allocateBytes(100);
+        p[0] = e;
+        pointers[e] = p;
+    }
+
+    for (int e = 0; e < 1024; e++) {
+        ASSERT_EQ(e, pointers[e][0]);
+        ASSERT_EQ(0, ((Nd4jIndex) pointers[e]) % WORKSPACE_ALIGNMENT);
+    }
+
+    ASSERT_EQ(0, ws.getSpilledSize());
+    ASSERT_TRUE(ws.getCurrentOffset() >= 1024 * 128);
+
+    // arenas carved in previous cycle are invalidated
+    ws.scopeOut();
+    ASSERT_EQ(0, ws.getCurrentOffset());
+
+    ws.allocateBytes(100);
+    ASSERT_EQ(16384, ws.getCurrentOffset());
+
+    // allocations bigger than quarter of arena go to shared block directly
+    ws.allocateBytes(8192);
+    ASSERT_EQ(16384 + 8192, ws.getCurrentOffset());
+}
+
+
+TEST_F(WorkspaceTests, ThreadArenaTest2) {
+    Workspace ws;
+    ws.setThreadArenaSize(16384);
+
+    // nothing fits yet, but usage is still accounted in whole sub-arenas
+    ws.allocateBytes(100);
+    ws.allocateBytes(100);
+    ASSERT_EQ(200, ws.getSpilledSize());
+
+    ws.scopeIn();
+    ASSERT_EQ(16384, ws.getCurrentSize());
+
+    ws.allocateBytes(100);
+    ws.allocateBytes(100);
+    ASSERT_EQ(0, ws.getSpilledSize());
+    ASSERT_EQ(16384, ws.getCurrentOffset());
+}
 
 #endif //LIBND4J_WORKSPACETESTS_H